@@ -22,6 +22,53 @@
 #define MEMORY_LATENCY 137
 #define RANDOM_CHOICE 138
 #define TRACEFILE 139
+#define L2_CACHELINES 140
+#define L2_CACHELINE_SIZE 141
+#define L2_LATENCY 142
+#define TREE_PSEUDO_LRU 143
+#define BIT_PSEUDO_LRU 144
+#define STATIC_RRIP 145
+#define BIMODAL_RRIP 146
+#define DYNAMIC_RRIP 147
+#define RRPV_BITS 148
+#define LEAST_FREQUENTLY_USED 149
+#define ADAPTIVE_REPLACEMENT 150
+#define TWO_QUEUE 151
+#define LIRS_CHOICE 152
+#define OPTIMAL_CHOICE 153
+#define DYNAMIC_INSERTION 154
+#define DIP_SERIES 155
+#define POLICY_PLUGIN_CHOICE 156
+#define WRITE_BUFFER_DEPTH 157
+#define WRITE_COMBINING 158
+#define DRAM_BANKS 159
+#define DRAM_CHANNELS 160
+#define DRAM_RANKS 161
+#define DRAM_ROW_SIZE 162
+#define DRAM_TIMING 163
+#define CLOSED_PAGE 164
+#define MC_QUEUE_DEPTH 165
+#define MC_WATERMARKS 166
+#define CORE_CLOCK 167
+#define CACHE_CLOCK 168
+#define MEMORY_CLOCK 169
+#define CDC_STAGES 170
+#define CACHE_LATENCY_NS 171
+#define MEMORY_LATENCY_NS 172
+#define L2_LATENCY_NS 173
+#define MEMORY_IMAGE 174
+#define MEMORY_IMAGE_BASE 175
+#define LOAD_STORE_QUEUE 176
+#define ISSUE_WIDTH 177
+#define QUANTUM 178
+#define WAYS 179
+#define WAY_MASKS 180
+#define READ_RESULTS 181
+#define READ_RESULTS_BINARY 182
+#define ICACHE_LINES 183
+#define ICACHE_LINE_SIZE 184
+#define ICACHE_FULLASSOCIATIVE 185
+#define ICACHE_POLICY 186
 
 /**
  * Taken inspiration and adapted from exercises 'Nutzereingaben' and 'File IO' from GRA Week 3
@@ -30,7 +77,15 @@
 const char* usage_msg =
     "usage: %s [-c c/--cycles c] [--lcycles] [--directmapped] [--fullassociative] "
     "[--cacheline-size s] [--cachelines n] [--cache-latency l] [--memorylatency m] "
-    "[--lru] [--fifo] [--random] [--tf=<filename>] [--extended] [-h/--help] <filename>\n"
+    "[--lru] [--fifo] [--random] [--plru] [--bitplru] [--srrip] [--brrip] [--drrip] [--rrpv-bits b] [--lfu] [--arc] "
+    "[--2q] [--lirs] [--opt] [--dip] [--dip-series f] [--policy-plugin p] [--write-buffer-depth d] "
+    "[--write-combining] [--dram-banks n] [--dram-channels n] [--dram-ranks n] [--dram-row-size s] [--dram-timing t] "
+    "[--closed-page] [--mc-queue-depth n] [--mc-watermarks w] [--l2-cachelines n] [--l2-cacheline-size s] "
+    "[--l2-latency l] [--core-clock f] [--cache-clock f] [--memory-clock f] [--cdc-stages n] [--cache-latency-ns t] "
+    "[--memory-latency-ns t] [--l2-latency-ns t] [--mem-image f] [--mem-image-base a] [--lsq-size n] "
+    "[--issue-width w] [--quantum q] [--ways n] [--way-masks m] [--read-results f] [--read-results-binary] "
+    "[--icache-lines n] [--icache-line-size s] [--icache-fullassociative] [--icache-policy p] [--tf=<filename>] "
+    "[--extended] [-h/--help] <filename> [<filename> ...]\n"
     "   -c c / --cycles c       Set the number of cycles to be simulated to c. Allows inputs in range [0,2^16-1]\n"
     "   --lcycles               Allow input of cycles of up to 2^32-1\n"
     "   --directmapped          Simulate a direct-mapped cache\n"
@@ -42,6 +97,56 @@ const char* usage_msg =
     "   --lru                   Use LRU as cache-replacement policy\n"
     "   --fifo                  Use FIFO as cache-replacement policy\n"
     "   --random                Use random cache-replacement policy\n"
+    "   --plru                  Use tree pseudo-LRU as cache-replacement policy\n"
+    "   --bitplru               Use bit pseudo-LRU as cache-replacement policy\n"
+    "   --srrip                 Use static RRIP as cache-replacement policy\n"
+    "   --brrip                 Use bimodal RRIP as cache-replacement policy\n"
+    "   --drrip                 Use dynamic RRIP (set dueling between SRRIP and BRRIP) as cache-replacement policy\n"
+    "   --rrpv-bits b           Set the width of the re-reference prediction values of the RRIP policies to b bits\n"
+    "   --lfu                   Use LFU with aging as cache-replacement policy\n"
+    "   --arc                   Use ARC as cache-replacement policy\n"
+    "   --2q                    Use 2Q as cache-replacement policy\n"
+    "   --lirs                  Use LIRS as cache-replacement policy\n"
+    "   --opt                   Use Belady's optimal policy as cache-replacement policy (not combinable with an L2)\n"
+    "   --dip                   Use DIP (set dueling between LRU and bimodal insertion) as cache-replacement policy\n"
+    "   --dip-series f          Write the insertion DIP chooses per phase to the CSV file f\n"
+    "   --policy-plugin p       Use the cache-replacement policy implemented by the shared library p\n"
+    "   --write-buffer-depth d  Set the number of write buffer entries of the data cache to d\n"
+    "   --write-combining       Drain whole lines from the write buffer as burst writes (not combinable with an L2)\n";
+
+// split off usage_msg to stay below the maximum length of a string literal
+const char* usage_msg_continued =
+    "   --dram-banks n          Replace the flat memory latency by a DRAM model with n banks per rank\n"
+    "   --dram-channels n       Set the number of DRAM channels to n\n"
+    "   --dram-ranks n          Set the number of DRAM ranks per channel to n\n"
+    "   --dram-row-size s       Set the size of a DRAM row to s bytes\n"
+    "   --dram-timing t         Set the DRAM timings to t = tRCD,tCAS,tRP,tRAS cycles\n"
+    "   --closed-page           Close every DRAM row right after its access\n"
+    "   --mc-queue-depth n      Put a memory controller queueing n requests in front of the memory\n"
+    "   --mc-watermarks w       Set the write drain watermarks of the memory controller to w = high,low\n"
+    "   --l2-cachelines n       Add a unified L2 cache with n cachelines shared by instruction and data cache\n"
+    "   --l2-cacheline-size s   Set the L2 cache line size to s bytes\n"
+    "   --l2-latency l          Set the L2 cache latency to l cycles\n"
+    "   --core-clock f          Run the CPU and the L1 caches at f MHz\n"
+    "   --cache-clock f         Run the L2 cache at f MHz\n"
+    "   --memory-clock f        Run the memory and its controller at f MHz\n"
+    "   --cdc-stages n          Let requests between clock domains pass n synchronizer stages\n"
+    "   --cache-latency-ns t    Set the cache latency to t nanoseconds\n"
+    "   --memory-latency-ns t   Set the memory latency to t nanoseconds\n"
+    "   --l2-latency-ns t       Set the L2 cache latency to t nanoseconds\n"
+    "   --mem-image f           Preload the memory from the raw binary file f\n"
+    "   --mem-image-base a      Load the memory image to the addresses from a on\n"
+    "   --lsq-size n            Run the CPU out of order with a load/store queue of n entries\n"
+    "   --issue-width w         Issue and retire up to w requests per cycle out of order\n"
+    "   --quantum q             Run the files as processes sharing the core, switching every q requests\n"
+    "   --ways n                Partition the fully associative data cache into n ways\n"
+    "   --way-masks m           Let the processes fill only the ways set in their masks m = mask,mask,...\n"
+    "   --read-results f        Write the value and completion cycle of every read to the file f\n"
+    "   --read-results-binary   Write the read results as packed binary records instead of CSV\n"
+    "   --icache-lines n        Set the number of instruction cache lines to n\n"
+    "   --icache-line-size s    Set the instruction cache line size to s bytes\n"
+    "   --icache-fullassociative Simulate a fully associative instruction cache\n"
+    "   --icache-policy p       Replace the lines of the instruction cache by the policy p\n"
     "   --extended              Call extended run_simulation-method\n"
     "   --tf=<filename>         File name for a trace (without file extension) containing all signals. If not set, no "
     "trace file will be created\n"
@@ -49,6 +154,9 @@ const char* usage_msg =
 
 const char* help_msg = "Positional arguments:\n"
                        "   <filename>   The name of the file to be processed (including .csv extension)\n"
+                       "   <filename> ...   The names of the files further cores process, up to 15. Each core has "
+                       "its own caches, the data caches being write-back and kept coherent by a MESI snooping bus "
+                       "in front of the shared memory. Given --quantum, processes sharing the single core instead\n"
                        "\n"
                        "Optional arguments:\n"
                        "   -c c / --cycles c       The number of cycles used for the simulation (default: c = 100000)\n"
@@ -62,17 +170,123 @@ const char* help_msg = "Positional arguments:\n"
                        "   --lru                   Use LRU as cache-replacement policy (Set as default)\n"
                        "   --fifo                  Use FIFO as cache-replacement policy\n"
                        "   --random                Use random cache-replacement policy\n"
-                       "   --tf=<filename>         The name for a trace file (without file extension) containing all "
-                       "signals. If not set, no trace file will be created\n"
-                       "   --extended              Calls extended run_simulation-method with additional parameters "
-                       "\'policy' and \'lcycles'\n"
-                       "   -h / --help             Show this help message and exit\n";
+                       "   --plru                  Use tree pseudo-LRU as cache-replacement policy\n"
+                       "   --bitplru               Use bit pseudo-LRU (one MRU bit per cache line) as "
+                       "cache-replacement policy\n"
+                       "   --srrip                 Use static re-reference interval prediction as cache-replacement "
+                       "policy\n"
+                       "   --brrip                 Use bimodal re-reference interval prediction as cache-replacement "
+                       "policy\n"
+                       "   --drrip                 Use dynamic re-reference interval prediction, choosing between "
+                       "SRRIP and BRRIP by set dueling, as cache-replacement policy\n"
+                       "   --rrpv-bits b           The width of the re-reference prediction values of the RRIP "
+                       "policies in bits, in range [1,8] (default: 2)\n"
+                       "   --lfu                   Use least frequently used with periodically halved use counters as "
+                       "cache-replacement policy\n"
+                       "   --arc                   Use adaptive replacement cache as cache-replacement policy\n"
+                       "   --2q                    Use 2Q (FIFO for new, LRU for reused cache lines) as "
+                       "cache-replacement policy\n"
+                       "   --lirs                  Use low inter-reference recency set as cache-replacement policy\n"
+                       "   --opt                   Use Belady's optimal policy, evicting the cache line used again "
+                       "farthest in the future, as cache-replacement policy. Only meant as a bound for the other "
+                       "policies\n"
+                       "   --dip                   Use dynamic insertion, choosing between LRU and bimodal insertion "
+                       "by set dueling, as cache-replacement policy\n"
+                       "   --dip-series f          The name of a CSV file the insertion DIP chooses in each phase of "
+                       "10000 accesses is written to. If not set, no such file will be created\n"
+                       "   --policy-plugin p       The path of a shared library implementing the cache-replacement "
+                       "policy through the interface in src/Simulation/Policy/PolicyPlugin.h\n"
+                       "   --write-buffer-depth d  The number of entries of the write buffer of the data cache, each "
+                       "coalescing the writes to one cache line, in range [1,256] (default: 4)\n"
+                       "   --write-combining       Let the write buffer of the data cache wait for a line to be "
+                       "written completely and send it to the RAM as a single burst write, paying the memory latency "
+                       "only once\n";
+
+// split off help_msg to stay below the maximum length of a string literal
+const char* help_msg_continued =
+    "   --dram-banks n          The number of banks per rank of a DRAM model replacing the flat "
+    "memory latency, in range [1,256] (default: 0 = no DRAM model)\n"
+    "   --dram-channels n       The number of DRAM channels, in range [1,64] (default: 1)\n"
+    "   --dram-ranks n          The number of DRAM ranks per channel, in range [1,64] "
+    "(default: 1)\n"
+    "   --dram-row-size s       The size of a DRAM row in bytes, a power of 2 of at least 16 "
+    "(default: 2048)\n"
+    "   --dram-timing t         The DRAM timings tRCD,tCAS,tRP,tRAS in cycles "
+    "(default: 14,14,14,33)\n"
+    "   --closed-page           Close every DRAM row right after its access instead of leaving it "
+    "open for further accesses\n"
+    "   --mc-queue-depth n      The number of requests a memory controller in front of the memory "
+    "queues and reorders, in range [1,256] (default: 0 = no memory controller)\n"
+    "   --mc-watermarks w       The number of queued writes high,low at which the memory controller "
+    "starts and stops draining writes before reads, 0 <= low < high <= queue depth "
+    "(default: 3/4 and 1/4 of the queue depth)\n"
+    "   --l2-cachelines n       The number of cache lines of a unified L2 cache shared by "
+    "instruction and data cache (default: 0 = no L2)\n"
+    "   --l2-cacheline-size s   The size of an L2 cache line in bytes (default: 64)\n"
+    "   --l2-latency l          The L2 cache latency in cycles (default: 10)\n"
+    "   --core-clock f          The frequency of the CPU and the L1 caches in MHz, in range "
+    "[1,10000] (default: 1000)\n"
+    "   --cache-clock f         The frequency of the L2 cache in MHz, in range [1,10000] "
+    "(default: the core clock)\n"
+    "   --memory-clock f        The frequency of the memory and its controller in MHz, in range "
+    "[1,10000] (default: the core clock)\n"
+    "   --cdc-stages n          The number of synchronizer stages, i.e. cycles of the receiving "
+    "clock, a request or its result takes to cross between clock domains, in range [1,16] (default: 2)\n"
+    "   --cache-latency-ns t    The cache latency in nanoseconds, rounded up to cycles of the "
+    "core clock. Replaces --cache-latency\n"
+    "   --memory-latency-ns t   The memory latency in nanoseconds, rounded up to cycles of the "
+    "memory clock. Replaces --memory-latency\n"
+    "   --l2-latency-ns t       The L2 cache latency in nanoseconds, rounded up to cycles of the "
+    "cache clock. Replaces --l2-latency\n"
+    "   --mem-image f           A raw binary file (may be sparse) preloading the memory behind the "
+    "caches, mapped instead of read so only the accessed parts are loaded. If not set, all memory "
+    "reads as 0 until written\n"
+    "   --mem-image-base a      The address the first byte of the memory image is loaded to, decimal "
+    "or hexadecimal with 0x (default: 0)\n"
+    "   --lsq-size n            The number of entries of the load/store queue of an out-of-order CPU, "
+    "which fetches ahead, lets loads overtake older stores to independent addresses and serves loads "
+    "from older stores to the same address, while the data cache still serves one request at a time, in range "
+    "[1,256] (default: 0 = in-order CPU)\n"
+    "   --issue-width w         The number of requests the out-of-order CPU issues and retires per "
+    "cycle, in range [1,16] (default: 1)\n";
+
+// split off help_msg_continued to stay below the maximum length of a string literal
+const char* help_msg_end =
+    "   --quantum q             Instead of simulating a core per file, runs the files as processes "
+    "sharing the single core and its caches, switched round robin every q requests, in range "
+    "[1,2^20]. The data cache tags every line with the address space ID of its process\n"
+    "   --ways n                The number of equally sized groups of lines the fully associative "
+    "data cache is partitioned into, standing in for the ways CAT masks select, in range [1,32]. Each "
+    "is replaced by its own policy. Has to divide the number of cachelines\n"
+    "   --way-masks m           One mask per process, decimal or hexadecimal with 0x, separated by "
+    "commas. Bit i of the mask of a process lets it fill way i (default: all ways)\n"
+    "   --read-results f        The name of a file the index, value and completion cycle of every read "
+    "are written to as CSV, instead of writing the value back into the data of its request. Single core "
+    "only. If not set, no such file will be created\n"
+    "   --read-results-binary   Write the read results as packed little-endian records of 20 bytes: the "
+    "index as 8, the value as 4 and the completion cycle as 8 bytes\n"
+    "   --icache-lines n        The number of cache lines of the instruction cache (default: 16)\n"
+    "   --icache-line-size s    The size of an instruction cache line in bytes (default: 128)\n"
+    "   --icache-fullassociative Simulate a fully associative instruction cache instead of a "
+    "direct-mapped one\n"
+    "   --icache-policy p       The replacement policy of the fully associative instruction cache, "
+    "one of lru, fifo, random, plru, bitplru, srrip, brrip, drrip, lfu, arc, 2q, lirs and dip (default: "
+    "lru). The instruction cache fetches the instruction addresses of the optional fifth column of the "
+    "file, or the index of the request if there are none\n"
+    "   --tf=<filename>         The name for a trace file (without file extension) containing all "
+    "signals. If not set, no trace file will be created\n"
+    "   --extended              Calls extended run_simulation-method with additional parameters "
+    "\'policy' and \'lcycles'\n"
+    "   -h / --help             Show this help message and exit\n";
 
-void print_usage(const char* progname) { fprintf(stderr, usage_msg, progname, progname, progname); }
+void print_usage(const char* progname) {
+    fprintf(stderr, usage_msg, progname, progname, progname);
+    fputs(usage_msg_continued, stderr);
+}
 
 void print_help(const char* progname) {
     print_usage(progname);
-    fprintf(stderr, "\n%s", help_msg);
+    fprintf(stderr, "\n%s%s%s", help_msg, help_msg_continued, help_msg_end);
 }
 
 /**
@@ -90,7 +304,8 @@ unsigned long check_user_input(char* endptr, char* message, const char* progname
 
     if (n <= 0 || errno != 0 || n > UINT32_MAX) {
         if (errno == 0 && n <= 0) { // Allow certain options with value 0
-            if (n == 0 && (strncmp(option, "--cache-latency", 15) == 0 || strncmp(option, "--memory", 8) == 0)) {
+            if (n == 0 && (strncmp(option, "--cache-latency", 15) == 0 || strncmp(option, "--memory", 8) == 0 ||
+                           strncmp(option, "--l2-latency", 12) == 0)) {
                 fprintf(stderr, "Warning: A value of 0 for %s is not realistic!\n", option);
                 return 0;
             } else { // Negative input
@@ -108,6 +323,25 @@ unsigned long check_user_input(char* endptr, char* message, const char* progname
     return (unsigned)n;
 }
 
+/**
+ * Checks whether the configuration sets any option only run_simulation_with_options knows about, or has traces only it
+ * can simulate: further cores or processes, gaps or instruction addresses. Replacement policies other than LRU still
+ * need --extended, as run_simulation always simulates LRU.
+ */
+int needs_extended_simulation(const struct Configuration* config) {
+    const struct SimulationOptions* options = &config->options;
+    return options->rrpvBits != 0 || options->dipSeriesFile != NULL || options->policyPlugin != NULL ||
+           options->writeBufferDepth != 0 || options->writeCombining || options->dram.banks != 0 ||
+           options->memoryController.queueDepth != 0 || options->l2.cacheLines != 0 ||
+           options->clocks.corePeriod != 0 || options->clocks.cachePeriod != 0 || options->clocks.memoryPeriod != 0 ||
+           options->clocks.crossingStages != 0 || options->memoryImage != NULL ||
+           options->core.loadStoreQueueSize != 0 || options->core.gaps != NULL ||
+           options->core.instructionAddresses != NULL || options->readResults.file != NULL ||
+           options->instructionCache.cacheLines != 0 || options->instructionCache.cacheLineSize != 0 ||
+           options->instructionCache.fullyAssociative || options->multicore.additionalCores != 0 ||
+           options->multiprogram.additionalProcesses != 0;
+}
+
 /**
  * This function ensures that the cycle size provided by the user does not exceed
  * the maximum allowed value (int), unless the extended cycle option is enabled.
@@ -140,11 +374,148 @@ char* get_option(int option) {
         return "--memory-latency";
     case TRACEFILE:
         return "--tf";
+    case L2_CACHELINES:
+        return "--l2-cachelines";
+    case L2_CACHELINE_SIZE:
+        return "--l2-cacheline-size";
+    case L2_LATENCY:
+        return "--l2-latency";
+    case RRPV_BITS:
+        return "--rrpv-bits";
+    case DIP_SERIES:
+        return "--dip-series";
+    case POLICY_PLUGIN_CHOICE:
+        return "--policy-plugin";
+    case WRITE_BUFFER_DEPTH:
+        return "--write-buffer-depth";
+    case DRAM_BANKS:
+        return "--dram-banks";
+    case DRAM_CHANNELS:
+        return "--dram-channels";
+    case DRAM_RANKS:
+        return "--dram-ranks";
+    case DRAM_ROW_SIZE:
+        return "--dram-row-size";
+    case DRAM_TIMING:
+        return "--dram-timing";
+    case MC_QUEUE_DEPTH:
+        return "--mc-queue-depth";
+    case CORE_CLOCK:
+        return "--core-clock";
+    case CACHE_CLOCK:
+        return "--cache-clock";
+    case MEMORY_CLOCK:
+        return "--memory-clock";
+    case CDC_STAGES:
+        return "--cdc-stages";
+    case CACHE_LATENCY_NS:
+        return "--cache-latency-ns";
+    case MEMORY_LATENCY_NS:
+        return "--memory-latency-ns";
+    case L2_LATENCY_NS:
+        return "--l2-latency-ns";
+    case MEMORY_IMAGE:
+        return "--mem-image";
+    case MEMORY_IMAGE_BASE:
+        return "--mem-image-base";
+    case LOAD_STORE_QUEUE:
+        return "--lsq-size";
+    case ISSUE_WIDTH:
+        return "--issue-width";
+    case QUANTUM:
+        return "--quantum";
+    case WAYS:
+        return "--ways";
+    case WAY_MASKS:
+        return "--way-masks";
+    case READ_RESULTS:
+        return "--read-results";
+    case READ_RESULTS_BINARY:
+        return "--read-results-binary";
+    case ICACHE_LINES:
+        return "--icache-lines";
+    case ICACHE_LINE_SIZE:
+        return "--icache-line-size";
+    case ICACHE_POLICY:
+        return "--icache-policy";
+    default:
+        return "string_data";
+    }
+}
+
+/**
+ * Retrieves the option string selecting the given replacement policy.
+ */
+const char* get_policy_option(enum CacheReplacementPolicy policy) {
+    switch (policy) {
+    case POLICY_LRU:
+        return "--lru";
+    case POLICY_FIFO:
+        return "--fifo";
+    case POLICY_RANDOM:
+        return "--random";
+    case POLICY_PLRU:
+        return "--plru";
+    case POLICY_BITPLRU:
+        return "--bitplru";
+    case POLICY_SRRIP:
+        return "--srrip";
+    case POLICY_BRRIP:
+        return "--brrip";
+    case POLICY_DRRIP:
+        return "--drrip";
+    case POLICY_LFU:
+        return "--lfu";
+    case POLICY_ARC:
+        return "--arc";
+    case POLICY_TWO_QUEUE:
+        return "--2q";
+    case POLICY_LIRS:
+        return "--lirs";
+    case POLICY_OPT:
+        return "--opt";
+    case POLICY_DIP:
+        return "--dip";
+    case POLICY_PLUGIN:
+        return "--policy-plugin";
     default:
         return "string_data";
     }
 }
 
+/**
+ * Sets a replacement policy other than LRU. An explicitly set LRU takes precedence, setting two different other
+ * policies is an error.
+ */
+void set_policy(const char* progname, struct Configuration* config, enum CacheReplacementPolicy policy, int isLruSet) {
+    if (isLruSet) {
+        fprintf(stderr, "Warning: More than one policy set. Simulating cache using default value LRU!\n");
+        return;
+    }
+    if (config->policy != POLICY_LRU && config->policy != policy) {
+        // always name the options in the same order, independent of which one came first
+        enum CacheReplacementPolicy first = config->policy < policy ? config->policy : policy;
+        enum CacheReplacementPolicy second = config->policy < policy ? policy : config->policy;
+        fprintf(stderr, "Error: %s and %s are both set. Please choose only one option!\n", get_policy_option(first),
+                get_policy_option(second));
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+    config->policy = policy;
+}
+
+/**
+ * Parses the name of a replacement policy of the instruction cache, the option selecting it without its dashes.
+ * OPT and plugins replace the lines of the data cache only. Returns -1 for any other name.
+ */
+int parse_instruction_cache_policy(const char* name) {
+    for (int policy = POLICY_LRU; policy <= POLICY_DIP; ++policy) {
+        if (policy != POLICY_OPT && strcmp(name, get_policy_option((enum CacheReplacementPolicy)policy) + 2) == 0)
+            return policy;
+    }
+    return -1;
+}
+
 /**
  * Checks if a number is a power of two.
  * Taken from: https://graphics.stanford.edu/~seander/bithacks.html#DetermineIfPowerOf2
@@ -153,6 +524,245 @@ int is_power_of_two(unsigned long n) { return n && !(n & (n - 1)); }
 
 int is_multiple_of_sixteen(unsigned long n) { return !(n & 15); }
 
+/**
+ * Parses exactly n comma separated numbers in range [0,max] from arg into values.
+ * Returns 0 if arg is no such list, leaving values partially written.
+ */
+int parse_number_list(const char* arg, unsigned int* values[], size_t n, long max) {
+    const char* pos = arg;
+    for (size_t i = 0; i < n; ++i) {
+        char* end = NULL;
+        errno = 0;
+        long value = strtol(pos, &end, 10);
+        char expectedEnd = (i + 1 == n) ? '\0' : ',';
+        if (end == pos || *end != expectedEnd || errno != 0 || value < 0 || value > max) {
+            return 0;
+        }
+        *values[i] = (unsigned int)value;
+        pos = end + 1;
+    }
+    return 1;
+}
+
+/**
+ * Parses the DRAM timings given as "tRCD,tCAS,tRP,tRAS", each in range [0,2^16-1] cycles.
+ */
+void parse_dram_timing(const char* progname, const char* arg, struct DRAMOptions* dram) {
+    unsigned int* timings[] = {&dram->tRCD, &dram->tCAS, &dram->tRP, &dram->tRAS};
+    if (!parse_number_list(arg, timings, sizeof(timings) / sizeof(timings[0]), UINT16_MAX)) {
+        fprintf(stderr, "Invalid input: '%s' are no DRAM timings tRCD,tCAS,tRP,tRAS in range [0,2^16-1]!\n", arg);
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * Parses the write drain watermarks of the memory controller given as "high,low". Whether they fit the queue depth is
+ * checked once all options are known.
+ */
+void parse_mc_watermarks(const char* progname, const char* arg, struct MemoryControllerOptions* memoryController) {
+    unsigned int* watermarks[] = {&memoryController->writeHighWatermark, &memoryController->writeLowWatermark};
+    if (!parse_number_list(arg, watermarks, sizeof(watermarks) / sizeof(watermarks[0]), 256) ||
+        memoryController->writeLowWatermark >= memoryController->writeHighWatermark) {
+        fprintf(stderr, "Invalid input: '%s' are no memory controller watermarks high,low with low < high!\n", arg);
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * Parses an address in range [0,2^32-1], given in decimal or hexadecimal with 0x.
+ */
+unsigned int parse_address(const char* progname, const char* arg, const char* option) {
+    char* end = NULL;
+    errno = 0;
+    unsigned long long addr = strtoull(arg, &end, 0);
+    if (end == arg || *end != '\0' || *arg == '-' || errno != 0 || addr > UINT32_MAX) {
+        fprintf(stderr, "Invalid input: '%s' for %s is no address in range [0,2^32-1]!\n", arg, option);
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+    return (unsigned int)addr;
+}
+
+/**
+ * Parses a clock frequency in MHz in range [1,10000] and returns its period in picoseconds, rounded to the nearest.
+ */
+unsigned int parse_clock_period(char* endptr, const char* progname, char* option) {
+    unsigned long frequency = check_user_input(endptr, "Clock frequencies must be at least 1 MHz.", progname, option);
+    if (frequency == 0 || frequency > 10000) { // a --memory-clock of 0 passes check_user_input with a warning
+        fprintf(stderr, "Invalid input: %s must be in range [1,10000] MHz!\n", option);
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+    return (unsigned int)((1000000 + frequency / 2) / frequency);
+}
+
+/**
+ * Converts a latency of ns nanoseconds to cycles of a clock of period picoseconds (0 => 1000), rounded up so the
+ * latency is never shorter than asked for.
+ */
+unsigned int latency_in_cycles(unsigned long ns, unsigned int period) {
+    unsigned long long picoseconds = (unsigned long long)ns * 1000;
+    unsigned long long cyclePeriod = period == 0 ? 1000 : period;
+    unsigned long long cycles = (picoseconds + cyclePeriod - 1) / cyclePeriod;
+    return cycles > UINT32_MAX ? UINT32_MAX : (unsigned int)cycles;
+}
+
+/**
+ * Parses the comma separated way masks of the processes, each in range [1,2^32-1] and given in decimal or hexadecimal
+ * with 0x. Whether they fit the ways and the processes is checked once all options are known.
+ * @returns the masks, numMasks of them
+ */
+unsigned int* parse_way_masks(const char* progname, const char* arg, unsigned int* numMasks) {
+    unsigned int* masks = (unsigned int*)malloc(sizeof(unsigned int) * 16);
+    if (masks == NULL) {
+        perror("Error allocating memory for the way masks");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+    *numMasks = 0;
+    const char* pos = arg;
+    while (1) {
+        char* end = NULL;
+        errno = 0;
+        unsigned long long mask = strtoull(pos, &end, 0);
+        if (end == pos || (*end != ',' && *end != '\0') || *pos == '-' || errno != 0 || mask == 0 ||
+            mask > UINT32_MAX || *numMasks == 16) {
+            fprintf(stderr, "Invalid input: '%s' are no way masks mask,mask,... of at most 16 processes, none of "
+                            "them 0!\n", arg);
+            print_usage(progname);
+            exit(EXIT_FAILURE);
+        }
+        masks[(*numMasks)++] = (unsigned int)mask;
+        if (*end == '\0')
+            return masks;
+        pos = end + 1;
+    }
+}
+
+/**
+ * Reads the traces of the further cores of a multicore system or the further processes of the multi-programmed mode,
+ * one per file name.
+ */
+struct CoreTrace* read_core_traces(const char* progname, int numFiles, char** filenames, struct Configuration* config) {
+    struct CoreTrace* traces = (struct CoreTrace*)malloc(sizeof(struct CoreTrace) * numFiles);
+    if (traces == NULL) {
+        perror("Error allocating memory for the traces");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < numFiles; ++i) {
+        struct Configuration coreConfig = *config; // extract_file_data reads into the requests of a configuration
+        FILE* file = check_file(progname, filenames[i]);
+        extract_file_data(progname, filenames[i], file, &coreConfig);
+        traces[i].numRequests = coreConfig.numRequests;
+        traces[i].requests = coreConfig.requests;
+        traces[i].gaps = coreConfig.options.core.gaps;
+        traces[i].instructionAddresses = coreConfig.options.core.instructionAddresses;
+    }
+    return traces;
+}
+
+/**
+ * Checks whether the further positional files can be simulated as the traces of further cores.
+ */
+void check_multicore(const char* progname, int numCoreTraces, const struct Configuration* config) {
+    if (numCoreTraces > 15) {
+        fprintf(stderr, "Error: At most 16 cores can be simulated, one per file!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+
+    if (numCoreTraces > 0 && config->options.l2.cacheLines != 0) {
+        // the data caches of the cores share the memory through the snooping bus, there is no room for the L2
+        fprintf(stderr, "Error: Several cores cannot be combined with an L2 cache!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+    if (numCoreTraces > 0 && config->policy == POLICY_OPT) {
+        // the accesses of each data cache depend on the timing of all cores and cannot be known in advance
+        fprintf(stderr, "Error: Several cores cannot be combined with --opt!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+    if (numCoreTraces > 0 && (config->options.writeBufferDepth != 0 || config->options.writeCombining)) {
+        // the coherent data caches are write-back and have no write buffer
+        fprintf(stderr, "Error: Several cores cannot be combined with the write buffer options!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+    if (numCoreTraces > 0 && config->options.dipSeriesFile != NULL) {
+        // every core has a policy of its own, there is no single series of insertions to write
+        fprintf(stderr, "Error: Several cores cannot be combined with --dip-series!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * Checks whether the positional files can be simulated as processes sharing the core with the quantum, ways and way
+ * masks set, numWayMasks of them.
+ */
+void check_multiprogram(const char* progname, int numProcessTraces, unsigned int numWayMasks,
+                        const struct Configuration* config) {
+    const struct MultiprogramOptions* multiprogram = &config->options.multiprogram;
+    if (numProcessTraces == 0) {
+        fprintf(stderr, "Error: --quantum requires several files, one per process!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+    if (numProcessTraces > 15) {
+        fprintf(stderr, "Error: At most 16 processes can be simulated, one per file!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+    if (config->options.l2.cacheLines != 0) {
+        // only the data cache tags its lines with the address space ID, the processes would share the lines of the L2
+        fprintf(stderr, "Error: --quantum cannot be combined with an L2 cache!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+    if (config->policy == POLICY_OPT) {
+        // OPT looks ahead by tag only, the processes would share their blocks
+        fprintf(stderr, "Error: --quantum cannot be combined with --opt!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+    if (multiprogram->wayMasks != NULL && multiprogram->ways == 0) {
+        fprintf(stderr, "Error: --way-masks requires a partitioned cache set up with --ways!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+    if (multiprogram->ways == 0)
+        return;
+    if (config->directMapped) {
+        fprintf(stderr, "Error: --ways requires a fully associative cache!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+    if (config->cacheLines % multiprogram->ways != 0) {
+        fprintf(stderr, "Error: The number of ways has to divide the number of cachelines!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+    if (multiprogram->wayMasks == NULL)
+        return;
+    if (numWayMasks != (unsigned int)numProcessTraces + 1) {
+        fprintf(stderr, "Error: --way-masks requires one mask per process!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+    for (unsigned int i = 0; i < numWayMasks; ++i) {
+        if (multiprogram->ways < 32 && (multiprogram->wayMasks[i] >> multiprogram->ways) != 0) {
+            fprintf(stderr, "Error: The way mask 0x%x selects ways beyond the %u set by --ways!\n",
+                    multiprogram->wayMasks[i], multiprogram->ways);
+            print_usage(progname);
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
 /**
  * Parses command line arguments, sets default values and prints error messages and exits
  * if arguments are not useful for the simulation.
@@ -176,9 +786,55 @@ struct Configuration parse_arguments(int argc, char** argv) {
     config.memoryLatency = 100;
     config.tracefile = NULL;
 
-    config.policy = POLICY_LRU; // 0 => lru, 1 => fifo, 2 => random
+    config.policy = POLICY_LRU; // see enum CacheReplacementPolicy
     config.callExtended = 0;    // Default: false
 
+    config.options.l2.cacheLines = 0; // 0 => no L2
+    config.options.l2.cacheLineSize = 64;
+    config.options.l2.cacheLatency = 10;
+    config.options.rrpvBits = 0; // 0 => default width
+    config.options.dipSeriesFile = NULL;
+    config.options.policyPlugin = NULL;
+    config.options.writeBufferDepth = 0; // 0 => default depth
+    config.options.writeCombining = 0;
+    config.options.dram.channels = 1;
+    config.options.dram.ranks = 1;
+    config.options.dram.banks = 0; // 0 => flat memory latency
+    config.options.dram.rowSize = 2048;
+    config.options.dram.tRCD = 14;
+    config.options.dram.tCAS = 14;
+    config.options.dram.tRP = 14;
+    config.options.dram.tRAS = 33;
+    config.options.dram.closedPage = 0;
+    config.options.memoryController.queueDepth = 0; // 0 => no memory controller
+    config.options.memoryController.writeHighWatermark = 0; // 0 => derived from the queue depth
+    config.options.memoryController.writeLowWatermark = 0;
+    config.options.clocks.corePeriod = 0; // 0 => 1 GHz
+    config.options.clocks.cachePeriod = 0; // 0 => the core clock
+    config.options.clocks.memoryPeriod = 0; // 0 => the core clock
+    config.options.clocks.crossingStages = 0; // 0 => two-flop synchronizer
+    config.options.memoryImage = NULL; // NULL => memory reads as 0 until written
+    config.options.memoryImageBase = 0;
+    config.options.core.loadStoreQueueSize = 0; // 0 => in-order CPU
+    config.options.core.issueWidth = 0; // 0 => 1
+    config.options.core.gaps = NULL; // NULL => no gaps, set by extract_file_data
+    config.options.core.instructionAddresses = NULL; // NULL => fetched from the PC, set by extract_file_data
+    config.options.instructionCache.cacheLines = 0; // 0 => 16
+    config.options.instructionCache.cacheLineSize = 0; // 0 => 128
+    config.options.instructionCache.fullyAssociative = 0;
+    config.options.instructionCache.policy = POLICY_LRU;
+    config.options.multicore.additionalCores = 0; // 0 => single core
+    config.options.multicore.traces = NULL;
+    config.options.multiprogram.quantum = 0; // 0 => a core per file
+    config.options.multiprogram.additionalProcesses = 0;
+    config.options.multiprogram.traces = NULL;
+    config.options.multiprogram.ways = 0; // 0 => not partitioned
+    config.options.multiprogram.wayMasks = NULL; // NULL => every process fills every way
+    config.options.readResults.file = NULL; // NULL => the read results are written back into the requests
+    config.options.readResults.binary = 0;
+    config.options.readResults.callback = NULL;
+    config.options.readResults.context = NULL;
+
     // Command line argument parsing
     int opt;
     int option_index;
@@ -195,6 +851,53 @@ struct Configuration parse_arguments(int argc, char** argv) {
                                            {"lru", no_argument, 0, LEAST_RECENTLY_USED},
                                            {"fifo", no_argument, 0, FIRST_IN_FIRST_OUT},
                                            {"random", no_argument, 0, RANDOM_CHOICE},
+                                           {"plru", no_argument, 0, TREE_PSEUDO_LRU},
+                                           {"bitplru", no_argument, 0, BIT_PSEUDO_LRU},
+                                           {"srrip", no_argument, 0, STATIC_RRIP},
+                                           {"brrip", no_argument, 0, BIMODAL_RRIP},
+                                           {"drrip", no_argument, 0, DYNAMIC_RRIP},
+                                           {"rrpv-bits", required_argument, 0, RRPV_BITS},
+                                           {"lfu", no_argument, 0, LEAST_FREQUENTLY_USED},
+                                           {"arc", no_argument, 0, ADAPTIVE_REPLACEMENT},
+                                           {"2q", no_argument, 0, TWO_QUEUE},
+                                           {"lirs", no_argument, 0, LIRS_CHOICE},
+                                           {"opt", no_argument, 0, OPTIMAL_CHOICE},
+                                           {"dip", no_argument, 0, DYNAMIC_INSERTION},
+                                           {"dip-series", required_argument, 0, DIP_SERIES},
+                                           {"policy-plugin", required_argument, 0, POLICY_PLUGIN_CHOICE},
+                                           {"write-buffer-depth", required_argument, 0, WRITE_BUFFER_DEPTH},
+                                           {"write-combining", no_argument, 0, WRITE_COMBINING},
+                                           {"dram-banks", required_argument, 0, DRAM_BANKS},
+                                           {"dram-channels", required_argument, 0, DRAM_CHANNELS},
+                                           {"dram-ranks", required_argument, 0, DRAM_RANKS},
+                                           {"dram-row-size", required_argument, 0, DRAM_ROW_SIZE},
+                                           {"dram-timing", required_argument, 0, DRAM_TIMING},
+                                           {"closed-page", no_argument, 0, CLOSED_PAGE},
+                                           {"mc-queue-depth", required_argument, 0, MC_QUEUE_DEPTH},
+                                           {"mc-watermarks", required_argument, 0, MC_WATERMARKS},
+                                           {"l2-cachelines", required_argument, 0, L2_CACHELINES},
+                                           {"l2-cacheline-size", required_argument, 0, L2_CACHELINE_SIZE},
+                                           {"l2-latency", required_argument, 0, L2_LATENCY},
+                                           {"core-clock", required_argument, 0, CORE_CLOCK},
+                                           {"cache-clock", required_argument, 0, CACHE_CLOCK},
+                                           {"memory-clock", required_argument, 0, MEMORY_CLOCK},
+                                           {"cdc-stages", required_argument, 0, CDC_STAGES},
+                                           {"cache-latency-ns", required_argument, 0, CACHE_LATENCY_NS},
+                                           {"memory-latency-ns", required_argument, 0, MEMORY_LATENCY_NS},
+                                           {"l2-latency-ns", required_argument, 0, L2_LATENCY_NS},
+                                           {"mem-image", required_argument, 0, MEMORY_IMAGE},
+                                           {"mem-image-base", required_argument, 0, MEMORY_IMAGE_BASE},
+                                           {"lsq-size", required_argument, 0, LOAD_STORE_QUEUE},
+                                           {"issue-width", required_argument, 0, ISSUE_WIDTH},
+                                           {"quantum", required_argument, 0, QUANTUM},
+                                           {"ways", required_argument, 0, WAYS},
+                                           {"way-masks", required_argument, 0, WAY_MASKS},
+                                           {"read-results", required_argument, 0, READ_RESULTS},
+                                           {"read-results-binary", no_argument, 0, READ_RESULTS_BINARY},
+                                           {"icache-lines", required_argument, 0, ICACHE_LINES},
+                                           {"icache-line-size", required_argument, 0, ICACHE_LINE_SIZE},
+                                           {"icache-fullassociative", no_argument, 0, ICACHE_FULLASSOCIATIVE},
+                                           {"icache-policy", required_argument, 0, ICACHE_POLICY},
                                            {"extended", no_argument, 0, CALL_EXTENDED},
                                            {"tf=", required_argument, 0, TRACEFILE},
                                            {"help", no_argument, 0, 'h'},
@@ -206,6 +909,14 @@ struct Configuration parse_arguments(int argc, char** argv) {
     int isLruSet = 0;
     int isFullassociativeSet = 0;
     int longCycles = 0; // Default: false
+    int isDramConfigured = 0; // any DRAM option besides --dram-banks
+    // latencies in nanoseconds, converted to cycles once all clocks are known. -1 => given in cycles
+    long cacheLatencyNs = -1;
+    long memoryLatencyNs = -1;
+    long l2LatencyNs = -1;
+    int isMemoryImageBaseSet = 0;
+    unsigned int numWayMasks = 0;
+    int isInstructionCachePolicySet = 0;
 
     opterr = 0; // Use own error messages
 
@@ -285,7 +996,7 @@ struct Configuration parse_arguments(int argc, char** argv) {
             break;
 
         case LEAST_RECENTLY_USED:
-            if (config.policy == POLICY_FIFO || config.policy == POLICY_RANDOM) {
+            if (config.policy != POLICY_LRU) {
                 fprintf(stderr, "Warning: More than one policy set. "
                                 "Simulating cache using default value LRU!\n");
             }
@@ -294,30 +1005,366 @@ struct Configuration parse_arguments(int argc, char** argv) {
             break;
 
         case FIRST_IN_FIRST_OUT:
-            if (isLruSet) {
-                fprintf(stderr, "Warning: More than one policy set. Simulating cache using default value LRU!\n");
-                break;
-            } else if (config.policy == POLICY_RANDOM) {
-                fprintf(stderr, "Error: --fifo and --random are both set. Please choose only one option!\n");
+            set_policy(progname, &config, POLICY_FIFO, isLruSet);
+            break;
+
+        case RANDOM_CHOICE:
+            set_policy(progname, &config, POLICY_RANDOM, isLruSet);
+            break;
+
+        case TREE_PSEUDO_LRU:
+            set_policy(progname, &config, POLICY_PLRU, isLruSet);
+            break;
+
+        case BIT_PSEUDO_LRU:
+            set_policy(progname, &config, POLICY_BITPLRU, isLruSet);
+            break;
+
+        case STATIC_RRIP:
+            set_policy(progname, &config, POLICY_SRRIP, isLruSet);
+            break;
+
+        case BIMODAL_RRIP:
+            set_policy(progname, &config, POLICY_BRRIP, isLruSet);
+            break;
+
+        case DYNAMIC_RRIP:
+            set_policy(progname, &config, POLICY_DRRIP, isLruSet);
+            break;
+
+        case LEAST_FREQUENTLY_USED:
+            set_policy(progname, &config, POLICY_LFU, isLruSet);
+            break;
+
+        case ADAPTIVE_REPLACEMENT:
+            set_policy(progname, &config, POLICY_ARC, isLruSet);
+            break;
+
+        case TWO_QUEUE:
+            set_policy(progname, &config, POLICY_TWO_QUEUE, isLruSet);
+            break;
+
+        case LIRS_CHOICE:
+            set_policy(progname, &config, POLICY_LIRS, isLruSet);
+            break;
+
+        case OPTIMAL_CHOICE:
+            set_policy(progname, &config, POLICY_OPT, isLruSet);
+            break;
+
+        case DYNAMIC_INSERTION:
+            set_policy(progname, &config, POLICY_DIP, isLruSet);
+            break;
+
+        case DIP_SERIES:
+            config.options.dipSeriesFile = optarg;
+            break;
+
+        case POLICY_PLUGIN_CHOICE:
+            set_policy(progname, &config, POLICY_PLUGIN, isLruSet);
+            if (config.policy == POLICY_PLUGIN) {
+                config.options.policyPlugin = optarg;
+            }
+            break;
+
+        case RRPV_BITS:
+            error_msg = "RRPV width must be at least 1 bit.";
+            unsigned long rrpvBits = check_user_input(endptr, error_msg, progname, "--rrpv-bits");
+
+            if (rrpvBits > 8) {
+                fprintf(stderr, "Invalid input: RRPV width cannot exceed 8 bits!\n");
                 print_usage(progname);
                 exit(EXIT_FAILURE);
             }
-            config.policy = POLICY_FIFO;
+            config.options.rrpvBits = (unsigned int)rrpvBits;
             break;
 
-        case RANDOM_CHOICE:
-            if (isLruSet) {
-                fprintf(stderr, "Warning: More than one policy set. Simulating cache using default value LRU!\n");
-                break;
-            } else if (config.policy == POLICY_FIFO) {
-                fprintf(stderr, "Error: --fifo and --random are both set. Please choose only one option!\n");
+        case WRITE_BUFFER_DEPTH:
+            error_msg = "Write buffer depth must be at least 1.";
+            unsigned long depth = check_user_input(endptr, error_msg, progname, "--write-buffer-depth");
+
+            if (depth > 256) {
+                fprintf(stderr, "Invalid input: Write buffer depth cannot exceed 256 entries!\n");
+                print_usage(progname);
+                exit(EXIT_FAILURE);
+            }
+            config.options.writeBufferDepth = (unsigned int)depth;
+            break;
+
+        case WRITE_COMBINING:
+            config.options.writeCombining = 1;
+            break;
+
+        case DRAM_BANKS:
+            error_msg = "Number of DRAM banks must be at least 1.";
+            unsigned long banks = check_user_input(endptr, error_msg, progname, "--dram-banks");
+
+            if (banks > 256) {
+                fprintf(stderr, "Invalid input: Number of DRAM banks cannot exceed 256!\n");
+                print_usage(progname);
+                exit(EXIT_FAILURE);
+            }
+            config.options.dram.banks = (unsigned int)banks;
+            break;
+
+        case DRAM_CHANNELS:
+            error_msg = "Number of DRAM channels must be at least 1.";
+            unsigned long channels = check_user_input(endptr, error_msg, progname, "--dram-channels");
+
+            if (channels > 64) {
+                fprintf(stderr, "Invalid input: Number of DRAM channels cannot exceed 64!\n");
+                print_usage(progname);
+                exit(EXIT_FAILURE);
+            }
+            config.options.dram.channels = (unsigned int)channels;
+            isDramConfigured = 1;
+            break;
+
+        case DRAM_RANKS:
+            error_msg = "Number of DRAM ranks must be at least 1.";
+            unsigned long ranks = check_user_input(endptr, error_msg, progname, "--dram-ranks");
+
+            if (ranks > 64) {
+                fprintf(stderr, "Invalid input: Number of DRAM ranks cannot exceed 64!\n");
+                print_usage(progname);
+                exit(EXIT_FAILURE);
+            }
+            config.options.dram.ranks = (unsigned int)ranks;
+            isDramConfigured = 1;
+            break;
+
+        case DRAM_ROW_SIZE:
+            error_msg = "DRAM row size should be at least 1.";
+            unsigned long rowSize = check_user_input(endptr, error_msg, progname, "--dram-row-size");
+
+            if (!is_multiple_of_sixteen(rowSize) || !is_power_of_two(rowSize)) {
+                fprintf(stderr, "Invalid input: DRAM row size should be a power of 2 of at least 16 bytes!\n");
+                print_usage(progname);
+                exit(EXIT_FAILURE);
+            }
+            config.options.dram.rowSize = (unsigned int)rowSize;
+            isDramConfigured = 1;
+            break;
+
+        case DRAM_TIMING:
+            parse_dram_timing(progname, optarg, &config.options.dram);
+            isDramConfigured = 1;
+            break;
+
+        case CLOSED_PAGE:
+            config.options.dram.closedPage = 1;
+            isDramConfigured = 1;
+            break;
+
+        case MC_QUEUE_DEPTH:
+            error_msg = "Memory controller queue depth must be at least 1.";
+            unsigned long queueDepth = check_user_input(endptr, error_msg, progname, "--mc-queue-depth");
+
+            if (queueDepth > 256) {
+                fprintf(stderr, "Invalid input: Memory controller queue depth cannot exceed 256!\n");
                 print_usage(progname);
                 exit(EXIT_FAILURE);
             }
+            config.options.memoryController.queueDepth = (unsigned int)queueDepth;
+            break;
+
+        case MC_WATERMARKS:
+            parse_mc_watermarks(progname, optarg, &config.options.memoryController);
+            break;
+
+        case L2_CACHELINES:
+            error_msg = "Number of L2 cache-lines must be at least 1.";
+            unsigned long l2n = check_user_input(endptr, error_msg, progname, "--l2-cachelines");
+
+            if (!is_power_of_two(l2n)) {
+                fprintf(stderr, "Warning: Number of cachelines are usually a power of two!\n");
+            }
+            config.options.l2.cacheLines = (unsigned int)l2n;
+            break;
+
+        case L2_CACHELINE_SIZE:
+            error_msg = "L2 cacheline size should be at least 1.";
+            unsigned long l2s = check_user_input(endptr, error_msg, progname, "--l2-cacheline-size");
+
+            if (!is_multiple_of_sixteen(l2s)) {
+                fprintf(stderr, "Invalid input: L2 cacheline size should be a multiple of 16 bytes!\n");
+                print_usage(progname);
+                exit(EXIT_FAILURE);
+            } else if (!is_power_of_two(l2s)) {
+                fprintf(stderr, "Invalid input: L2 cacheline size should be a power of 2!\n");
+                print_usage(progname);
+                exit(EXIT_FAILURE);
+            }
+
+            config.options.l2.cacheLineSize = (unsigned int)l2s;
+            break;
+
+        case L2_LATENCY:
+            error_msg = "L2 latency cannot be negative.";
+            unsigned long l2l = check_user_input(endptr, error_msg, progname, "--l2-latency");
+            config.options.l2.cacheLatency = (unsigned int)l2l;
+            break;
+
+        case CORE_CLOCK:
+            config.options.clocks.corePeriod = parse_clock_period(endptr, progname, "--core-clock");
+            break;
+
+        case CACHE_CLOCK:
+            config.options.clocks.cachePeriod = parse_clock_period(endptr, progname, "--cache-clock");
+            break;
+
+        case MEMORY_CLOCK:
+            config.options.clocks.memoryPeriod = parse_clock_period(endptr, progname, "--memory-clock");
+            break;
+
+        case CDC_STAGES:
+            error_msg = "Number of synchronizer stages must be at least 1.";
+            unsigned long stages = check_user_input(endptr, error_msg, progname, "--cdc-stages");
+
+            if (stages > 16) {
+                fprintf(stderr, "Invalid input: Number of synchronizer stages cannot exceed 16!\n");
+                print_usage(progname);
+                exit(EXIT_FAILURE);
+            }
+            config.options.clocks.crossingStages = (unsigned int)stages;
+            break;
+
+        case CACHE_LATENCY_NS:
+            error_msg = "Cache-latency cannot be negative.";
+            cacheLatencyNs = (long)check_user_input(endptr, error_msg, progname, "--cache-latency-ns");
+            break;
+
+        case MEMORY_LATENCY_NS:
+            error_msg = "Memory-latency cannot be negative.";
+            memoryLatencyNs = (long)check_user_input(endptr, error_msg, progname, "--memory-latency-ns");
+            break;
+
+        case L2_LATENCY_NS:
+            error_msg = "L2 latency cannot be negative.";
+            l2LatencyNs = (long)check_user_input(endptr, error_msg, progname, "--l2-latency-ns");
+            break;
+
+        case MEMORY_IMAGE: {
+            FILE* image = fopen(optarg, "rb");
+            if (image == NULL) {
+                fprintf(stderr, "Error opening memory image '%s': %s\n", optarg, strerror(errno));
+                print_usage(progname);
+                exit(EXIT_FAILURE);
+            }
+            fclose(image);
+            config.options.memoryImage = optarg;
+            break;
+        }
+
+        case MEMORY_IMAGE_BASE:
+            config.options.memoryImageBase = parse_address(progname, optarg, "--mem-image-base");
+            isMemoryImageBaseSet = 1;
+            break;
+
+        case LOAD_STORE_QUEUE:
+            error_msg = "Size of the load/store queue must be at least 1.";
+            unsigned long lsq = check_user_input(endptr, error_msg, progname, "--lsq-size");
+
+            if (lsq > 256) {
+                fprintf(stderr, "Invalid input: Size of the load/store queue cannot exceed 256!\n");
+                print_usage(progname);
+                exit(EXIT_FAILURE);
+            }
+            config.options.core.loadStoreQueueSize = (unsigned int)lsq;
+            break;
+
+        case ISSUE_WIDTH:
+            error_msg = "Issue width must be at least 1.";
+            unsigned long width = check_user_input(endptr, error_msg, progname, "--issue-width");
+
+            if (width > 16) {
+                fprintf(stderr, "Invalid input: Issue width cannot exceed 16!\n");
+                print_usage(progname);
+                exit(EXIT_FAILURE);
+            }
+            config.options.core.issueWidth = (unsigned int)width;
+            break;
+
+        case QUANTUM:
+            error_msg = "Quantum must be at least 1 request.";
+            unsigned long quantum = check_user_input(endptr, error_msg, progname, "--quantum");
+
+            if (quantum > (1 << 20)) {
+                fprintf(stderr, "Invalid input: Quantum cannot exceed 2^20 requests!\n");
+                print_usage(progname);
+                exit(EXIT_FAILURE);
+            }
+            config.options.multiprogram.quantum = (unsigned int)quantum;
+            break;
+
+        case WAYS:
+            error_msg = "Number of ways must be at least 1.";
+            unsigned long ways = check_user_input(endptr, error_msg, progname, "--ways");
+
+            if (ways > 32) {
+                fprintf(stderr, "Invalid input: Number of ways cannot exceed 32!\n");
+                print_usage(progname);
+                exit(EXIT_FAILURE);
+            }
+            config.options.multiprogram.ways = (unsigned int)ways;
+            break;
 
-            config.policy = POLICY_RANDOM;
+        case WAY_MASKS:
+            free((void*)config.options.multiprogram.wayMasks); // given more than once
+            config.options.multiprogram.wayMasks = parse_way_masks(progname, optarg, &numWayMasks);
             break;
 
+        case READ_RESULTS:
+            config.options.readResults.file = optarg;
+            break;
+
+        case READ_RESULTS_BINARY:
+            config.options.readResults.binary = 1;
+            break;
+
+        case ICACHE_LINES:
+            error_msg = "Number of instruction cache-lines must be at least 1.";
+            unsigned long icn = check_user_input(endptr, error_msg, progname, "--icache-lines");
+
+            if (!is_power_of_two(icn)) {
+                fprintf(stderr, "Warning: Number of cachelines are usually a power of two!\n");
+            }
+            config.options.instructionCache.cacheLines = (unsigned int)icn;
+            break;
+
+        case ICACHE_LINE_SIZE:
+            error_msg = "Instruction cacheline size should be at least 1.";
+            unsigned long ics = check_user_input(endptr, error_msg, progname, "--icache-line-size");
+
+            if (!is_multiple_of_sixteen(ics)) {
+                fprintf(stderr, "Invalid input: Instruction cacheline size should be a multiple of 16 bytes!\n");
+                print_usage(progname);
+                exit(EXIT_FAILURE);
+            } else if (!is_power_of_two(ics)) {
+                fprintf(stderr, "Invalid input: Instruction cacheline size should be a power of 2!\n");
+                print_usage(progname);
+                exit(EXIT_FAILURE);
+            }
+
+            config.options.instructionCache.cacheLineSize = (unsigned int)ics;
+            break;
+
+        case ICACHE_FULLASSOCIATIVE:
+            config.options.instructionCache.fullyAssociative = 1;
+            break;
+
+        case ICACHE_POLICY: {
+            int policy = parse_instruction_cache_policy(optarg);
+            if (policy < 0) {
+                fprintf(stderr, "Error: '%s' is no replacement policy of the instruction cache!\n", optarg);
+                print_usage(progname);
+                exit(EXIT_FAILURE);
+            }
+            config.options.instructionCache.policy = (enum CacheReplacementPolicy)policy;
+            isInstructionCachePolicySet = 1;
+            break;
+        }
+
         case TRACEFILE:
             if (*optarg == '\0') {
                 fprintf(stderr, "Error: Option --tf requires an argument.\n");
@@ -350,6 +1397,21 @@ struct Configuration parse_arguments(int argc, char** argv) {
         }
     }
 
+    // each latency counts cycles of the clock of its component
+    unsigned int corePeriod = config.options.clocks.corePeriod;
+    unsigned int cachePeriod = config.options.clocks.cachePeriod == 0 ? corePeriod : config.options.clocks.cachePeriod;
+    unsigned int memoryPeriod =
+        config.options.clocks.memoryPeriod == 0 ? corePeriod : config.options.clocks.memoryPeriod;
+    if (cacheLatencyNs >= 0) {
+        config.cacheLatency = latency_in_cycles((unsigned long)cacheLatencyNs, corePeriod);
+    }
+    if (memoryLatencyNs >= 0) {
+        config.memoryLatency = latency_in_cycles((unsigned long)memoryLatencyNs, memoryPeriod);
+    }
+    if (l2LatencyNs >= 0) {
+        config.options.l2.cacheLatency = latency_in_cycles((unsigned long)l2LatencyNs, cachePeriod);
+    }
+
     if (config.memoryLatency < config.cacheLatency) {
         fprintf(stderr, "Warning: Memory latency is less than cache latency.\n");
     }
@@ -362,18 +1424,137 @@ struct Configuration parse_arguments(int argc, char** argv) {
         exit(EXIT_FAILURE);
     }
 
-    check_cycle_size(longCycles, progname, &config);
+    const struct InstructionCacheOptions* instructionCache = &config.options.instructionCache;
+    unsigned int instructionCacheLines = instructionCache->cacheLines == 0 ? 16 : instructionCache->cacheLines;
+    unsigned int instructionCacheLineSize =
+        instructionCache->cacheLineSize == 0 ? 128 : instructionCache->cacheLineSize;
+    if (instructionCacheLines > UINT32_MAX / instructionCacheLineSize ||
+        instructionCacheLineSize * instructionCacheLines > (1 << 20)) {
+        fprintf(stderr, "Error: Instruction cache of %u %u byte long cache lines is too big. Max total size is 2^20\n",
+                instructionCacheLines, instructionCacheLineSize);
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+
+    if (isInstructionCachePolicySet && !instructionCache->fullyAssociative) {
+        fprintf(stderr, "Error: --icache-policy requires a fully associative instruction cache set up with "
+                        "--icache-fullassociative!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.options.l2.cacheLines > UINT32_MAX / config.options.l2.cacheLineSize ||
+        config.options.l2.cacheLineSize * config.options.l2.cacheLines > (1 << 24)) {
+        fprintf(stderr, "Error: L2 cache of %u %u byte long cache lines is too big. Max total size is 2^24\n",
+                config.options.l2.cacheLines, config.options.l2.cacheLineSize);
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.policy == POLICY_OPT && config.options.l2.cacheLines != 0) {
+        // the accesses of the L2 depend on the timing of both L1 caches and cannot be known in advance
+        fprintf(stderr, "Error: --opt cannot be combined with an L2 cache!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.options.writeCombining && config.options.l2.cacheLines != 0) {
+        // the L2 takes single words only, the bursts have to go to the RAM directly
+        fprintf(stderr, "Error: --write-combining cannot be combined with an L2 cache!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+
+    if (isDramConfigured && config.options.dram.banks == 0) {
+        fprintf(stderr, "Error: The DRAM options require a DRAM model set up with --dram-banks!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.options.memoryController.writeHighWatermark != 0) {
+        if (config.options.memoryController.queueDepth == 0) {
+            fprintf(stderr, "Error: --mc-watermarks requires a memory controller set up with --mc-queue-depth!\n");
+            print_usage(progname);
+            exit(EXIT_FAILURE);
+        }
+        if (config.options.memoryController.writeHighWatermark > config.options.memoryController.queueDepth) {
+            fprintf(stderr, "Error: The high watermark of the memory controller cannot exceed its queue depth!\n");
+            print_usage(progname);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (isMemoryImageBaseSet && config.options.memoryImage == NULL) {
+        fprintf(stderr, "Error: --mem-image-base requires a memory image set up with --mem-image!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.options.core.issueWidth != 0 && config.options.core.loadStoreQueueSize == 0) {
+        fprintf(stderr, "Error: --issue-width requires an out-of-order CPU set up with --lsq-size!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.options.clocks.cachePeriod != 0 && config.options.l2.cacheLines == 0) {
+        fprintf(stderr, "Error: --cache-clock requires an L2 cache set up with --l2-cachelines!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.options.dipSeriesFile != NULL && (config.policy != POLICY_DIP || config.directMapped)) {
+        fprintf(stderr, "Error: --dip-series requires a fully associative cache using --dip!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.options.readResults.binary && config.options.readResults.file == NULL) {
+        fprintf(stderr, "Error: --read-results-binary requires a file set up with --read-results!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+
+    // every positional argument after the first one is the trace of a further core, or process given a quantum
+    int numCoreTraces = optind < argc ? argc - optind - 1 : 0;
+    if (numCoreTraces > 0 && config.options.readResults.file != NULL) {
+        // the indices of the reads would be ambiguous between the traces
+        fprintf(stderr, "Error: --read-results cannot be combined with several files!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    }
+    const struct MultiprogramOptions* multiprogram = &config.options.multiprogram;
+    if (multiprogram->quantum != 0) {
+        check_multiprogram(progname, numCoreTraces, numWayMasks, &config);
+    } else if (multiprogram->ways != 0 || multiprogram->wayMasks != NULL) {
+        fprintf(stderr, "Error: --ways and --way-masks require several processes set up with --quantum!\n");
+        print_usage(progname);
+        exit(EXIT_FAILURE);
+    } else {
+        check_multicore(progname, numCoreTraces, &config);
+    }
 
     // Check for Positional Argument
     if (optind < argc) {
         // Check input file for valid file format and save data to requests
         FILE* file = check_file(progname, argv[optind]);
         extract_file_data(progname, argv[optind], file, &config);
+        if (numCoreTraces > 0 && multiprogram->quantum != 0) {
+            config.options.multiprogram.traces = read_core_traces(progname, numCoreTraces, argv + optind + 1, &config);
+            config.options.multiprogram.additionalProcesses = (unsigned int)numCoreTraces;
+        } else if (numCoreTraces > 0) {
+            config.options.multicore.traces = read_core_traces(progname, numCoreTraces, argv + optind + 1, &config);
+            config.options.multicore.additionalCores = (unsigned int)numCoreTraces;
+        }
     } else {
         fprintf(stderr, "Error: Positional argument is missing!\n");
         print_usage(progname);
         exit(EXIT_FAILURE);
     }
 
+    if (needs_extended_simulation(&config)) {
+        config.callExtended = 1;
+    }
+    check_cycle_size(longCycles, progname, &config);
+
     return config;
 }
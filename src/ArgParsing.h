@@ -2,11 +2,12 @@
 
 #include "stddef.h"
 #include "Request.h"
+#include "SimulationOptions.h"
 #include "Simulation/Policy/Policy.h"
 
 /**
  * This structure contains all parameters needed for the simulation including
- * the additional parameters 'policy' and 'callExtended' used for an
+ * the additional parameters 'policy', 'options' and 'callExtended' used for an
  * extension of the simulation method.
  */
 struct Configuration {
@@ -20,6 +21,7 @@ struct Configuration {
     struct Request* requests;
     const char* tracefile;
     enum CacheReplacementPolicy policy;
+    struct SimulationOptions options;
     int callExtended;
 };
 
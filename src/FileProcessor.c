@@ -72,8 +72,34 @@ error:
     exit(EXIT_FAILURE);
 }
 
+#define COLUMN_MISSING (-2)
+
 /**
- * Extracts and validates data from a file and saves it in a 'Request structure'
+ * Parses an optional numeric column of a line of the input file, counting the columns from 0: the fourth one holds the
+ * cycles computed before its request, the fifth one the address of its instruction.
+ * @returns the number, COLUMN_MISSING if the column is missing or empty, -1 if it is no number between 0 and max
+ */
+long long parse_optional_column(const char* line, int index, long long max) {
+    const char* column = strchr(line, ',');
+    for (int i = 1; i < index && column != NULL; ++i) {
+        column = strchr(column + 1, ',');
+    }
+    if (column == NULL || column[1] == ',' || column[1] == '\n' || column[1] == '\r' || column[1] == '\0')
+        return COLUMN_MISSING;
+
+    char* end = NULL;
+    errno = 0;
+    long long number = strtoll(column + 1, &end, 0);
+    if (end == column + 1 || (*end != ',' && *end != '\n' && *end != '\r' && *end != '\0') || errno != 0 ||
+        number < 0 || number > max)
+        return -1;
+    return number;
+}
+
+/**
+ * Extracts and validates data from a file and saves it in a 'Request structure'. Gaps given in the optional fourth
+ * column are saved in the core options, which get no gaps if no line has one. Likewise for the instruction addresses
+ * of the optional fifth column, a line without one fetches its instruction from address 0.
  * Inspired by: https://github.com/portfoliocourses/c-example-code/blob/main/csv_to_struct_array.c
  */
 int extract_file_data(const char* progname, const char* filename, FILE* file, struct Configuration* config) {
@@ -99,6 +125,8 @@ int extract_file_data(const char* progname, const char* filename, FILE* file, st
     int character;  // Used to check right file format
     char *comma;
     char line[file_info.st_size];
+    uint32_t* gaps = NULL; // allocated once the first line has a gap
+    uint32_t* instruction_addresses = NULL; // allocated once the first line has an instruction address
 
     do {
         char we;
@@ -136,6 +164,40 @@ int extract_file_data(const char* progname, const char* filename, FILE* file, st
             goto error;
         }
 
+        long long gap = parse_optional_column(line, 3, INT32_MAX);
+        if (gap == COLUMN_MISSING) {
+            gap = 0;
+        } else if (gap < 0) {
+            fprintf(stderr, "Error: Wrong file format! The gap has to be a number of cycles below 2^31.\n");
+            goto error;
+        }
+        if (gap != 0 && gaps == NULL) {
+            gaps = (uint32_t*)calloc(file_info.st_size, sizeof(uint32_t));
+            if (gaps == NULL) {
+                perror("Error allocating memory buffer for the gaps");
+                goto error;
+            }
+        }
+        if (gaps != NULL) {
+            gaps[config->numRequests] = (uint32_t) gap;
+        }
+
+        long long instruction_address = parse_optional_column(line, 4, UINT32_MAX);
+        if (instruction_address == -1) {
+            fprintf(stderr, "Error: Wrong file format! The instruction address has to be a number below 2^32.\n");
+            goto error;
+        }
+        if (instruction_address != COLUMN_MISSING && instruction_addresses == NULL) {
+            instruction_addresses = (uint32_t*)calloc(file_info.st_size, sizeof(uint32_t));
+            if (instruction_addresses == NULL) {
+                perror("Error allocating memory buffer for the instruction addresses");
+                goto error;
+            }
+        }
+        if (instruction_address != COLUMN_MISSING) {
+            instruction_addresses[config->numRequests] = (uint32_t) instruction_address;
+        }
+
         config->requests[config->numRequests].addr = (uint32_t) addr;
         config->requests[config->numRequests].data = (uint32_t) data;
 
@@ -158,6 +220,8 @@ int extract_file_data(const char* progname, const char* filename, FILE* file, st
     } while (!feof(file));
 
     fclose(file);
+    config->options.core.gaps = gaps;
+    config->options.core.instructionAddresses = instruction_addresses;
     return EXIT_SUCCESS;
 
 error:
@@ -165,6 +229,8 @@ error:
     print_usage(progname);
     free(config->requests);
     config->requests = NULL;
+    free(gaps);
+    free(instruction_addresses);
     exit(EXIT_FAILURE);
 }
 
@@ -16,7 +16,8 @@ FILE* check_file(const char* progname, const char* filename);
  * This function reads data from the specified file and extracts relevant information to
  * save them in a Request structure containing read and write operations used for the simulation.
  * It assumes that the file format is correct and checks if the extracted data is in
- * the right format.
+ * the right format. The cycles computed before each request, given in an optional fourth
+ * column, are saved as the gaps of the core options.
  *
  * @return 0 if successful, or exits with an error if there is an issue with extracting data.
  */
@@ -1,9 +1,152 @@
 #pragma once
 #include <stddef.h>
 
+/**
+ * Traffic seen by the unified L2, attributed to the L1 cache it came from. Contention stalls are the cycles a side
+ * waited with a valid request while the L2 was busy serving the other side. All values are 0 if no L2 was simulated.
+ */
+struct L2Statistics {
+    size_t instructionAccesses;
+    size_t instructionMisses;
+    size_t instructionContentionStalls;
+    size_t dataAccesses;
+    size_t dataMisses;
+    size_t dataContentionStalls;
+};
+
+/**
+ * Activity of the write buffer of the data cache. Writes to a line that already has a buffered entry are coalesced
+ * into it instead of taking an entry of their own. The occupancy counts the entries holding writes not yet completed
+ * in RAM, including the one currently drained. Full-stall cycles are the cycles a write waited for a free entry.
+ * In write-combining mode every drained entry is one burst, a partial flush being one whose line was not completely
+ * written. Each word of a burst after its first is a RAM request (and memory latency) saved.
+ * Reads of a line with buffered writes are either forwarded completely from the buffer or merged with the line read
+ * from RAM. The stall cycles avoided that way are estimated as the RAM write requests such reads would have waited for
+ * times the mean cycles a RAM write request took.
+ */
+struct WriteBufferStatistics {
+    size_t depth;
+    size_t bufferedWrites;
+    size_t coalescedWrites;
+    size_t fullStallCycles;
+    size_t occupancySum; // summed over all cycles, divided by cycles it is the mean occupancy
+    size_t maxOccupancy;
+    size_t cycles;
+    size_t bursts;
+    size_t partialFlushes;
+    size_t savedRequests;
+    size_t forwardedReads;
+    size_t mergedReads;
+    size_t stallCyclesAvoided;
+};
+
+/**
+ * Row buffer statistics of the DRAM behind the data cache (or the L2). A row hit finds its row already open, a row
+ * miss finds its bank precharged and only has to activate the row, a row conflict first has to close another row.
+ * Words following the first one of a burst write are part of its access and not counted on their own.
+ */
+struct DRAMStatistics {
+    size_t accesses;
+    size_t rowHits;
+    size_t rowMisses;
+    size_t rowConflicts;
+    size_t latencyCycles; // summed over all accesses, divided by accesses it is the mean latency
+};
+
+/**
+ * Activity of the memory controller. The queueing delay is summed over all requests, from entering the queue until
+ * being sent to the memory. Reordered requests were sent while an older one was still queued, either because reads go
+ * first or because they hit an open DRAM row (FR-FCFS). Busy cycles are the cycles the memory worked on a request, so
+ * busyCycles / cycles is the utilisation of its bandwidth.
+ */
+struct MemoryControllerStatistics {
+    size_t queueDepth;
+    size_t reads;
+    size_t writes;
+    size_t queueingDelay;
+    size_t maxOccupancy;
+    size_t fullStallCycles; // cycles a request waited for a free queue slot
+    size_t reorderedRequests;
+    size_t writeDrains;
+    size_t bursts; // queued writes to the same line sent as one burst
+    size_t busyCycles;
+    size_t bytesTransferred;
+    size_t cycles;
+};
+
+/**
+ * Coherence traffic of a multicore system, summed over all cores. Invalidations are the copies other caches lost to a
+ * write, coherence misses the misses on a line that would still have been present had it not been invalidated.
+ * Cache-to-cache transfers are lines a cache flushed to the requester instead of the memory answering. Busy cycles are
+ * the cycles the snooping bus worked on a transaction, so busBusyCycles / cycles is its utilisation. All values are 0
+ * for a single core.
+ */
+struct CoherenceStatistics {
+    size_t cores;
+    size_t busTransactions;
+    size_t invalidations;
+    size_t coherenceMisses;
+    size_t writeBacks;
+    size_t cacheToCacheTransfers;
+    size_t busBusyCycles;
+    size_t cycles;
+};
+
+// the most processes the multi-programmed mode can run, see MultiprogramOptions
+#define MAX_PROCESSES 16
+
+/**
+ * Activity of one process in the data cache it shares with the others in the multi-programmed mode. Its lines were
+ * evicted by others when another process missed and took them, it evicted others when it took their lines itself.
+ */
+struct ProcessStatistics {
+    size_t requests;
+    size_t hits;
+    size_t misses;
+    size_t evictedByOthers;
+    size_t evictionsOfOthers;
+};
+
+/**
+ * Statistics of the multi-programmed mode, process[i] for i < processes. A context switch is every change of the
+ * process running on the core. Cross-process evictions are the evictions of a line of another process, summed over all
+ * processes. All values are 0 for a single process.
+ */
+struct MultiprogramStatistics {
+    size_t processes;
+    size_t contextSwitches;
+    size_t crossProcessEvictions;
+    struct ProcessStatistics process[MAX_PROCESSES];
+};
+
+/**
+ * Activity of the instruction cache, one access per request fetched. Summed over all cores.
+ */
+struct InstructionCacheStatistics {
+    size_t hits;
+    size_t misses;
+};
+
+/**
+ * Activity of the load/store queue of the out-of-order CPU, summed over all cores. Forwarded loads took their data from
+ * an older store to the same address in the queue instead of going to the data cache. All values are 0 for an in-order
+ * CPU.
+ */
+struct LoadStoreQueueStatistics {
+    size_t forwardedLoads;
+};
+
 struct Result {
     size_t cycles;
     size_t misses;
     size_t hits;
     size_t primitiveGateCount;
+    struct L2Statistics l2;
+    struct WriteBufferStatistics writeBuffer;
+    struct DRAMStatistics dram;
+    struct MemoryControllerStatistics memoryController;
+    struct CoherenceStatistics coherence;
+    struct MultiprogramStatistics multiprogram;
+    struct InstructionCacheStatistics instructionCache;
+    struct LoadStoreQueueStatistics loadStoreQueue;
 };
@@ -0,0 +1,42 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+#include <systemc>
+
+/**
+ * One beat of the 128 bit wide read bus between RAM, write buffers and caches. Byte i of the beat is the byte at the
+ * address of the beat plus i. Being a plain byte array, a beat is filled from and copied into a cacheline with a
+ * single memcpy instead of being assembled bit by bit like a sc_bv.
+ */
+struct BusBeat {
+    static constexpr std::size_t SIZE_IN_BYTE = 16;
+    std::array<std::uint8_t, SIZE_IN_BYTE> bytes{};
+};
+static_assert(std::is_trivially_copyable<BusBeat>::value, "bus beats are copied around as raw bytes");
+
+// implementation of required methods for BusBeat to be transmittable through systemc ports
+inline bool operator==(const BusBeat& lhs, const BusBeat& rhs) { return lhs.bytes == rhs.bytes; }
+inline bool operator!=(const BusBeat& lhs, const BusBeat& rhs) { return !(lhs == rhs); }
+
+inline std::ostream& operator<<(std::ostream& os, const BusBeat& beat) {
+    const auto flags = os.flags();
+    const auto fill = os.fill('0');
+    os << std::hex;
+    // most significant byte first, like the sc_bv<128> it replaces
+    for (std::size_t i = BusBeat::SIZE_IN_BYTE; i-- > 0;)
+        os << std::setw(2) << static_cast<unsigned int>(beat.bytes[i]);
+    os.flags(flags);
+    os.fill(fill);
+    return os;
+}
+
+inline void sc_trace(sc_core::sc_trace_file* tf, const BusBeat& beat, const std::string& pre) {
+    for (std::size_t i = 0; i < BusBeat::SIZE_IN_BYTE; ++i)
+        sc_core::sc_trace(tf, beat.bytes[i], pre + "_byte" + std::to_string(i));
+}
@@ -1,7 +1,23 @@
 #include "CPU.h"
 
-CPU::CPU(sc_core::sc_module_name name, Request* instructions, std::size_t numRequests)
-    : sc_module{name}, instructions{instructions}, numRequests{numRequests} {
+#include <cassert>
+
+CPU::CPU(sc_core::sc_module_name name, Request* instructions, std::size_t numRequests,
+         const sc_core::sc_time& clockPeriod, std::uint32_t loadStoreQueueSize, std::uint32_t issueWidth)
+    : sc_module{name}, instructions{instructions}, numRequests{numRequests}, clockPeriod{clockPeriod},
+      issueWidth{issueWidth} {
+    assert(issueWidth > 0);
+    if (loadStoreQueueSize > 0) {
+        loadStoreQueue = std::make_unique<LoadStoreQueue>(loadStoreQueueSize);
+
+        SC_THREAD(issueFromQueue);
+        sensitive << clock.pos();
+
+        SC_THREAD(fetchIntoQueue);
+        sensitive << clock.pos();
+        return;
+    }
+
     SC_THREAD(handleInstruction);
     sensitive << clock.pos();
 
@@ -19,9 +35,11 @@ void CPU::handleInstruction() noexcept {
 
         if (instructionReady) {
             Request currentRequest = instrBus.read();
+            waitForGapBefore(program_counter);
             addressBus.write(currentRequest.addr);
             dataOutBus.write(currentRequest.data);
             weBus.write(currentRequest.we);
+            sendAddressSpaceOf(program_counter); // the PC moves on once the next instruction read is triggered
 
             validDataRequestBus.write(true);
 
@@ -31,16 +49,16 @@ void CPU::handleInstruction() noexcept {
 
             waitForInstructionProcessing();
 
-            lastCycleWhereWorkWasDone = sc_core::sc_time_stamp().value() / 1000;
+            lastCycleWhereWorkWasDone = sc_core::sc_time_stamp().value() / clockPeriod.value();
 
 #ifndef DEBUG_RUN_TILL_END
             if (program_counter == numRequests) {
-                sc_core::sc_stop();
+                finish();
             }
 #endif
 
             if (!currentRequest.we) {
-                instructions[program_counter - 1].data = dataInBus;
+                putReadResult(program_counter - 1, dataInBus.read(), lastCycleWhereWorkWasDone);
             }
         }
     }
@@ -51,6 +69,7 @@ void CPU::readInstruction() noexcept {
         wait();
 
         pcBus.write(program_counter);
+        sendFetchAddressSpaceOf(program_counter);
         validInstrRequestBus.write(true);
 
         waitForInstruction();
@@ -62,6 +81,36 @@ void CPU::readInstruction() noexcept {
     }
 }
 
+void CPU::finish() noexcept {
+    if (runningCPUs != nullptr && --*runningCPUs > 0)
+        return;
+    sc_core::sc_stop();
+}
+
+void CPU::sendAddressSpaceOf(std::size_t index) noexcept {
+    if (!addressSpaces.empty())
+        addressSpaceBus.write(addressSpaces[index]);
+}
+
+// the PC runs one past the trace once its last request was fetched
+void CPU::sendFetchAddressSpaceOf(std::size_t index) noexcept {
+    if (index < addressSpaces.size())
+        instrAddressSpaceBus.write(addressSpaces[index]);
+}
+
+void CPU::putReadResult(std::size_t index, std::uint32_t data, std::uint64_t cycle) noexcept {
+    if (readResultSink == nullptr) {
+        instructions[index].data = data;
+        return;
+    }
+    readResultSink->record(index, data, cycle);
+}
+
+void CPU::waitForGapBefore(std::size_t index) noexcept {
+    if (gaps != nullptr && gaps[index] > 0)
+        wait(static_cast<int>(gaps[index])); // counts the clock edges without waking up for each of them
+}
+
 void CPU::waitForInstruction() noexcept {
     wait();
     validInstrRequestBus.write(false);
@@ -77,4 +126,88 @@ void CPU::waitForInstructionProcessing() noexcept {
         wait();
     }
     skipAhead = true;
-}
\ No newline at end of file
+}
+
+// ======================================= Out of Order ========================================
+
+void CPU::fetchIntoQueue() noexcept {
+    while (program_counter < numRequests) {
+        wait();
+        if (loadStoreQueue->isFull())
+            continue;
+
+        waitForGapBefore(program_counter);
+        pcBus.write(program_counter);
+        sendFetchAddressSpaceOf(program_counter);
+        validInstrRequestBus.write(true);
+
+        waitForInstruction();
+
+        loadStoreQueue->push(program_counter, instrBus.read());
+        ++program_counter;
+    }
+}
+
+void CPU::issueFromQueue() noexcept {
+    while (true) {
+        wait();
+
+        if (isCacheBusy) {
+            validDataRequestBus.write(false);
+            if (dataReadyBus.read())
+                takeResultFromCache();
+        }
+
+        // a read completes once it retires
+        const std::uint64_t cycle = sc_core::sc_time_stamp().value() / clockPeriod.value();
+        const std::size_t retired =
+            loadStoreQueue->retire(issueWidth, [this, cycle](const LoadStoreQueue::Entry& entry) {
+                if (!entry.request.we)
+                    putReadResult(entry.index, entry.request.data, cycle);
+            });
+        if (retired > 0) {
+            // all retired requests were older than the one at the cache, which is not done yet
+            positionAtCache -= isCacheBusy ? retired : 0;
+            numRetired += retired;
+            lastCycleWhereWorkWasDone = cycle;
+#ifndef DEBUG_RUN_TILL_END
+            if (numRetired == numRequests) {
+                finish();
+            }
+#endif
+        }
+
+        std::uint32_t issued = 0;
+        for (std::size_t position = 0; position < loadStoreQueue->getSize() && issued < issueWidth; ++position) {
+            const auto& entry = loadStoreQueue->at(position);
+            if (!entry.isIssued && !entry.request.we && loadStoreQueue->forward(position))
+                ++issued;
+        }
+        if (!isCacheBusy && issued < issueWidth) {
+            const std::size_t position = loadStoreQueue->nextForCache();
+            if (position != loadStoreQueue->getSize())
+                sendToCache(position);
+        }
+    }
+}
+
+void CPU::takeResultFromCache() noexcept {
+    auto& entry = loadStoreQueue->at(positionAtCache);
+    if (!entry.request.we)
+        entry.request.data = dataInBus.read();
+    entry.isDone = true;
+    isCacheBusy = false;
+}
+
+void CPU::sendToCache(std::size_t position) noexcept {
+    auto& entry = loadStoreQueue->at(position);
+    addressBus.write(entry.request.addr);
+    dataOutBus.write(entry.request.data);
+    weBus.write(entry.request.we);
+    sendAddressSpaceOf(entry.index);
+    validDataRequestBus.write(true);
+
+    entry.isIssued = true;
+    isCacheBusy = true;
+    positionAtCache = position;
+}
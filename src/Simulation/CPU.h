@@ -1,10 +1,38 @@
 #pragma once
 
 #include "../Request.h"
+#include "LoadStoreQueue.h"
+#include "ReadResultSink.h"
 #include <cstdint>
+#include <memory>
 #include <systemc>
+#include <utility>
 #include <vector>
 
+/**
+ * The CPU replaying the trace. By default it is in-order: it sends one request to the data cache and waits for it to be
+ * done before sending the next one, only the instruction fetch of the next request overlaps with it.
+ *
+ * Given a load/store queue size, it works out of order instead: the instruction fetch runs ahead into the load/store
+ * queue as long as it has room, and every cycle up to issueWidth requests are issued from it - loads served from an
+ * older store in the queue and one request sent to the data cache, which takes one at a time. Loads overtake older
+ * stores to independent addresses, stores wait in the queue without holding anything up. Up to issueWidth requests
+ * retire per cycle, in order. See LoadStoreQueue for the dependencies between requests.
+ *
+ * The data cache and the memory behind it are blocking, so at most one request is in flight at the data cache and
+ * independent misses never overlap: this is no model of memory-level parallelism. What the out-of-order CPU saves over
+ * the in-order one are the fetches hidden behind the data cache, the stores no load waits for and the loads forwarded
+ * from the queue without going to the cache at all, see getForwardedLoads.
+ *
+ * Along with every request and every instruction fetch it sends the address space ID of the process the request
+ * belongs to, 0 unless set by setAddressSpaces.
+ *
+ * Given gaps, the CPU lets the cycles the program computes between its accesses pass before it issues (out of order:
+ * fetches) each request, so its cycle count includes them.
+ *
+ * The value a read returns is written back into the data field of its request, unless a ReadResultSink is set, which
+ * it is streamed to instead, leaving the requests untouched.
+ */
 SC_MODULE(CPU) {
   public:
     // ====================================== External Ports  ======================================
@@ -16,6 +44,7 @@ SC_MODULE(CPU) {
     sc_core::sc_out<std::uint32_t> SC_NAMED(dataOutBus);
     sc_core::sc_out<bool> SC_NAMED(weBus);
     sc_core::sc_out<bool> SC_NAMED(validDataRequestBus);
+    sc_core::sc_out<std::uint16_t> SC_NAMED(addressSpaceBus);
 
     // Cache -> CPU
     sc_core::sc_in<std::uint32_t> SC_NAMED(dataInBus);
@@ -28,13 +57,18 @@ SC_MODULE(CPU) {
     // CPU -> Instr Cache
     sc_core::sc_out<bool> SC_NAMED(validInstrRequestBus);
     sc_core::sc_out<std::uint32_t> SC_NAMED(pcBus);
+    sc_core::sc_out<std::uint16_t> SC_NAMED(instrAddressSpaceBus);
 
   private:
     Request* instructions;
+    std::vector<std::uint16_t> addressSpaces; // per request, empty if all belong to address space 0
+    ReadResultSink* readResultSink = nullptr; // nullptr writes the read results back into the instructions
+    const std::uint32_t* gaps = nullptr; // the cycles computed before each request, nullptr for none
 
     std::uint64_t program_counter = 0;
     std::uint64_t lastCycleWhereWorkWasDone = 0;
     std::size_t numRequests = 0;
+    sc_core::sc_time clockPeriod;
 
     // needed to handle a parallel instruction read and instruction processing
     bool instructionReady = false;
@@ -43,8 +77,26 @@ SC_MODULE(CPU) {
     // this is for when we have just waited for an instruction to be done so we don't need to wait any longer
     bool skipAhead = false;
 
+    // out of order only, nullptr in-order
+    std::unique_ptr<LoadStoreQueue> loadStoreQueue;
+    const std::uint32_t issueWidth;
+    std::size_t numRetired = 0;
+    // the position in the load/store queue of the request the data cache works on
+    bool isCacheBusy = false;
+    std::size_t positionAtCache = 0;
+
+    // the CPUs still running if several of them share the simulation, see shareStopWith
+    std::size_t* runningCPUs = nullptr;
+
   public:
-    CPU(sc_core::sc_module_name name, Request * instructions, std::size_t numRequests);
+    /**
+     * @param[in] clockPeriod The period of the clock the CPU runs on, used to count its cycles
+     * @param[in] loadStoreQueueSize The entries of the load/store queue of an out-of-order CPU, 0 for an in-order CPU.
+     * @param[in] issueWidth The requests issued and retired per cycle out of order. Has to be > 0.
+     */
+    CPU(sc_core::sc_module_name name, Request * instructions, std::size_t numRequests,
+        const sc_core::sc_time& clockPeriod = sc_core::sc_time(1, sc_core::SC_NS), std::uint32_t loadStoreQueueSize = 0,
+        std::uint32_t issueWidth = 1);
 
     /**
      * Returns the cycle in which the last instruction was completed
@@ -52,6 +104,41 @@ SC_MODULE(CPU) {
      */
     constexpr std::uint64_t getElapsedCycleCount() const noexcept { return lastCycleWhereWorkWasDone; }
 
+    /**
+     * Returns the number of loads served from an older store in the load/store queue, 0 for an in-order CPU
+     */
+    std::size_t getForwardedLoads() const noexcept {
+        return loadStoreQueue == nullptr ? 0 : loadStoreQueue->getForwardedLoads();
+    }
+
+    /**
+     * Lets several CPUs share a simulation: instead of stopping it once its own trace is done, a CPU decrements
+     * runningCPUs and only the last one to finish stops the simulation.
+     * @param[in] runningCPUs The number of CPUs sharing the simulation, has to outlive it
+     */
+    void shareStopWith(std::size_t & runningCPUs) noexcept { this->runningCPUs = &runningCPUs; }
+
+    /**
+     * Lets the requests belong to several processes, as in a trace interleaving theirs.
+     * @param[in] addressSpaces The address space ID of the process of each request, one per request
+     */
+    void setAddressSpaces(std::vector<std::uint16_t> addressSpaces) noexcept {
+        this->addressSpaces = std::move(addressSpaces);
+    }
+
+    /**
+     * Lets the program compute between its requests.
+     * @param[in] gaps The cycles to pass before each request, one per request, each below 2^31. Has to outlive the
+     * simulation, nullptr for none.
+     */
+    void setGaps(const std::uint32_t* gaps) noexcept { this->gaps = gaps; }
+
+    /**
+     * Streams the value every read returns to readResultSink instead of writing it back into the requests.
+     * @param[in] readResultSink Has to outlive the simulation
+     */
+    void setReadResultSink(ReadResultSink * readResultSink) noexcept { this->readResultSink = readResultSink; }
+
   private:
     SC_CTOR(CPU); // private since this is never to be called, just to get systemc typedef
 
@@ -67,6 +154,26 @@ SC_MODULE(CPU) {
      * Afterwards the event triggerNextInstructionRead has to be notified to read the next instruction.
      */
     void readInstruction() noexcept;
+    // stops the simulation once the trace is done, unless other CPUs sharing it still run
+    void finish() noexcept;
+    void sendAddressSpaceOf(std::size_t index) noexcept;
+    void sendFetchAddressSpaceOf(std::size_t index) noexcept;
+    void putReadResult(std::size_t index, std::uint32_t data, std::uint64_t cycle) noexcept;
+    // lets the cycles computed before the request at index pass
+    void waitForGapBefore(std::size_t index) noexcept;
+
+    // ======================================= Out of Order ========================================
+    /**
+     * Fetches the requests from the instruction cache in program order into the load/store queue while it has room.
+     */
+    void fetchIntoQueue() noexcept;
+    /**
+     * Every cycle: takes the result of the data cache if it is done, retires, forwards to loads and sends the next
+     * request to the data cache if it is free, all within the issue width.
+     */
+    void issueFromQueue() noexcept;
+    void takeResultFromCache() noexcept;
+    void sendToCache(std::size_t position) noexcept;
 
     // ====================================== Waiting Helpers ======================================
     /**
@@ -1,118 +1,101 @@
 #include "Cache.h"
+#include "Policy/ARCPolicy.h"
+#include "Policy/BitPLRUPolicy.h"
+#include "Policy/DIPPolicy.h"
+#include "Policy/FIFOPolicy.h"
+#include "Policy/LFUPolicy.h"
+#include "Policy/LIRSPolicy.h"
+#include "Policy/LRUPolicy.h"
+#include "Policy/OPTPolicy.h"
+#include "Policy/PluginPolicy.h"
+#include "Policy/RRIPPolicy.h"
+#include "Policy/RandomPolicy.h"
+#include "Policy/TreePLRUPolicy.h"
+#include "Policy/TwoQueuePolicy.h"
 #include "Saturating_Arithmetic.h"
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 using namespace sc_core;
 
-template <>
+template <MappingType mappingType, typename PolicyType>
 std::vector<Cacheline>::iterator
-Cache<MappingType::Direct>::getCachelineOwnedByAddr(const DecomposedAddress& decomposedAddr) noexcept {
-    assert(decomposedAddr.index < cacheInternal.size());
-    auto cachelineExpectedAt = cacheInternal.begin() + decomposedAddr.index;
-    if (cachelineExpectedAt->isValid && cachelineExpectedAt->tag == decomposedAddr.tag) {
-        return cachelineExpectedAt;
-    } else {
-        return cacheInternal.end();
-    }
-}
-
-template <>
-std::vector<Cacheline>::iterator
-Cache<MappingType::Fully_Associative>::getCachelineOwnedByAddr(const DecomposedAddress& decomposedAddr) noexcept {
-    wait(); // reference hash table implementation has a frequency of 370MHz, we run at 1GHz. To compensate for this
-    wait(); // discrepancy, we wait 2 extra cycles.  (source: https://ar5iv.labs.arxiv.org/html/2108.03390v2)
-
-    if (cachelineLookupTable.count(decomposedAddr.tag)) {
-        // isValid is true by virtue of the tag being in there
-        return cacheInternal.begin() + cachelineLookupTable[decomposedAddr.tag];
-    } else {
-        return cacheInternal.end();
+Cache<mappingType, PolicyType>::getCachelineOwnedByAddr(const DecomposedAddress& decomposedAddr) noexcept {
+    if (mappingType == MappingType::Fully_Associative) {
+        // the reference hash table implementation runs at 370MHz, slower than the cache, see setClockPeriod
+        for (std::uint32_t waited = 0; waited < hashTableLookupCycles; ++waited) {
+            wait();
+        }
     }
+    return lineTable.find(decomposedAddr, currentAddressSpace);
 }
 
-template <>
+template <MappingType mappingType, typename PolicyType>
+template <MappingType m, OnlyForMapping<m, MappingType::Direct>>
 std::vector<Cacheline>::iterator
-Cache<MappingType::Direct>::chooseWhichCachelineToFillFromRAM(const DecomposedAddress& decomposedAddr) {
-    auto cachelineToWriteInto = cacheInternal.begin() + decomposedAddr.index; // there is only one possible space
-    assert(cachelineToWriteInto != cacheInternal.end());
-    return cachelineToWriteInto;
+Cache<mappingType, PolicyType>::chooseWhichCachelineToFillFromRAM(const DecomposedAddress& decomposedAddr) {
+    return lineTable.chooseLineToFill(decomposedAddr, replacementPolicy.get());
 }
 
-template <>
+template <MappingType mappingType, typename PolicyType>
+template <MappingType m, OnlyForMapping<m, MappingType::Fully_Associative>>
 std::vector<Cacheline>::iterator
-Cache<MappingType::Fully_Associative>::chooseWhichCachelineToFillFromRAM(const DecomposedAddress& decomposedAddr) {
-    auto firstUnusedCacheline = cacheInternal.end();
-    // since there is no way for a valid cacheline to become string_data again, we can safely just fill them up one by one.
-    // If this process has finished, there are sadly no more free cachelines - and there never will be again
-    if (cachelineLookupTable.numCacheLinesUsed != numCacheLines) {
-        firstUnusedCacheline = cacheInternal.begin() + cachelineLookupTable.numCacheLinesUsed;
-        cachelineLookupTable.numCacheLinesUsed += 1;
-    }
-
-    // if there was no free cacheline :(
-    if (firstUnusedCacheline == cacheInternal.end()) {
-        firstUnusedCacheline = cacheInternal.begin() + replacementPolicy->pop();
-        // kick out entry for tag we replaced
-        cachelineLookupTable.erase(firstUnusedCacheline->tag);
+Cache<mappingType, PolicyType>::chooseWhichCachelineToFillFromRAM(const DecomposedAddress& decomposedAddr) {
+    if (!wayPolicies.empty()) {
+        const std::uint32_t line = chooseWhichCachelineToFillInWays(decomposedAddr);
+        return lineTable.claim(line, decomposedAddr.tag, currentAddressSpace);
     }
-    assert(firstUnusedCacheline != cacheInternal.end());
-    // enter us into hashtable because we now own this cacheline
-    cachelineLookupTable[decomposedAddr.tag] = firstUnusedCacheline - cacheInternal.begin();
-    return firstUnusedCacheline;
-}
-
-template <> DecomposedAddress Cache<MappingType::Direct>::decomposeAddress(std::uint32_t address) noexcept {
-    assert(addressOffsetBitMask > 0 && addressTagBitMask > 0);
-    // modding the offset bits is presumably not necessary, but has been left in as a precaution
-    return DecomposedAddress{((address >> addressOffsetBits) >> addressIndexBits) & addressTagBitMask,
-                             ((address >> addressOffsetBits) & addressIndexBitMask) % numCacheLines,
-                             (address & addressOffsetBitMask) % cacheLineSize};
+    return lineTable.chooseLineToFill(decomposedAddr, replacementPolicy.get(), currentAddressSpace);
 }
 
-template <> DecomposedAddress Cache<MappingType::Fully_Associative>::decomposeAddress(std::uint32_t address) noexcept {
-    assert(addressOffsetBitMask > 0 && addressIndexBitMask == 0 && addressTagBitMask > 0);
-    // modding the offset bits is presumably not necessary, but has been left in as a precaution
-    return DecomposedAddress{(address >> addressOffsetBits) & addressTagBitMask, 0,
-                             (address & addressOffsetBitMask) % cacheLineSize};
-}
+template <MappingType mappingType, typename PolicyType>
+template <MappingType m, OnlyForMapping<m, MappingType::Fully_Associative>>
+std::uint32_t
+Cache<mappingType, PolicyType>::chooseWhichCachelineToFillInWays(const DecomposedAddress& decomposedAddr) {
+    const std::uint32_t numWays = wayPolicies.size();
+    const std::uint32_t linesPerWay = numCacheLines / numWays;
+    const std::uint32_t mask = currentAddressSpace < wayMasks.size() ? wayMasks[currentAddressSpace] : ~0u;
+    auto isAllowed = [mask](std::uint32_t way) { return (mask >> way & 1u) != 0; };
+
+    // like without ways, the free lines of a way are filled up one by one and never become free again
+    for (std::uint32_t way = 0; way < numWays; ++way) {
+        if (isAllowed(way) && linesUsedOfWay[way] != linesPerWay) {
+            wayPolicies[way]->logMiss(decomposedAddr.tag);
+            return way * linesPerWay + linesUsedOfWay[way]++;
+        }
+    }
 
-template <>
-void Cache<MappingType::Direct>::registerUsage(
-    __attribute__((unused)) std::vector<Cacheline>::iterator cacheline) noexcept {
-    // no bookkeeping needed
+    std::uint32_t& way = lastVictimWay[currentAddressSpace];
+    do {
+        way = (way + 1) % numWays;
+    } while (!isAllowed(way));
+    wayPolicies[way]->logMiss(decomposedAddr.tag);
+    const std::uint32_t line = way * linesPerWay + lineTable.checkVictim(wayPolicies[way]->pop(), linesPerWay);
+    // kick out entry for tag we replaced
+    lineTable.forget(line);
+    return line;
 }
 
-template <>
-void Cache<MappingType::Fully_Associative>::registerUsage(std::vector<Cacheline>::iterator cacheline) noexcept {
-    replacementPolicy->logUse(cacheline - cacheInternal.begin());
+template <MappingType mappingType, typename PolicyType>
+void Cache<mappingType, PolicyType>::registerUsage(std::vector<Cacheline>::iterator cacheline) noexcept {
+    if (wayPolicies.empty()) {
+        lineTable.registerUsage(cacheline, replacementPolicy.get());
+    } else {
+        const std::uint32_t line = cacheline - cacheInternal.begin();
+        const std::uint32_t linesPerWay = numCacheLines / wayPolicies.size();
+        wayPolicies[line / linesPerWay]->logUse(line % linesPerWay);
+    }
 }
 
-template <MappingType mappingType> void Cache<mappingType>::waitForRAM() noexcept {
+template <MappingType mappingType, typename PolicyType> void Cache<mappingType, PolicyType>::waitForRAM() noexcept {
     do {
         wait();
     } while (!writeBufferReady.read());
 }
 
-template <> void Cache<MappingType::Fully_Associative>::precomputeAddressDecompositionBits() noexcept {
-    addressOffsetBits = safeCeilLog2(cacheLineSize);
-    addressIndexBits = 0; // no index bits in fully associative cache
-    addressTagBits = 32 - addressOffsetBits;
-    assert(addressTagBits + addressIndexBits + addressOffsetBits == 32);
-    addressOffsetBitMask = generateBitmaskForLowestNBits(addressOffsetBits);
-    addressTagBitMask = generateBitmaskForLowestNBits(addressTagBits);
-}
-
-template <> void Cache<MappingType::Direct>::precomputeAddressDecompositionBits() noexcept {
-    addressOffsetBits = safeCeilLog2(cacheLineSize);
-    addressIndexBits = safeCeilLog2(numCacheLines);
-    addressTagBits = 32 - addressIndexBits - addressOffsetBits;
-    assert(addressTagBits + addressIndexBits + addressOffsetBits == 32);
-    addressOffsetBitMask = generateBitmaskForLowestNBits(addressOffsetBits);
-    addressIndexBitMask = generateBitmaskForLowestNBits(addressIndexBits);
-    addressTagBitMask = generateBitmaskForLowestNBits(addressTagBits);
-}
-
-template <MappingType mappingType> void Cache<mappingType>::setUpWriteBufferConnects() noexcept {
+template <MappingType mappingType, typename PolicyType>
+void Cache<mappingType, PolicyType>::setUpWriteBufferConnects() noexcept {
     writeBuffer.clock.bind(clock);
 
     writeBuffer.ready.bind(writeBufferReady);
@@ -132,18 +115,21 @@ template <MappingType mappingType> void Cache<mappingType>::setUpWriteBufferConn
     writeBuffer.memoryReadyBus.bind(memoryReadyBus);
 }
 
-template <MappingType mappingType> void Cache<mappingType>::zeroInitialiseCachelines() noexcept {
+template <MappingType mappingType, typename PolicyType>
+void Cache<mappingType, PolicyType>::zeroInitialiseCachelines() noexcept {
     for (auto& cacheline : cacheInternal) {
         cacheline.data = std::vector<std::uint8_t>(cacheLineSize, 0);
     }
 }
 
-template <MappingType mappingType>
-Cache<mappingType>::Cache(sc_module_name name, std::uint32_t numCacheLines, std::uint32_t cacheLineSize,
-                          std::uint32_t cacheLatency, std::unique_ptr<ReplacementPolicy<std::uint32_t>> policy)
+template <MappingType mappingType, typename PolicyType>
+Cache<mappingType, PolicyType>::Cache(sc_module_name name, std::uint32_t numCacheLines, std::uint32_t cacheLineSize,
+                                      std::uint32_t cacheLatency, std::unique_ptr<PolicyType> policy,
+                                      std::uint32_t writeBufferDepth, bool writeCombining)
     : sc_module{name}, numCacheLines{numCacheLines}, cacheLineSize{cacheLineSize}, cacheLatency{cacheLatency},
       replacementPolicy{std::move(policy)}, cacheInternal{numCacheLines},
-      writeBuffer{"writeBuffer", cacheLineSize / RAM_READ_BUS_SIZE_IN_BYTE, cacheLineSize} {
+      writeBuffer{"writeBuffer", cacheLineSize / RAM_READ_BUS_SIZE_IN_BYTE, cacheLineSize, writeBufferDepth,
+                  writeCombining} {
     if (replacementPolicy != nullptr && mappingType == MappingType::Direct) {
         std::cerr << "Replacement Policy is set on a direct mapped cache - this has no effect.\n";
     }
@@ -154,67 +140,74 @@ Cache<mappingType>::Cache(sc_module_name name, std::uint32_t numCacheLines, std:
     assert(cacheLineSize > 0 && numCacheLines > 0);
 
     zeroInitialiseCachelines();
-    precomputeAddressDecompositionBits();
     setUpWriteBufferConnects();
 
     SC_THREAD(handleRequest);
     sensitive << clock.pos();
 }
 
-template <MappingType mappingType>
+template <MappingType mappingType, typename PolicyType>
 std::vector<Cacheline>::iterator
-Cache<mappingType>::writeRAMReadIntoCacheline(const DecomposedAddress& decomposedAddr) noexcept {
+Cache<mappingType, PolicyType>::writeRAMReadIntoCacheline(const DecomposedAddress& decomposedAddr) noexcept {
     auto cachelineToWriteInto = chooseWhichCachelineToFillFromRAM(decomposedAddr);
     writeBufferValidRequest.write(false);
     // we do not allow any inputs violating this rule in the C-part
     assert(cachelineToWriteInto->data.size() % RAM_READ_BUS_SIZE_IN_BYTE == 0);
-    sc_dt::sc_bv<RAM_READ_BUS_SIZE_IN_BYTE * BITS_IN_BYTE> dataRead;
     std::uint32_t numReadEvents = (cachelineToWriteInto->data.size() / RAM_READ_BUS_SIZE_IN_BYTE);
 
     for (std::size_t i = 0; i < numReadEvents; ++i) {
-        dataRead = writeBufferDataOut.read();
-        for (std::size_t byte = 0; byte < RAM_READ_BUS_SIZE_IN_BYTE; ++byte) {
-            cachelineToWriteInto->data[RAM_READ_BUS_SIZE_IN_BYTE * i + byte] =
-                dataRead.range(BITS_IN_BYTE * byte + (BITS_IN_BYTE - 1), BITS_IN_BYTE * byte).to_uint();
-        }
+        const auto& dataRead = writeBufferDataOut.read().bytes;
+        std::copy(dataRead.begin(), dataRead.end(), cachelineToWriteInto->data.begin() + RAM_READ_BUS_SIZE_IN_BYTE * i);
         //  if this is the last one we don't need to wait anymore
         if (i + 1 <= numReadEvents)
             wait();
     }
 
+    if (!addressSpaceStatistics.empty() && cachelineToWriteInto->isValid &&
+        cachelineToWriteInto->addressSpace != currentAddressSpace) {
+        ++addressSpaceStatistics[cachelineToWriteInto->addressSpace].evictedByOthers;
+        ++addressSpaceStatistics[currentAddressSpace].evictionsOfOthers;
+    }
     cachelineToWriteInto->isValid = true;
     cachelineToWriteInto->tag = decomposedAddr.tag;
+    cachelineToWriteInto->addressSpace = currentAddressSpace;
 
     return cachelineToWriteInto;
 }
 
-template <MappingType mappingType> void Cache<mappingType>::waitOutCacheLatency() noexcept {
+template <MappingType mappingType, typename PolicyType>
+void Cache<mappingType, PolicyType>::waitOutCacheLatency() noexcept {
     for (std::size_t i = 0; i < cacheLatency; ++i) {
         wait();
     }
 }
 
-template <MappingType mappingType>
+template <MappingType mappingType, typename PolicyType>
 std::vector<Cacheline>::iterator
-Cache<mappingType>::fetchIfNotPresent(std::uint32_t addr, const DecomposedAddress& decomposedAddr) noexcept {
+Cache<mappingType, PolicyType>::fetchIfNotPresent(std::uint32_t addr,
+                                                  const DecomposedAddress& decomposedAddr) noexcept {
     waitOutCacheLatency();
     auto cacheline = getCachelineOwnedByAddr(decomposedAddr);
     if (cacheline != cacheInternal.end()) {
         ++hitCount;
+        if (!addressSpaceStatistics.empty())
+            ++addressSpaceStatistics[currentAddressSpace].hits;
         return cacheline;
     }
     ++missCount;
+    if (!addressSpaceStatistics.empty())
+        ++addressSpaceStatistics[currentAddressSpace].misses;
     startReadFromRAM(addr);
     waitForRAM();
     return writeRAMReadIntoCacheline(decomposedAddr);
 }
 
-template <MappingType mappingType>
-void Cache<mappingType>::handleSubRequest(SubRequest subRequest, std::uint32_t& readData) noexcept {
+template <MappingType mappingType, typename PolicyType>
+void Cache<mappingType, PolicyType>::handleSubRequest(SubRequest subRequest, std::uint32_t& readData) noexcept {
     auto addr = subRequest.addr;
 
     // split into tag - index - offset
-    const auto decomposedAddr = decomposeAddress(addr);
+    const auto decomposedAddr = lineTable.decomposeAddress(addr);
 
     // check if in cache (waits for #cycles specified by cacheLatency) - if not read from RAM
     auto cacheline = fetchIfNotPresent(addr, decomposedAddr);
@@ -232,9 +225,9 @@ void Cache<mappingType>::handleSubRequest(SubRequest subRequest, std::uint32_t&
     }
 }
 
-template <MappingType mappingType>
-std::uint32_t Cache<mappingType>::doRead(const DecomposedAddress& decomposedAddr, Cacheline& cacheline,
-                                         std::uint32_t numBytes) noexcept {
+template <MappingType mappingType, typename PolicyType>
+std::uint32_t Cache<mappingType, PolicyType>::doRead(const DecomposedAddress& decomposedAddr, Cacheline& cacheline,
+                                                     std::uint32_t numBytes) noexcept {
     assert((numBytes + decomposedAddr.offset - 1) < cacheLineSize);
 
     std::uint32_t retVal = 0;
@@ -244,7 +237,7 @@ std::uint32_t Cache<mappingType>::doRead(const DecomposedAddress& decomposedAddr
     return retVal;
 }
 
-template <MappingType mappingType> void Cache<mappingType>::handleRequest() noexcept {
+template <MappingType mappingType, typename PolicyType> void Cache<mappingType, PolicyType>::handleRequest() noexcept {
     while (true) {
         wait();
         ready.write(false);
@@ -252,6 +245,8 @@ template <MappingType mappingType> void Cache<mappingType>::handleRequest() noex
         if (!cpuValidRequest.read())
             continue;
         const auto request = constructRequestFromBusses();
+        currentAddressSpace = cpuAddressSpaceBus.read();
+        assert(addressSpaceStatistics.empty() || currentAddressSpace < addressSpaceStatistics.size());
         const auto subRequests = splitRequestIntoSubRequests(request, cacheLineSize);
 
         // while this is also passed into write requests, it is only relevant for read request and will not be accessed
@@ -269,9 +264,9 @@ template <MappingType mappingType> void Cache<mappingType>::handleRequest() noex
     }
 }
 
-template <MappingType mappingType>
-void Cache<mappingType>::doWrite(Cacheline& cacheline, const DecomposedAddress& decomposedAddr, std::uint32_t data,
-                                 std::uint32_t numBytes) noexcept {
+template <MappingType mappingType, typename PolicyType>
+void Cache<mappingType, PolicyType>::doWrite(Cacheline& cacheline, const DecomposedAddress& decomposedAddr,
+                                             std::uint32_t data, std::uint32_t numBytes) noexcept {
     assert((numBytes + decomposedAddr.offset - 1) < cacheLineSize);
     for (std::size_t byteNr = 0; byteNr < numBytes; ++byteNr) {
         cacheline.data[(decomposedAddr.offset + byteNr)] =
@@ -279,9 +274,9 @@ void Cache<mappingType>::doWrite(Cacheline& cacheline, const DecomposedAddress&
     }
 }
 
-template <MappingType mappingType>
-void Cache<mappingType>::passWriteOnToRAM(Cacheline& cacheline, const DecomposedAddress& decomposedAddr,
-                                          std::uint32_t addr) noexcept {
+template <MappingType mappingType, typename PolicyType>
+void Cache<mappingType, PolicyType>::passWriteOnToRAM(Cacheline& cacheline, const DecomposedAddress& decomposedAddr,
+                                                      std::uint32_t addr) noexcept {
     std::uint32_t data = 0;
 
     std::size_t startByte = std::min(static_cast<std::size_t>(decomposedAddr.offset), cacheline.data.size() - 4);
@@ -311,14 +306,16 @@ void Cache<mappingType>::passWriteOnToRAM(Cacheline& cacheline, const Decomposed
 #endif
 }
 
-template <MappingType mappingType> void Cache<mappingType>::startReadFromRAM(std::uint32_t addr) noexcept {
+template <MappingType mappingType, typename PolicyType>
+void Cache<mappingType, PolicyType>::startReadFromRAM(std::uint32_t addr) noexcept {
     std::uint32_t alignedAddr = (addr / cacheLineSize) * cacheLineSize;
     writeBufferAddr.write(alignedAddr);
     writeBufferWE.write(false);
     writeBufferValidRequest.write(true);
 }
 
-template <MappingType mappingType> Request Cache<mappingType>::constructRequestFromBusses() const noexcept {
+template <MappingType mappingType, typename PolicyType>
+Request Cache<mappingType, PolicyType>::constructRequestFromBusses() const noexcept {
     return Request{cpuAddrBus.read(), cpuDataInBus.read(), cpuWeBus.read()};
 }
 
@@ -382,19 +379,54 @@ static constexpr size_t calcGateCountForMisc() {
     return 1000;
 }
 
-template <MappingType mappingType> std::size_t Cache<mappingType>::calculateGateCount() const noexcept {
+template <MappingType mappingType, typename PolicyType>
+std::size_t Cache<mappingType, PolicyType>::calculateGateCount() const noexcept {
     return addSatUnsigned(
         calcGateCountForCachelineSelection(numCacheLines, cacheLineSize, mappingType, *replacementPolicy),
-        calcGateCountForInternalTable(numCacheLines, cacheLineSize, addressTagBits),
+        calcGateCountForInternalTable(numCacheLines, cacheLineSize, lineTable.tagBits() + addressSpaceBits),
         calcGateCountForDoingReads(cacheLineSize), calcGateCountForSubRequestSplitting(), calcGateCountForMisc());
 }
 // ============ END GATE COUNT ========================
 
+std::uint32_t hashTableLookupCyclesAt(const sc_time& clockPeriod) noexcept {
+    const sc_time hashTablePeriod{1e6 / 370, SC_PS};
+    const double cycles = std::ceil(hashTablePeriod.to_double() / clockPeriod.to_double());
+    return static_cast<std::uint32_t>(std::max(cycles, 1.0)) - 1;
+}
+
+template <MappingType mappingType, typename PolicyType>
+void Cache<mappingType, PolicyType>::setAddressSpaces(std::uint16_t numAddressSpaces) {
+    assert(numAddressSpaces > 0);
+    addressSpaceStatistics.assign(numAddressSpaces, AddressSpaceStatistics{});
+    addressSpaceBits = safeCeilLog2(numAddressSpaces);
+}
+
+template <MappingType mappingType, typename PolicyType>
+void Cache<mappingType, PolicyType>::partitionWays(std::vector<std::unique_ptr<PolicyType>> wayPolicies,
+                                                   std::vector<std::uint32_t> wayMasks) {
+    // taken care of in C part
+    assert(mappingType == MappingType::Fully_Associative && !addressSpaceStatistics.empty());
+    assert(!wayPolicies.empty() && wayPolicies.size() <= 32 && numCacheLines % wayPolicies.size() == 0);
+    assert(std::none_of(wayMasks.begin(), wayMasks.end(), [](std::uint32_t mask) { return mask == 0; }));
+    this->wayPolicies = std::move(wayPolicies);
+    this->wayMasks = std::move(wayMasks);
+    linesUsedOfWay.assign(this->wayPolicies.size(), 0);
+    // so the first victim of every address space is taken from the first way it may fill
+    lastVictimWay.assign(addressSpaceStatistics.size(), this->wayPolicies.size() - 1);
+}
+
+template <MappingType mappingType, typename PolicyType>
+void Cache<mappingType, PolicyType>::setClockPeriod(const sc_time& period) noexcept {
+    hashTableLookupCycles = hashTableLookupCyclesAt(period);
+}
+
 #ifdef STRICT_INSTRUCTION_ORDER
-template <MappingType mappingType> void Cache<mappingType>::setMemoryLatency(std::uint32_t memoryLatency) {}
+template <MappingType mappingType, typename PolicyType>
+void Cache<mappingType, PolicyType>::setMemoryLatency(std::uint32_t memoryLatency) {}
 #endif
 
-template <MappingType mappingType> void Cache<mappingType>::traceInternalSignals(sc_trace_file* const traceFile) const {
+template <MappingType mappingType, typename PolicyType>
+void Cache<mappingType, PolicyType>::traceInternalSignals(sc_trace_file* const traceFile) const {
     sc_trace(traceFile, writeBufferReady, "WriteBuffer_Cache_Ready");
     sc_trace(traceFile, writeBufferDataOut, "WriteBuffer_Cache_Data_Out");
     sc_trace(traceFile, writeBufferAddr, "Cache_WriteBuffer_Addr");
@@ -405,4 +437,18 @@ template <MappingType mappingType> void Cache<mappingType>::traceInternalSignals
 
 // here to allow the move of function definitions to cpp
 template struct Cache<MappingType::Direct>;
-template struct Cache<MappingType::Fully_Associative>;
\ No newline at end of file
+template struct Cache<MappingType::Fully_Associative>;
+// the fully associative cache bound to each policy at compile time, see run_simulation_extended
+template struct Cache<MappingType::Fully_Associative, LRUPolicy<std::uint32_t>>;
+template struct Cache<MappingType::Fully_Associative, FIFOPolicy<std::uint32_t>>;
+template struct Cache<MappingType::Fully_Associative, RandomPolicy<std::uint32_t>>;
+template struct Cache<MappingType::Fully_Associative, TreePLRUPolicy<std::uint32_t>>;
+template struct Cache<MappingType::Fully_Associative, BitPLRUPolicy<std::uint32_t>>;
+template struct Cache<MappingType::Fully_Associative, RRIPPolicy<std::uint32_t>>;
+template struct Cache<MappingType::Fully_Associative, LFUPolicy<std::uint32_t>>;
+template struct Cache<MappingType::Fully_Associative, ARCPolicy<std::uint32_t>>;
+template struct Cache<MappingType::Fully_Associative, TwoQueuePolicy<std::uint32_t>>;
+template struct Cache<MappingType::Fully_Associative, LIRSPolicy<std::uint32_t>>;
+template struct Cache<MappingType::Fully_Associative, OPTPolicy<std::uint32_t>>;
+template struct Cache<MappingType::Fully_Associative, DIPPolicy<std::uint32_t>>;
+template struct Cache<MappingType::Fully_Associative, PluginPolicy<std::uint32_t>>;
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../Request.h"
+#include "BusBeat.h"
+#include "CachelineTable.h"
 #include "Cacheline.h"
 #include "DecomposedAddress.h"
 #include "Policy/ReplacementPolicy.h"
@@ -8,20 +10,25 @@
 #include "WriteBuffer.h"
 
 #include <algorithm>
+#include <cassert>
 #include <cstdint>
 #include <iostream>
 #include <memory>
-#include <type_traits>
 #include <typeinfo>
-#include <unordered_map>
 
 #include <systemc>
 
-enum class MappingType { Direct, Fully_Associative };
-
-constexpr std::uint16_t RAM_READ_BUS_SIZE_IN_BYTE{16}; // NOT a config value, just a transparent way to access
+// NOT a config value, just a transparent way to access
+constexpr std::uint16_t RAM_READ_BUS_SIZE_IN_BYTE{BusBeat::SIZE_IN_BYTE};
 constexpr std::uint16_t BITS_IN_BYTE{8}; // we could use the systemc BITS_PER_BYTE, but this gives more transparency
-constexpr std::uint16_t WRITE_BUFFER_SIZE{4}; // chosen by fair dice roll. guaranteed to be optimal :)
+constexpr std::uint16_t WRITE_BUFFER_SIZE{4}; // default depth. chosen by fair dice roll. guaranteed to be optimal :)
+
+/**
+ * A fully associative cache looks its lines up in a hash table running at 370 MHz (source:
+ * https://ar5iv.labs.arxiv.org/html/2108.03390v2). Returns the cycles of a clock of clockPeriod this takes on top of
+ * the first one, 2 at the default of 1 ns.
+ */
+std::uint32_t hashTableLookupCyclesAt(const sc_core::sc_time& clockPeriod) noexcept;
 
 /**
  * This module represents a Cache of a certain mapping type (Direct / Fully associative). It is meant to be connected
@@ -37,11 +44,20 @@ constexpr std::uint16_t WRITE_BUFFER_SIZE{4}; // chosen by fair dice roll. guara
  *
  * All operations happen on rising clock edge.
  *
- * This cache uses a write buffer able to buffer WRITE_BUFFER_SIZE writes at once. See its documentation for more
- * detail. Its optimisation can be turned off by compiling with definition STRICT_INSTRUCTION_ORDER.
+ * This cache uses a write buffer able to buffer writes to writeBufferDepth (by default WRITE_BUFFER_SIZE) cachelines at
+ * once, optionally combining them into burst writes. See its documentation for more detail. Its optimisation can be
+ * turned off by compiling with definition STRICT_INSTRUCTION_ORDER.
+ *
+ * The replacement policy is called on every access of a fully associative cache. By default it is chosen at runtime
+ * through the ReplacementPolicy interface, but PolicyType may also be one of the concrete (final) policies, which lets
+ * the compiler inline its logUse and pop. Cache.cpp instantiates the cache for each of them.
+ *
+ * Several processes may share the cache, see setAddressSpaces: every line is tagged with the address space ID of the
+ * process that filled it, which the CPU sends along with each request, and only requests of that process hit on it. A
+ * fully associative cache can further be partitioned into ways per process, see partitionWays.
  *
  */
-template <MappingType mappingType> SC_MODULE(Cache) {
+template <MappingType mappingType, typename PolicyType = ReplacementPolicy<std::uint32_t>> SC_MODULE(Cache) {
   public:
     // ====================================== External Ports  ======================================
     // Global Clock
@@ -52,6 +68,7 @@ template <MappingType mappingType> SC_MODULE(Cache) {
     sc_core::sc_in<std::uint32_t> SC_NAMED(cpuDataInBus);
     sc_core::sc_in<bool> SC_NAMED(cpuWeBus);
     sc_core::sc_in<bool> SC_NAMED(cpuValidRequest);
+    sc_core::sc_in<std::uint16_t> SC_NAMED(cpuAddressSpaceBus);
 
     // Cache -> RAM
     sc_core::sc_out<std::uint32_t> SC_NAMED(memoryAddrBus);
@@ -60,7 +77,7 @@ template <MappingType mappingType> SC_MODULE(Cache) {
     sc_core::sc_out<bool> SC_NAMED(memoryValidRequestBus);
 
     // RAM -> Cache
-    sc_core::sc_in<sc_dt::sc_bv<RAM_READ_BUS_SIZE_IN_BYTE * BITS_IN_BYTE>> SC_NAMED(memoryDataInBus);
+    sc_core::sc_in<BusBeat> SC_NAMED(memoryDataInBus);
     sc_core::sc_in<bool> SC_NAMED(memoryReadyBus);
 
     // Cache -> CPU
@@ -71,7 +88,7 @@ template <MappingType mappingType> SC_MODULE(Cache) {
     // ====================================== Internal Signals  ======================================
     // Buffer -> Cache
     sc_core::sc_signal<bool, sc_core::SC_MANY_WRITERS> SC_NAMED(writeBufferReady);
-    sc_core::sc_signal<sc_dt::sc_bv<RAM_READ_BUS_SIZE_IN_BYTE * BITS_IN_BYTE>> SC_NAMED(writeBufferDataOut);
+    sc_core::sc_signal<BusBeat> SC_NAMED(writeBufferDataOut);
 
     // Cache -> Buffer
     sc_core::sc_signal<std::uint32_t> SC_NAMED(writeBufferAddr);
@@ -84,33 +101,39 @@ template <MappingType mappingType> SC_MODULE(Cache) {
     std::uint64_t hitCount{0};
     std::uint64_t missCount{0};
 
+    // per address space, empty unless set up by setAddressSpaces
+    struct AddressSpaceStatistics {
+        std::uint64_t hits{0};
+        std::uint64_t misses{0};
+        std::uint64_t evictedByOthers{0};   // lines of this address space another one took
+        std::uint64_t evictionsOfOthers{0}; // lines of another address space this one took
+    };
+    std::vector<AddressSpaceStatistics> addressSpaceStatistics;
+
   private:
     // ====================================== Config  ======================================
     std::uint32_t numCacheLines{0};
     std::uint32_t cacheLineSize{0}; // in Byte
     std::uint32_t cacheLatency{0};  // in Cycles
-    std::unique_ptr<ReplacementPolicy<std::uint32_t>> replacementPolicy{nullptr};
+    std::uint32_t hashTableLookupCycles{2}; // on top of the cacheLatency, see setClockPeriod
+    std::unique_ptr<PolicyType> replacementPolicy{nullptr};
 #ifdef STRICT_INSTRUCTION_ORDER
     std::uint32_t memoryLatency{0};
 #endif
 
     // ====================================== Internals ======================================
     std::vector<Cacheline> cacheInternal;
-    WriteBuffer<WRITE_BUFFER_SIZE> writeBuffer;
-
-    struct Empty {}; // we only want to pay the price for having a hash-table if we need it
-    struct CachelineLookupTableType : std::conditional<mappingType == MappingType::Fully_Associative,
-                                                       std::unordered_map<std::uint32_t, std::uint32_t>, Empty>::type {
-        std::uint32_t numCacheLinesUsed{0};
-    } cachelineLookupTable;
-
-    // ====================================== Precomputation ======================================
-    std::uint32_t addressOffsetBits{0};
-    std::uint32_t addressIndexBits{0};
-    std::uint32_t addressTagBits{0};
-    std::uint32_t addressOffsetBitMask{0};
-    std::uint32_t addressIndexBitMask{0};
-    std::uint32_t addressTagBitMask{0};
+    CachelineTable<mappingType, Cacheline> lineTable{cacheInternal, cacheLineSize};
+    WriteBuffer writeBuffer;
+
+    // ====================================== Address Spaces ======================================
+    std::uint16_t currentAddressSpace{0}; // of the request being handled
+    std::uint32_t addressSpaceBits{0};    // added to the tag of every line, 0 for a single address space
+    // the ways of a partitioned fully associative cache, each replaced by a policy of its own. Empty if not partitioned
+    std::vector<std::unique_ptr<PolicyType>> wayPolicies;
+    std::vector<std::uint32_t> linesUsedOfWay;
+    std::vector<std::uint32_t> wayMasks;      // per address space, all ways for those without one
+    std::vector<std::uint32_t> lastVictimWay; // per address space, the way it evicted from last
 
   public:
     /**
@@ -125,21 +148,73 @@ template <MappingType mappingType> SC_MODULE(Cache) {
      * @param[in] policy Optional parameter - the replacement policy taking effect when the cache is full and a new
      * entry shall be stored. Only relevant if MappingType is Fully_Associative, results in a warning on Direct if not
      * null_ptr. Takes ownership of the policy. Default value is nullptr.
+     * @param[in] writeBufferDepth Optional parameter - the number of entries of the write buffer. Has to be > 0.
+     * Default value is WRITE_BUFFER_SIZE.
+     * @param[in] writeCombining Optional parameter - whether the write buffer combines writes into whole lines drained
+     * as bursts, see WriteBuffer. Default value is false.
      */
     Cache(sc_core::sc_module_name name, std::uint32_t numCacheLines, std::uint32_t cacheLineSize,
-          std::uint32_t cacheLatency, std::unique_ptr<ReplacementPolicy<std::uint32_t>> policy = nullptr);
+          std::uint32_t cacheLatency, std::unique_ptr<PolicyType> policy = nullptr,
+          std::uint32_t writeBufferDepth = WRITE_BUFFER_SIZE, bool writeCombining = false);
     /**
      * Approximates the primitive gate count used to construct this cache
      * @returns An approximation of the amount of primitive gates within this caches
      */
     std::size_t calculateGateCount() const noexcept;
 
+    /**
+     * @returns The replacement policy of this cache. Only to be called on a fully associative cache
+     */
+    const PolicyType& getReplacementPolicy() const noexcept {
+        assert(replacementPolicy != nullptr);
+        return *replacementPolicy;
+    }
+
+    /**
+     * @returns The occupancy, coalescing and stalls of the write buffer so far
+     */
+    const WriteBufferStatistics& getWriteBufferStatistics() const noexcept { return writeBuffer.getStatistics(); }
+
+    /**
+     * @returns The first victim out of range the replacement policy chose, NO_INVALID_VICTIM if there was none. A
+     * policy loaded from a plugin may do so, which stops the simulation, see CachelineTable::checkVictim
+     */
+    std::uint64_t getInvalidVictim() const noexcept { return lineTable.getInvalidVictim(); }
+
+    /**
+     * Lets numAddressSpaces processes share the cache, counting the hits, misses and evictions of each of them in
+     * addressSpaceStatistics. The CPU has to send the ID of the process of each request, in range [0,numAddressSpaces).
+     * Lines of different processes never alias, the IDs are part of the tag.
+     * @param[in] numAddressSpaces The number of processes, has to be > 0
+     */
+    void setAddressSpaces(std::uint16_t numAddressSpaces);
+
+    /**
+     * Partitions a fully associative cache like Intel CAT does a set associative one: its lines are split into
+     * wayPolicies.size() equally sized groups of consecutive lines standing in for the ways, and a miss of address space
+     * i only fills a line of the ways whose bit is set in wayMasks[i] (all ways if i has no mask). It takes a free line
+     * of those ways if there is one, otherwise the victim of the way policy of the next of them in round robin order.
+     * Hits are not restricted. Only to be called on a fully associative cache, after setAddressSpaces and before the
+     * simulation starts.
+     * @param[in] wayPolicies The replacement policies of the ways, each for numCacheLines / wayPolicies.size() lines.
+     * Their number has to divide numCacheLines and be in range [1,32].
+     * @param[in] wayMasks The ways each address space may fill, none of them 0
+     */
+    void partitionWays(std::vector<std::unique_ptr<PolicyType>> wayPolicies, std::vector<std::uint32_t> wayMasks);
+
     /**
      * Adds internal signals to and from write buffer to the trace file
      * @param[in] traceFile The trace file the signals shall be added to
      */
     void traceInternalSignals(sc_core::sc_trace_file* const traceFile) const;
 
+    /**
+     * Sets the period of the clock the cache runs on (default: 1 ns), which the hash table lookup of a fully
+     * associative cache depends on, see hashTableLookupCyclesAt.
+     * @param[in] period The period of the clock the cache runs on
+     */
+    void setClockPeriod(const sc_core::sc_time& period) noexcept;
+
 #ifdef STRICT_INSTRUCTION_ORDER
     /**
      * Sets the correct memory latency this system experiences. This is only to be used if one insists on bypassing
@@ -162,11 +237,6 @@ template <MappingType mappingType> SC_MODULE(Cache) {
      * Initialise all cachelines with 0 bytes.
      */
     void zeroInitialiseCachelines() noexcept;
-    /**
-     * Precomputes what (and how many) bits of an address correspond to tag, index and offset in our cache. Furthermore
-     * preconstructs bit masks to extract those values.
-     */
-    void precomputeAddressDecompositionBits() noexcept;
 
     // ========== Main Request Handling ==============
     /**
@@ -189,16 +259,10 @@ template <MappingType mappingType> SC_MODULE(Cache) {
 
     // ====================================== Helpers to determine which cache line to read from / write to
     // ======================================
-    /**
-     * Use precomputed masks to decompose address into tag, index and offset
-     * @param[in] address The address to be decomposed
-     * @returns The address decomposed into tag, index and offset
-     */
-    DecomposedAddress decomposeAddress(std::uint32_t address) noexcept;
     /**
      * Use address decomposed into tag, index and offset to find a cacheline in the cache that is already "owned" by
-     * this address, meaning the tag matches and it is a valid cacheline. How this cacheline is found is determined by
-     * the Mapping Type
+     * this address, meaning the tag matches, it belongs to the current address space and it is a valid cacheline. How
+     * this cacheline is found is determined by the Mapping Type, see CachelineTable
      * @param[in] decomposedAddr  The address decomposed into tag, index, offset
      * @returns an iterator to the cacheline we own. Returns end() iterator if none found
      */
@@ -208,7 +272,16 @@ template <MappingType mappingType> SC_MODULE(Cache) {
      * @param[in] decomposedAddr  The address decomposed into tag, index, offset
      * @returns an iterator to the cacheline to be read into. Always a valid iterator
      */
+    template <MappingType m = mappingType, OnlyForMapping<m, MappingType::Direct> = 0>
+    std::vector<Cacheline>::iterator chooseWhichCachelineToFillFromRAM(const DecomposedAddress& decomposedAddr);
+    template <MappingType m = mappingType, OnlyForMapping<m, MappingType::Fully_Associative> = 0>
     std::vector<Cacheline>::iterator chooseWhichCachelineToFillFromRAM(const DecomposedAddress& decomposedAddr);
+    /**
+     * chooseWhichCachelineToFillFromRAM of a cache partitioned into ways, see partitionWays
+     * @returns the index of the cacheline to be read into
+     */
+    template <MappingType m = mappingType, OnlyForMapping<m, MappingType::Fully_Associative> = 0>
+    std::uint32_t chooseWhichCachelineToFillInWays(const DecomposedAddress& decomposedAddr);
     /**
      * If this is a fully associative cache with a stateful policy (e.g. LRU), this updates the aforementioned state. If
      * direct mapped, this is a NOP
@@ -240,7 +313,8 @@ template <MappingType mappingType> SC_MODULE(Cache) {
     std::uint32_t doRead(const DecomposedAddress& decomposedAddr, Cacheline& cacheline,
                          std::uint32_t numBytes) noexcept;
     /**
-     * Reads data from bus written to by RAM and copies it into the corresponding cacheline
+     * Reads data from bus written to by RAM and copies it into the corresponding cacheline, counting the eviction of
+     * a line of another address space
      * */
     std::vector<Cacheline>::iterator writeRAMReadIntoCacheline(const DecomposedAddress& decomposedAddr) noexcept;
 
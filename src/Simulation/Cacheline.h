@@ -6,9 +6,14 @@
 struct Cacheline {
     bool isValid = false; // let's pretend this is a single bit
     std::uint32_t tag = 0;
+    std::uint16_t addressSpace = 0; // the ID of the process owning the line, part of its tag
     std::vector<std::uint8_t> data;
 };
 
+// see CachelineTable
+inline bool holdsTag(const Cacheline& cacheline) noexcept { return cacheline.isValid; }
+inline std::uint16_t addressSpaceOf(const Cacheline& cacheline) noexcept { return cacheline.addressSpace; }
+
 // Debug purposes
 static inline std::ostream& operator<<(std::ostream& os, const Cacheline& cacheline) {
     os << "Cacheline used: " << cacheline.isValid << "\n";
@@ -0,0 +1,212 @@
+#pragma once
+#include "DecomposedAddress.h"
+
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <systemc>
+
+enum class MappingType { Direct, Fully_Associative };
+
+// Enables the member templates of Cache and CachelineTable only meant for a certain MappingType
+template <MappingType actual, MappingType required>
+using OnlyForMapping = typename std::enable_if<actual == required, int>::type;
+
+// no victim of a replacement policy was out of range, see CachelineTable::getInvalidVictim
+constexpr std::uint64_t NO_INVALID_VICTIM{UINT64_MAX};
+
+/**
+ * Finds the cachelines of a cache, shared by Cache, L2Cache and CoherentCache: it decomposes addresses into tag, index
+ * and offset, looks up the line owned by an address and chooses the line a miss is filled into.
+ *
+ * A fully associative table finds its lines through a hash table keyed by the tag and the address space ID of the
+ * process owning the line (see Cache::setAddressSpaces, always 0 for the other caches). Its lines are filled up one by
+ * one and never become free again - not even when another cache invalidates them - so once all of them are used the
+ * replacement policy passed in chooses the victim. A policy loaded from a plugin may choose one out of range, which cannot
+ * be thrown through the SystemC kernel: the table stops the simulation instead and remembers it, see getInvalidVictim.
+ *
+ * LineType needs the members tag and data, and the free functions holdsTag (whether the tag of the line means anything)
+ * and addressSpaceOf have to be overloaded for it, see Cacheline.h.
+ */
+template <MappingType mappingType, typename LineType> class CachelineTable {
+  public:
+    using iterator = typename std::vector<LineType>::iterator;
+
+    /**
+     * @param[in] lines The cachelines of the cache, each holding cacheLineSize bytes. Have to outlive the table.
+     * @param[in] cacheLineSize The number of bytes a cacheline holds. Has to be > 0.
+     */
+    CachelineTable(std::vector<LineType>& lines, std::uint32_t cacheLineSize) noexcept
+        : lines{lines}, numCacheLines{static_cast<std::uint32_t>(lines.size())}, cacheLineSize{cacheLineSize} {
+        assert(numCacheLines > 0 && cacheLineSize > 0);
+        precomputeAddressDecompositionBits();
+    }
+
+    /**
+     * Use precomputed masks to decompose address into tag, index and offset
+     */
+    template <MappingType m = mappingType, OnlyForMapping<m, MappingType::Direct> = 0>
+    DecomposedAddress decomposeAddress(std::uint32_t address) const noexcept {
+        assert(addressOffsetBitMask > 0 && addressTagBitMask > 0);
+        return DecomposedAddress{((address >> addressOffsetBits) >> addressIndexBits) & addressTagBitMask,
+                                 ((address >> addressOffsetBits) & addressIndexBitMask) % numCacheLines,
+                                 (address & addressOffsetBitMask) % cacheLineSize};
+    }
+    template <MappingType m = mappingType, OnlyForMapping<m, MappingType::Fully_Associative> = 0>
+    DecomposedAddress decomposeAddress(std::uint32_t address) const noexcept {
+        assert(addressOffsetBitMask > 0 && addressIndexBitMask == 0 && addressTagBitMask > 0);
+        return DecomposedAddress{(address >> addressOffsetBits) & addressTagBitMask, 0,
+                                 (address & addressOffsetBitMask) % cacheLineSize};
+    }
+
+    /**
+     * Finds the cacheline holding the tag of the address for addressSpace. This does not wait, the caches pay for the
+     * hash table lookup themselves.
+     * @returns an iterator to the cacheline. Returns end() iterator if none found
+     */
+    template <MappingType m = mappingType, OnlyForMapping<m, MappingType::Direct> = 0>
+    iterator find(const DecomposedAddress& decomposedAddr, std::uint16_t addressSpace = 0) noexcept {
+        assert(decomposedAddr.index < lines.size());
+        auto cachelineExpectedAt = lines.begin() + decomposedAddr.index;
+        if (holdsTag(*cachelineExpectedAt) && cachelineExpectedAt->tag == decomposedAddr.tag &&
+            addressSpaceOf(*cachelineExpectedAt) == addressSpace) {
+            return cachelineExpectedAt;
+        } else {
+            return lines.end();
+        }
+    }
+    template <MappingType m = mappingType, OnlyForMapping<m, MappingType::Fully_Associative> = 0>
+    iterator find(const DecomposedAddress& decomposedAddr, std::uint16_t addressSpace = 0) noexcept {
+        const auto entry = lookupTable.find(lookupKeyOf(decomposedAddr.tag, addressSpace));
+        if (entry != lookupTable.end()) {
+            return lines.begin() + entry->second;
+        } else {
+            return lines.end();
+        }
+    }
+
+    /**
+     * Determines which cacheline a miss on the address of addressSpace is filled into and, if fully associative,
+     * enters it into the hash table as owned by it right away.
+     * @param[in] policy The replacement policy, unused (and may be null) if direct mapped
+     * @returns an iterator to the cacheline to be filled. Always a valid iterator
+     */
+    template <typename PolicyType, MappingType m = mappingType, OnlyForMapping<m, MappingType::Direct> = 0>
+    iterator chooseLineToFill(const DecomposedAddress& decomposedAddr, __attribute__((unused)) PolicyType* policy,
+                              __attribute__((unused)) std::uint16_t addressSpace = 0) {
+        assert(decomposedAddr.index < lines.size());
+        return lines.begin() + decomposedAddr.index; // there is only one possible space
+    }
+    template <typename PolicyType, MappingType m = mappingType, OnlyForMapping<m, MappingType::Fully_Associative> = 0>
+    iterator chooseLineToFill(const DecomposedAddress& decomposedAddr, PolicyType* policy,
+                              std::uint16_t addressSpace = 0) {
+        policy->logMiss(decomposedAddr.tag);
+        std::uint32_t line = 0;
+        if (lookupTable.numCacheLinesUsed != numCacheLines) {
+            line = lookupTable.numCacheLinesUsed++;
+        } else {
+            line = checkVictim(policy->pop(), numCacheLines);
+            forget(line);
+        }
+        return claim(line, decomposedAddr.tag, addressSpace);
+    }
+
+    /**
+     * Enters line into the hash table as owned by tag of addressSpace, for a cache choosing the line to fill itself
+     * @returns an iterator to the cacheline
+     */
+    template <MappingType m = mappingType, OnlyForMapping<m, MappingType::Fully_Associative> = 0>
+    iterator claim(std::uint32_t line, std::uint32_t tag, std::uint16_t addressSpace) {
+        lookupTable[lookupKeyOf(tag, addressSpace)] = line;
+        return lines.begin() + line;
+    }
+    // removes the entry of the tag line holds from the hash table, to be done before the line is claimed again
+    template <MappingType m = mappingType, OnlyForMapping<m, MappingType::Fully_Associative> = 0>
+    void forget(std::uint32_t line) noexcept {
+        lookupTable.erase(lookupKeyOf(lines[line].tag, addressSpaceOf(lines[line])));
+    }
+
+    /**
+     * Tells a stateful policy (e.g. LRU) of a fully associative cache that an operation was performed on cacheline. If
+     * direct mapped, this is a NOP
+     */
+    template <typename PolicyType, MappingType m = mappingType, OnlyForMapping<m, MappingType::Direct> = 0>
+    void registerUsage(__attribute__((unused)) iterator cacheline,
+                       __attribute__((unused)) PolicyType* policy) noexcept {
+        // no bookkeeping needed
+    }
+    template <typename PolicyType, MappingType m = mappingType, OnlyForMapping<m, MappingType::Fully_Associative> = 0>
+    void registerUsage(iterator cacheline, PolicyType* policy) noexcept {
+        policy->logUse(cacheline - lines.begin());
+    }
+
+    // the address of the first byte of the line held by cacheline
+    template <MappingType m = mappingType, OnlyForMapping<m, MappingType::Direct> = 0>
+    std::uint32_t lineAddressOf(typename std::vector<LineType>::const_iterator cacheline) const noexcept {
+        const auto index = static_cast<std::uint32_t>(cacheline - lines.cbegin());
+        return ((cacheline->tag << addressIndexBits) | index) << addressOffsetBits;
+    }
+    template <MappingType m = mappingType, OnlyForMapping<m, MappingType::Fully_Associative> = 0>
+    std::uint32_t lineAddressOf(typename std::vector<LineType>::const_iterator cacheline) const noexcept {
+        return cacheline->tag << addressOffsetBits;
+    }
+
+    /**
+     * Checks that the victim a replacement policy chose lies among the numLines lines it replaces. If not, it stops the
+     * simulation and remembers the victim for getInvalidVictim.
+     * @returns the victim, or line 0 to finish the request with if it is out of range
+     */
+    std::uint32_t checkVictim(std::uint32_t victim, std::uint32_t numLines) noexcept {
+        if (victim < numLines)
+            return victim;
+        if (invalidVictim == NO_INVALID_VICTIM)
+            invalidVictim = victim;
+        sc_core::sc_stop();
+        return 0;
+    }
+    // the first victim out of range a replacement policy chose, see checkVictim. NO_INVALID_VICTIM if there was none
+    std::uint64_t getInvalidVictim() const noexcept { return invalidVictim; }
+
+    // the number of bits of an address making up the tag
+    std::uint32_t tagBits() const noexcept { return addressTagBits; }
+
+  private:
+    std::vector<LineType>& lines;
+    const std::uint32_t numCacheLines;
+    const std::uint32_t cacheLineSize; // in Byte
+
+    struct Empty {}; // we only want to pay the price for having a hash-table if we need it
+    // keyed by the address space ID and the tag of the line, see lookupKeyOf
+    struct LookupTableType : std::conditional<mappingType == MappingType::Fully_Associative,
+                                              std::unordered_map<std::uint64_t, std::uint32_t>, Empty>::type {
+        std::uint32_t numCacheLinesUsed{0};
+    } lookupTable;
+    std::uint64_t invalidVictim{NO_INVALID_VICTIM};
+
+    std::uint32_t addressOffsetBits{0};
+    std::uint32_t addressIndexBits{0}; // no index bits in fully associative cache
+    std::uint32_t addressTagBits{0};
+    std::uint32_t addressOffsetBitMask{0};
+    std::uint32_t addressIndexBitMask{0};
+    std::uint32_t addressTagBitMask{0};
+
+    /**
+     * Precomputes what (and how many) bits of an address correspond to tag, index and offset. Furthermore preconstructs
+     * bit masks to extract those values.
+     */
+    void precomputeAddressDecompositionBits() noexcept {
+        addressOffsetBits = safeCeilLog2(cacheLineSize);
+        addressIndexBits = mappingType == MappingType::Direct ? safeCeilLog2(numCacheLines) : 0;
+        addressTagBits = 32 - addressIndexBits - addressOffsetBits;
+        addressOffsetBitMask = generateBitmaskForLowestNBits(addressOffsetBits);
+        addressIndexBitMask = generateBitmaskForLowestNBits(addressIndexBits);
+        addressTagBitMask = generateBitmaskForLowestNBits(addressTagBits);
+    }
+
+    static std::uint64_t lookupKeyOf(std::uint32_t tag, std::uint16_t addressSpace) noexcept {
+        return static_cast<std::uint64_t>(addressSpace) << 32 | tag;
+    }
+};
@@ -0,0 +1,96 @@
+#include "ClockDomainBridge.h"
+
+#include <cassert>
+
+ClockDomainBridge::ClockDomainBridge(sc_core::sc_module_name name, std::uint32_t readsPerCacheline,
+                                     std::uint32_t synchronizerStages)
+    : sc_module{name}, readsPerCacheline{readsPerCacheline}, synchronizerStages{synchronizerStages},
+      beatsRead(readsPerCacheline) {
+    using namespace sc_core;
+    assert(synchronizerStages > 0);
+
+    SC_THREAD(passRequests);
+    sensitive << clock.pos();
+    dont_initialize();
+    SC_THREAD(sendRequests);
+    sensitive << memoryClock.neg();
+}
+
+// ============= Requester domain =============
+
+void ClockDomainBridge::passRequests() noexcept {
+    while (true) {
+        wait();
+        readyBus.write(false);
+
+        if (!validRequestBus.read())
+            continue;
+
+        requestAddr = addressBus.read();
+        requestData = dataInBus.read();
+        requestWe = weBus.read();
+        isRequestHandedOver = true;
+
+        do {
+            wait();
+        } while (!isResultHandedBack);
+        waitForSynchronizer();
+        isResultHandedBack = false;
+
+        passResultToRequester();
+    }
+}
+
+void ClockDomainBridge::passResultToRequester() noexcept {
+    if (requestWe) {
+        readyBus.write(true);
+        return;
+    }
+    // like the RAM, one beat per cycle - the wait at the beginning of passRequests takes care of the last one
+    for (std::uint32_t i = 0; i < readsPerCacheline; ++i) {
+        dataOutBus.write(beatsRead[i]);
+        readyBus.write(true);
+        if (i != readsPerCacheline - 1)
+            wait();
+    }
+}
+
+// ============= Memory domain =============
+
+void ClockDomainBridge::sendRequests() noexcept {
+    while (true) {
+        wait();
+        if (!isRequestHandedOver)
+            continue;
+
+        waitForSynchronizer();
+        isRequestHandedOver = false;
+        sendRequestToMemory();
+        isResultHandedBack = true;
+    }
+}
+
+void ClockDomainBridge::sendRequestToMemory() noexcept {
+    memoryAddrBus.write(requestAddr);
+    memoryDataOutBus.write(requestData);
+    memoryWeBus.write(requestWe);
+    memoryValidRequestBus.write(true);
+    while (!memoryReadyBus.read()) {
+        wait();
+    }
+    memoryValidRequestBus.write(false);
+
+    if (requestWe)
+        return;
+    // don't need to wait before the first one because we can only get here if the memory tells us it is ready
+    for (std::uint32_t i = 0; i < readsPerCacheline; ++i) {
+        beatsRead[i] = memoryDataInBus.read();
+        wait();
+    }
+}
+
+void ClockDomainBridge::waitForSynchronizer() noexcept {
+    for (std::uint32_t stage = 1; stage < synchronizerStages; ++stage) {
+        wait();
+    }
+}
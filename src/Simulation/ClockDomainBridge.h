@@ -0,0 +1,84 @@
+#pragma once
+#include "BusBeat.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <systemc>
+
+/**
+ * This module passes memory requests from one clock domain to another, e.g. from the L1 caches running on the core
+ * clock to a RAM running on the slower memory clock. Connecting the two sides directly does not work: the protocol
+ * relies on both sides seeing the same edges, a ready held for one cycle of a slow memory being seen on several edges
+ * of a fast cache and vice versa.
+ *
+ * Towards the requester it behaves like a RAM on the requester clock (clock), towards the memory like a write buffer on
+ * the memory clock (memoryClock). A request is taken over from the requester and handed to the memory domain, which
+ * sends it to the memory and collects the beats of a read. The result is then handed back and passed on to the
+ * requester like a RAM does, with ready up for one cycle of a write or for all beats of a read. Every handover passes
+ * a synchronizer of synchronizerStages flip-flops, i.e. takes that many cycles of the receiving clock.
+ *
+ * A single request is in flight at a time. Writes are done once the memory has them, as words of a burst write are sent
+ * separately, the memory only pays its latency for every one of them.
+ */
+SC_MODULE(ClockDomainBridge) {
+  public:
+    // Requester domain
+    sc_core::sc_in<bool> SC_NAMED(clock);
+
+    // Requester -> Bridge
+    sc_core::sc_in<std::uint32_t> SC_NAMED(dataInBus);
+    sc_core::sc_in<std::uint32_t> SC_NAMED(addressBus);
+    sc_core::sc_in<bool> SC_NAMED(weBus);
+    sc_core::sc_in<bool> SC_NAMED(validRequestBus);
+
+    // Bridge -> Requester
+    sc_core::sc_out<BusBeat> SC_NAMED(dataOutBus);
+    sc_core::sc_out<bool> SC_NAMED(readyBus);
+
+    // Memory domain
+    sc_core::sc_in<bool> SC_NAMED(memoryClock);
+
+    // Bridge -> Memory
+    sc_core::sc_out<std::uint32_t> SC_NAMED(memoryAddrBus);
+    sc_core::sc_out<std::uint32_t> SC_NAMED(memoryDataOutBus);
+    sc_core::sc_out<bool> SC_NAMED(memoryWeBus);
+    sc_core::sc_out<bool> SC_NAMED(memoryValidRequestBus);
+
+    // Memory -> Bridge
+    sc_core::sc_in<BusBeat> SC_NAMED(memoryDataInBus);
+    sc_core::sc_in<bool> SC_NAMED(memoryReadyBus);
+
+    /**
+     * @param[in] readsPerCacheline The number of 128 bit beats of a read.
+     * @param[in] synchronizerStages The cycles of the receiving clock a handover takes. Has to be > 0.
+     */
+    ClockDomainBridge(sc_core::sc_module_name name, std::uint32_t readsPerCacheline, std::uint32_t synchronizerStages);
+
+  private:
+    SC_CTOR(ClockDomainBridge);
+
+    const std::uint32_t readsPerCacheline;
+    const std::uint32_t synchronizerStages;
+
+    // the request handed over to the memory domain
+    std::uint32_t requestAddr = 0;
+    std::uint32_t requestData = 0;
+    bool requestWe = false;
+    bool isRequestHandedOver = false;
+
+    // the result handed back to the requester domain
+    std::vector<BusBeat> beatsRead;
+    bool isResultHandedBack = false;
+
+    // ============= Requester domain =============
+    void passRequests() noexcept;
+    void passResultToRequester() noexcept;
+
+    // ============= Memory domain =============
+    void sendRequests() noexcept;
+    void sendRequestToMemory() noexcept;
+
+    // waits out the remaining stages of a synchronizer once the first has seen the handover
+    void waitForSynchronizer() noexcept;
+};
@@ -0,0 +1,176 @@
+#include "CoherentCache.h"
+#include <stdexcept>
+
+using namespace sc_core;
+
+template <MappingType mappingType> void CoherentCache<mappingType>::waitOutLookupLatency() noexcept {
+    for (std::size_t i = 0; i < cacheLatency; ++i) {
+        wait();
+    }
+    if (mappingType == MappingType::Fully_Associative) {
+        // same hash table penalty as in the fully associative L1, see hashTableLookupCyclesAt
+        for (std::uint32_t i = 0; i < hashTableLookupCycles; ++i) {
+            wait();
+        }
+    }
+}
+
+template <MappingType mappingType> void CoherentCache<mappingType>::setClockPeriod(const sc_time& period) noexcept {
+    hashTableLookupCycles = hashTableLookupCyclesAt(period);
+}
+
+template <MappingType mappingType> void CoherentCache<mappingType>::zeroInitialiseCachelines() noexcept {
+    for (auto& cacheline : cacheInternal) {
+        cacheline.data = std::vector<std::uint8_t>(cacheLineSize, 0);
+    }
+}
+
+template <MappingType mappingType>
+CoherentCache<mappingType>::CoherentCache(sc_module_name name, SnoopingBus& bus, std::uint32_t numCacheLines,
+                                          std::uint32_t cacheLineSize, std::uint32_t cacheLatency,
+                                          std::unique_ptr<ReplacementPolicy<std::uint32_t>> policy)
+    : sc_module{name}, numCacheLines{numCacheLines}, cacheLineSize{cacheLineSize}, cacheLatency{cacheLatency},
+      replacementPolicy{std::move(policy)}, cacheInternal{numCacheLines}, bus{bus} {
+    if (replacementPolicy == nullptr && mappingType == MappingType::Fully_Associative) {
+        throw std::invalid_argument("Replacement Policy must be set for fully associative cache.");
+    }
+    // taken care of in C part
+    assert(cacheLineSize > 0 && cacheLineSize % RAM_READ_BUS_SIZE_IN_BYTE == 0 && numCacheLines > 0);
+
+    zeroInitialiseCachelines();
+    busId = bus.attach(*this);
+
+    SC_THREAD(handleRequest);
+    sensitive << clock.pos();
+}
+
+template <MappingType mappingType> void CoherentCache<mappingType>::handleRequest() noexcept {
+    while (true) {
+        wait();
+        ready.write(false);
+
+        if (!cpuValidRequest.read())
+            continue;
+        const Request request{cpuAddrBus.read(), cpuDataInBus.read(), cpuWeBus.read()};
+        const auto subRequests = splitRequestIntoSubRequests(request, cacheLineSize);
+
+        std::uint32_t readData = 0;
+        for (const auto& subRequest : subRequests) {
+            handleSubRequest(subRequest, readData);
+        }
+
+        if (!request.we) {
+            cpuDataOutBus.write(readData);
+        }
+        ready.write(true);
+    }
+}
+
+template <MappingType mappingType>
+void CoherentCache<mappingType>::handleSubRequest(const SubRequest& subRequest, std::uint32_t& readData) noexcept {
+    const auto decomposedAddr = lineTable.decomposeAddress(subRequest.addr);
+    waitOutLookupLatency();
+
+    auto cacheline = lineTable.find(decomposedAddr);
+    const bool isPresent = cacheline != cacheInternal.end() && cacheline->state != CoherenceState::Invalid;
+    if (isPresent) {
+        ++hitCount;
+    } else {
+        ++missCount;
+        if (cacheline != cacheInternal.end() && cacheline->wasInvalidated)
+            ++coherenceMissCount;
+    }
+    // a write to a Shared line still has to invalidate all other copies first, even though it hits
+    if (!isPresent || (subRequest.we && cacheline->state == CoherenceState::Shared)) {
+        requestLine(subRequest.addr, subRequest.we);
+        cacheline = lineTable.find(decomposedAddr);
+    }
+    assert(cacheline != cacheInternal.end() && cacheline->state != CoherenceState::Invalid);
+    lineTable.registerUsage(cacheline, replacementPolicy.get());
+
+    // from here on until the next wait the bus cannot take the line away again
+    if (subRequest.we) {
+        assert(cacheline->state != CoherenceState::Shared);
+        for (std::size_t byteNr = 0; byteNr < subRequest.size; ++byteNr) {
+            cacheline->data[decomposedAddr.offset + byteNr] = (subRequest.data >> (byteNr * BITS_IN_BYTE)) & 0xFF;
+        }
+        cacheline->state = CoherenceState::Modified;
+    } else {
+        std::uint32_t lineData = 0;
+        for (std::size_t byteNr = 0; byteNr < subRequest.size; ++byteNr) {
+            lineData += cacheline->data[decomposedAddr.offset + byteNr] << (byteNr * BITS_IN_BYTE);
+        }
+        readData = applyPartialRead(subRequest, readData, lineData);
+    }
+}
+
+template <MappingType mappingType>
+void CoherentCache<mappingType>::requestLine(std::uint32_t addr, bool wantsExclusive) noexcept {
+    BusTransaction transaction;
+    transaction.lineAddress = (addr / cacheLineSize) * cacheLineSize;
+    transaction.wantsExclusive = wantsExclusive;
+    bus.post(busId, transaction);
+    do {
+        wait();
+    } while (!bus.isDone(busId));
+}
+
+template <MappingType mappingType> void CoherentCache<mappingType>::prepare(BusTransaction& transaction) {
+    const auto decomposedAddr = lineTable.decomposeAddress(transaction.lineAddress);
+    auto cacheline = lineTable.find(decomposedAddr);
+    if (cacheline != cacheInternal.end() && cacheline->state != CoherenceState::Invalid) {
+        // only a write to a Shared line asks for a line it already has
+        assert(transaction.wantsExclusive && cacheline->state == CoherenceState::Shared);
+        transaction.operation = BusOperation::Upgrade;
+        lineBeingFilled = cacheline - cacheInternal.begin();
+        return;
+    }
+
+    transaction.operation = transaction.wantsExclusive ? BusOperation::ReadExclusive : BusOperation::Read;
+    if (cacheline == cacheInternal.end()) { // an invalidated line keeps its place, anything else needs room
+        cacheline = lineTable.chooseLineToFill(decomposedAddr, replacementPolicy.get());
+        transaction.hasWriteBack = cacheline->state == CoherenceState::Modified;
+        if (transaction.hasWriteBack) {
+            transaction.writeBackAddress = lineTable.lineAddressOf(cacheline);
+            transaction.writeBackLine = cacheline->data;
+        }
+    }
+    cacheline->state = CoherenceState::Invalid;
+    cacheline->wasInvalidated = false;
+    cacheline->tag = decomposedAddr.tag;
+    lineBeingFilled = cacheline - cacheInternal.begin();
+}
+
+template <MappingType mappingType>
+bool CoherentCache<mappingType>::snoop(BusOperation operation, std::uint32_t lineAddress,
+                                       std::vector<std::uint8_t>& line, bool& wasModified) {
+    auto cacheline = lineTable.find(lineTable.decomposeAddress(lineAddress));
+    if (cacheline == cacheInternal.end() || cacheline->state == CoherenceState::Invalid)
+        return false;
+
+    wasModified = cacheline->state == CoherenceState::Modified;
+    if (wasModified)
+        line = cacheline->data;
+    if (operation == BusOperation::Read) {
+        cacheline->state = CoherenceState::Shared;
+    } else {
+        cacheline->state = CoherenceState::Invalid;
+        cacheline->wasInvalidated = true;
+    }
+    return true;
+}
+
+template <MappingType mappingType> void CoherentCache<mappingType>::complete(const BusTransaction& transaction) {
+    auto& cacheline = cacheInternal[lineBeingFilled];
+    if (transaction.operation != BusOperation::Upgrade)
+        cacheline.data = transaction.line;
+    if (transaction.operation == BusOperation::Read) {
+        cacheline.state = transaction.isShared ? CoherenceState::Shared : CoherenceState::Exclusive;
+    } else {
+        cacheline.state = CoherenceState::Modified; // the write that asked for it follows right away
+    }
+}
+
+// here to allow the move of function definitions to cpp
+template struct CoherentCache<MappingType::Direct>;
+template struct CoherentCache<MappingType::Fully_Associative>;
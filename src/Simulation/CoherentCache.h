@@ -0,0 +1,139 @@
+#pragma once
+
+#include "Cache.h"
+#include "CachelineTable.h"
+#include "DecomposedAddress.h"
+#include "Policy/ReplacementPolicy.h"
+#include "SnoopingBus.h"
+#include "SubRequest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <systemc>
+
+// the MESI state of a line in a CoherentCache
+enum class CoherenceState { Invalid, Shared, Exclusive, Modified };
+
+struct CoherentCacheline {
+    CoherenceState state = CoherenceState::Invalid;
+    bool wasInvalidated = false; // by another cache, the next miss on its tag is a coherence miss
+    std::uint32_t tag = 0;
+    std::vector<std::uint8_t> data;
+};
+
+// see CachelineTable. A line another cache invalidated keeps its tag, only one never filled holds none
+inline bool holdsTag(const CoherentCacheline& cacheline) noexcept {
+    return cacheline.state != CoherenceState::Invalid || cacheline.wasInvalidated;
+}
+inline std::uint16_t addressSpaceOf(__attribute__((unused)) const CoherentCacheline& cacheline) noexcept { return 0; }
+
+/**
+ * This module represents the private L1 data cache of one core of a multicore system. Towards the CPU it looks exactly
+ * like a Cache (same ports, same protocol), but instead of a RAM it talks to the other caches and the shared memory
+ * through a SnoopingBus, which keeps all of them coherent with the MESI protocol.
+ *
+ * Unlike the Cache it is write-back and write-allocate: every line is in one of the states
+ * - Modified: the only copy, differs from memory
+ * - Exclusive: the only copy, equals memory
+ * - Shared: one of several copies, all of them equal memory
+ * - Invalid: not present
+ * A read hits on any valid line. A write hits on a Modified or Exclusive line only, turning it Modified. Any other
+ * access posts a transaction on the bus and waits for it to be done: Read for a read, ReadExclusive for a write and
+ * Upgrade for a write to a Shared line, which still counts as a hit. Modified lines are only written to memory when
+ * they are evicted or another cache reads them.
+ *
+ * A miss on a line another cache invalidated, that would have been a hit otherwise, is counted as a coherence miss.
+ *
+ * All operations towards the CPU happen on rising clock edge, the bus calls the Snooper side on falling clock edge.
+ */
+template <MappingType mappingType> SC_MODULE(CoherentCache), public Snooper {
+  public:
+    // ====================================== External Ports  ======================================
+    // Global Clock
+    sc_core::sc_in<bool> SC_NAMED(clock);
+
+    // CPU -> Cache
+    sc_core::sc_in<std::uint32_t> SC_NAMED(cpuAddrBus);
+    sc_core::sc_in<std::uint32_t> SC_NAMED(cpuDataInBus);
+    sc_core::sc_in<bool> SC_NAMED(cpuWeBus);
+    sc_core::sc_in<bool> SC_NAMED(cpuValidRequest);
+
+    // Cache -> CPU
+    sc_core::sc_out<bool> SC_NAMED(ready);
+    sc_core::sc_out<std::uint32_t> SC_NAMED(cpuDataOutBus);
+
+    // ====================================== Hit/Miss Bookkeeping  ======================================
+    std::uint64_t hitCount{0};
+    std::uint64_t missCount{0};
+    std::uint64_t coherenceMissCount{0}; // part of missCount
+
+  private:
+    // ====================================== Config  ======================================
+    std::uint32_t numCacheLines{0};
+    std::uint32_t cacheLineSize{0}; // in Byte
+    std::uint32_t cacheLatency{0};  // in Cycles
+    std::uint32_t hashTableLookupCycles{2}; // on top of the cacheLatency, see setClockPeriod
+    std::unique_ptr<ReplacementPolicy<std::uint32_t>> replacementPolicy{nullptr};
+
+    // ====================================== Internals ======================================
+    std::vector<CoherentCacheline> cacheInternal;
+    // finds lines that another cache invalidated too, see holdsTag
+    CachelineTable<mappingType, CoherentCacheline> lineTable{cacheInternal, cacheLineSize};
+    SnoopingBus& bus;
+    std::size_t busId{0};
+    std::size_t lineBeingFilled{0}; // by the transaction on the bus, see prepare
+
+  public:
+    /**
+     * Constructs a coherent L1 data cache and attaches it to the bus.
+     * @param[in] name  The name systemc assigns to this module.
+     * @param[in] bus The bus connecting the cache to the other caches and the shared memory.
+     * @param[in] numCacheLines The number of cache lines the cache will have. Has to be > 0.
+     * @param[in] cacheLineSize The number of bytes a cacheline holds. Has to be a multiple of the memory bus size 16B.
+     * @param[in] cacheLatency The number of cycles the cache takes to find out whether an access results in a hit or a
+     * miss.
+     * @param[in] policy The replacement policy. Only relevant (and then required) if MappingType is Fully_Associative.
+     */
+    CoherentCache(sc_core::sc_module_name name, SnoopingBus & bus, std::uint32_t numCacheLines,
+                  std::uint32_t cacheLineSize, std::uint32_t cacheLatency,
+                  std::unique_ptr<ReplacementPolicy<std::uint32_t>> policy = nullptr);
+
+    /**
+     * Sets the period of the clock the cache runs on (default: 1 ns), see Cache::setClockPeriod
+     * @param[in] period The period of the clock the cache runs on
+     */
+    void setClockPeriod(const sc_core::sc_time& period) noexcept;
+
+    // see Cache::getInvalidVictim
+    std::uint64_t getInvalidVictim() const noexcept { return lineTable.getInvalidVictim(); }
+
+    // ====================================== Snooper ======================================
+    void prepare(BusTransaction & transaction) override;
+    bool snoop(BusOperation operation, std::uint32_t lineAddress, std::vector<std::uint8_t> & line,
+               bool& wasModified) override;
+    void complete(const BusTransaction& transaction) override;
+
+  private:
+    // ====================================== Set-Up ======================================
+    SC_CTOR(CoherentCache); // private since this is never to be called, just to get systemc typedef
+
+    void zeroInitialiseCachelines() noexcept;
+
+    // ====================================== Serving the CPU ======================================
+    void handleRequest() noexcept;
+    void handleSubRequest(const SubRequest& subRequest, std::uint32_t & readData) noexcept;
+    /**
+     * Posts a transaction for the line the address lies in and waits for the bus to complete it.
+     * @param[in] wantsExclusive Whether the line is needed for a write
+     */
+    void requestLine(std::uint32_t addr, bool wantsExclusive) noexcept;
+
+    // ====================================== Waiting Helpers ======================================
+    /**
+     * Sleeps for cacheLatency cycles (plus the hash table penalty if fully associative)
+     */
+    void waitOutLookupLatency() noexcept;
+};
@@ -1,15 +1,111 @@
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <systemc>
 
 #include "../Request.h"
+#include "../SimulationOptions.h"
 #include "CPU.h"
 #include "Cache.h"
+#include "ClockDomainBridge.h"
+#include "CoherentCache.h"
+#include "DRAM.h"
 #include "InstructionCache.h"
+#include "L2Cache.h"
+#include "MemoryController.h"
 #include "RAM.h"
+#include "SnoopingBus.h"
+
+/**
+ * The signals between a requester and a memory, named name + "_Address" etc.
+ */
+struct MemoryBus {
+    // Requester -> Memory
+    sc_core::sc_signal<std::uint32_t> address;
+    sc_core::sc_signal<std::uint32_t> data;
+    sc_core::sc_signal<bool> we;
+    sc_core::sc_signal<bool> validRequest;
+
+    // Memory -> Requester
+    sc_core::sc_signal<BusBeat> beat;
+    sc_core::sc_signal<bool> ready;
+
+    bool isUsed = false; // set once something was connected through it
+
+    explicit MemoryBus(const std::string& name)
+        : address{(name + "_Address").c_str()}, data{(name + "_Data").c_str()}, we{(name + "_WE").c_str()},
+          validRequest{(name + "_Valid_Request").c_str()}, beat{(name + "_Beat").c_str()},
+          ready{(name + "_Ready").c_str()} {}
+};
+
+/**
+ * The signals of one core of a multicore system, named prefix + "_Data_Address" etc.: between its CPU and its caches
+ * and behind its instruction cache, which has a memory of its own.
+ */
+struct CoreSignals {
+    // CPU -> Data Cache
+    sc_core::sc_signal<std::uint32_t> dataAddress;
+    sc_core::sc_signal<std::uint32_t> dataOut;
+    sc_core::sc_signal<bool> dataWe;
+    sc_core::sc_signal<bool> dataValidRequest;
+    sc_core::sc_signal<std::uint16_t> dataAddressSpace; // not read, the coherent data cache has a single address space
+
+    // Data Cache -> CPU
+    sc_core::sc_signal<std::uint32_t> dataIn;
+    sc_core::sc_signal<bool> dataReady;
+
+    // CPU -> Instruction Cache
+    sc_core::sc_signal<std::uint32_t> pc;
+    sc_core::sc_signal<bool> instrValidRequest;
+    sc_core::sc_signal<std::uint16_t> instrAddressSpace; // always 0, a core runs a single process
+
+    // Instruction Cache -> CPU
+    sc_core::sc_signal<Request> instruction;
+    sc_core::sc_signal<bool> instrReady;
+
+    MemoryBus instrMemory;   // behind the instruction cache
+    MemoryBus instrCrossing; // behind the bridge into the memory clock domain, if there is one
+
+    explicit CoreSignals(const std::string& prefix)
+        : dataAddress{(prefix + "_Data_Address").c_str()}, dataOut{(prefix + "_Data_Out").c_str()},
+          dataWe{(prefix + "_Data_WE").c_str()}, dataValidRequest{(prefix + "_Data_Valid_Request").c_str()},
+          dataAddressSpace{(prefix + "_Data_Address_Space").c_str()},
+          dataIn{(prefix + "_Data_In").c_str()}, dataReady{(prefix + "_Data_Ready").c_str()},
+          pc{(prefix + "_PC").c_str()}, instrValidRequest{(prefix + "_Instr_Valid_Request").c_str()},
+          instrAddressSpace{(prefix + "_Instr_Address_Space").c_str()},
+          instruction{(prefix + "_Instruction").c_str()}, instrReady{(prefix + "_Instr_Ready").c_str()},
+          instrMemory{prefix + "_instrMemory"}, instrCrossing{prefix + "_instrCrossing"} {}
+};
 
 struct Connections {
-    sc_core::sc_clock SC_NAMED(clk, sc_core::sc_time(1, sc_core::SC_NS));
+    // the core clock of the CPU and the L1 caches
+    sc_core::sc_clock clk;
+
+    /**
+     * @param[in] clocks The periods of the clock domains, see ClockOptions. Only clocks with a period of their own are
+     * created, the others are shared.
+     */
+    explicit Connections(const ClockOptions& clocks = ClockOptions{})
+        : clk{"clk", sc_core::sc_time::from_value(clocks.corePeriod == 0 ? 1000 : clocks.corePeriod)} {
+        const sc_core::sc_time cachePeriod = periodOr(clocks.cachePeriod, clk);
+        if (cachePeriod != clk.period())
+            ownCacheClock = std::make_unique<sc_core::sc_clock>("cache_clk", cachePeriod);
+        const sc_core::sc_time memoryPeriod = periodOr(clocks.memoryPeriod, clk);
+        if (memoryPeriod != clk.period() && memoryPeriod != cacheClock().period())
+            ownMemoryClock = std::make_unique<sc_core::sc_clock>("memory_clk", memoryPeriod);
+        else if (memoryPeriod != clk.period())
+            sharesCacheClock = true;
+    }
+
+    // the clock of the L2
+    sc_core::sc_clock& cacheClock() noexcept { return ownCacheClock ? *ownCacheClock : clk; }
+    // the clock of the memory and its controller
+    sc_core::sc_clock& memoryClock() noexcept {
+        return ownMemoryClock ? *ownMemoryClock : (sharesCacheClock ? cacheClock() : clk);
+    }
 
     // Data Cache
     // CPU -> Cache
@@ -17,6 +113,7 @@ struct Connections {
     sc_core::sc_signal<std::uint32_t> SC_NAMED(CPU_to_dataCache_Data);
     sc_core::sc_signal<bool> SC_NAMED(CPU_to_dataCache_WE);
     sc_core::sc_signal<bool, sc_core::SC_MANY_WRITERS> SC_NAMED(CPU_to_dataCache_Valid_Request);
+    sc_core::sc_signal<std::uint16_t> SC_NAMED(CPU_to_dataCache_Address_Space);
 
     // Cache -> CPU
     sc_core::sc_signal<std::uint32_t> SC_NAMED(dataCache_to_CPU_Data);
@@ -29,13 +126,14 @@ struct Connections {
     sc_core::sc_signal<bool, sc_core::SC_MANY_WRITERS> SC_NAMED(dataCache_to_dataRAM_Valid_Request);
 
     // RAM -> Cache
-    sc_core::sc_signal<sc_dt::sc_bv<128>> SC_NAMED(dataRAM_to_dataCache_Data);
+    sc_core::sc_signal<BusBeat> SC_NAMED(dataRAM_to_dataCache_Data);
     sc_core::sc_signal<bool> SC_NAMED(dataRAM_to_dataCache_Ready);
 
     // Instruction Cache
     // CPU -> Cache
     sc_core::sc_signal<std::uint32_t> SC_NAMED(CPU_to_instrCache_PC);
     sc_core::sc_signal<bool> SC_NAMED(CPU_to_instrCache_Valid_Request);
+    sc_core::sc_signal<std::uint16_t> SC_NAMED(CPU_to_instrCache_Address_Space);
 
     // Cache -> CPU
     sc_core::sc_signal<Request> SC_NAMED(instrCache_to_CPU_Instruction);
@@ -48,90 +146,365 @@ struct Connections {
     sc_core::sc_signal<bool> SC_NAMED(instrCache_to_instrRAM_Valid_Request);
 
     // RAM -> Cache
-    sc_core::sc_signal<sc_dt::sc_bv<128>> SC_NAMED(instrRAM_to_instrCache_Data);
+    sc_core::sc_signal<BusBeat> SC_NAMED(instrRAM_to_instrCache_Data);
     sc_core::sc_signal<bool> SC_NAMED(instrRAM_to_instrCache_Ready);
+
+    // Unified L2 - only used if there is one. In that case the dataRAM and instrRAM signals above connect the L1 caches
+    // to the L2 instead of to their own RAM
+    // L2 -> RAM
+    sc_core::sc_signal<std::uint32_t, sc_core::SC_MANY_WRITERS> SC_NAMED(L2_to_RAM_Address);
+    sc_core::sc_signal<std::uint32_t> SC_NAMED(L2_to_RAM_Data);
+    sc_core::sc_signal<bool, sc_core::SC_MANY_WRITERS> SC_NAMED(L2_to_RAM_WE);
+    sc_core::sc_signal<bool, sc_core::SC_MANY_WRITERS> SC_NAMED(L2_to_RAM_Valid_Request);
+
+    // RAM -> L2
+    sc_core::sc_signal<BusBeat> SC_NAMED(RAM_to_L2_Data);
+    sc_core::sc_signal<bool> SC_NAMED(RAM_to_L2_Ready);
+
+    // Clock domain crossings - only used if the clocks differ. A bridge takes the place of the memory of a requester in
+    // the signals above, and these connect it to the memory in the other domain
+    MemoryBus dataCrossing{"dataCrossing"};   // behind the data cache or in front of the data side of the L2
+    MemoryBus instrCrossing{"instrCrossing"}; // behind the instruction cache or in front of its side of the L2
+    MemoryBus memoryCrossing{"memoryCrossing"}; // behind the L2, in front of the memory (controller)
+
+    // Multicore - only used if there are several cores. Their data caches share the memory behind a snooping bus
+    // instead of using the data cache signals above, each core has signals of its own
+    MemoryBus sharedMemory{"sharedMemory"}; // behind the snooping bus, in front of the memory (controller) or a bridge
+    std::vector<std::unique_ptr<CoreSignals>> cores;
+
+    // Memory Controller - only used if there is one. In that case it takes the place of the data RAM (or of the RAM
+    // behind the L2) in the signals above, and these connect it to the actual RAM
+    // Controller -> RAM
+    sc_core::sc_signal<std::uint32_t> SC_NAMED(controller_to_RAM_Address);
+    sc_core::sc_signal<std::uint32_t> SC_NAMED(controller_to_RAM_Data);
+    sc_core::sc_signal<bool> SC_NAMED(controller_to_RAM_WE);
+    sc_core::sc_signal<bool> SC_NAMED(controller_to_RAM_Valid_Request);
+
+    // RAM -> Controller
+    sc_core::sc_signal<BusBeat> SC_NAMED(RAM_to_controller_Data);
+    sc_core::sc_signal<bool> SC_NAMED(RAM_to_controller_Ready);
+
+  private:
+    std::unique_ptr<sc_core::sc_clock> ownCacheClock;
+    std::unique_ptr<sc_core::sc_clock> ownMemoryClock;
+    bool sharesCacheClock = false;
+
+    static sc_core::sc_time periodOr(unsigned int period, const sc_core::sc_clock& clock) {
+        return period == 0 ? clock.period() : sc_core::sc_time::from_value(period);
+    }
 };
 
-template <MappingType mappingType>
-inline std::unique_ptr<Connections> connectComponents(CPU& cpu, RAM& dataRam, RAM& instructionRam,
-                                                      Cache<mappingType>& dataCache,
-                                                      InstructionCache& instructionCache) {
-    auto connections = std::make_unique<Connections>();
+template <MappingType mappingType, typename PolicyType>
+inline void connectCPUToCaches(Connections& connections, CPU& cpu, Cache<mappingType, PolicyType>& dataCache,
+                               InstructionCache& instructionCache) {
     // Data Cache
     // CPU -> Cache
-    cpu.addressBus(connections->CPU_to_dataCache_Address);
-    cpu.dataOutBus(connections->CPU_to_dataCache_Data);
-    cpu.weBus(connections->CPU_to_dataCache_WE);
-    cpu.validDataRequestBus(connections->CPU_to_dataCache_Valid_Request);
+    cpu.addressBus(connections.CPU_to_dataCache_Address);
+    cpu.dataOutBus(connections.CPU_to_dataCache_Data);
+    cpu.weBus(connections.CPU_to_dataCache_WE);
+    cpu.validDataRequestBus(connections.CPU_to_dataCache_Valid_Request);
+    cpu.addressSpaceBus(connections.CPU_to_dataCache_Address_Space);
 
-    dataCache.cpuAddrBus(connections->CPU_to_dataCache_Address);
-    dataCache.cpuDataInBus(connections->CPU_to_dataCache_Data);
-    dataCache.cpuWeBus(connections->CPU_to_dataCache_WE);
-    dataCache.cpuValidRequest(connections->CPU_to_dataCache_Valid_Request);
+    dataCache.cpuAddrBus(connections.CPU_to_dataCache_Address);
+    dataCache.cpuDataInBus(connections.CPU_to_dataCache_Data);
+    dataCache.cpuWeBus(connections.CPU_to_dataCache_WE);
+    dataCache.cpuValidRequest(connections.CPU_to_dataCache_Valid_Request);
+    dataCache.cpuAddressSpaceBus(connections.CPU_to_dataCache_Address_Space);
 
     // Cache -> CPU
-    cpu.dataInBus(connections->dataCache_to_CPU_Data);
-    cpu.dataReadyBus(connections->dataCache_to_CPU_Ready);
+    cpu.dataInBus(connections.dataCache_to_CPU_Data);
+    cpu.dataReadyBus(connections.dataCache_to_CPU_Ready);
 
-    dataCache.cpuDataOutBus(connections->dataCache_to_CPU_Data);
-    dataCache.ready(connections->dataCache_to_CPU_Ready);
+    dataCache.cpuDataOutBus(connections.dataCache_to_CPU_Data);
+    dataCache.ready(connections.dataCache_to_CPU_Ready);
 
-    // Cache -> RAM
-    dataRam.addressBus(connections->dataCache_to_dataRAM_Address);
-    dataRam.dataInBus(connections->dataCache_to_dataRAM_Data);
-    dataRam.weBus(connections->dataCache_to_dataRAM_WE);
-    dataRam.validRequestBus(connections->dataCache_to_dataRAM_Valid_Request);
+    // Instruction Cache
+    // CPU -> Cache
+    cpu.pcBus(connections.CPU_to_instrCache_PC);
+    cpu.validInstrRequestBus(connections.CPU_to_instrCache_Valid_Request);
+    cpu.instrAddressSpaceBus(connections.CPU_to_instrCache_Address_Space);
 
-    dataCache.memoryAddrBus(connections->dataCache_to_dataRAM_Address);
-    dataCache.memoryDataOutBus(connections->dataCache_to_dataRAM_Data);
-    dataCache.memoryWeBus(connections->dataCache_to_dataRAM_WE);
-    dataCache.memoryValidRequestBus(connections->dataCache_to_dataRAM_Valid_Request);
+    instructionCache.pcBus(connections.CPU_to_instrCache_PC);
+    instructionCache.validInstrRequestBus(connections.CPU_to_instrCache_Valid_Request);
+    instructionCache.addressSpaceBus(connections.CPU_to_instrCache_Address_Space);
 
-    // RAM -> Cache
-    dataRam.dataOutBus(connections->dataRAM_to_dataCache_Data);
-    dataRam.readyBus(connections->dataRAM_to_dataCache_Ready);
+    // Cache -> CPU
+    cpu.instrBus(connections.instrCache_to_CPU_Instruction);
+    cpu.instrReadyBus(connections.instrCache_to_CPU_Ready);
 
-    dataCache.memoryDataInBus(connections->dataRAM_to_dataCache_Data);
-    dataCache.memoryReadyBus(connections->dataRAM_to_dataCache_Ready);
+    instructionCache.instructionBus(connections.instrCache_to_CPU_Instruction);
+    instructionCache.instrReadyBus(connections.instrCache_to_CPU_Ready);
 
-    // Instruction Cache
-    // CPU -> Cache
-    cpu.pcBus(connections->CPU_to_instrCache_PC);
-    cpu.validInstrRequestBus(connections->CPU_to_instrCache_Valid_Request);
+    // the memory side of the caches is wired up by the caller
+    cpu.clock(connections.clk);
+    dataCache.clock(connections.clk);
+    instructionCache.clock(connections.clk);
+}
 
-    instructionCache.pcBus(connections->CPU_to_instrCache_PC);
-    instructionCache.validInstrRequestBus(connections->CPU_to_instrCache_Valid_Request);
+template <MappingType mappingType, typename PolicyType>
+inline void connectCachesToMemory(Connections& connections, Cache<mappingType, PolicyType>& dataCache,
+                                  InstructionCache& instructionCache) {
+    // Data Cache -> Memory
+    dataCache.memoryAddrBus(connections.dataCache_to_dataRAM_Address);
+    dataCache.memoryDataOutBus(connections.dataCache_to_dataRAM_Data);
+    dataCache.memoryWeBus(connections.dataCache_to_dataRAM_WE);
+    dataCache.memoryValidRequestBus(connections.dataCache_to_dataRAM_Valid_Request);
 
-    // Cache -> CPU
-    cpu.instrBus(connections->instrCache_to_CPU_Instruction);
-    cpu.instrReadyBus(connections->instrCache_to_CPU_Ready);
+    // Memory -> Data Cache
+    dataCache.memoryDataInBus(connections.dataRAM_to_dataCache_Data);
+    dataCache.memoryReadyBus(connections.dataRAM_to_dataCache_Ready);
+
+    // Instruction Cache -> Memory
+    instructionCache.memoryAddrBus(connections.instrCache_to_instrRAM_Address);
+    instructionCache.memoryDataOutBus(connections.instrCache_to_instrRAM_Data);
+    instructionCache.memoryWeBus(connections.instrCache_to_instrRAM_WE);
+    instructionCache.memoryValidRequestBus(connections.instrCache_to_instrRAM_Valid_Request);
+
+    // Memory -> Instruction Cache
+    instructionCache.memoryDataInBus(connections.instrRAM_to_instrCache_Data);
+    instructionCache.memoryReadyBus(connections.instrRAM_to_instrCache_Ready);
+}
+
+// connects the memory side of requester (a cache, the L2, a MemoryController or a ClockDomainBridge) to memory (a RAM,
+// DRAM, MemoryController or ClockDomainBridge) through bus. The clock of memory is bound by the caller
+template <typename RequesterType, typename MemoryType>
+inline void connectThroughBus(MemoryBus& bus, RequesterType& requester, MemoryType& memory) {
+    // Requester -> Memory
+    requester.memoryAddrBus(bus.address);
+    requester.memoryDataOutBus(bus.data);
+    requester.memoryWeBus(bus.we);
+    requester.memoryValidRequestBus(bus.validRequest);
 
-    instructionCache.instructionBus(connections->instrCache_to_CPU_Instruction);
-    instructionCache.instrReadyBus(connections->instrCache_to_CPU_Ready);
+    memory.addressBus(bus.address);
+    memory.dataInBus(bus.data);
+    memory.weBus(bus.we);
+    memory.validRequestBus(bus.validRequest);
+
+    // Memory -> Requester
+    memory.dataOutBus(bus.beat);
+    memory.readyBus(bus.ready);
+
+    requester.memoryDataInBus(bus.beat);
+    requester.memoryReadyBus(bus.ready);
+
+    bus.isUsed = true;
+}
+
+// the memory types are either RAM or DRAM, both having the same ports, or a MemoryController in front of the data RAM
+// or a ClockDomainBridge in front of either. The memories run on the core clock, so with clocks of different periods
+// they have to be bridges
+template <MappingType mappingType, typename PolicyType, typename DataMemoryType, typename InstructionMemoryType>
+inline void connectComponents(Connections& connections, CPU& cpu, DataMemoryType& dataRam,
+                              InstructionMemoryType& instructionRam, Cache<mappingType, PolicyType>& dataCache,
+                              InstructionCache& instructionCache) {
+    connectCPUToCaches(connections, cpu, dataCache, instructionCache);
+    connectCachesToMemory(connections, dataCache, instructionCache);
 
     // Cache -> RAM
-    instructionRam.addressBus(connections->instrCache_to_instrRAM_Address);
-    instructionRam.dataInBus(connections->instrCache_to_instrRAM_Data);
-    instructionRam.weBus(connections->instrCache_to_instrRAM_WE);
-    instructionRam.validRequestBus(connections->instrCache_to_instrRAM_Valid_Request);
+    dataRam.addressBus(connections.dataCache_to_dataRAM_Address);
+    dataRam.dataInBus(connections.dataCache_to_dataRAM_Data);
+    dataRam.weBus(connections.dataCache_to_dataRAM_WE);
+    dataRam.validRequestBus(connections.dataCache_to_dataRAM_Valid_Request);
 
-    instructionCache.memoryAddrBus(connections->instrCache_to_instrRAM_Address);
-    instructionCache.memoryDataOutBus(connections->instrCache_to_instrRAM_Data);
-    instructionCache.memoryWeBus(connections->instrCache_to_instrRAM_WE);
-    instructionCache.memoryValidRequestBus(connections->instrCache_to_instrRAM_Valid_Request);
+    instructionRam.addressBus(connections.instrCache_to_instrRAM_Address);
+    instructionRam.dataInBus(connections.instrCache_to_instrRAM_Data);
+    instructionRam.weBus(connections.instrCache_to_instrRAM_WE);
+    instructionRam.validRequestBus(connections.instrCache_to_instrRAM_Valid_Request);
 
     // RAM -> Cache
-    instructionRam.dataOutBus(connections->instrRAM_to_instrCache_Data);
-    instructionRam.readyBus(connections->instrRAM_to_instrCache_Ready);
+    dataRam.dataOutBus(connections.dataRAM_to_dataCache_Data);
+    dataRam.readyBus(connections.dataRAM_to_dataCache_Ready);
 
-    instructionCache.memoryDataInBus(connections->instrRAM_to_instrCache_Data);
-    instructionCache.memoryReadyBus(connections->instrRAM_to_instrCache_Ready);
+    instructionRam.dataOutBus(connections.instrRAM_to_instrCache_Data);
+    instructionRam.readyBus(connections.instrRAM_to_instrCache_Ready);
 
-    cpu.clock(connections->clk);
-    dataCache.clock(connections->clk);
-    instructionCache.clock(connections->clk);
-    dataRam.clock(connections->clk);
-    instructionRam.clock(connections->clk);
+    dataRam.clock(connections.clk);
+    instructionRam.clock(connections.clk);
+}
 
+template <MappingType mappingType, typename PolicyType, typename DataMemoryType, typename InstructionMemoryType>
+inline std::unique_ptr<Connections> connectComponents(CPU& cpu, DataMemoryType& dataRam,
+                                                      InstructionMemoryType& instructionRam,
+                                                      Cache<mappingType, PolicyType>& dataCache,
+                                                      InstructionCache& instructionCache) {
+    auto connections = std::make_unique<Connections>();
+    connectComponents(*connections, cpu, dataRam, instructionRam, dataCache, instructionCache);
     return connections;
-}
\ No newline at end of file
+}
+
+// the memory type is as for connectComponents, but runs on the cache clock of the L2
+template <MappingType mappingType, typename MemoryType>
+inline void connectL2ToMemory(Connections& connections, L2Cache<mappingType>& l2Cache, MemoryType& ram) {
+    // L2 -> RAM
+    ram.addressBus(connections.L2_to_RAM_Address);
+    ram.dataInBus(connections.L2_to_RAM_Data);
+    ram.weBus(connections.L2_to_RAM_WE);
+    ram.validRequestBus(connections.L2_to_RAM_Valid_Request);
+
+    l2Cache.memoryAddrBus(connections.L2_to_RAM_Address);
+    l2Cache.memoryDataOutBus(connections.L2_to_RAM_Data);
+    l2Cache.memoryWeBus(connections.L2_to_RAM_WE);
+    l2Cache.memoryValidRequestBus(connections.L2_to_RAM_Valid_Request);
+
+    // RAM -> L2
+    ram.dataOutBus(connections.RAM_to_L2_Data);
+    ram.readyBus(connections.RAM_to_L2_Ready);
+
+    l2Cache.memoryDataInBus(connections.RAM_to_L2_Data);
+    l2Cache.memoryReadyBus(connections.RAM_to_L2_Ready);
+
+    l2Cache.clock(connections.cacheClock());
+    ram.clock(connections.cacheClock());
+}
+
+// the L1 caches are connected to the L2 directly, so both have to run on the same clock
+template <MappingType mappingType, typename PolicyType, typename MemoryType>
+inline void connectComponents(Connections& connections, CPU& cpu, MemoryType& ram, L2Cache<mappingType>& l2Cache,
+                              Cache<mappingType, PolicyType>& dataCache, InstructionCache& instructionCache) {
+    connectCPUToCaches(connections, cpu, dataCache, instructionCache);
+    connectCachesToMemory(connections, dataCache, instructionCache);
+
+    // L1 Caches -> L2
+    l2Cache.dataAddrBus(connections.dataCache_to_dataRAM_Address);
+    l2Cache.dataDataInBus(connections.dataCache_to_dataRAM_Data);
+    l2Cache.dataWeBus(connections.dataCache_to_dataRAM_WE);
+    l2Cache.dataValidRequestBus(connections.dataCache_to_dataRAM_Valid_Request);
+
+    l2Cache.instrAddrBus(connections.instrCache_to_instrRAM_Address);
+    l2Cache.instrDataInBus(connections.instrCache_to_instrRAM_Data);
+    l2Cache.instrWeBus(connections.instrCache_to_instrRAM_WE);
+    l2Cache.instrValidRequestBus(connections.instrCache_to_instrRAM_Valid_Request);
+
+    // L2 -> L1 Caches
+    l2Cache.dataDataOutBus(connections.dataRAM_to_dataCache_Data);
+    l2Cache.dataReadyBus(connections.dataRAM_to_dataCache_Ready);
+
+    l2Cache.instrDataOutBus(connections.instrRAM_to_instrCache_Data);
+    l2Cache.instrReadyBus(connections.instrRAM_to_instrCache_Ready);
+
+    connectL2ToMemory(connections, l2Cache, ram);
+}
+
+template <MappingType mappingType, typename PolicyType, typename MemoryType>
+inline std::unique_ptr<Connections> connectComponents(CPU& cpu, MemoryType& ram, L2Cache<mappingType>& l2Cache,
+                                                      Cache<mappingType, PolicyType>& dataCache,
+                                                      InstructionCache& instructionCache) {
+    auto connections = std::make_unique<Connections>();
+    connectComponents(*connections, cpu, ram, l2Cache, dataCache, instructionCache);
+    return connections;
+}
+
+// connects the bridges the L1 caches were connected to by connectComponents to the L2 on the other side
+template <MappingType mappingType>
+inline void connectBridgesToL2(Connections& connections, ClockDomainBridge& dataBridge,
+                               ClockDomainBridge& instructionBridge, L2Cache<mappingType>& l2Cache) {
+    // Bridges -> L2
+    dataBridge.memoryAddrBus(connections.dataCrossing.address);
+    dataBridge.memoryDataOutBus(connections.dataCrossing.data);
+    dataBridge.memoryWeBus(connections.dataCrossing.we);
+    dataBridge.memoryValidRequestBus(connections.dataCrossing.validRequest);
+
+    l2Cache.dataAddrBus(connections.dataCrossing.address);
+    l2Cache.dataDataInBus(connections.dataCrossing.data);
+    l2Cache.dataWeBus(connections.dataCrossing.we);
+    l2Cache.dataValidRequestBus(connections.dataCrossing.validRequest);
+
+    instructionBridge.memoryAddrBus(connections.instrCrossing.address);
+    instructionBridge.memoryDataOutBus(connections.instrCrossing.data);
+    instructionBridge.memoryWeBus(connections.instrCrossing.we);
+    instructionBridge.memoryValidRequestBus(connections.instrCrossing.validRequest);
+
+    l2Cache.instrAddrBus(connections.instrCrossing.address);
+    l2Cache.instrDataInBus(connections.instrCrossing.data);
+    l2Cache.instrWeBus(connections.instrCrossing.we);
+    l2Cache.instrValidRequestBus(connections.instrCrossing.validRequest);
+
+    // L2 -> Bridges
+    l2Cache.dataDataOutBus(connections.dataCrossing.beat);
+    l2Cache.dataReadyBus(connections.dataCrossing.ready);
+
+    dataBridge.memoryDataInBus(connections.dataCrossing.beat);
+    dataBridge.memoryReadyBus(connections.dataCrossing.ready);
+
+    l2Cache.instrDataOutBus(connections.instrCrossing.beat);
+    l2Cache.instrReadyBus(connections.instrCrossing.ready);
+
+    instructionBridge.memoryDataInBus(connections.instrCrossing.beat);
+    instructionBridge.memoryReadyBus(connections.instrCrossing.ready);
+
+    dataBridge.memoryClock(connections.cacheClock());
+    instructionBridge.memoryClock(connections.cacheClock());
+    connections.dataCrossing.isUsed = true;
+    connections.instrCrossing.isUsed = true;
+}
+
+// puts controller in front of ram, after the requesting side of controller was connected by connectComponents. Both
+// run on the memory clock
+template <typename MemoryType>
+inline void connectControllerToMemory(Connections& connections, MemoryController& controller, MemoryType& ram) {
+    // Controller -> RAM
+    ram.addressBus(connections.controller_to_RAM_Address);
+    ram.dataInBus(connections.controller_to_RAM_Data);
+    ram.weBus(connections.controller_to_RAM_WE);
+    ram.validRequestBus(connections.controller_to_RAM_Valid_Request);
+
+    controller.memoryAddrBus(connections.controller_to_RAM_Address);
+    controller.memoryDataOutBus(connections.controller_to_RAM_Data);
+    controller.memoryWeBus(connections.controller_to_RAM_WE);
+    controller.memoryValidRequestBus(connections.controller_to_RAM_Valid_Request);
+
+    // RAM -> Controller
+    ram.dataOutBus(connections.RAM_to_controller_Data);
+    ram.readyBus(connections.RAM_to_controller_Ready);
+
+    controller.memoryDataInBus(connections.RAM_to_controller_Data);
+    controller.memoryReadyBus(connections.RAM_to_controller_Ready);
+
+    ram.clock(connections.memoryClock());
+}
+
+// connects the CPU of a core of a multicore system to its data and instruction cache, all running on the core clock.
+// The data cache is connected to the other cores by the SnoopingBus it was constructed with, the memory side of the
+// instruction cache is connected through signals.instrMemory by the caller
+template <MappingType mappingType>
+inline void connectCore(Connections& connections, CoreSignals& signals, CPU& cpu, CoherentCache<mappingType>& dataCache,
+                        InstructionCache& instructionCache) {
+    // CPU -> Data Cache
+    cpu.addressBus(signals.dataAddress);
+    cpu.dataOutBus(signals.dataOut);
+    cpu.weBus(signals.dataWe);
+    cpu.validDataRequestBus(signals.dataValidRequest);
+    cpu.addressSpaceBus(signals.dataAddressSpace);
+
+    dataCache.cpuAddrBus(signals.dataAddress);
+    dataCache.cpuDataInBus(signals.dataOut);
+    dataCache.cpuWeBus(signals.dataWe);
+    dataCache.cpuValidRequest(signals.dataValidRequest);
+
+    // Data Cache -> CPU
+    cpu.dataInBus(signals.dataIn);
+    cpu.dataReadyBus(signals.dataReady);
+
+    dataCache.cpuDataOutBus(signals.dataIn);
+    dataCache.ready(signals.dataReady);
+
+    // CPU -> Instruction Cache
+    cpu.pcBus(signals.pc);
+    cpu.validInstrRequestBus(signals.instrValidRequest);
+    cpu.instrAddressSpaceBus(signals.instrAddressSpace);
+
+    instructionCache.pcBus(signals.pc);
+    instructionCache.validInstrRequestBus(signals.instrValidRequest);
+    instructionCache.addressSpaceBus(signals.instrAddressSpace);
+
+    // Instruction Cache -> CPU
+    cpu.instrBus(signals.instruction);
+    cpu.instrReadyBus(signals.instrReady);
+
+    instructionCache.instructionBus(signals.instruction);
+    instructionCache.instrReadyBus(signals.instrReady);
+
+    cpu.clock(connections.clk);
+    dataCache.clock(connections.clk);
+    instructionCache.clock(connections.clk);
+}
@@ -0,0 +1,70 @@
+#include "DRAM.h"
+
+#include <algorithm>
+
+namespace {
+constexpr std::uint32_t defaultRowSize = 2048;
+
+std::uint32_t atLeastOne(unsigned int value) noexcept { return value == 0 ? 1 : value; }
+} // namespace
+
+DRAMAddressMapping::DRAMAddressMapping(const DRAMOptions& options) noexcept
+    : channels{atLeastOne(options.channels)}, ranks{atLeastOne(options.ranks)}, banksPerRank{atLeastOne(options.banks)},
+      rowSize{options.rowSize == 0 ? defaultRowSize : options.rowSize} {}
+
+DRAMAddressMapping::Location DRAMAddressMapping::locate(std::uint32_t addr) const noexcept {
+    std::uint32_t rest = addr / rowSize;
+    const std::uint32_t channel = rest % channels;
+    rest /= channels;
+    const std::uint32_t bank = rest % banksPerRank;
+    rest /= banksPerRank;
+    const std::uint32_t rank = rest % ranks;
+    const std::uint32_t row = rest / ranks;
+    return Location{(channel * ranks + rank) * banksPerRank + bank, row};
+}
+
+DRAM::DRAM(sc_core::sc_module_name name, const DRAMOptions& options, std::uint32_t wordsPerRead)
+    : RAM{name, 0, wordsPerRead}, mapping{options}, tRCD{options.tRCD}, tCAS{options.tCAS}, tRP{options.tRP},
+      tRAS{options.tRAS}, closedPage{options.closedPage != 0}, banks(mapping.getNumBanks()) {}
+
+std::uint32_t DRAM::latencyOf(std::uint32_t addr, bool continuesBurst) noexcept {
+    const Location location = mapping.locate(addr);
+    const bool staysInRow = location.bank == lastLocation.bank && location.row == lastLocation.row;
+    lastLocation = location;
+    return continuesBurst && staysInRow ? 0 : openRowOf(addr);
+}
+
+std::uint32_t DRAM::openRowOf(std::uint32_t addr) noexcept {
+    const Location location = mapping.locate(addr);
+    Bank& bank = banks[location.bank];
+
+    // a bank still precharging from a closed-page access cannot be used before it is done
+    const std::uint64_t start = std::max(cycle, bank.readyAt);
+    std::uint64_t end;
+    if (bank.isOpen && bank.openRow == location.row) {
+        ++statistics.rowHits;
+        end = start + tCAS;
+    } else if (!bank.isOpen) {
+        ++statistics.rowMisses;
+        bank.activatedAt = start;
+        end = start + tRCD + tCAS;
+    } else {
+        ++statistics.rowConflicts;
+        const std::uint64_t prechargeStart = std::max(start, bank.activatedAt + tRAS);
+        bank.activatedAt = prechargeStart + tRP;
+        end = bank.activatedAt + tRCD + tCAS;
+    }
+
+    if (closedPage) {
+        bank.isOpen = false;
+        bank.readyAt = std::max(end, bank.activatedAt + tRAS) + tRP;
+    } else {
+        bank.isOpen = true;
+        bank.openRow = location.row;
+    }
+
+    const auto latency = static_cast<std::uint32_t>(end - cycle);
+    ++statistics.accesses;
+    statistics.latencyCycles += latency;
+    return latency;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "../Result.h"
+#include "../SimulationOptions.h"
+#include "RAM.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <systemc>
+
+/**
+ * Where an address ends up in a DRAM of channels x ranks x banks banks with rows of rowSize bytes. Consecutive rows
+ * are interleaved over the channels first, then the banks and then the ranks:
+ * address = row | rank | bank | channel | column.
+ */
+class DRAMAddressMapping {
+  public:
+    struct Location {
+        std::uint32_t bank; // index over all banks, covering channel, rank and bank
+        std::uint32_t row;
+    };
+
+    // takes channels and ranks of 0 as 1 and a rowSize of 0 as 2048 bytes, like DRAM
+    explicit DRAMAddressMapping(const DRAMOptions& options) noexcept;
+
+    Location locate(std::uint32_t addr) const noexcept;
+    std::uint32_t getNumBanks() const noexcept { return channels * ranks * banksPerRank; }
+
+  private:
+    std::uint32_t channels;
+    std::uint32_t ranks;
+    std::uint32_t banksPerRank;
+    std::uint32_t rowSize;
+};
+
+/**
+ * A RAM that models the timing of a DRAM instead of charging a flat latency per access. It only replaces latencyOf,
+ * keeping the ports and protocol of the RAM, so it can take its place anywhere.
+ *
+ * The memory consists of channels x ranks x banks banks, each with a row buffer holding one row of rowSize bytes,
+ * mapped to the addresses as described in DRAMAddressMapping.
+ * An access to the row already open in its bank (row hit) costs tCAS. One to a precharged bank (row miss) has to
+ * activate the row first and costs tRCD + tCAS. One to a bank with another row open (row conflict) additionally has to
+ * precharge that row, which may only start tRAS cycles after it was activated, and costs another tRP cycles on top.
+ * With the open-page policy rows stay open after an access, betting on the next access hitting them. With the
+ * closed-page policy every row is precharged right after its access, so an access never conflicts, but a bank still
+ * precharging from the previous access has to be waited for.
+ *
+ * As there is only a single request port, requests are served one at a time - more channels only spread the rows over
+ * more banks. Like the RAM, burst writes are supported: as long as the following words stay in the open row, they are
+ * written one per cycle.
+ */
+struct DRAM : public RAM {
+  private:
+    struct Bank {
+        bool isOpen = false;
+        std::uint32_t openRow = 0;
+        std::uint64_t activatedAt = 0; // cycle the open (or last) row was activated
+        std::uint64_t readyAt = 0;     // cycle the bank is done precharging
+    };
+
+    using Location = DRAMAddressMapping::Location;
+
+    const DRAMAddressMapping mapping;
+    const std::uint32_t tRCD;
+    const std::uint32_t tCAS;
+    const std::uint32_t tRP;
+    const std::uint32_t tRAS;
+    const bool closedPage;
+
+    std::vector<Bank> banks;
+    Location lastLocation{0, 0}; // of the last access, which a burst write has to stay in
+    DRAMStatistics statistics{};
+
+  public:
+    DRAM(sc_core::sc_module_name name, const DRAMOptions& options, std::uint32_t wordsPerRead);
+
+    const DRAMStatistics& getStatistics() const noexcept { return statistics; }
+
+  protected:
+    /**
+     * Returns the cycles until the row of addr is ready. The next word of a burst write is taken right away as long as
+     * it stays in the row just written.
+     */
+    std::uint32_t latencyOf(std::uint32_t addr, bool continuesBurst) noexcept override;
+
+  private:
+    SC_CTOR(DRAM);
+
+    /**
+     * Brings the row of addr into its row buffer, updating the state of its bank and the statistics.
+     * @returns the cycles from now until the access can be performed
+     */
+    std::uint32_t openRowOf(std::uint32_t addr) noexcept;
+};
@@ -3,7 +3,8 @@
 #include "../Request.h"
 #include "Cache.h"
 
-#include "Policy/FIFOPolicy.h"
+#include "Policy/Policy.h"
+#include <cstddef>
 #include <memory>
 #include <systemc>
 
@@ -13,6 +14,15 @@
  * cacheline and subsequently "decodes it" by using its internal instruction store to look up the corresponding
  * instruction.
  *
+ * The PC is used as the address of the instruction, shifted by fetchAddressBase. By default this is 0, if the
+ * instruction cache shares a memory with the data cache it can be used to move the instructions into their own segment
+ * so they do not alias the data addresses of the trace. If the trace carries the real addresses of its instructions,
+ * setFetchAddresses makes them the addresses fetched instead. As processes sharing the core may fetch the same addresses,
+ * the lines are tagged with the address space ID the CPU sends along with the PC.
+ *
+ * The instructions are the trace the CPU replays, shared with it instead of copied. Without a policy the internal cache
+ * is direct-mapped, given one it is fully associative and replaces its lines by it.
+ *
  * For more information on how the internal cache works see Cache.cpp
  */
 
@@ -21,9 +31,14 @@ SC_MODULE(InstructionCache) {
     const std::uint32_t cacheLineNum;
     const std::uint32_t cacheLineSize;
     const std::uint32_t cacheLatency;
+    const std::uint32_t fetchAddressBase;
 
-    Cache<MappingType::Direct> cache{"Cache", cacheLineNum, cacheLineSize, cacheLatency, nullptr};
-    std::vector<Request> instructions;
+    // exactly one of them exists, depending on the mapping
+    std::unique_ptr<Cache<MappingType::Direct>> directCache;
+    std::unique_ptr<Cache<MappingType::Fully_Associative>> associativeCache;
+    const Request* instructions;
+    const std::size_t numInstructions;
+    const std::uint32_t* fetchAddresses = nullptr; // of each instruction, nullptr to fetch from the PC
 
     SC_CTOR(InstructionCache);
 
@@ -37,6 +52,7 @@ SC_MODULE(InstructionCache) {
     // CPU -> Instruction Cache
     sc_core::sc_in<bool> SC_NAMED(validInstrRequestBus);
     sc_core::sc_in<std::uint32_t> SC_NAMED(pcBus);
+    sc_core::sc_in<std::uint16_t> SC_NAMED(addressSpaceBus);
 
     // Cache -> RAM
     sc_core::sc_out<std::uint32_t> SC_NAMED(memoryAddrBus);
@@ -45,7 +61,7 @@ SC_MODULE(InstructionCache) {
     sc_core::sc_out<bool> SC_NAMED(memoryValidRequestBus);
 
     // RAM -> Cache
-    sc_core::sc_in<sc_dt::sc_bv<128>> SC_NAMED(memoryDataInBus);
+    sc_core::sc_in<BusBeat> SC_NAMED(memoryDataInBus);
     sc_core::sc_in<bool> SC_NAMED(memoryReadyBus);
 
   private:
@@ -55,15 +71,70 @@ SC_MODULE(InstructionCache) {
     // All other ports can be directly connected to internal cache
     sc_core::sc_signal<std::uint32_t> SC_NAMED(cacheDataOutSignal);
     sc_core::sc_signal<bool> SC_NAMED(validInstrRequestSignal);
+    sc_core::sc_signal<std::uint32_t> SC_NAMED(fetchAddrSignal);
 
   public:
+    /**
+     * @param[in] instructions The trace, numInstructions requests. Has to outlive the simulation.
+     * @param[in] policy The replacement policy of a fully associative cache, nullptr for a direct-mapped one
+     */
     InstructionCache(sc_core::sc_module_name name, std::uint32_t cacheLines, std::uint32_t cacheLineSize,
-                     std::uint32_t cacheLatency, std::vector<Request> instructions)
+                     std::uint32_t cacheLatency, const Request* instructions, std::size_t numInstructions,
+                     std::uint32_t fetchAddressBase = 0,
+                     std::unique_ptr<ReplacementPolicy<std::uint32_t>> policy = nullptr)
         : sc_module{name}, cacheLineNum{cacheLines}, cacheLineSize{cacheLineSize}, cacheLatency{cacheLatency},
-          instructions{instructions} {
+          fetchAddressBase{fetchAddressBase}, instructions{instructions}, numInstructions{numInstructions} {
 
         using namespace sc_core;
 
+        if (policy == nullptr) {
+            directCache = std::make_unique<Cache<MappingType::Direct>>("Cache", cacheLineNum, cacheLineSize,
+                                                                       cacheLatency, nullptr);
+            bindCache(*directCache);
+        } else {
+            associativeCache = std::make_unique<Cache<MappingType::Fully_Associative>>(
+                "Cache", cacheLineNum, cacheLineSize, cacheLatency, std::move(policy));
+            bindCache(*associativeCache);
+        }
+
+        SC_METHOD(provideInstruction);
+        sensitive << instrReadyBus;
+
+        SC_METHOD(interceptTooHighPCVal);
+        sensitive << pcBus << validInstrRequestBus;
+
+        SC_METHOD(relocatePC);
+        sensitive << pcBus;
+    }
+
+    /**
+     * Fetches the instructions from their real addresses instead of the PC.
+     * @param[in] fetchAddresses The address of each instruction. Has to outlive the simulation.
+     */
+    void setFetchAddresses(const std::uint32_t* fetchAddresses) noexcept { this->fetchAddresses = fetchAddresses; }
+
+    std::size_t getHitCount() const noexcept {
+        return directCache != nullptr ? directCache->hitCount : associativeCache->hitCount;
+    }
+    std::size_t getMissCount() const noexcept {
+        return directCache != nullptr ? directCache->missCount : associativeCache->missCount;
+    }
+    // see Cache::getInvalidVictim
+    std::uint64_t getInvalidVictim() const noexcept {
+        return directCache != nullptr ? directCache->getInvalidVictim() : associativeCache->getInvalidVictim();
+    }
+
+#ifdef STRICT_INSTRUCTION_ORDER
+    void setMemoryLatency(std::uint32_t latency) {
+        if (directCache != nullptr)
+            directCache->setMemoryLatency(latency);
+        else
+            associativeCache->setMemoryLatency(latency);
+    }
+#endif
+
+  private:
+    template <typename CacheType> void bindCache(CacheType & cache) {
         cache.clock(clock);
 
         cache.memoryAddrBus(memoryAddrBus);
@@ -77,29 +148,27 @@ SC_MODULE(InstructionCache) {
         cache.cpuDataOutBus(cacheDataOutSignal); // dummy - gets discarded
         cache.ready(instrReadyBus);
 
-        cache.cpuAddrBus(pcBus);
+        cache.cpuAddrBus(fetchAddrSignal);
         cache.cpuDataInBus(instrDataInSignal);
         cache.cpuWeBus(instrWeSignal);
         cache.cpuValidRequest(validInstrRequestSignal);
-
-        SC_METHOD(provideInstruction);
-        sensitive << cache.ready;
-
-        SC_METHOD(interceptTooHighPCVal);
-        sensitive << pcBus << validInstrRequestBus;
+        cache.cpuAddressSpaceBus(addressSpaceBus);
     }
 
-#ifdef STRICT_INSTRUCTION_ORDER
-    void setMemoryLatency(std::uint32_t latency) { cache.setMemoryLatency(latency); }
-#endif
-
-  private:
     void interceptTooHighPCVal() {
-        validInstrRequestSignal.write(validInstrRequestBus.read() && pcBus.read() < instructions.size());
+        validInstrRequestSignal.write(validInstrRequestBus.read() && pcBus.read() < numInstructions);
+    }
+
+    void relocatePC() {
+        const std::uint32_t pc = pcBus.read();
+        if (fetchAddresses != nullptr && pc < numInstructions)
+            fetchAddrSignal.write(fetchAddresses[pc]);
+        else
+            fetchAddrSignal.write(fetchAddressBase + pc);
     }
 
     void provideInstruction() {
-        if (cache.ready.read()) {
+        if (instrReadyBus.read()) {
             instructionBus.write(instructions[pcBus.read()]);
         }
     }
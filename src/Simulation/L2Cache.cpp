@@ -0,0 +1,272 @@
+#include "L2Cache.h"
+#include <stdexcept>
+
+using namespace sc_core;
+
+template <MappingType mappingType> void L2Cache<mappingType>::waitOutLookupLatency() noexcept {
+    for (std::size_t i = 0; i < cacheLatency; ++i) {
+        wait();
+    }
+    if (mappingType == MappingType::Fully_Associative) {
+        // same hash table penalty as in the fully associative L1, see hashTableLookupCyclesAt
+        for (std::uint32_t i = 0; i < hashTableLookupCycles; ++i) {
+            wait();
+        }
+    }
+}
+
+template <MappingType mappingType> void L2Cache<mappingType>::setClockPeriod(const sc_time& period) noexcept {
+    hashTableLookupCycles = hashTableLookupCyclesAt(period);
+}
+
+template <MappingType mappingType> void L2Cache<mappingType>::waitForRAM() noexcept {
+    do {
+        wait();
+    } while (!writeBufferReady.read());
+}
+
+template <MappingType mappingType> void L2Cache<mappingType>::setUpWriteBufferConnects() noexcept {
+    writeBuffer.clock.bind(clock);
+
+    writeBuffer.ready.bind(writeBufferReady);
+    writeBuffer.cacheDataOutBus.bind(writeBufferDataOut);
+
+    writeBuffer.cacheAddrBus.bind(writeBufferAddr);
+    writeBuffer.cacheDataInBus.bind(writeBufferDataIn);
+    writeBuffer.cacheWeBus.bind(writeBufferWE);
+    writeBuffer.cacheValidRequest.bind(writeBufferValidRequest);
+
+    writeBuffer.memoryAddrBus.bind(memoryAddrBus);
+    writeBuffer.memoryDataOutBus.bind(memoryDataOutBus);
+    writeBuffer.memoryWeBus.bind(memoryWeBus);
+    writeBuffer.memoryValidRequestBus.bind(memoryValidRequestBus);
+
+    writeBuffer.memoryDataInBus.bind(memoryDataInBus);
+    writeBuffer.memoryReadyBus.bind(memoryReadyBus);
+}
+
+template <MappingType mappingType> void L2Cache<mappingType>::zeroInitialiseCachelines() noexcept {
+    for (auto& cacheline : cacheInternal) {
+        cacheline.data = std::vector<std::uint8_t>(cacheLineSize, 0);
+    }
+}
+
+template <MappingType mappingType>
+L2Cache<mappingType>::L2Cache(sc_module_name name, std::uint32_t numCacheLines, std::uint32_t cacheLineSize,
+                              std::uint32_t cacheLatency, std::uint32_t instrReadsPerCacheline,
+                              std::uint32_t dataReadsPerCacheline,
+                              std::unique_ptr<ReplacementPolicy<std::uint32_t>> policy)
+    : sc_module{name}, numCacheLines{numCacheLines}, cacheLineSize{cacheLineSize}, cacheLatency{cacheLatency},
+      instrReadsPerCacheline{instrReadsPerCacheline}, dataReadsPerCacheline{dataReadsPerCacheline},
+      replacementPolicy{std::move(policy)}, cacheInternal{numCacheLines},
+      writeBuffer{"writeBuffer", cacheLineSize / RAM_READ_BUS_SIZE_IN_BYTE, cacheLineSize, WRITE_BUFFER_SIZE, false} {
+    if (replacementPolicy == nullptr && mappingType == MappingType::Fully_Associative) {
+        throw std::invalid_argument("Replacement Policy must be set for fully associative cache.");
+    }
+    // taken care of in C part
+    assert(cacheLineSize > 0 && cacheLineSize % RAM_READ_BUS_SIZE_IN_BYTE == 0 && numCacheLines > 0);
+
+    zeroInitialiseCachelines();
+    setUpWriteBufferConnects();
+
+    SC_THREAD(handleRequest);
+    sensitive << clock.pos();
+
+    SC_METHOD(countContentionStalls);
+    sensitive << clock.pos();
+    dont_initialize();
+}
+
+template <MappingType mappingType>
+typename L2Cache<mappingType>::Side L2Cache<mappingType>::arbitrate(bool instrWaiting,
+                                                                    bool dataWaiting) const noexcept {
+    if (instrWaiting && dataWaiting) {
+        return lastServed == Side::Instruction ? Side::Data : Side::Instruction;
+    }
+    return instrWaiting ? Side::Instruction : Side::Data;
+}
+
+template <MappingType mappingType> void L2Cache<mappingType>::handleRequest() noexcept {
+    while (true) {
+        wait();
+        instrReadyBus.write(false);
+        dataReadyBus.write(false);
+
+        const bool instrWaiting = instrValidRequestBus.read();
+        const bool dataWaiting = dataValidRequestBus.read();
+        if (!instrWaiting && !dataWaiting)
+            continue;
+
+        const Side side = arbitrate(instrWaiting, dataWaiting);
+        busy = true;
+        busyWith = side;
+        ++statisticsOf(side).accesses;
+
+        const bool isWrite = (side == Side::Instruction) ? instrWeBus.read() : dataWeBus.read();
+        if (isWrite) {
+            serveWrite(side);
+        } else {
+            serveRead(side);
+        }
+
+        lastServed = side;
+        busy = false;
+    }
+}
+
+template <MappingType mappingType> void L2Cache<mappingType>::countContentionStalls() noexcept {
+    if (!busy)
+        return;
+    if (busyWith == Side::Data && instrValidRequestBus.read()) {
+        ++instructionStatistics.contentionStallCycles;
+    } else if (busyWith == Side::Instruction && dataValidRequestBus.read()) {
+        ++dataStatistics.contentionStallCycles;
+    }
+}
+
+template <MappingType mappingType> void L2Cache<mappingType>::serveRead(Side side) noexcept {
+    const std::uint32_t addr = (side == Side::Instruction) ? instrAddrBus.read() : dataAddrBus.read();
+    const std::uint32_t numBeats = readsPerCachelineOf(side);
+    auto& dataOutBus = (side == Side::Instruction) ? instrDataOutBus : dataDataOutBus;
+
+    waitOutLookupLatency();
+
+    // collect the whole burst first - the RAM protocol has no way of stalling in the middle of it. Copying right away
+    // also means a later miss of the same burst evicting an earlier line does no harm
+    std::vector<std::uint8_t> burst(numBeats * RAM_READ_BUS_SIZE_IN_BYTE);
+    bool wasMiss = false;
+    std::uint64_t byteAddr = addr;
+    while (byteAddr < addr + static_cast<std::uint64_t>(burst.size())) {
+        auto cacheline = fetchIfNotPresent(static_cast<std::uint32_t>(byteAddr), wasMiss);
+        lineTable.registerUsage(cacheline, replacementPolicy.get());
+        std::uint32_t offset = lineTable.decomposeAddress(static_cast<std::uint32_t>(byteAddr)).offset;
+        while (offset < cacheLineSize && byteAddr < addr + static_cast<std::uint64_t>(burst.size())) {
+            burst[byteAddr - addr] = cacheline->data[offset];
+            ++offset;
+            ++byteAddr;
+        }
+    }
+    if (wasMiss) {
+        ++statisticsOf(side).misses;
+    } else {
+        ++statisticsOf(side).hits;
+    }
+
+    auto& readyBus = readyBusOf(side);
+    for (std::uint32_t beat = 0; beat < numBeats; ++beat) {
+        BusBeat beatData;
+        const auto beatBegin = burst.begin() + beat * RAM_READ_BUS_SIZE_IN_BYTE;
+        std::copy(beatBegin, beatBegin + RAM_READ_BUS_SIZE_IN_BYTE, beatData.bytes.begin());
+        dataOutBus.write(beatData);
+        readyBus.write(true);
+
+        // the last beat is taken care of by the wait at the beginning of handleRequest - just like in the RAM
+        if (beat != numBeats - 1) {
+            wait();
+        }
+    }
+}
+
+template <MappingType mappingType> void L2Cache<mappingType>::serveWrite(Side side) noexcept {
+    const std::uint32_t addr = (side == Side::Instruction) ? instrAddrBus.read() : dataAddrBus.read();
+    const std::uint32_t data = (side == Side::Instruction) ? instrDataInBus.read() : dataDataInBus.read();
+
+    waitOutLookupLatency();
+
+    auto& statistics = statisticsOf(side);
+    bool hit = false;
+    // an unaligned word may touch two L2 cachelines, so every byte is looked up on its own
+    for (std::uint32_t byteNr = 0; byteNr < 4; ++byteNr) {
+        const auto decomposedAddr = lineTable.decomposeAddress(addr + byteNr);
+        auto cacheline = lineTable.find(decomposedAddr);
+        if (cacheline == cacheInternal.end())
+            continue;
+        if (byteNr == 0 || decomposedAddr.offset == 0) // first byte we see of this cacheline
+            lineTable.registerUsage(cacheline, replacementPolicy.get());
+        cacheline->data[decomposedAddr.offset] = (data >> (BITS_IN_BYTE * byteNr)) & 0xFF;
+        hit = hit || byteNr == 0;
+    }
+    if (hit) {
+        ++statistics.hits;
+    } else {
+        ++statistics.misses;
+    }
+
+    passWriteOnToRAM(addr, data);
+    readyBusOf(side).write(true);
+}
+
+template <MappingType mappingType>
+std::vector<Cacheline>::iterator L2Cache<mappingType>::fetchIfNotPresent(std::uint32_t addr, bool& wasMiss) noexcept {
+    const auto decomposedAddr = lineTable.decomposeAddress(addr);
+    auto cacheline = lineTable.find(decomposedAddr);
+    if (cacheline != cacheInternal.end()) {
+        return cacheline;
+    }
+    wasMiss = true;
+
+    writeBufferAddr.write((addr / cacheLineSize) * cacheLineSize);
+    writeBufferWE.write(false);
+    writeBufferValidRequest.write(true);
+    waitForRAM();
+    return writeRAMReadIntoCacheline(decomposedAddr);
+}
+
+template <MappingType mappingType>
+std::vector<Cacheline>::iterator
+L2Cache<mappingType>::writeRAMReadIntoCacheline(const DecomposedAddress& decomposedAddr) noexcept {
+    auto cachelineToWriteInto = lineTable.chooseLineToFill(decomposedAddr, replacementPolicy.get());
+    writeBufferValidRequest.write(false);
+    const std::uint32_t numReadEvents = cacheLineSize / RAM_READ_BUS_SIZE_IN_BYTE;
+
+    for (std::size_t i = 0; i < numReadEvents; ++i) {
+        const auto& dataRead = writeBufferDataOut.read().bytes;
+        std::copy(dataRead.begin(), dataRead.end(), cachelineToWriteInto->data.begin() + RAM_READ_BUS_SIZE_IN_BYTE * i);
+        wait();
+    }
+
+    cachelineToWriteInto->isValid = true;
+    cachelineToWriteInto->tag = decomposedAddr.tag;
+    return cachelineToWriteInto;
+}
+
+template <MappingType mappingType>
+void L2Cache<mappingType>::passWriteOnToRAM(std::uint32_t addr, std::uint32_t data) noexcept {
+    writeBufferAddr.write(addr);
+    writeBufferDataIn.write(data);
+    writeBufferWE.write(true);
+    writeBufferValidRequest.write(true);
+
+    wait();
+    writeBufferValidRequest.write(false); // ensure we only set valid for exactly one cycle
+    while (!writeBufferReady) {
+        wait();
+    }
+}
+
+template <MappingType mappingType>
+typename L2Cache<mappingType>::SideStatistics& L2Cache<mappingType>::statisticsOf(Side side) noexcept {
+    return side == Side::Instruction ? instructionStatistics : dataStatistics;
+}
+
+template <MappingType mappingType> std::uint32_t L2Cache<mappingType>::readsPerCachelineOf(Side side) const noexcept {
+    return side == Side::Instruction ? instrReadsPerCacheline : dataReadsPerCacheline;
+}
+
+template <MappingType mappingType> sc_out<bool>& L2Cache<mappingType>::readyBusOf(Side side) noexcept {
+    return side == Side::Instruction ? instrReadyBus : dataReadyBus;
+}
+
+template <MappingType mappingType>
+void L2Cache<mappingType>::traceInternalSignals(sc_trace_file* const traceFile) const {
+    sc_trace(traceFile, writeBufferReady, "L2_WriteBuffer_Ready");
+    sc_trace(traceFile, writeBufferDataOut, "L2_WriteBuffer_Data_Out");
+    sc_trace(traceFile, writeBufferAddr, "L2_WriteBuffer_Addr");
+    sc_trace(traceFile, writeBufferDataIn, "L2_WriteBuffer_Data_in");
+    sc_trace(traceFile, writeBufferWE, "L2_WriteBuffer_WE");
+    sc_trace(traceFile, writeBufferValidRequest, "L2_WriteBuffer_Valid_Request");
+}
+
+// here to allow the move of function definitions to cpp
+template struct L2Cache<MappingType::Direct>;
+template struct L2Cache<MappingType::Fully_Associative>;
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "Cache.h"
+#include "CachelineTable.h"
+#include "Cacheline.h"
+#include "DecomposedAddress.h"
+#include "Policy/ReplacementPolicy.h"
+#include "WriteBuffer.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <systemc>
+
+/**
+ * This module represents a unified second-level cache shared by the instruction and the data cache. Towards both L1
+ * caches it looks exactly like a RAM module (same ports, same protocol), towards the RAM it behaves like an L1 cache
+ * and buffers its accesses through its own write buffer.
+ *
+ * Each L1 cache is connected to its own set of ports. An arbiter decides which of them is served next: if only one
+ * side has a valid request, it is served. If both do, the side that was not served last wins (round robin). Every
+ * cycle a side holds up a valid request while the L2 is busy with the other side is counted as a contention stall for
+ * that side. All traffic is attributed to the side it came from.
+ *
+ * Reads from an L1 always ask for a whole L1 cacheline. All L2 cachelines the request touches are made present first,
+ * afterwards the data is streamed back in 128 bit beats, one per cycle, like the RAM does. Writes are the 32 bit
+ * write-throughs of the L1 caches. They update the L2 copy if there is one (no write allocate) and are always passed on
+ * to the RAM.
+ *
+ * All operations happen on rising clock edge.
+ */
+template <MappingType mappingType> SC_MODULE(L2Cache) {
+  public:
+    // ====================================== External Ports  ======================================
+    // Global Clock
+    sc_core::sc_in<bool> SC_NAMED(clock);
+
+    // Instruction Cache -> L2
+    sc_core::sc_in<std::uint32_t> SC_NAMED(instrAddrBus);
+    sc_core::sc_in<std::uint32_t> SC_NAMED(instrDataInBus);
+    sc_core::sc_in<bool> SC_NAMED(instrWeBus);
+    sc_core::sc_in<bool> SC_NAMED(instrValidRequestBus);
+
+    // L2 -> Instruction Cache
+    sc_core::sc_out<BusBeat> SC_NAMED(instrDataOutBus);
+    sc_core::sc_out<bool> SC_NAMED(instrReadyBus);
+
+    // Data Cache -> L2
+    sc_core::sc_in<std::uint32_t> SC_NAMED(dataAddrBus);
+    sc_core::sc_in<std::uint32_t> SC_NAMED(dataDataInBus);
+    sc_core::sc_in<bool> SC_NAMED(dataWeBus);
+    sc_core::sc_in<bool> SC_NAMED(dataValidRequestBus);
+
+    // L2 -> Data Cache
+    sc_core::sc_out<BusBeat> SC_NAMED(dataDataOutBus);
+    sc_core::sc_out<bool> SC_NAMED(dataReadyBus);
+
+    // L2 -> RAM
+    sc_core::sc_out<std::uint32_t> SC_NAMED(memoryAddrBus);
+    sc_core::sc_out<std::uint32_t> SC_NAMED(memoryDataOutBus);
+    sc_core::sc_out<bool> SC_NAMED(memoryWeBus);
+    sc_core::sc_out<bool> SC_NAMED(memoryValidRequestBus);
+
+    // RAM -> L2
+    sc_core::sc_in<BusBeat> SC_NAMED(memoryDataInBus);
+    sc_core::sc_in<bool> SC_NAMED(memoryReadyBus);
+
+  private:
+    // ====================================== Internal Signals  ======================================
+    // Buffer -> L2
+    sc_core::sc_signal<bool, sc_core::SC_MANY_WRITERS> SC_NAMED(writeBufferReady);
+    sc_core::sc_signal<BusBeat> SC_NAMED(writeBufferDataOut);
+
+    // L2 -> Buffer
+    sc_core::sc_signal<std::uint32_t> SC_NAMED(writeBufferAddr);
+    sc_core::sc_signal<std::uint32_t> SC_NAMED(writeBufferDataIn);
+    sc_core::sc_signal<bool> SC_NAMED(writeBufferWE);
+    sc_core::sc_signal<bool> SC_NAMED(writeBufferValidRequest);
+
+  public:
+    // ====================================== Bookkeeping  ======================================
+    enum class Side { Instruction, Data };
+
+    struct SideStatistics {
+        std::uint64_t accesses{0};
+        std::uint64_t hits{0};
+        std::uint64_t misses{0};
+        std::uint64_t contentionStallCycles{0};
+    };
+
+    SideStatistics instructionStatistics;
+    SideStatistics dataStatistics;
+
+  private:
+    // ====================================== Config  ======================================
+    std::uint32_t numCacheLines{0};
+    std::uint32_t cacheLineSize{0}; // in Byte
+    std::uint32_t cacheLatency{0};  // in Cycles
+    std::uint32_t hashTableLookupCycles{2}; // on top of the cacheLatency, see setClockPeriod
+    std::uint32_t instrReadsPerCacheline{0};
+    std::uint32_t dataReadsPerCacheline{0};
+    std::unique_ptr<ReplacementPolicy<std::uint32_t>> replacementPolicy{nullptr};
+
+    // ====================================== Internals ======================================
+    std::vector<Cacheline> cacheInternal;
+    CachelineTable<mappingType, Cacheline> lineTable{cacheInternal, cacheLineSize};
+    WriteBuffer writeBuffer;
+
+    // ====================================== Arbitration ======================================
+    Side lastServed{Side::Data}; // so the instruction side wins the very first tie
+    bool busy{false};
+    Side busyWith{Side::Data};
+
+  public:
+    /**
+     * Constructs a unified L2 cache.
+     * @param[in] name  The name systemc assigns to this module.
+     * @param[in] numCacheLines The number of cache lines the cache will have. Has to be > 0.
+     * @param[in] cacheLineSize The number of bytes a cacheline holds. Has to be a multiple of the memory bus size 16B.
+     * @param[in] cacheLatency The number of cycles the cache takes to find out whether an access results in a hit or a
+     * miss.
+     * @param[in] instrReadsPerCacheline The number of 128 bit beats a read of the instruction cache expects.
+     * @param[in] dataReadsPerCacheline The number of 128 bit beats a read of the data cache expects.
+     * @param[in] policy The replacement policy. Only relevant (and then required) if MappingType is Fully_Associative.
+     */
+    L2Cache(sc_core::sc_module_name name, std::uint32_t numCacheLines, std::uint32_t cacheLineSize,
+            std::uint32_t cacheLatency, std::uint32_t instrReadsPerCacheline, std::uint32_t dataReadsPerCacheline,
+            std::unique_ptr<ReplacementPolicy<std::uint32_t>> policy = nullptr);
+
+    /**
+     * Adds internal signals to and from the write buffer to the trace file
+     * @param[in] traceFile The trace file the signals shall be added to
+     */
+    void traceInternalSignals(sc_core::sc_trace_file* const traceFile) const;
+
+    /**
+     * Sets the period of the clock the cache runs on (default: 1 ns), see Cache::setClockPeriod
+     * @param[in] period The period of the clock the cache runs on
+     */
+    void setClockPeriod(const sc_core::sc_time& period) noexcept;
+
+    // see Cache::getInvalidVictim
+    std::uint64_t getInvalidVictim() const noexcept { return lineTable.getInvalidVictim(); }
+
+  private:
+    // ====================================== Set-Up ======================================
+    SC_CTOR(L2Cache); // private since this is never to be called, just to get systemc typedef
+
+    void setUpWriteBufferConnects() noexcept;
+    void zeroInitialiseCachelines() noexcept;
+
+    // ====================================== Arbitration ======================================
+    /**
+     * The main point of entry. Picks the side to be served next and serves its request.
+     */
+    void handleRequest() noexcept;
+    /**
+     * Chooses which side to serve if at least one of them has a valid request
+     * @param[in] instrWaiting Whether the instruction side has a valid request
+     * @param[in] dataWaiting Whether the data side has a valid request
+     * @returns the side to be served
+     */
+    Side arbitrate(bool instrWaiting, bool dataWaiting) const noexcept;
+    /**
+     * Counts a contention stall for every side that waits while the other one is being served. Runs every cycle.
+     */
+    void countContentionStalls() noexcept;
+
+    // ====================================== Serving a Side ======================================
+    /**
+     * Makes sure all L2 cachelines the requested L1 cacheline lies in are present and streams the L1 cacheline back.
+     * The request counts as a single miss if any of these cachelines had to be fetched.
+     */
+    void serveRead(Side side) noexcept;
+    /**
+     * Updates the L2 copy (if present) and passes the write on to the RAM.
+     */
+    void serveWrite(Side side) noexcept;
+
+    // ====================================== Talking to RAM ======================================
+    /**
+     * Looks up the cacheline the address lies in and fetches it from RAM if it is a miss.
+     * @param[out] wasMiss Set to true if the cacheline had to be fetched, left untouched otherwise
+     * @returns an iterator to the cacheline (now) holding the address
+     */
+    std::vector<Cacheline>::iterator fetchIfNotPresent(std::uint32_t addr, bool& wasMiss) noexcept;
+    std::vector<Cacheline>::iterator writeRAMReadIntoCacheline(const DecomposedAddress& decomposedAddr) noexcept;
+    void passWriteOnToRAM(std::uint32_t addr, std::uint32_t data) noexcept;
+
+    // ====================================== Port Helpers ======================================
+    SideStatistics& statisticsOf(Side side) noexcept;
+    std::uint32_t readsPerCachelineOf(Side side) const noexcept;
+    sc_core::sc_out<bool>& readyBusOf(Side side) noexcept;
+
+    // ====================================== Waiting Helpers ======================================
+    /**
+     * Sleeps for cacheLatency cycles (plus the hash table penalty if fully associative)
+     */
+    void waitOutLookupLatency() noexcept;
+    void waitForRAM() noexcept;
+};
@@ -0,0 +1,129 @@
+#pragma once
+#include "../Request.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+/**
+ * The load/store queue of the out-of-order CPU: the requests fetched but not yet retired, in program order. It decides
+ * which of them may leave for the data cache and which loads are served from an older store right away.
+ *
+ * The dependency model only looks at addresses, the trace knows nothing about registers. Two requests depend on each
+ * other if the 4 bytes they access overlap and at least one of them is a store, everything else is independent and
+ * may be reordered:
+ *  - a load whose youngest older overlapping store has exactly its address takes the data of that store (forwarding),
+ *    it never goes to the cache
+ *  - a load whose youngest older overlapping store accesses different bytes waits until that store is done
+ *  - a store waits until all older overlapping requests are done, loads as well as stores
+ * Of the requests that may go to the cache, loads go before stores, so a load never waits for older stores to
+ * independent addresses. Requests retire in program order once done.
+ */
+class LoadStoreQueue {
+  public:
+    struct Entry {
+        std::size_t index; // in the trace
+        Request request;
+        bool isIssued = false; // sent to the cache or forwarded
+        bool isDone = false;
+    };
+
+    explicit LoadStoreQueue(std::size_t capacity) : capacity{capacity} { assert(capacity > 0); }
+
+    std::size_t getSize() const noexcept { return entries.size(); }
+    bool isEmpty() const noexcept { return entries.empty(); }
+    bool isFull() const noexcept { return entries.size() == capacity; }
+
+    void push(std::size_t index, const Request& request) noexcept {
+        assert(!isFull());
+        entries.push_back(Entry{index, request});
+    }
+
+    /**
+     * Serves the load at position from the youngest older store to its address if there is one. The data of the store
+     * is set as the data of the load.
+     * @return whether the load was forwarded and is done
+     */
+    bool forward(std::size_t position) noexcept {
+        Entry& load = entries[position];
+        assert(!load.request.we && !load.isIssued);
+        const Entry* store = youngestOlderOverlappingStore(position);
+        if (store == nullptr || store->request.addr != load.request.addr)
+            return false;
+        load.request.data = store->request.data;
+        load.isIssued = true;
+        load.isDone = true;
+        ++forwardedLoads;
+        return true;
+    }
+
+    /**
+     * The position of the oldest request which may be sent to the cache now, loads before stores.
+     * @return the position or getSize() if there is none
+     */
+    std::size_t nextForCache() const noexcept {
+        std::size_t oldestStore = entries.size();
+        for (std::size_t position = 0; position < entries.size(); ++position) {
+            const Entry& entry = entries[position];
+            if (entry.isIssued || !mayGoToCache(position))
+                continue;
+            if (!entry.request.we)
+                return position;
+            if (oldestStore == entries.size())
+                oldestStore = position;
+        }
+        return oldestStore;
+    }
+
+    Entry& at(std::size_t position) noexcept { return entries[position]; }
+
+    /**
+     * Removes up to maxCount done requests from the front, calling retire on each of them.
+     * @return the number of requests retired
+     */
+    template <typename RetireFunction> std::size_t retire(std::size_t maxCount, RetireFunction retire) {
+        std::size_t retired = 0;
+        while (retired < maxCount && !entries.empty() && entries.front().isDone) {
+            retire(entries.front());
+            entries.pop_front();
+            ++retired;
+        }
+        return retired;
+    }
+
+    std::size_t getForwardedLoads() const noexcept { return forwardedLoads; }
+
+  private:
+    const std::size_t capacity;
+    std::deque<Entry> entries;
+    std::size_t forwardedLoads = 0;
+
+    static bool overlap(const Request& lhs, const Request& rhs) noexcept {
+        // every request accesses 4 bytes, computed in 64 bit so addresses at the end of the address space don't wrap
+        return std::uint64_t{lhs.addr} + 4 > rhs.addr && std::uint64_t{rhs.addr} + 4 > lhs.addr;
+    }
+
+    const Entry* youngestOlderOverlappingStore(std::size_t position) const noexcept {
+        for (std::size_t older = position; older-- > 0;) {
+            const Entry& entry = entries[older];
+            if (entry.request.we && overlap(entry.request, entries[position].request))
+                return &entry;
+        }
+        return nullptr;
+    }
+
+    bool mayGoToCache(std::size_t position) const noexcept {
+        const Request& request = entries[position].request;
+        if (!request.we) {
+            const Entry* store = youngestOlderOverlappingStore(position);
+            // one of the exact address could forward instead, the CPU tries that first
+            return store == nullptr || store->isDone;
+        }
+        for (std::size_t older = 0; older < position; ++older) {
+            if (!entries[older].isDone && overlap(entries[older].request, request))
+                return false;
+        }
+        return true;
+    }
+};
@@ -0,0 +1,228 @@
+#include "MemoryController.h"
+
+#include <algorithm>
+#include <cassert>
+
+MemoryController::MemoryController(sc_core::sc_module_name name, const MemoryControllerOptions& options,
+                                   std::uint32_t readsPerCacheline, const DRAMOptions& dram)
+    : sc_module{name}, queueDepth{options.queueDepth},
+      writeHighWatermark{options.writeHighWatermark != 0 ? options.writeHighWatermark
+                                                         : std::max(1u, options.queueDepth * 3 / 4)},
+      writeLowWatermark{options.writeHighWatermark != 0 ? options.writeLowWatermark : options.queueDepth / 4},
+      readsPerCacheline{readsPerCacheline},
+      lineSize{readsPerCacheline * static_cast<std::uint32_t>(BusBeat::SIZE_IN_BYTE)}, mapping{dram},
+      tracksOpenRows{dram.banks != 0 && dram.closedPage == 0}, isRowOpen(mapping.getNumBanks(), false),
+      openRows(mapping.getNumBanks()), beatsToPass{readsPerCacheline} {
+    using namespace sc_core;
+    assert(queueDepth > 0);
+    assert(writeLowWatermark < writeHighWatermark);
+    queue.reserve(queueDepth);
+    statistics.queueDepth = queueDepth;
+
+    SC_THREAD(acceptRequests);
+    sensitive << clock.pos();
+    dont_initialize();
+    SC_THREAD(sendRequests);
+    sensitive << clock.neg();
+}
+
+// ============= Requester side =============
+
+void MemoryController::acceptRequests() noexcept {
+    while (true) {
+        wait();
+        recordCycle();
+        readyBus.write(false);
+
+        // the beats of a read follow each other one per cycle, just like they arrive from the memory
+        if (!beatsToPass.isEmpty()) {
+            dataOutBus.write(beatsToPass.pop());
+            readyBus.write(true);
+            if (++beatsPassed == readsPerCacheline) {
+                beatsPassed = 0;
+                isReadQueued = false;
+            }
+            continue;
+        }
+
+        if (validRequestBus.read())
+            queueRequest();
+    }
+}
+
+void MemoryController::queueRequest() noexcept {
+    const bool we = weBus.read();
+    if (!we && isReadQueued) // still waiting for its data
+        return;
+    if (queue.size() == queueDepth) {
+        ++statistics.fullStallCycles;
+        return;
+    }
+
+    queue.push_back(QueuedRequest{addressBus.read(), dataInBus.read(), we, cycle});
+    if (we) {
+        // posted: the requester does not have to wait for the write to arrive in memory
+        ++statistics.writes;
+        readyBus.write(true);
+    } else {
+        ++statistics.reads;
+        isReadQueued = true;
+    }
+}
+
+void MemoryController::recordCycle() noexcept {
+    ++cycle;
+    ++statistics.cycles;
+    statistics.maxOccupancy = std::max(statistics.maxOccupancy, queue.size());
+    if (isMemoryBusy)
+        ++statistics.busyCycles;
+}
+
+// ============= Memory side =============
+
+void MemoryController::sendRequests() noexcept {
+    while (true) {
+        wait();
+        const std::size_t index = pickNext();
+        if (index == queue.size())
+            continue;
+
+        const QueuedRequest request = takeFromQueue(index);
+        isMemoryBusy = true;
+        if (request.we)
+            sendWrites(request);
+        else
+            sendRead(request);
+        isMemoryBusy = false;
+    }
+}
+
+void MemoryController::sendRead(const QueuedRequest& request) noexcept {
+    memoryAddrBus.write(request.addr);
+    memoryWeBus.write(false);
+    memoryValidRequestBus.write(true);
+    while (!memoryReadyBus.read()) {
+        wait();
+    }
+    memoryValidRequestBus.write(false);
+
+    // don't need to wait before the first one because we can only get here if the memory tells us it is ready
+    for (std::uint32_t i = 0; i < readsPerCacheline; ++i) {
+        beatsToPass.push(memoryDataInBus.read());
+        wait();
+    }
+    statistics.bytesTransferred += lineSize;
+}
+
+void MemoryController::sendWrites(const QueuedRequest& first) noexcept {
+    // valid is kept up until the last word is done, which tells the memory they belong together
+    memoryWeBus.write(true);
+    memoryValidRequestBus.write(true);
+    memoryAddrBus.write(first.addr);
+    memoryDataOutBus.write(first.data);
+    while (!memoryReadyBus.read()) {
+        wait();
+    }
+
+    std::size_t words = 1;
+    const std::uint32_t lineAddress = makeAddrAligned(first.addr);
+    for (std::size_t next = nextWriteToLine(lineAddress); next != queue.size(); next = nextWriteToLine(lineAddress)) {
+        const QueuedRequest request = takeFromQueue(next);
+        memoryAddrBus.write(request.addr);
+        memoryDataOutBus.write(request.data);
+        wait(); // the ready of the previous word is still up until the memory took the next one
+        while (!memoryReadyBus.read()) {
+            wait();
+        }
+        ++words;
+    }
+    memoryValidRequestBus.write(false);
+
+    statistics.bytesTransferred += words * sizeof(std::uint32_t);
+    if (words > 1)
+        ++statistics.bursts;
+}
+
+std::size_t MemoryController::pickNext() noexcept {
+    const std::size_t queuedWrites = countQueuedWrites();
+    if (!isDrainingWrites && queuedWrites >= writeHighWatermark) {
+        isDrainingWrites = true;
+        ++statistics.writeDrains;
+    } else if (isDrainingWrites && queuedWrites <= writeLowWatermark) {
+        isDrainingWrites = false;
+    }
+
+    // a read waiting for an older write to its line falls through to the writes
+    const std::size_t preferred = oldestSendable(isDrainingWrites);
+    return preferred != queue.size() ? preferred : oldestSendable(!isDrainingWrites);
+}
+
+MemoryController::QueuedRequest MemoryController::takeFromQueue(std::size_t index) noexcept {
+    const QueuedRequest request = queue[index];
+    queue.erase(queue.begin() + index);
+
+    statistics.queueingDelay += cycle - request.queuedAt;
+    if (index != 0)
+        ++statistics.reorderedRequests;
+    if (tracksOpenRows) {
+        const DRAMAddressMapping::Location location = mapping.locate(request.addr);
+        isRowOpen[location.bank] = true;
+        openRows[location.bank] = location.row;
+    }
+    return request;
+}
+
+// ============= Helpers =============
+
+std::size_t MemoryController::oldestSendable(bool we) const noexcept {
+    std::size_t oldest = queue.size();
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+        if (queue[i].we != we || !maySend(i))
+            continue;
+        if (hitsOpenRow(queue[i].addr))
+            return i;
+        if (oldest == queue.size())
+            oldest = i;
+    }
+    return oldest;
+}
+
+std::size_t MemoryController::nextWriteToLine(std::uint32_t lineAddress) const noexcept {
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+        if (queue[i].we && makeAddrAligned(queue[i].addr) == lineAddress && maySend(i))
+            return i;
+    }
+    return queue.size();
+}
+
+bool MemoryController::maySend(std::size_t index) const noexcept {
+    for (std::size_t older = 0; older < index; ++older) {
+        // two reads may pass each other, everything else keeps its order if it touches the same bytes
+        if ((queue[older].we || queue[index].we) && overlaps(queue[older], queue[index]))
+            return false;
+    }
+    return true;
+}
+
+bool MemoryController::hitsOpenRow(std::uint32_t addr) const noexcept {
+    if (!tracksOpenRows)
+        return false;
+    const DRAMAddressMapping::Location location = mapping.locate(addr);
+    return isRowOpen[location.bank] && openRows[location.bank] == location.row;
+}
+
+bool MemoryController::overlaps(const QueuedRequest& a, const QueuedRequest& b) const noexcept {
+    // a write covers its 4 bytes, a read the whole line; 64 bit so a request at the end of memory does not wrap
+    const std::uint64_t aEnd = std::uint64_t{a.addr} + (a.we ? sizeof(std::uint32_t) : lineSize);
+    const std::uint64_t bEnd = std::uint64_t{b.addr} + (b.we ? sizeof(std::uint32_t) : lineSize);
+    return a.addr < bEnd && b.addr < aEnd;
+}
+
+std::size_t MemoryController::countQueuedWrites() const noexcept {
+    return static_cast<std::size_t>(
+        std::count_if(queue.begin(), queue.end(), [](const QueuedRequest& request) { return request.we; }));
+}
+
+std::uint32_t MemoryController::makeAddrAligned(std::uint32_t addr) const noexcept {
+    return (addr / lineSize) * lineSize;
+}
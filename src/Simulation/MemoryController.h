@@ -0,0 +1,125 @@
+#pragma once
+#include "../Result.h"
+#include "../SimulationOptions.h"
+#include "BusBeat.h"
+#include "DRAM.h"
+#include "RingQueue.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <systemc>
+
+/**
+ * This module sits between a write buffer (or any other requester speaking the RAM protocol) and the RAM or DRAM,
+ * queueing the requests instead of handing them over one at a time in arrival order.
+ *
+ * Towards the requester it behaves like a RAM, except that a write is done as soon as it is queued - the requester can
+ * carry on while the write waits for the memory. A read is queued as well, its beats being passed on as they arrive
+ * from the memory. Once the queue of queueDepth requests is full, new requests have to wait.
+ *
+ * Towards the memory it behaves like a write buffer, picking the next request to send from the queue:
+ * - Reads go first, as the requester is waiting for them, while writes are only sent when no read is queued. Once
+ *   writeHighWatermark writes are queued, the writes are drained first until only writeLowWatermark are left.
+ * - Of the requests of the chosen kind the oldest hitting an open row is sent, or the oldest if none does (FR-FCFS).
+ *   The open rows are tracked here, using the DRAMOptions of the memory, as all its requests come from here. Behind a
+ *   RAM or a closed-page DRAM no row is ever open, so the oldest request is sent.
+ * - A write is never sent before an older write to the same bytes, a read never before an older write to its line.
+ * Queued writes to the same line as the one just sent follow it as a burst, see RAM.
+ *
+ * The requester side acts on the rising edge like the RAM, the memory side on the falling edge like the write buffer.
+ */
+SC_MODULE(MemoryController) {
+  public:
+    // Global -> Controller
+    sc_core::sc_in<bool> SC_NAMED(clock);
+
+    // Requester -> Controller
+    sc_core::sc_in<std::uint32_t> SC_NAMED(dataInBus);
+    sc_core::sc_in<std::uint32_t> SC_NAMED(addressBus);
+    sc_core::sc_in<bool> SC_NAMED(weBus);
+    sc_core::sc_in<bool> SC_NAMED(validRequestBus);
+
+    // Controller -> Requester
+    sc_core::sc_out<BusBeat> SC_NAMED(dataOutBus);
+    sc_core::sc_out<bool> SC_NAMED(readyBus);
+
+    // Controller -> Memory
+    sc_core::sc_out<std::uint32_t> SC_NAMED(memoryAddrBus);
+    sc_core::sc_out<std::uint32_t> SC_NAMED(memoryDataOutBus);
+    sc_core::sc_out<bool> SC_NAMED(memoryWeBus);
+    sc_core::sc_out<bool> SC_NAMED(memoryValidRequestBus);
+
+    // Memory -> Controller
+    sc_core::sc_in<BusBeat> SC_NAMED(memoryDataInBus);
+    sc_core::sc_in<bool> SC_NAMED(memoryReadyBus);
+
+    /**
+     * @param[in] options The queue depth (> 0) and write watermarks.
+     * @param[in] readsPerCacheline The number of 128 bit beats of a read, also giving the size of a line.
+     * @param[in] dram The DRAM behind the controller, a DRAMOptions with 0 banks for a RAM.
+     */
+    MemoryController(sc_core::sc_module_name name, const MemoryControllerOptions& options,
+                     std::uint32_t readsPerCacheline, const DRAMOptions& dram);
+
+    const MemoryControllerStatistics& getStatistics() const noexcept { return statistics; }
+
+  private:
+    SC_CTOR(MemoryController);
+
+    struct QueuedRequest {
+        std::uint32_t addr;
+        std::uint32_t data;
+        bool we;
+        std::uint64_t queuedAt; // cycle it entered the queue
+    };
+
+    const std::uint32_t queueDepth;
+    const std::uint32_t writeHighWatermark;
+    const std::uint32_t writeLowWatermark;
+    const std::uint32_t readsPerCacheline;
+    const std::uint32_t lineSize;
+    const DRAMAddressMapping mapping;
+    const bool tracksOpenRows;
+
+    std::vector<QueuedRequest> queue; // oldest first, at most queueDepth requests
+    std::vector<bool> isRowOpen;         // per bank, whether a row is open in the DRAM ...
+    std::vector<std::uint32_t> openRows; // ... and which one
+    bool isDrainingWrites = false;
+    bool isReadQueued = false; // a read is queued or in flight, the requester waiting for its data
+    bool isMemoryBusy = false;
+    RingQueue<BusBeat> beatsToPass; // beats read from the memory, passed on to the requester one per cycle
+    std::uint32_t beatsPassed = 0;
+    std::uint64_t cycle = 0;
+    MemoryControllerStatistics statistics{};
+
+    // ============= Requester side =============
+    void acceptRequests() noexcept;
+    void queueRequest() noexcept;
+    void recordCycle() noexcept;
+
+    // ============= Memory side =============
+    void sendRequests() noexcept;
+    void sendRead(const QueuedRequest& request) noexcept;
+    // sends first followed by the queued writes to its line as a single burst
+    void sendWrites(const QueuedRequest& first) noexcept;
+    /**
+     * Chooses the next request to send, see the description of the module.
+     * @returns its index in queue, queue.size() if there is nothing to send
+     */
+    std::size_t pickNext() noexcept;
+    // removes the request at index from the queue, updating the statistics and open rows
+    QueuedRequest takeFromQueue(std::size_t index) noexcept;
+
+    // ============= Helpers =============
+    // the index of the oldest sendable request of the given kind hitting an open row, else of the oldest sendable one
+    std::size_t oldestSendable(bool we) const noexcept;
+    // the index of the oldest sendable write to the line at lineAddress, queue.size() if there is none
+    std::size_t nextWriteToLine(std::uint32_t lineAddress) const noexcept;
+    // whether the request at index does not have to wait for an older one touching the same bytes
+    bool maySend(std::size_t index) const noexcept;
+    bool hitsOpenRow(std::uint32_t addr) const noexcept;
+    bool overlaps(const QueuedRequest& a, const QueuedRequest& b) const noexcept;
+    std::size_t countQueuedWrites() const noexcept;
+    std::uint32_t makeAddrAligned(std::uint32_t addr) const noexcept;
+};
@@ -0,0 +1,46 @@
+#include "MemoryImage.h"
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+[[noreturn]] void fail(const char* path, const char* what) {
+    throw MemoryImageError{std::string{"Could not "} + what + " memory image '" + path + "': " + std::strerror(errno)};
+}
+} // namespace
+
+MemoryImage::MemoryImage(const char* path, std::uint32_t base) : base{base} {
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        fail(path, "open");
+
+    struct stat status {};
+    if (fstat(fd, &status) != 0) {
+        close(fd);
+        fail(path, "inspect");
+    }
+    // whatever lies beyond the end of the 32 bit address space could never be accessed anyway
+    const std::uint64_t addressable = (std::uint64_t{1} << 32) - base;
+    length = static_cast<std::size_t>(std::min<std::uint64_t>(static_cast<std::uint64_t>(status.st_size), addressable));
+    if (length == 0) { // mmap refuses empty mappings, an empty image simply is all zero
+        close(fd);
+        return;
+    }
+
+    void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping stays valid without the descriptor
+    if (mapping == MAP_FAILED)
+        fail(path, "map");
+    // the caches access the memory line by line all over the image, reading ahead would mostly load unused pages
+    madvise(mapping, length, MADV_RANDOM);
+    bytes = static_cast<const std::uint8_t*>(mapping);
+}
+
+MemoryImage::~MemoryImage() {
+    if (bytes != nullptr)
+        munmap(const_cast<std::uint8_t*>(bytes), length);
+}
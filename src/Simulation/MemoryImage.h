@@ -0,0 +1,54 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+// a memory image could not be opened or mapped
+class MemoryImageError : public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * The initial contents of a memory, read from a raw binary file: the byte at offset i of the file is the byte at
+ * address base + i, everything outside of the file reads as 0. The file is mapped read-only with mmap instead of being
+ * read, so only the parts actually accessed are loaded, page by page, when they are first touched. A sparse file (e.g.
+ * made with truncate and dd seek=) covers a large footprint, up to the whole 4 GiB address space, at the disk and load
+ * cost of the parts holding data only.
+ *
+ * The file itself is never written, a PagedMemory keeps its own copy of every page written to.
+ */
+class MemoryImage {
+  public:
+    /**
+     * Maps the file at path to the addresses from base on. Bytes beyond the end of the address space are ignored.
+     * @throws MemoryImageError if the file cannot be opened or mapped
+     */
+    MemoryImage(const char* path, std::uint32_t base);
+    ~MemoryImage();
+    MemoryImage(const MemoryImage&) = delete;
+    MemoryImage& operator=(const MemoryImage&) = delete;
+
+    // copies the n bytes starting at addr to dest, addresses may not wrap around
+    void read(std::uint32_t addr, std::uint8_t* dest, std::size_t n) const noexcept {
+        const std::uint64_t begin = std::max<std::uint64_t>(addr, base);
+        const std::uint64_t end = std::min<std::uint64_t>(std::uint64_t{addr} + n, std::uint64_t{base} + length);
+        if (begin >= end) {
+            std::memset(dest, 0, n);
+            return;
+        }
+        std::memset(dest, 0, begin - addr);
+        std::memcpy(dest + (begin - addr), bytes + (begin - base), end - begin);
+        std::memset(dest + (end - addr), 0, addr + n - end);
+    }
+
+    std::size_t getLength() const noexcept { return length; }
+
+  private:
+    const std::uint32_t base;
+    const std::uint8_t* bytes{nullptr};
+    std::size_t length{0}; // of the mapping, 0 for an empty file
+};
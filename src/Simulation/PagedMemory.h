@@ -0,0 +1,130 @@
+#pragma once
+#include "MemoryImage.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+/**
+ * A sparse byte-addressable memory covering the whole 32 bit address space. The bytes are kept in pages of PAGE_SIZE
+ * bytes found through a two-level page table (directory -> table -> page), both tables and pages only being allocated
+ * once something is written to them. Bytes never written read as 0, or as their byte of the MemoryImage set with
+ * setImage. A page is copied from the image when it is first written to, all other reads are served by the image.
+ *
+ * Compared to a map from address to byte this needs a small fraction of the memory per touched byte, and reading or
+ * writing a block within one page is a single memcpy. Addresses wrap around at the end of the address space, just like
+ * they do on a 32 bit address bus.
+ */
+class PagedMemory {
+  public:
+    static constexpr std::uint32_t PAGE_BITS = 12;
+    static constexpr std::uint32_t PAGE_SIZE = 1u << PAGE_BITS;
+
+  private:
+    static constexpr std::uint32_t TABLE_BITS = 10;
+    static constexpr std::uint32_t ENTRIES_PER_TABLE = 1u << TABLE_BITS;
+    static constexpr std::uint32_t DIRECTORY_SHIFT = PAGE_BITS + TABLE_BITS;
+    static_assert(DIRECTORY_SHIFT + TABLE_BITS == 32, "the page table has to cover the 32 bit address space");
+
+    typedef std::array<std::uint8_t, PAGE_SIZE> Page;
+    typedef std::array<std::unique_ptr<Page>, ENTRIES_PER_TABLE> PageTable;
+
+    std::array<std::unique_ptr<PageTable>, ENTRIES_PER_TABLE> directory{};
+    std::size_t allocatedPages = 0;
+    std::shared_ptr<const MemoryImage> image{};
+
+    static std::uint32_t directoryIndex(std::uint32_t addr) noexcept { return addr >> DIRECTORY_SHIFT; }
+    static std::uint32_t tableIndex(std::uint32_t addr) noexcept { return (addr >> PAGE_BITS) % ENTRIES_PER_TABLE; }
+    static std::uint32_t pageOffset(std::uint32_t addr) noexcept { return addr % PAGE_SIZE; }
+    // bytes from addr to the end of its page, at most n
+    static std::size_t chunkSize(std::uint32_t addr, std::size_t n) noexcept {
+        return std::min<std::size_t>(n, PAGE_SIZE - pageOffset(addr));
+    }
+
+    // @returns the page containing addr, nullptr if nothing has been written to it yet
+    const Page* findPage(std::uint32_t addr) const noexcept {
+        const auto& table = directory[directoryIndex(addr)];
+        return table ? (*table)[tableIndex(addr)].get() : nullptr;
+    }
+
+    Page& getOrAllocatePage(std::uint32_t addr) {
+        auto& table = directory[directoryIndex(addr)];
+        if (!table)
+            table = std::make_unique<PageTable>();
+        auto& page = (*table)[tableIndex(addr)];
+        if (!page) {
+            page = std::make_unique<Page>(); // value initialised, so all zero
+            if (image)
+                image->read(addr - pageOffset(addr), page->data(), PAGE_SIZE);
+            ++allocatedPages;
+        }
+        return *page;
+    }
+
+  public:
+    /**
+     * Sets the contents of all pages not written to yet. Meant to be called before the first write, pages written
+     * before keep their contents.
+     */
+    void setImage(std::shared_ptr<const MemoryImage> newImage) noexcept { image = std::move(newImage); }
+
+    std::uint8_t readByte(std::uint32_t addr) const noexcept {
+        const Page* page = findPage(addr);
+        if (page)
+            return (*page)[pageOffset(addr)];
+        std::uint8_t byte = 0;
+        if (image)
+            image->read(addr, &byte, 1);
+        return byte;
+    }
+
+    // reads the 4 bytes at addr as a little endian word
+    std::uint32_t readWord(std::uint32_t addr) const noexcept {
+        std::uint8_t bytes[4];
+        read(addr, bytes, 4);
+        return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+    }
+
+    // writes word to the 4 bytes at addr, least significant byte first
+    void writeWord(std::uint32_t addr, std::uint32_t word) {
+        const std::uint8_t bytes[4] = {static_cast<std::uint8_t>(word), static_cast<std::uint8_t>(word >> 8),
+                                       static_cast<std::uint8_t>(word >> 16), static_cast<std::uint8_t>(word >> 24)};
+        write(addr, bytes, 4);
+    }
+
+    // copies the n bytes starting at addr to dest
+    void read(std::uint32_t addr, std::uint8_t* dest, std::size_t n) const noexcept {
+        while (n > 0) {
+            const std::size_t chunk = chunkSize(addr, n);
+            const Page* page = findPage(addr);
+            if (page)
+                std::memcpy(dest, page->data() + pageOffset(addr), chunk);
+            else if (image)
+                image->read(addr, dest, chunk);
+            else
+                std::memset(dest, 0, chunk);
+            addr += chunk;
+            dest += chunk;
+            n -= chunk;
+        }
+    }
+
+    // copies the n bytes at src to the memory starting at addr
+    void write(std::uint32_t addr, const std::uint8_t* src, std::size_t n) {
+        while (n > 0) {
+            const std::size_t chunk = chunkSize(addr, n);
+            std::memcpy(getOrAllocatePage(addr).data() + pageOffset(addr), src, chunk);
+            addr += chunk;
+            src += chunk;
+            n -= chunk;
+        }
+    }
+
+    // direct access to a single byte, allocating its page if necessary - meant for inspecting the memory in tests
+    std::uint8_t& operator[](std::uint32_t addr) { return getOrAllocatePage(addr)[pageOffset(addr)]; }
+
+    std::size_t getAllocatedPages() const noexcept { return allocatedPages; }
+};
@@ -0,0 +1,158 @@
+#pragma once
+#include "../Saturating_Arithmetic.h"
+#include "GhostPool.h"
+#include "IndexLists.h"
+#include "ReplacementPolicy.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Adaptive replacement cache policy (Megiddo and Modha). Cachelines used once since they were filled are kept in the
+ * LRU list T1, cachelines used at least twice in the LRU list T2. The tags of blocks evicted from T1 and T2 are
+ * remembered in the ghost lists B1 and B2. A miss on a block in B1 means T1 should have been larger, one in B2 that T2
+ * should have been, so the target size p of T1 is adapted accordingly. The victim is taken from T1 if it exceeds p and
+ * from T2 otherwise.
+ *
+ * Cachelines are the nodes [0, size), ghost entries the nodes [size, 2 * size) of the same IndexLists. The tags of
+ * missing blocks are reported through logMiss, a fill without one is treated like a block never seen before.
+ */
+template <typename T> class ARCPolicy final : public ReplacementPolicy<T> {
+  public:
+    void logUse(T usage) override;
+    T pop() override;
+    void logMiss(std::uint32_t tag) override;
+    std::size_t getCapacity() const { return size; }
+    std::size_t getTargetRecencySize() const { return target; }
+    ARCPolicy(std::size_t size);
+    constexpr std::size_t calcBasicGates() const noexcept override;
+
+  private:
+    enum List : std::uint8_t { T1, T2, B1, B2, None };
+    enum class MissKind { Unseen, InB1, InB2 };
+
+    const std::size_t size;
+    IndexLists lists;
+    GhostPool ghosts;
+    std::vector<std::uint8_t> listOf;
+    std::array<std::size_t, 4> listSize{0, 0, 0, 0};
+    std::vector<std::uint32_t> tagOfCacheline;
+    std::size_t target{0}; // p
+
+    bool missPending{false};
+    MissKind pendingKind{MissKind::Unseen};
+    std::uint32_t pendingTag{GhostPool::noTag};
+    bool evictWithoutHistory{false};
+
+    void push(List list, std::uint32_t node) noexcept;
+    void remove(std::uint32_t node) noexcept;
+    void dropOldestGhost(List list) noexcept;
+    void prepareMiss(std::uint32_t tag) noexcept;
+};
+
+template <typename T>
+inline ARCPolicy<T>::ARCPolicy(std::size_t size)
+    : size{size}, lists{2 * size, 4}, ghosts{static_cast<std::uint32_t>(size), size}, listOf(2 * size, None),
+      tagOfCacheline(size, GhostPool::noTag) {
+    assert(size > 0);
+}
+
+template <typename T> inline void ARCPolicy<T>::push(List list, std::uint32_t node) noexcept {
+    lists.pushBack(list, node);
+    listOf[node] = list;
+    ++listSize[list];
+}
+
+template <typename T> inline void ARCPolicy<T>::remove(std::uint32_t node) noexcept {
+    lists.remove(node);
+    --listSize[listOf[node]];
+    listOf[node] = None;
+}
+
+template <typename T> inline void ARCPolicy<T>::dropOldestGhost(List list) noexcept {
+    const auto ghost = lists.front(list);
+    if (ghost == IndexLists::none)
+        return;
+    remove(ghost);
+    ghosts.release(ghost);
+}
+
+template <typename T> inline void ARCPolicy<T>::prepareMiss(std::uint32_t tag) noexcept {
+    missPending = true;
+    pendingTag = tag;
+    evictWithoutHistory = false;
+    const auto ghost = ghosts.find(tag);
+    if (ghost != TagTable::notFound && listOf[ghost] == B1) {
+        pendingKind = MissKind::InB1;
+        target = std::min(size, target + std::max<std::size_t>(listSize[B2] / listSize[B1], 1));
+    } else if (ghost != TagTable::notFound) {
+        pendingKind = MissKind::InB2;
+        target = subSatUnsigned(target, std::max<std::size_t>(listSize[B1] / listSize[B2], 1));
+    } else {
+        pendingKind = MissKind::Unseen;
+        if (listSize[T1] + listSize[B1] == size) {
+            if (listSize[T1] < size) {
+                dropOldestGhost(B1);
+            } else {
+                evictWithoutHistory = true; // B1 is empty, so T1 can only lose its oldest line
+            }
+        } else if (listSize[T1] + listSize[T2] + listSize[B1] + listSize[B2] >= 2 * size) {
+            dropOldestGhost(B2);
+        }
+        return;
+    }
+    // the block is going to be filled into T2, its ghost entry is no longer needed
+    remove(ghost);
+    ghosts.release(ghost);
+}
+
+template <typename T> inline void ARCPolicy<T>::logMiss(std::uint32_t tag) { prepareMiss(tag); }
+
+// precondition: usage lies in [0, size)
+template <typename T> inline void ARCPolicy<T>::logUse(T usage) {
+    const auto index = static_cast<std::uint32_t>(usage);
+    assert(index < size);
+    if (listOf[index] != None) { // hit
+        remove(index);
+        push(T2, index);
+        return;
+    }
+    if (!missPending)
+        prepareMiss(GhostPool::noTag);
+    push(pendingKind == MissKind::Unseen ? T1 : T2, index);
+    tagOfCacheline[index] = pendingTag;
+    missPending = false;
+}
+
+// Precondition: the cache is full
+template <typename T> inline T ARCPolicy<T>::pop() {
+    if (!missPending)
+        prepareMiss(GhostPool::noTag);
+    const bool fromT1 = listSize[T1] > 0 && (listSize[T2] == 0 || evictWithoutHistory || listSize[T1] > target ||
+                                             (pendingKind == MissKind::InB2 && listSize[T1] == target));
+    const auto victim = lists.front(fromT1 ? T1 : T2);
+    assert(victim != IndexLists::none);
+    remove(victim);
+
+    const auto tag = tagOfCacheline[victim];
+    tagOfCacheline[victim] = GhostPool::noTag;
+    if (!evictWithoutHistory && tag != GhostPool::noTag) {
+        if (ghosts.isFull()) // only possible if some fills were not reported
+            dropOldestGhost(listSize[B1] > listSize[B2] ? B1 : B2);
+        push(fromT1 ? B1 : B2, ghosts.add(tag));
+    }
+    return static_cast<T>(victim);
+}
+
+template <typename T> inline constexpr std::size_t ARCPolicy<T>::calcBasicGates() const noexcept {
+    // two 32 bit pointer registers (4 gates per bit) per entry for twice as many entries as lines, plus the tags of
+    // the ghost entries with a comparator each (32 * 2 gates), the relinking multiplexers and p with its adder and
+    // divider, which we estimate with 3 * 150 gates
+    return addSatUnsigned(mulSatUnsigned(static_cast<std::size_t>(2 * 32 * 4 + 4 * 32), 2 * size),
+                          mulSatUnsigned(static_cast<std::size_t>(32 * 4 + 32 * 2), size),
+                          static_cast<std::size_t>(32 * 4 + 3 * 150));
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include "../DecomposedAddress.h"
+#include "../Saturating_Arithmetic.h"
+#include "ReplacementPolicy.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Bit pseudo-LRU policy (also known as MRU-bit policy). Every cacheline has a single bit that is set when it is used.
+ * If that would set the last cleared bit, all other bits get cleared instead. The victim is the cacheline with the
+ * lowest index whose bit is cleared.
+ *
+ * The bits are stored in 64 bit words. Since bits only ever get set between two clears, the first word containing a
+ * cleared bit can only move forwards, so we remember it instead of searching from the start on every pop. This makes
+ * both operations amortised O(1).
+ */
+template <typename T> class BitPLRUPolicy final : public ReplacementPolicy<T> {
+  public:
+    void logUse(T usage) override;
+    T pop() override;
+    std::size_t getCapacity() const { return size; }
+    BitPLRUPolicy(std::size_t size);
+    constexpr std::size_t calcBasicGates() const noexcept override;
+
+  private:
+    static constexpr std::size_t bitsPerWord = 64;
+
+    const std::size_t size;
+    std::vector<std::uint64_t> mruBits;
+    std::size_t numBitsSet{0};
+    std::size_t firstWordWithClearedBit{0};
+
+    void clearAllBits() noexcept;
+};
+
+template <typename T>
+inline BitPLRUPolicy<T>::BitPLRUPolicy(std::size_t size)
+    : size{size}, mruBits((size + bitsPerWord - 1) / bitsPerWord, 0) {
+    assert(size > 0);
+    clearAllBits();
+}
+
+template <typename T> inline void BitPLRUPolicy<T>::clearAllBits() noexcept {
+    std::fill(mruBits.begin(), mruBits.end(), 0);
+    // the padding bits of the last word are permanently set, so they are never chosen as victim
+    if (size % bitsPerWord != 0) {
+        mruBits.back() = ~((std::uint64_t{1} << (size % bitsPerWord)) - 1);
+    }
+    numBitsSet = 0;
+    firstWordWithClearedBit = 0;
+}
+
+// precondition: usage lies in [0, size)
+template <typename T> inline void BitPLRUPolicy<T>::logUse(T usage) {
+    const auto index = static_cast<std::size_t>(usage);
+    assert(index < size);
+    const std::uint64_t bit = std::uint64_t{1} << (index % bitsPerWord);
+    if ((mruBits[index / bitsPerWord] & bit) != 0)
+        return;
+
+    if (numBitsSet + 1 == size) {
+        clearAllBits();
+        if (size == 1)
+            return; // a single cacheline always is the victim
+    }
+    mruBits[index / bitsPerWord] |= bit;
+    ++numBitsSet;
+}
+
+template <typename T> inline T BitPLRUPolicy<T>::pop() {
+    while (mruBits[firstWordWithClearedBit] == ~std::uint64_t{0}) {
+        ++firstWordWithClearedBit;
+        assert(firstWordWithClearedBit < mruBits.size()); // there always is at least one cleared bit
+    }
+    const auto victim = firstWordWithClearedBit * bitsPerWord +
+                        static_cast<std::size_t>(__builtin_ctzll(~mruBits[firstWordWithClearedBit]));
+    // the cache refills the victim right away, so treat it as used. This also keeps repeated pops from returning the
+    // same cacheline
+    logUse(static_cast<T>(victim));
+    return static_cast<T>(victim);
+}
+
+template <typename T> inline constexpr std::size_t BitPLRUPolicy<T>::calcBasicGates() const noexcept {
+    // one bit register per cacheline (4 gates each), one gate per bit to set it from the decoded index of the used
+    // cacheline, an AND tree over all bits to detect that all are set (about size gates) and a priority encoder finding
+    // the first cleared bit, which takes about size * log2(size) gates
+    const std::size_t log2Size = safeCeilLog2(static_cast<std::uint32_t>(size));
+    return addSatUnsigned(mulSatUnsigned(static_cast<std::size_t>(4), size), size, size,
+                          mulSatUnsigned(size, log2Size));
+}
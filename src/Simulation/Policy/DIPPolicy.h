@@ -0,0 +1,219 @@
+#pragma once
+#include "../Saturating_Arithmetic.h"
+#include "GhostPool.h"
+#include "IndexLists.h"
+#include "ReplacementPolicy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Dynamic insertion policy (DIP, Qureshi et al.). Victims are chosen like in LRU, only the position a filled cacheline
+ * is inserted at varies:
+ * - LRU insertion puts it at the most recently used position, like plain LRU.
+ * - Bimodal insertion (BIP) puts it at the least recently used position and only every 32nd time at the most recently
+ *   used one, so a working set larger than the cache keeps a part of itself instead of thrashing.
+ * Which one is better depends on the phase of the program, so the two duel in leader sets, one always using LRU and
+ * one always using BIP. A miss in a leader counts against its insertion in the saturating counter PSEL, the cache
+ * itself (the follower) uses the insertion currently missing less.
+ * The fully associative cache consists of a single set, and leaders sharing its recency order would not duel fairly:
+ * a block inserted at the least recently used position is the next victim of every miss, no matter which leader it
+ * belongs to. So the leaders are tag-only shadow caches instead: every samplePeriod-th block (by tag) is sampled, and
+ * both leaders replay the uses of the sampled blocks on 1 / samplePeriod of the capacity. The tags of missing blocks
+ * are reported through logMiss, a block filled without one is not sampled.
+ *
+ * To see how the choice changes over time, the policy closes a phase every phaseLength uses and records the decision
+ * of the follower at its end together with the misses of the leaders during the phase.
+ */
+template <typename T> class DIPPolicy final : public ReplacementPolicy<T> {
+  public:
+    enum class Insertion { LRU, Bimodal };
+
+    struct PhaseDecision {
+        std::uint64_t uses;                // uses logged up to the end of the phase
+        std::uint32_t psel;                // PSEL at the end of the phase
+        Insertion followerInsertion;       // the insertion the follower uses at the end of the phase
+        std::uint32_t lruLeaderMisses;     // misses of the LRU leader during the phase
+        std::uint32_t bimodalLeaderMisses; // misses of the BIP leader during the phase
+    };
+
+    void logUse(T usage) override;
+    T pop() override;
+    void logMiss(std::uint32_t tag) override;
+    std::size_t getCapacity() const { return size; }
+    DIPPolicy(std::size_t size, std::uint64_t phaseLength = defaultPhaseLength);
+    constexpr std::size_t calcBasicGates() const noexcept override;
+
+    Insertion getFollowerInsertion() const noexcept {
+        // bimodal only once the LRU leader misses more, a cache without any sampled miss stays LRU
+        return psel > (1u << pselBits) / 2 ? Insertion::Bimodal : Insertion::LRU;
+    }
+    /**
+     * The decisions of all phases so far, oldest first. An unfinished last phase is included as well if there has been
+     * a use since the end of the previous one.
+     */
+    std::vector<PhaseDecision> getSelectionHistory() const;
+
+    static constexpr std::uint32_t bimodalThrottle = 32;
+    static constexpr std::uint32_t pselBits = 10;
+    static constexpr std::uint64_t defaultPhaseLength = 10000;
+
+  private:
+    static constexpr std::uint32_t recency = 0; // front is the least, back the most recently used entry
+
+    // the sampled blocks a leader would hold, in its recency order
+    struct LeaderSet {
+        const Insertion insertion;
+        IndexLists lists;
+        GhostPool blocks;
+        std::uint32_t bimodalCounter{0};
+
+        LeaderSet(Insertion insertion, std::size_t capacity)
+            : insertion{insertion}, lists{capacity, 1}, blocks{0, capacity} {}
+        bool access(std::uint32_t tag) noexcept; // returns whether the block missed
+    };
+
+    const std::size_t size;
+    const std::uint64_t phaseLength;
+    const std::uint32_t samplePeriod;
+    IndexLists lists;
+    std::uint32_t bimodalCounter{0};
+    std::uint32_t psel{(1u << pselBits) / 2};
+    LeaderSet lruLeader;
+    LeaderSet bimodalLeader;
+    std::vector<std::uint32_t> tagOfCacheline;
+    std::uint32_t pendingTag{GhostPool::noTag};
+
+    std::uint64_t uses{0};
+    PhaseDecision currentPhase{};
+    std::vector<PhaseDecision> history;
+
+    // leaders of 32 entries, like the 32 leader sets of the original proposal, if the cache is big enough
+    static constexpr std::uint32_t samplePeriodOf(std::size_t size) noexcept {
+        return static_cast<std::uint32_t>(std::min<std::size_t>(std::max<std::size_t>(size / 32, 1), 32));
+    }
+    static constexpr std::size_t leaderCapacityOf(std::size_t size) noexcept {
+        return std::max<std::size_t>(size / samplePeriodOf(size), 1);
+    }
+    bool isSampled(std::uint32_t tag) const noexcept { return tag != GhostPool::noTag && tag % samplePeriod == 0; }
+    // inserts node at the most recently used position, or at the least recently used one when inserting bimodally
+    static void insert(IndexLists& lists, std::uint32_t node, Insertion insertion,
+                       std::uint32_t& bimodalCounter) noexcept;
+    void duel(std::uint32_t tag) noexcept;
+    PhaseDecision closedPhase() const noexcept;
+};
+
+template <typename T> constexpr std::uint32_t DIPPolicy<T>::bimodalThrottle;
+template <typename T> constexpr std::uint32_t DIPPolicy<T>::pselBits;
+template <typename T> constexpr std::uint64_t DIPPolicy<T>::defaultPhaseLength;
+template <typename T> constexpr std::uint32_t DIPPolicy<T>::recency;
+
+template <typename T>
+inline DIPPolicy<T>::DIPPolicy(std::size_t size, std::uint64_t phaseLength)
+    : size{size}, phaseLength{phaseLength}, samplePeriod{samplePeriodOf(size)}, lists{size, 1},
+      lruLeader{Insertion::LRU, leaderCapacityOf(size)}, bimodalLeader{Insertion::Bimodal, leaderCapacityOf(size)},
+      tagOfCacheline(size, GhostPool::noTag) {
+    assert(size > 0 && phaseLength > 0);
+}
+
+template <typename T>
+inline void DIPPolicy<T>::insert(IndexLists& lists, std::uint32_t node, Insertion insertion,
+                                 std::uint32_t& bimodalCounter) noexcept {
+    if (insertion == Insertion::Bimodal) {
+        bimodalCounter = (bimodalCounter + 1) % bimodalThrottle;
+        const auto leastRecentlyUsed = lists.front(recency);
+        if (bimodalCounter != 0 && leastRecentlyUsed != IndexLists::none) {
+            lists.insertBefore(leastRecentlyUsed, node);
+            return;
+        }
+    }
+    lists.pushBack(recency, node);
+}
+
+template <typename T> inline bool DIPPolicy<T>::LeaderSet::access(std::uint32_t tag) noexcept {
+    const auto entry = blocks.find(tag);
+    if (entry != TagTable::notFound) {
+        lists.moveToBack(recency, entry);
+        return false;
+    }
+    if (blocks.isFull()) {
+        const auto victim = lists.front(recency);
+        lists.remove(victim);
+        blocks.release(victim);
+    }
+    insert(lists, blocks.add(tag), insertion, bimodalCounter);
+    return true;
+}
+
+template <typename T> inline void DIPPolicy<T>::duel(std::uint32_t tag) noexcept {
+    if (!isSampled(tag))
+        return;
+    if (lruLeader.access(tag)) {
+        psel = std::min(addSatUnsigned(psel, 1u), (1u << pselBits) - 1);
+        currentPhase.lruLeaderMisses = addSatUnsigned(currentPhase.lruLeaderMisses, 1u);
+    }
+    if (bimodalLeader.access(tag)) {
+        psel = subSatUnsigned(psel, 1u);
+        currentPhase.bimodalLeaderMisses = addSatUnsigned(currentPhase.bimodalLeaderMisses, 1u);
+    }
+}
+
+template <typename T> inline void DIPPolicy<T>::logMiss(std::uint32_t tag) { pendingTag = tag; }
+
+template <typename T> inline typename DIPPolicy<T>::PhaseDecision DIPPolicy<T>::closedPhase() const noexcept {
+    PhaseDecision phase = currentPhase;
+    phase.uses = uses;
+    phase.psel = psel;
+    phase.followerInsertion = getFollowerInsertion();
+    return phase;
+}
+
+// precondition: usage lies in [0, size)
+template <typename T> inline void DIPPolicy<T>::logUse(T usage) {
+    const auto index = static_cast<std::uint32_t>(usage);
+    assert(index < size);
+    if (lists.contains(index)) { // hit
+        lists.moveToBack(recency, index);
+    } else { // cacheline was just filled
+        tagOfCacheline[index] = pendingTag;
+        pendingTag = GhostPool::noTag;
+        insert(lists, index, getFollowerInsertion(), bimodalCounter);
+    }
+    duel(tagOfCacheline[index]);
+
+    if (++uses % phaseLength == 0) {
+        history.push_back(closedPhase());
+        currentPhase = PhaseDecision{};
+    }
+}
+
+// Precondition: at least one cacheline was logged
+template <typename T> inline T DIPPolicy<T>::pop() {
+    const auto victim = lists.front(recency);
+    assert(victim != IndexLists::none);
+    lists.remove(victim);
+    tagOfCacheline[victim] = GhostPool::noTag;
+    return static_cast<T>(victim);
+}
+
+template <typename T>
+inline std::vector<typename DIPPolicy<T>::PhaseDecision> DIPPolicy<T>::getSelectionHistory() const {
+    auto decisions = history;
+    if (uses % phaseLength != 0)
+        decisions.push_back(closedPhase());
+    return decisions;
+}
+
+template <typename T> inline constexpr std::size_t DIPPolicy<T>::calcBasicGates() const noexcept {
+    // the recency list of LRU (two 32 bit registers per entry with 4 gates per bit and 4 32 bit multiplexers to relink)
+    // with a second insertion point at its front, once for the cache and once for each leader. The cache also keeps
+    // the tag of every cacheline, the leaders the tag of every entry with a comparator (32 * 2 gates). On top come the
+    // 5 bit counters throttling the bimodal insertions with their incrementers and PSEL with its up / down counter
+    const std::size_t listEntry = 2 * 32 * 4 + 4 * 32;
+    return addSatUnsigned(mulSatUnsigned(listEntry + 32 * 4, size),
+                          mulSatUnsigned(listEntry + 32 * 4 + 32 * 2, 2 * leaderCapacityOf(size)),
+                          static_cast<std::size_t>(3 * 32 * 4 + 2 * (5 * 4 + 150) + pselBits * 4 + 2 * 150));
+}
@@ -2,31 +2,41 @@
 #include "../RingQueue.h"
 #include "ReplacementPolicy.h"
 
-#include <unordered_set>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
-template <typename T> class FIFOPolicy : public ReplacementPolicy<T> {
+/**
+ * First in first out policy. The keys are cacheline indices, i.e. they always lie in [0, size), so whether a
+ * cacheline is already queued is kept in a bitset indexed by the cacheline instead of a hash set.
+ */
+template <typename T> class FIFOPolicy final : public ReplacementPolicy<T> {
   public:
     void logUse(T usage) override;
     T pop() override;
     std::size_t getSize() const { return contents.getSize(); }
-    FIFOPolicy(std::size_t size) : contents{size} {}
+    FIFOPolicy(std::size_t size) : contents{size}, itemsInCache(size, false) {}
     constexpr std::size_t calcBasicGates() const noexcept override;
 
   private:
     RingQueue<T> contents;
-    std::unordered_set<T> itemsInCache;
+    std::vector<bool> itemsInCache;
 };
 
+// precondition: usage lies in [0, size)
 template <typename T> inline void FIFOPolicy<T>::logUse(T usage) {
-    if (itemsInCache.count(usage) == 0) {
+    const auto index = static_cast<std::size_t>(usage);
+    assert(index < itemsInCache.size());
+    if (!itemsInCache[index]) {
         contents.push(usage);
-        itemsInCache.insert(usage);
+        itemsInCache[index] = true;
     }
 }
 
 template <typename T> inline T FIFOPolicy<T>::pop() {
     T popped = contents.pop();
-    itemsInCache.erase(popped);
+    itemsInCache[static_cast<std::size_t>(popped)] = false;
     return popped;
 }
 
@@ -35,4 +45,4 @@ template <typename T> inline constexpr std::size_t FIFOPolicy<T>::calcBasicGates
     // for comparison whether already in we need SIZE comparators and then an or chain
     // an adder for incrementing
     return 10 * getSize() + 1;
-}
\ No newline at end of file
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "TagTable.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Preallocated ghost entries for the policies remembering blocks that have been evicted from the cache. Ghost entries
+ * are the nodes [firstNode, firstNode + capacity), so they can live in the same IndexLists as the cachelines
+ * [0, firstNode). Every entry holds the tag of its block and can be looked up by it.
+ */
+class GhostPool {
+  public:
+    // marks a cacheline whose tag is unknown, because it was filled without the cache reporting the miss
+    enum : std::uint32_t { noTag = UINT32_MAX };
+
+    GhostPool(std::uint32_t firstNode, std::size_t capacity)
+        : firstNode{firstNode}, table{capacity}, tags(capacity, noTag) {
+        freeNodes.reserve(capacity);
+        for (std::size_t i = capacity; i > 0; --i)
+            freeNodes.push_back(firstNode + static_cast<std::uint32_t>(i - 1));
+    }
+
+    std::uint32_t find(std::uint32_t tag) const noexcept { return tag == noTag ? TagTable::notFound : table.find(tag); }
+    bool isFull() const noexcept { return freeNodes.empty(); }
+    bool isGhost(std::uint32_t node) const noexcept { return node >= firstNode; }
+    std::uint32_t tagOf(std::uint32_t node) const noexcept { return tags[node - firstNode]; }
+
+    // precondition: the pool is not full and tag is known
+    std::uint32_t add(std::uint32_t tag) noexcept {
+        assert(!isFull() && tag != noTag);
+        const auto node = freeNodes.back();
+        freeNodes.pop_back();
+        tags[node - firstNode] = tag;
+        table.insert(tag, node);
+        return node;
+    }
+
+    void release(std::uint32_t node) noexcept {
+        assert(isGhost(node) && tags[node - firstNode] != noTag);
+        table.erase(tags[node - firstNode]);
+        tags[node - firstNode] = noTag;
+        freeNodes.push_back(node); // never exceeds the reserved capacity
+    }
+
+  private:
+    const std::uint32_t firstNode;
+    TagTable table;
+    std::vector<std::uint32_t> tags;
+    std::vector<std::uint32_t> freeNodes;
+};
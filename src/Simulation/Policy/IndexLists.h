@@ -0,0 +1,78 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A fixed number of doubly linked lists over the nodes [0, numNodes), threaded through two preallocated index arrays
+ * just like the list of the LRU policy. Node numNodes + i is the sentinel of list i, a node that is in no list points
+ * to itself. Every node is in at most one list at a time. Front is the oldest end of a list, back the newest one.
+ * All operations are O(1).
+ */
+class IndexLists {
+  public:
+    enum : std::uint32_t { none = UINT32_MAX };
+
+    IndexLists(std::size_t numNodes, std::size_t numLists)
+        : numNodes{static_cast<std::uint32_t>(numNodes)}, prev(numNodes + numLists), next(numNodes + numLists) {
+        for (std::uint32_t index = 0; index < prev.size(); ++index) {
+            prev[index] = index;
+            next[index] = index;
+        }
+    }
+
+    bool contains(std::uint32_t node) const noexcept { return next[node] != node; }
+    bool isEmpty(std::uint32_t list) const noexcept { return !contains(sentinelOf(list)); }
+    std::uint32_t front(std::uint32_t list) const noexcept { return orNone(next[sentinelOf(list)]); }
+    std::uint32_t back(std::uint32_t list) const noexcept { return orNone(prev[sentinelOf(list)]); }
+    std::uint32_t following(std::uint32_t node) const noexcept { return orNone(next[node]); }
+
+    void pushBack(std::uint32_t list, std::uint32_t node) noexcept { insertBefore(sentinelOf(list), node); }
+
+    // inserts node in front of position, which has to be in a list or a sentinel
+    void insertBefore(std::uint32_t position, std::uint32_t node) noexcept {
+        assert(!contains(node) && (contains(position) || position >= numNodes));
+        prev[node] = prev[position];
+        next[node] = position;
+        next[prev[position]] = node;
+        prev[position] = node;
+    }
+
+    void remove(std::uint32_t node) noexcept {
+        assert(node < numNodes);
+        next[prev[node]] = next[node];
+        prev[next[node]] = prev[node];
+        prev[node] = node;
+        next[node] = node;
+    }
+
+    void moveToBack(std::uint32_t list, std::uint32_t node) noexcept {
+        remove(node);
+        pushBack(list, node);
+    }
+
+    // appends all nodes of list from to list to, leaving from empty
+    void splice(std::uint32_t to, std::uint32_t from) noexcept {
+        const auto fromSentinel = sentinelOf(from);
+        const auto toSentinel = sentinelOf(to);
+        if (fromSentinel == toSentinel || !contains(fromSentinel))
+            return;
+        const auto first = next[fromSentinel];
+        const auto last = prev[fromSentinel];
+        next[prev[toSentinel]] = first;
+        prev[first] = prev[toSentinel];
+        next[last] = toSentinel;
+        prev[toSentinel] = last;
+        prev[fromSentinel] = fromSentinel;
+        next[fromSentinel] = fromSentinel;
+    }
+
+  private:
+    const std::uint32_t numNodes;
+    std::vector<std::uint32_t> prev;
+    std::vector<std::uint32_t> next;
+
+    std::uint32_t sentinelOf(std::uint32_t list) const noexcept { return numNodes + list; }
+    std::uint32_t orNone(std::uint32_t node) const noexcept { return node >= numNodes ? none : node; }
+};
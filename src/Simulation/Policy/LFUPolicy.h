@@ -0,0 +1,113 @@
+#pragma once
+#include "../Saturating_Arithmetic.h"
+#include "IndexLists.h"
+#include "ReplacementPolicy.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Least frequently used policy with aging. Every cacheline has a saturating 4 bit use counter, a filled cacheline
+ * starts at 1. The victim is a cacheline with the lowest count, among those the one that reached its count first.
+ * Every agingInterval * size uses all counters are halved, so blocks that were hot a long time ago do not stay forever.
+ * Cachelines whose counts were halved to the same value are evicted by their count before the aging first, the lower
+ * one going first, and only then by the order they reached it.
+ *
+ * Cachelines are kept in one list per count, which makes a use O(1) and a pop O(maxFrequency). Aging never touches the
+ * cachelines either: the lists of the counts 2k and 2k + 1 are spliced into the new list of count k, and every
+ * cacheline remembers the aging epoch its counter was last written in, so its current count is the stored one shifted
+ * right by the number of agings since.
+ */
+template <typename T> class LFUPolicy final : public ReplacementPolicy<T> {
+  public:
+    void logUse(T usage) override;
+    T pop() override;
+    std::size_t getCapacity() const { return size; }
+    LFUPolicy(std::size_t size);
+    constexpr std::size_t calcBasicGates() const noexcept override;
+
+    static constexpr std::uint32_t counterBits = 4;
+    static constexpr std::uint32_t maxFrequency = (1u << counterBits) - 1;
+    static constexpr std::size_t agingInterval = 8;
+
+  private:
+    const std::size_t size;
+    IndexLists lists;
+    std::array<std::uint32_t, maxFrequency + 1> listOfFrequency;
+    std::vector<std::uint8_t> storedFrequency;
+    std::vector<std::uint32_t> storedInEpoch;
+    std::uint32_t epoch{0};
+    std::size_t usesSinceAging{0};
+
+    std::uint32_t frequencyOf(std::uint32_t index) const noexcept {
+        const std::uint32_t agingsSince = epoch - storedInEpoch[index];
+        return agingsSince >= counterBits ? 0 : storedFrequency[index] >> agingsSince;
+    }
+    void age() noexcept;
+};
+
+template <typename T> constexpr std::uint32_t LFUPolicy<T>::counterBits;
+template <typename T> constexpr std::uint32_t LFUPolicy<T>::maxFrequency;
+template <typename T> constexpr std::size_t LFUPolicy<T>::agingInterval;
+
+template <typename T>
+inline LFUPolicy<T>::LFUPolicy(std::size_t size)
+    : size{size}, lists{size, maxFrequency + 1}, storedFrequency(size, 0), storedInEpoch(size, 0) {
+    assert(size > 0);
+    for (std::uint32_t frequency = 0; frequency <= maxFrequency; ++frequency)
+        listOfFrequency[frequency] = frequency;
+}
+
+template <typename T> inline void LFUPolicy<T>::age() noexcept {
+    std::array<std::uint32_t, maxFrequency + 1> aged;
+    for (std::uint32_t frequency = 0; frequency <= maxFrequency / 2; ++frequency) {
+        lists.splice(listOfFrequency[2 * frequency], listOfFrequency[2 * frequency + 1]);
+        aged[frequency] = listOfFrequency[2 * frequency];
+        aged[frequency + (maxFrequency + 1) / 2] = listOfFrequency[2 * frequency + 1]; // now empty
+    }
+    listOfFrequency = aged;
+    ++epoch;
+    usesSinceAging = 0;
+}
+
+// precondition: usage lies in [0, size)
+template <typename T> inline void LFUPolicy<T>::logUse(T usage) {
+    const auto index = static_cast<std::uint32_t>(usage);
+    assert(index < size);
+    std::uint32_t frequency = 1; // the cacheline was just filled
+    if (lists.contains(index)) {
+        frequency = std::min(frequencyOf(index) + 1, maxFrequency);
+        lists.remove(index);
+    }
+    storedFrequency[index] = static_cast<std::uint8_t>(frequency);
+    storedInEpoch[index] = epoch;
+    lists.pushBack(listOfFrequency[frequency], index);
+
+    if (++usesSinceAging == agingInterval * size)
+        age();
+}
+
+// Precondition: at least one cacheline was logged
+template <typename T> inline T LFUPolicy<T>::pop() {
+    for (const auto list : listOfFrequency) {
+        const auto victim = lists.front(list);
+        if (victim != IndexLists::none) {
+            lists.remove(victim);
+            return static_cast<T>(victim);
+        }
+    }
+    assert(false && "pop on empty LFU policy");
+    return T{};
+}
+
+template <typename T> inline constexpr std::size_t LFUPolicy<T>::calcBasicGates() const noexcept {
+    // a 4 bit counter per cacheline (4 gates per bit) with its incrementer (about 2 gates per bit) and a shifter for
+    // aging (1 gate per bit), plus a tree of comparators finding the lowest counter, about 6 gates per bit and
+    // cacheline. The aging timer is a single 32 bit counter
+    return addSatUnsigned(mulSatUnsigned(static_cast<std::size_t>((4 + 2 + 1 + 6) * counterBits), size),
+                          static_cast<std::size_t>(32 * 4 + 150));
+}
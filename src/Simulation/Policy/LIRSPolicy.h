@@ -0,0 +1,188 @@
+#pragma once
+#include "../Saturating_Arithmetic.h"
+#include "GhostPool.h"
+#include "IndexLists.h"
+#include "ReplacementPolicy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Low inter-reference recency set policy (Jiang and Zhang). Most of the cache holds LIR blocks, i.e. blocks reused
+ * within a short distance, a small part (1 percent, at least one cacheline) holds HIR blocks, which are the only ones
+ * ever evicted. The recency stack S holds all LIR blocks and the HIR blocks used since the oldest LIR block, including
+ * evicted ones, which are kept as ghost entries. A HIR block used again while still in S has a shorter reuse distance
+ * than the oldest LIR block and swaps roles with it. Its bottom always is a LIR block, every other block is removed
+ * once it gets there ("pruning"). The queue Q holds the resident HIR blocks in eviction order.
+ *
+ * Cachelines are the nodes [0, size), ghost entries the nodes [size, 2 * size). S and Q are two separate IndexLists
+ * over these nodes - ghost entries use the second list of the latter to be dropped oldest first once the pool is
+ * full, which bounds the size of S. The tags of missing blocks are reported through logMiss, a fill without one is
+ * treated like a block never seen before.
+ */
+template <typename T> class LIRSPolicy final : public ReplacementPolicy<T> {
+  public:
+    void logUse(T usage) override;
+    T pop() override;
+    void logMiss(std::uint32_t tag) override;
+    std::size_t getCapacity() const { return size; }
+    std::size_t getNumLIRCachelines() const { return numLIR; }
+    LIRSPolicy(std::size_t size);
+    constexpr std::size_t calcBasicGates() const noexcept override;
+
+  private:
+    static constexpr std::uint32_t stack = 0;
+    static constexpr std::uint32_t residentHIR = 0;
+    static constexpr std::uint32_t ghostAge = 1;
+
+    const std::size_t size;
+    const std::size_t maxLIR;
+    IndexLists recency; // S, bottom at the front
+    IndexLists queues;  // Q and the ghost entries by age
+    GhostPool ghosts;
+    std::vector<bool> isLIR;
+    std::size_t numLIR{0};
+    std::vector<std::uint32_t> tagOfCacheline;
+
+    bool missPending{false};
+    std::uint32_t pendingTag{GhostPool::noTag};
+    std::uint32_t pendingGhost{TagTable::notFound};
+
+    bool isResident(std::uint32_t index) const noexcept { return isLIR[index] || queues.contains(index); }
+    void prepareMiss(std::uint32_t tag) noexcept;
+    void dropGhost(std::uint32_t ghost) noexcept;
+    void makeLIR(std::uint32_t index) noexcept;
+    void demoteOldestLIR() noexcept;
+    void prune() noexcept;
+};
+
+template <typename T>
+inline LIRSPolicy<T>::LIRSPolicy(std::size_t size)
+    : size{size}, maxLIR{size - std::max<std::size_t>(size / 100, 1)}, recency{2 * size, 1}, queues{2 * size, 2},
+      ghosts{static_cast<std::uint32_t>(size), size}, isLIR(size, false), tagOfCacheline(size, GhostPool::noTag) {
+    assert(size > 0);
+}
+
+template <typename T> inline void LIRSPolicy<T>::prepareMiss(std::uint32_t tag) noexcept {
+    missPending = true;
+    pendingTag = tag;
+    pendingGhost = ghosts.find(tag);
+}
+
+template <typename T> inline void LIRSPolicy<T>::logMiss(std::uint32_t tag) { prepareMiss(tag); }
+
+template <typename T> inline void LIRSPolicy<T>::dropGhost(std::uint32_t ghost) noexcept {
+    recency.remove(ghost);
+    queues.remove(ghost);
+    ghosts.release(ghost);
+    if (ghost == pendingGhost)
+        pendingGhost = TagTable::notFound;
+}
+
+template <typename T> inline void LIRSPolicy<T>::makeLIR(std::uint32_t index) noexcept {
+    isLIR[index] = true;
+    ++numLIR;
+}
+
+template <typename T> inline void LIRSPolicy<T>::demoteOldestLIR() noexcept {
+    prune(); // without any LIR cacheline (i.e. with a single cacheline) the bottom of S may be a HIR one
+    const auto oldest = recency.front(stack);
+    assert(oldest != IndexLists::none && oldest < size && isLIR[oldest]);
+    recency.remove(oldest);
+    isLIR[oldest] = false;
+    --numLIR;
+    queues.pushBack(residentHIR, oldest);
+    prune();
+}
+
+template <typename T> inline void LIRSPolicy<T>::prune() noexcept {
+    for (auto bottom = recency.front(stack); bottom != IndexLists::none; bottom = recency.front(stack)) {
+        if (ghosts.isGhost(bottom)) {
+            dropGhost(bottom);
+        } else if (!isLIR[bottom]) {
+            recency.remove(bottom); // stays resident in Q
+        } else {
+            return;
+        }
+    }
+}
+
+// precondition: usage lies in [0, size)
+template <typename T> inline void LIRSPolicy<T>::logUse(T usage) {
+    const auto index = static_cast<std::uint32_t>(usage);
+    assert(index < size);
+    if (isLIR[index]) {
+        const bool wasBottom = recency.front(stack) == index;
+        recency.moveToBack(stack, index);
+        if (wasBottom)
+            prune();
+        return;
+    }
+    if (isResident(index)) { // HIR hit
+        if (recency.contains(index)) {
+            recency.moveToBack(stack, index);
+            queues.remove(index);
+            makeLIR(index);
+            if (numLIR > maxLIR)
+                demoteOldestLIR();
+        } else {
+            recency.pushBack(stack, index);
+            queues.moveToBack(residentHIR, index);
+        }
+        return;
+    }
+
+    // the cacheline was just filled
+    if (!missPending)
+        prepareMiss(GhostPool::noTag);
+    tagOfCacheline[index] = pendingTag;
+    missPending = false;
+    if (pendingGhost != TagTable::notFound) { // reused while its ghost entry still was in S
+        dropGhost(pendingGhost);
+        recency.pushBack(stack, index);
+        makeLIR(index);
+        if (numLIR > maxLIR)
+            demoteOldestLIR();
+    } else if (numLIR < maxLIR) {
+        recency.pushBack(stack, index);
+        makeLIR(index);
+    } else {
+        recency.pushBack(stack, index);
+        queues.pushBack(residentHIR, index);
+    }
+}
+
+// Precondition: the cache is full
+template <typename T> inline T LIRSPolicy<T>::pop() {
+    if (queues.isEmpty(residentHIR)) // only possible if the whole cache is LIR, e.g. with a single cacheline
+        demoteOldestLIR();
+    const auto victim = queues.front(residentHIR);
+    assert(victim != IndexLists::none);
+    queues.remove(victim);
+
+    const auto tag = tagOfCacheline[victim];
+    tagOfCacheline[victim] = GhostPool::noTag;
+    if (recency.contains(victim)) {
+        // remember the evicted block in its place in S
+        if (tag != GhostPool::noTag) {
+            if (ghosts.isFull())
+                dropGhost(queues.front(ghostAge));
+            const auto ghost = ghosts.add(tag);
+            recency.insertBefore(victim, ghost);
+            queues.pushBack(ghostAge, ghost);
+        }
+        recency.remove(victim);
+    }
+    return static_cast<T>(victim);
+}
+
+template <typename T> inline constexpr std::size_t LIRSPolicy<T>::calcBasicGates() const noexcept {
+    // four 32 bit pointer registers (4 gates per bit) per entry for S and Q together with their relinking multiplexers,
+    // for twice as many entries as there are cachelines. The ghost entries additionally need their tag and a comparator
+    // (32 * 2 gates) each, the LIR bits and their counter are negligible
+    return addSatUnsigned(mulSatUnsigned(static_cast<std::size_t>(4 * 32 * 4 + 8 * 32), 2 * size),
+                          mulSatUnsigned(static_cast<std::size_t>(32 * 4 + 32 * 2), size));
+}
@@ -3,61 +3,87 @@
 #include "ReplacementPolicy.h"
 
 #include <assert.h>
+#include <cstddef>
 #include <cstdint>
-#include <initializer_list>
-#include <iostream>
-#include <list>
-#include <memory>
-#include <type_traits>
-#include <unordered_map>
-
-template <typename T> class LRUPolicy : public ReplacementPolicy<T> {
+#include <vector>
+
+/**
+ * Least recently used policy. The keys are cacheline indices, i.e. they always lie in [0, size). This allows us to
+ * keep the recency order as a doubly linked list threaded through two preallocated index arrays: prev[i] and next[i]
+ * are the neighbours of cacheline i. Index size is a sentinel closing the list into a ring, the most recently used
+ * element follows it and the least recently used one precedes it. A cacheline not in the list points to itself.
+ * Every operation is O(1), without any allocation or hashing.
+ */
+template <typename T> class LRUPolicy final : public ReplacementPolicy<T> {
   public:
     void logUse(T usage) override;
     // Return by value since T is small
     T pop() override;
-    std::size_t getSize() const { return cache.size(); }
+    std::size_t getSize() const { return numEntries; }
     std::size_t getCapacity() const { return size; }
-    LRUPolicy(std::size_t size) : size{size} {}
+    LRUPolicy(std::size_t size);
     constexpr std::size_t calcBasicGates() const noexcept override;
 
   private:
     const std::size_t size;
-    std::list<T> cache;
-    // necessary because of dependant type
-    typedef typename std::list<T>::iterator ItType;
-    std::unordered_map<T, ItType> mapping;
+    const std::uint32_t sentinel;
+    std::vector<std::uint32_t> prev;
+    std::vector<std::uint32_t> next;
+    std::size_t numEntries{0};
+
+    bool isInList(std::uint32_t index) const noexcept { return next[index] != index; }
+    void unlink(std::uint32_t index) noexcept;
+    void pushFront(std::uint32_t index) noexcept;
 };
 
-// precondition: either usage is in the cache already OR there is enough space
-// left
+template <typename T>
+inline LRUPolicy<T>::LRUPolicy(std::size_t size)
+    : size{size}, sentinel{static_cast<std::uint32_t>(size)}, prev(size + 1), next(size + 1) {
+    for (std::uint32_t index = 0; index <= sentinel; ++index) {
+        prev[index] = index;
+        next[index] = index;
+    }
+}
+
+template <typename T> inline void LRUPolicy<T>::unlink(std::uint32_t index) noexcept {
+    next[prev[index]] = next[index];
+    prev[next[index]] = prev[index];
+}
+
+template <typename T> inline void LRUPolicy<T>::pushFront(std::uint32_t index) noexcept {
+    next[index] = next[sentinel];
+    prev[index] = sentinel;
+    prev[next[sentinel]] = index;
+    next[sentinel] = index;
+}
+
+// precondition: usage lies in [0, size)
 template <typename T> void inline LRUPolicy<T>::logUse(T usage) {
-    if (mapping.count(usage) != 0) {
-        const auto& it = mapping[usage];
-        cache.erase(it);
-        cache.push_front(usage);
+    const auto index = static_cast<std::uint32_t>(usage);
+    assert(index < size);
+    if (isInList(index)) {
+        unlink(index);
     } else {
-        assert(cache.size() < size);
-        cache.push_front(usage);
+        ++numEntries;
     }
-    mapping[usage] = cache.begin();
+    pushFront(index);
 }
 
 // Precondition: Non-Empty cache
 template <typename T> inline T LRUPolicy<T>::pop() {
-    assert(!cache.empty());
-    const auto retVal = cache.back();
-    cache.pop_back();
-    assert(mapping.find(retVal) != mapping.end());
-    mapping.erase(retVal);
-    return retVal;
+    assert(numEntries > 0);
+    const auto leastRecentlyUsed = prev[sentinel];
+    unlink(leastRecentlyUsed);
+    prev[leastRecentlyUsed] = leastRecentlyUsed;
+    next[leastRecentlyUsed] = leastRecentlyUsed;
+    --numEntries;
+    return static_cast<T>(leastRecentlyUsed);
 }
 
 template <typename T> inline constexpr std::size_t LRUPolicy<T>::calcBasicGates() const noexcept {
-    // this is difficult to say as we are really not emulating hardware very well here (lots of dynamic memory
-    // allocation). This is not really necessary, but as there is no requirement of making this synthesisable, we opted
-    // for a more general amortized O(1) approach
-    // lets assume the linked list is an array of registers and we are storing about 32 bit in each T
-    // further assume the hashings use the same hash table as used in the main Cache => 2753000
-    return addSatUnsigned(mulSatUnsigned(static_cast<size_t>(32), getCapacity()), static_cast<size_t>(2753000));
-}
\ No newline at end of file
+    // this is difficult to say as we are really not emulating hardware very well here. Lets assume the list is an array
+    // of registers and we are storing about 32 bit in each T. The estimate still assumes the hash table used in the main
+    // Cache => 2753000, as the list linked through arrays has been chosen for the speed of the simulation only
+    return addSatUnsigned(mulSatUnsigned(static_cast<std::size_t>(32), getCapacity()),
+                          static_cast<std::size_t>(2753000));
+}
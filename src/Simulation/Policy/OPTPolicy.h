@@ -0,0 +1,113 @@
+#pragma once
+#include "ReplacementPolicy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Belady's optimal policy (OPT): the victim is the cacheline whose block is used again farthest in the future. It needs
+ * to know all accesses in advance, so it is no real policy but the bound every other one is measured against.
+ *
+ * It is constructed with the sequence of blocks the cache is going to access, i.e. one entry per call of logUse, and
+ * computes the index of the next access to the same block for every access with a single backward pass. Each logUse
+ * advances the position in that sequence and stores the next use of the cacheline in a max-heap. Entries that became
+ * outdated by a later use are only discarded once they reach the top, the heap is rebuilt from the current next uses
+ * whenever it grows beyond a few times the cache size, which keeps every operation amortised O(log size).
+ */
+template <typename T> class OPTPolicy final : public ReplacementPolicy<T> {
+  public:
+    void logUse(T usage) override;
+    T pop() override;
+    std::size_t getCapacity() const { return size; }
+    OPTPolicy(std::size_t size, const std::vector<std::uint32_t>& accessedBlocks);
+    constexpr std::size_t calcBasicGates() const noexcept override;
+
+    static constexpr std::size_t never = SIZE_MAX;
+
+  private:
+    using HeapEntry = std::pair<std::size_t, std::uint32_t>; // next use, cacheline
+
+    const std::size_t size;
+    std::vector<std::size_t> nextUseOfAccess;
+    std::size_t currentAccess{0};
+    std::vector<std::size_t> nextUseOfCacheline;
+    std::vector<bool> isResident;
+    std::vector<HeapEntry> heap;
+
+    bool isCurrent(const HeapEntry& entry) const noexcept {
+        return isResident[entry.second] && nextUseOfCacheline[entry.second] == entry.first;
+    }
+    void rebuildHeap() noexcept;
+};
+
+template <typename T> constexpr std::size_t OPTPolicy<T>::never;
+
+template <typename T>
+inline OPTPolicy<T>::OPTPolicy(std::size_t size, const std::vector<std::uint32_t>& accessedBlocks)
+    : size{size}, nextUseOfAccess(accessedBlocks.size(), never), nextUseOfCacheline(size, never),
+      isResident(size, false) {
+    assert(size > 0);
+    std::unordered_map<std::uint32_t, std::size_t> laterAccessOfBlock{};
+    for (std::size_t access = accessedBlocks.size(); access > 0; --access) {
+        const auto block = accessedBlocks[access - 1];
+        auto later = laterAccessOfBlock.find(block);
+        if (later != laterAccessOfBlock.end()) {
+            nextUseOfAccess[access - 1] = later->second;
+            later->second = access - 1;
+        } else {
+            laterAccessOfBlock.emplace(block, access - 1);
+        }
+    }
+    heap.reserve(4 * size + 1);
+}
+
+template <typename T> inline void OPTPolicy<T>::rebuildHeap() noexcept {
+    heap.clear();
+    for (std::uint32_t index = 0; index < size; ++index) {
+        if (isResident[index])
+            heap.emplace_back(nextUseOfCacheline[index], index);
+    }
+    std::make_heap(heap.begin(), heap.end());
+}
+
+// precondition: usage lies in [0, size)
+template <typename T> inline void OPTPolicy<T>::logUse(T usage) {
+    const auto index = static_cast<std::uint32_t>(usage);
+    assert(index < size);
+    // accesses beyond the known sequence are never used again as far as we know
+    const auto nextUse = currentAccess < nextUseOfAccess.size() ? nextUseOfAccess[currentAccess] : never;
+    ++currentAccess;
+
+    isResident[index] = true;
+    nextUseOfCacheline[index] = nextUse;
+    if (heap.size() == 4 * size) {
+        rebuildHeap(); // already contains the new next use
+        return;
+    }
+    heap.emplace_back(nextUse, index);
+    std::push_heap(heap.begin(), heap.end());
+}
+
+// Precondition: at least one cacheline was logged
+template <typename T> inline T OPTPolicy<T>::pop() {
+    while (!isCurrent(heap.front())) {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.pop_back();
+        assert(!heap.empty());
+    }
+    const auto victim = heap.front().second;
+    std::pop_heap(heap.begin(), heap.end());
+    heap.pop_back();
+    isResident[victim] = false;
+    return static_cast<T>(victim);
+}
+
+template <typename T> inline constexpr std::size_t OPTPolicy<T>::calcBasicGates() const noexcept {
+    // knowing the future cannot be built, so OPT has no hardware equivalent to count
+    return 0;
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include "PolicyPlugin.h"
+#include "ReplacementPolicy.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include <dlfcn.h>
+
+// a plugin could not be loaded, refused to create a policy or broke its contract during the simulation
+class PolicyPluginError : public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * Replacement policy implemented by a plugin loaded from a shared library, see PolicyPlugin.h for its interface. Every
+ * instance opens the library itself, so it stays loaded as long as any policy created by it is alive. All calls go
+ * through the function pointers of the plugin and cannot be inlined, even in a cache bound to this class.
+ */
+template <typename T> class PluginPolicy final : public ReplacementPolicy<T> {
+  public:
+    void logUse(T usage) override;
+    T pop() override;
+    void logMiss(std::uint32_t tag) override;
+    std::size_t getCapacity() const { return size; }
+    const char* getName() const noexcept { return plugin->name; }
+    // throws PolicyPluginError if the library at libraryPath is no compatible plugin or cannot handle size cachelines
+    PluginPolicy(std::size_t size, const char* libraryPath);
+    ~PluginPolicy() override;
+    PluginPolicy(const PluginPolicy&) = delete;
+    PluginPolicy& operator=(const PluginPolicy&) = delete;
+    std::size_t calcBasicGates() const noexcept override;
+
+  private:
+    const std::size_t size;
+    void* library{nullptr};
+    const PolicyPlugin* plugin{nullptr};
+    void* state{nullptr};
+
+    [[noreturn]] void fail(const std::string& libraryPath, const std::string& reason);
+};
+
+template <typename T> inline void PluginPolicy<T>::fail(const std::string& libraryPath, const std::string& reason) {
+    if (library != nullptr)
+        dlclose(library);
+    throw PolicyPluginError{"Could not load policy plugin '" + libraryPath + "': " + reason};
+}
+
+template <typename T>
+inline PluginPolicy<T>::PluginPolicy(std::size_t size, const char* libraryPath) : size{size} {
+    assert(size > 0 && libraryPath != nullptr);
+    library = dlopen(libraryPath, RTLD_NOW | RTLD_LOCAL);
+    if (library == nullptr)
+        fail(libraryPath, dlerror());
+
+    dlerror(); // the symbol may legitimately be NULL, so errors are only told apart by dlerror
+    const auto entryPoint = reinterpret_cast<PolicyPluginEntryPoint>(dlsym(library, POLICY_PLUGIN_ENTRY_POINT));
+    if (const char* error = dlerror())
+        fail(libraryPath, error);
+    if (entryPoint == nullptr || (plugin = entryPoint()) == nullptr)
+        fail(libraryPath, "it provides no policy");
+    if (plugin->abiVersion != POLICY_PLUGIN_ABI_VERSION)
+        fail(libraryPath, "it was built for ABI version " + std::to_string(plugin->abiVersion) + " instead of " +
+                              std::to_string(POLICY_PLUGIN_ABI_VERSION));
+    if (plugin->create == nullptr || plugin->destroy == nullptr || plugin->logUse == nullptr ||
+        plugin->pop == nullptr || plugin->calcBasicGates == nullptr)
+        fail(libraryPath, "it lacks one of the required functions");
+    state = plugin->create(size);
+    if (state == nullptr)
+        fail(libraryPath, "it cannot handle " + std::to_string(size) + " cachelines");
+}
+
+template <typename T> inline PluginPolicy<T>::~PluginPolicy() {
+    plugin->destroy(state);
+    dlclose(library);
+}
+
+// precondition: usage lies in [0, size)
+template <typename T> inline void PluginPolicy<T>::logUse(T usage) {
+    assert(static_cast<std::size_t>(usage) < size);
+    plugin->logUse(state, static_cast<std::uint32_t>(usage));
+}
+
+// the victim is passed on unchecked, a broken plugin may return one >= getCapacity(). The cache checks it
+template <typename T> inline T PluginPolicy<T>::pop() { return static_cast<T>(plugin->pop(state)); }
+
+template <typename T> inline void PluginPolicy<T>::logMiss(std::uint32_t tag) {
+    if (plugin->logMiss != nullptr)
+        plugin->logMiss(state, tag);
+}
+
+template <typename T> inline std::size_t PluginPolicy<T>::calcBasicGates() const noexcept {
+    return plugin->calcBasicGates(state);
+}
@@ -1,3 +1,19 @@
 #pragma once
 
-enum CacheReplacementPolicy { POLICY_LRU, POLICY_FIFO, POLICY_RANDOM };
\ No newline at end of file
+enum CacheReplacementPolicy {
+    POLICY_LRU,
+    POLICY_FIFO,
+    POLICY_RANDOM,
+    POLICY_PLRU,
+    POLICY_BITPLRU,
+    POLICY_SRRIP,
+    POLICY_BRRIP,
+    POLICY_DRRIP,
+    POLICY_LFU,
+    POLICY_ARC,
+    POLICY_TWO_QUEUE,
+    POLICY_LIRS,
+    POLICY_OPT,
+    POLICY_DIP,
+    POLICY_PLUGIN // implemented by the shared library SimulationOptions::policyPlugin
+};
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Stable C interface of replacement policies loaded at runtime with --policy-plugin. A plugin is a shared library
+ * exporting the function named by POLICY_PLUGIN_ENTRY_POINT, which returns a pointer to a PolicyPlugin living as long
+ * as the library is loaded. The simulator checks abiVersion against its own POLICY_PLUGIN_ABI_VERSION and refuses
+ * plugins built against another one.
+ *
+ * The functions mirror ReplacementPolicy: cachelines are the indices [0, numCacheLines) of the fully associative cache.
+ * On a miss the cache calls logMiss (if set) with the tag of the missing block, pop if it is full, and logUse with the
+ * cacheline it filled. A hit only calls logUse. pop has to return a cacheline logged before and not popped since.
+ * All functions get the state create returned, which is passed to destroy once the cache is done with the policy. A
+ * simulation may create several independent states, e.g. one for the data cache and one for the L2.
+ */
+
+#define POLICY_PLUGIN_ABI_VERSION 1
+#define POLICY_PLUGIN_ENTRY_POINT "cache_policy_plugin"
+
+struct PolicyPlugin {
+    uint32_t abiVersion; // POLICY_PLUGIN_ABI_VERSION the plugin was built against
+    const char* name;    // shown in error messages
+
+    void* (*create)(size_t numCacheLines); // NULL if the policy cannot handle that many cachelines
+    void (*destroy)(void* state);
+    void (*logUse)(void* state, uint32_t cacheline);
+    uint32_t (*pop)(void* state);
+    void (*logMiss)(void* state, uint32_t tag); // may be NULL if the policy keeps no history of blocks
+    size_t (*calcBasicGates)(const void* state);
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// the entry point every plugin exports
+typedef const struct PolicyPlugin* (*PolicyPluginEntryPoint)(void);
+#ifdef __cplusplus
+}
+#endif
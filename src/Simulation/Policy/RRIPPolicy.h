@@ -0,0 +1,186 @@
+#pragma once
+#include "../DecomposedAddress.h"
+#include "../Saturating_Arithmetic.h"
+#include "ReplacementPolicy.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Re-reference interval prediction (RRIP) policies. Every cacheline has a re-reference prediction value (RRPV) of
+ * rrpvBits bits, 0 meaning it is expected to be used again soon and the maximum meaning it is expected to be used again
+ * in the distant future. A hit sets the RRPV to 0, the victim is a cacheline with the maximum RRPV. If there is none,
+ * all RRPVs are incremented until there is one. How a filled cacheline is inserted depends on the variant:
+ * - Static (SRRIP) inserts with the maximum - 1, so a scan never evicts lines that were hit before.
+ * - Bimodal (BRRIP) inserts with the maximum and only every 32nd time with the maximum - 1, which protects a part of
+ *   the working set against thrashing.
+ * - Dynamic (DRRIP) picks between the two by set dueling. As the fully associative cache consists of a single set, we
+ *   duel with interleaved groups of cachelines instead: a few leader lines always use SRRIP, a few others always BRRIP,
+ *   and a miss refilling a leader line counts against its variant in the saturating counter PSEL. All other lines
+ *   use the variant currently missing less.
+ *
+ * A filled cacheline is recognised by being logged for the first time or right after it was popped. Cachelines are
+ * kept in one list per RRPV, so a use takes O(1) and a pop O(2^rrpvBits). Incrementing all RRPVs never needs to touch
+ * the cachelines: it is only done when the list of the maximum RRPV is empty, so it just relabels which list belongs
+ * to which RRPV. Within a list the line that got its RRPV first is chosen as victim.
+ */
+template <typename T> class RRIPPolicy final : public ReplacementPolicy<T> {
+  public:
+    enum class Insertion { Static, Bimodal, Dynamic };
+
+    void logUse(T usage) override;
+    T pop() override;
+    std::size_t getCapacity() const { return size; }
+    RRIPPolicy(std::size_t size, Insertion insertion, std::uint32_t rrpvBits = 2);
+    constexpr std::size_t calcBasicGates() const noexcept override;
+
+    static constexpr std::uint32_t bimodalThrottle = 32;
+    static constexpr std::uint32_t pselBits = 10;
+
+  private:
+    const std::size_t size;
+    const Insertion insertion;
+    const std::uint32_t rrpvBits;
+    const std::uint32_t maxRRPV;
+    const std::uint32_t numLists;
+
+    // the lists are threaded through these arrays, index size + i is the sentinel of the i-th list. A cacheline that is
+    // not in any list points to itself
+    std::vector<std::uint32_t> prev;
+    std::vector<std::uint32_t> next;
+    std::uint32_t listRotation{0}; // the list of RRPV r is the ((r + listRotation) mod numLists)-th one
+
+    std::uint32_t bimodalCounter{0};
+
+    // set dueling, only used if insertion is Dynamic
+    std::uint32_t psel;
+    std::uint32_t leaderPeriod;
+
+    std::uint32_t sentinelOf(std::uint32_t rrpv) const noexcept {
+        return static_cast<std::uint32_t>(size) + ((rrpv + listRotation) & (numLists - 1));
+    }
+    bool isInList(std::uint32_t index) const noexcept { return next[index] != index; }
+    bool isEmpty(std::uint32_t sentinel) const noexcept { return next[sentinel] == sentinel; }
+    void unlink(std::uint32_t index) noexcept;
+    void pushBack(std::uint32_t sentinel, std::uint32_t index) noexcept;
+
+    bool isStaticLeader(std::uint32_t line) const noexcept { return line % leaderPeriod == 0; }
+    bool isBimodalLeader(std::uint32_t line) const noexcept { return line % leaderPeriod == leaderPeriod / 2; }
+    std::uint32_t insertionRRPV(std::uint32_t line) noexcept;
+    std::uint32_t bimodalInsertionRRPV() noexcept;
+    void recordMiss(std::uint32_t line) noexcept;
+};
+
+template <typename T> constexpr std::uint32_t RRIPPolicy<T>::bimodalThrottle;
+template <typename T> constexpr std::uint32_t RRIPPolicy<T>::pselBits;
+
+template <typename T>
+inline RRIPPolicy<T>::RRIPPolicy(std::size_t size, Insertion insertion, std::uint32_t rrpvBits)
+    : size{size}, insertion{insertion}, rrpvBits{rrpvBits}, maxRRPV{(1u << rrpvBits) - 1}, numLists{1u << rrpvBits},
+      prev(size + numLists), next(size + numLists), psel{(1u << pselBits) / 2} {
+    assert(size > 0 && rrpvBits > 0 && rrpvBits <= 8);
+    for (std::uint32_t index = 0; index < prev.size(); ++index) {
+        prev[index] = index;
+        next[index] = index;
+    }
+    // 32 leader lines of each kind, as in the original proposal, if the cache is big enough
+    leaderPeriod = static_cast<std::uint32_t>(size / 32);
+    if (leaderPeriod < 2)
+        leaderPeriod = 2;
+    if (leaderPeriod > 32)
+        leaderPeriod = 32;
+}
+
+template <typename T> inline void RRIPPolicy<T>::unlink(std::uint32_t index) noexcept {
+    next[prev[index]] = next[index];
+    prev[next[index]] = prev[index];
+}
+
+template <typename T> inline void RRIPPolicy<T>::pushBack(std::uint32_t sentinel, std::uint32_t index) noexcept {
+    prev[index] = prev[sentinel];
+    next[index] = sentinel;
+    next[prev[sentinel]] = index;
+    prev[sentinel] = index;
+}
+
+template <typename T> inline std::uint32_t RRIPPolicy<T>::bimodalInsertionRRPV() noexcept {
+    bimodalCounter = (bimodalCounter + 1) % bimodalThrottle;
+    return bimodalCounter == 0 ? maxRRPV - 1 : maxRRPV;
+}
+
+template <typename T> inline std::uint32_t RRIPPolicy<T>::insertionRRPV(std::uint32_t line) noexcept {
+    bool useBimodal = insertion == Insertion::Bimodal;
+    if (insertion == Insertion::Dynamic) {
+        if (isStaticLeader(line)) {
+            useBimodal = false;
+        } else if (isBimodalLeader(line)) {
+            useBimodal = true;
+        } else {
+            useBimodal = psel >= (1u << pselBits) / 2; // the static leaders miss more
+        }
+    }
+    return useBimodal ? bimodalInsertionRRPV() : maxRRPV - 1;
+}
+
+template <typename T> inline void RRIPPolicy<T>::recordMiss(std::uint32_t line) noexcept {
+    if (insertion != Insertion::Dynamic)
+        return;
+    if (isStaticLeader(line)) {
+        psel = std::min(addSatUnsigned(psel, 1u), (1u << pselBits) - 1);
+    } else if (isBimodalLeader(line)) {
+        psel = subSatUnsigned(psel, 1u);
+    }
+}
+
+// precondition: usage lies in [0, size)
+template <typename T> inline void RRIPPolicy<T>::logUse(T usage) {
+    const auto index = static_cast<std::uint32_t>(usage);
+    assert(index < size);
+    if (isInList(index)) { // hit
+        unlink(index);
+        pushBack(sentinelOf(0), index);
+    } else { // cacheline was just filled
+        pushBack(sentinelOf(insertionRRPV(index)), index);
+    }
+}
+
+// Precondition: at least one cacheline was logged
+template <typename T> inline T RRIPPolicy<T>::pop() {
+    std::uint32_t highestRRPV = maxRRPV;
+    while (isEmpty(sentinelOf(highestRRPV))) {
+        assert(highestRRPV > 0);
+        --highestRRPV;
+    }
+    // age all cachelines until the highest RRPV reaches the maximum. All lists above are empty, so they can simply
+    // wrap around to become the lists of the lowest RRPVs
+    listRotation = (listRotation - (maxRRPV - highestRRPV)) & (numLists - 1);
+
+    const auto victim = next[sentinelOf(maxRRPV)];
+    unlink(victim);
+    prev[victim] = victim;
+    next[victim] = victim;
+    recordMiss(victim);
+    return static_cast<T>(victim);
+}
+
+template <typename T> inline constexpr std::size_t RRIPPolicy<T>::calcBasicGates() const noexcept {
+    // rrpvBits bit registers per cacheline (4 gates per bit), per cacheline an incrementer for aging (about 2 gates per
+    // bit) and an AND over its bits to detect the maximum, plus a priority encoder over all cachelines choosing the
+    // first line at the maximum (about size * log2(size) gates)
+    const std::size_t log2Size = safeCeilLog2(static_cast<std::uint32_t>(size));
+    std::size_t gates = addSatUnsigned(mulSatUnsigned(static_cast<std::size_t>(4 + 2 + 1), size,
+                                                      static_cast<std::size_t>(rrpvBits)),
+                                       mulSatUnsigned(size, log2Size));
+    if (insertion != Insertion::Static) {
+        // 5 bit counter throttling the bimodal insertion and its incrementer
+        gates = addSatUnsigned(gates, static_cast<std::size_t>(5 * 4 + 150));
+    }
+    if (insertion == Insertion::Dynamic) {
+        // PSEL register and its up / down counter, the leader lines are hard wired
+        gates = addSatUnsigned(gates, static_cast<std::size_t>(pselBits * 4 + 2 * 150));
+    }
+    return gates;
+}
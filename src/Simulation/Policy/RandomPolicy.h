@@ -2,7 +2,7 @@
 #include <cstdint>
 #include <random>
 
-template <typename T> class RandomPolicy : public ReplacementPolicy<T> {
+template <typename T> class RandomPolicy final : public ReplacementPolicy<T> {
   public:
     void logUse(T usage) override;
     T pop() override;
@@ -5,6 +5,12 @@ template <typename T> class ReplacementPolicy {
   public:
     virtual void logUse(T usage) = 0;
     virtual T pop() = 0;
+    /**
+     * Called by a fully associative cache on every miss with the tag of the missing block, before it chooses the
+     * cacheline to fill (and pops a victim if it is full). Policies keeping a history of evicted blocks use it to
+     * recognise blocks they have seen before, all others ignore it.
+     */
+    virtual void logMiss(__attribute__((unused)) std::uint32_t tag) {}
     virtual std::size_t calcBasicGates() const noexcept = 0;
     virtual ~ReplacementPolicy() = default;
 };
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+#include "../DecomposedAddress.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Hash table from block tags to node indices with a capacity fixed on construction, used by the policies remembering
+ * evicted blocks. It uses open addressing with linear probing and is kept at most half full. Erasing shifts the
+ * following entries of the probe sequence back instead of leaving tombstones, so lookups never degrade over time.
+ */
+class TagTable {
+  public:
+    enum : std::uint32_t { notFound = UINT32_MAX };
+
+    explicit TagTable(std::size_t maxEntries)
+        : slotBits{std::max<std::uint32_t>(1, safeCeilLog2(static_cast<std::uint32_t>(2 * maxEntries)))},
+          mask{(std::uint32_t{1} << slotBits) - 1}, tags(std::size_t{1} << slotBits),
+          values(std::size_t{1} << slotBits, notFound) {}
+
+    std::uint32_t find(std::uint32_t tag) const noexcept {
+        for (std::uint32_t slot = homeSlotOf(tag);; slot = (slot + 1) & mask) {
+            if (values[slot] == notFound || tags[slot] == tag)
+                return values[slot];
+        }
+    }
+
+    // precondition: tag is not in the table yet
+    void insert(std::uint32_t tag, std::uint32_t value) noexcept {
+        assert(value != notFound && find(tag) == notFound);
+        std::uint32_t slot = homeSlotOf(tag);
+        while (values[slot] != notFound)
+            slot = (slot + 1) & mask;
+        tags[slot] = tag;
+        values[slot] = value;
+    }
+
+    void erase(std::uint32_t tag) noexcept {
+        std::uint32_t hole = homeSlotOf(tag);
+        while (values[hole] != notFound && tags[hole] != tag)
+            hole = (hole + 1) & mask;
+        if (values[hole] == notFound)
+            return;
+        // move every later entry of the cluster that may not live behind the hole into it
+        for (std::uint32_t slot = (hole + 1) & mask; values[slot] != notFound; slot = (slot + 1) & mask) {
+            const std::uint32_t probeDistance = (slot - homeSlotOf(tags[slot])) & mask;
+            if (probeDistance >= ((slot - hole) & mask)) {
+                tags[hole] = tags[slot];
+                values[hole] = values[slot];
+                hole = slot;
+            }
+        }
+        values[hole] = notFound;
+    }
+
+  private:
+    const std::uint32_t slotBits;
+    const std::uint32_t mask;
+    std::vector<std::uint32_t> tags;
+    std::vector<std::uint32_t> values;
+
+    // Fibonacci hashing - consecutive tags are common and would otherwise form long clusters
+    std::uint32_t homeSlotOf(std::uint32_t tag) const noexcept {
+        return static_cast<std::uint32_t>((tag * 2654435769u) >> (32 - slotBits));
+    }
+};
@@ -0,0 +1,78 @@
+#pragma once
+#include "../Saturating_Arithmetic.h"
+#include "ReplacementPolicy.h"
+
+#include <assert.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Tree pseudo-LRU policy as found in real set associative caches. The cachelines are the leaves of a binary tree, every
+ * inner node holds a single bit pointing into the half that was used less recently. A use flips all bits on the path
+ * to the leaf away from it, the victim is found by following the bits from the root. Both take O(log size) steps on a
+ * fixed array of size - 1 node bits. Each bit gets a byte of its own, so walking the tree needs no branches on the
+ * bits, which would be mispredicted about half of the time.
+ *
+ * If size is not a power of 2, the tree is padded to the next one. Subtrees consisting of padding only are never chosen.
+ */
+template <typename T> class TreePLRUPolicy final : public ReplacementPolicy<T> {
+  public:
+    void logUse(T usage) override;
+    T pop() override;
+    std::size_t getCapacity() const { return size; }
+    TreePLRUPolicy(std::size_t size);
+    constexpr std::size_t calcBasicGates() const noexcept override;
+
+  private:
+    const std::size_t size;
+    std::size_t levels{0};
+    std::size_t numLeaves{1}; // size rounded up to the next power of 2
+    // heap layout: root at 1, children of node i at 2i and 2i + 1. A 1 means the victim lies in the right half
+    std::vector<std::uint8_t> tree;
+};
+
+template <typename T> inline TreePLRUPolicy<T>::TreePLRUPolicy(std::size_t size) : size{size} {
+    assert(size > 0);
+    while (numLeaves < size) {
+        numLeaves *= 2;
+        ++levels;
+    }
+    tree = std::vector<std::uint8_t>(numLeaves, 0);
+}
+
+// precondition: usage lies in [0, size)
+template <typename T> inline void TreePLRUPolicy<T>::logUse(T usage) {
+    const auto leaf = static_cast<std::size_t>(usage);
+    assert(leaf < size);
+    std::size_t node = 1;
+    for (std::size_t level = levels; level > 0; --level) {
+        const std::size_t leafIsRight = (leaf >> (level - 1)) & 1;
+        tree[node] = static_cast<std::uint8_t>(leafIsRight ^ 1); // point away from the leaf just used
+        node = 2 * node + leafIsRight;
+    }
+}
+
+template <typename T> inline T TreePLRUPolicy<T>::pop() {
+    std::size_t node = 1;
+    for (std::size_t level = levels; level > 0; --level) {
+        // the right subtree only holds padding if its first leaf is not a cacheline
+        const std::size_t rightSubtreeStart = ((2 * node + 1) << (level - 1)) - numLeaves;
+        const std::size_t goRight = tree[node] & static_cast<std::size_t>(rightSubtreeStart < size);
+        node = 2 * node + goRight;
+    }
+    const std::size_t victim = node - numLeaves;
+    // the cache refills the victim right away, so treat it as used. This also keeps repeated pops from returning the
+    // same cacheline
+    logUse(static_cast<T>(victim));
+    return static_cast<T>(victim);
+}
+
+template <typename T> inline constexpr std::size_t TreePLRUPolicy<T>::calcBasicGates() const noexcept {
+    // size - 1 bit registers with 4 gates each, about 2 gates per node to update its bit from the address of the used
+    // cacheline and for the victim selection one multiplexer per tree level, picking the bit of the node on the path.
+    // The multiplexers of all levels together have about size inputs
+    const std::size_t nodes = numLeaves - 1;
+    return addSatUnsigned(mulSatUnsigned(static_cast<std::size_t>(4), nodes),
+                          mulSatUnsigned(static_cast<std::size_t>(2), nodes), nodes);
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include "../Saturating_Arithmetic.h"
+#include "GhostPool.h"
+#include "IndexLists.h"
+#include "ReplacementPolicy.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Full 2Q policy (Johnson and Shasha). A filled cacheline first enters the FIFO A1in, which holds about a quarter of
+ * the cache, so blocks used only once (e.g. during a scan) leave again quickly. The tags of blocks evicted from A1in
+ * are remembered in the ghost FIFO A1out of half the cache size. Only a block missing again while in A1out is
+ * considered hot and is filled into the LRU list Am, which is never evicted from as long as A1in exceeds its share.
+ *
+ * Cachelines are the nodes [0, size), ghost entries the nodes following them in the same IndexLists. The tags of
+ * missing blocks are reported through logMiss, a fill without one is treated like a block never seen before.
+ */
+template <typename T> class TwoQueuePolicy final : public ReplacementPolicy<T> {
+  public:
+    void logUse(T usage) override;
+    T pop() override;
+    void logMiss(std::uint32_t tag) override;
+    std::size_t getCapacity() const { return size; }
+    TwoQueuePolicy(std::size_t size);
+    constexpr std::size_t calcBasicGates() const noexcept override;
+
+  private:
+    enum List : std::uint8_t { Am, A1In, A1Out, None };
+
+    const std::size_t size;
+    const std::size_t maxA1InSize;  // Kin
+    const std::size_t maxA1OutSize; // Kout
+    IndexLists lists;
+    GhostPool ghosts;
+    std::vector<std::uint8_t> listOf;
+    std::array<std::size_t, 3> listSize{0, 0, 0};
+    std::vector<std::uint32_t> tagOfCacheline;
+
+    bool missPending{false};
+    bool pendingWasRemembered{false};
+    std::uint32_t pendingTag{GhostPool::noTag};
+
+    void push(List list, std::uint32_t node) noexcept;
+    void remove(std::uint32_t node) noexcept;
+    void prepareMiss(std::uint32_t tag) noexcept;
+};
+
+template <typename T>
+inline TwoQueuePolicy<T>::TwoQueuePolicy(std::size_t size)
+    : size{size}, maxA1InSize{std::max<std::size_t>(size / 4, 1)}, maxA1OutSize{std::max<std::size_t>(size / 2, 1)},
+      lists{size + maxA1OutSize, 3}, ghosts{static_cast<std::uint32_t>(size), maxA1OutSize},
+      listOf(size + maxA1OutSize, None), tagOfCacheline(size, GhostPool::noTag) {
+    assert(size > 0);
+}
+
+template <typename T> inline void TwoQueuePolicy<T>::push(List list, std::uint32_t node) noexcept {
+    lists.pushBack(list, node);
+    listOf[node] = list;
+    ++listSize[list];
+}
+
+template <typename T> inline void TwoQueuePolicy<T>::remove(std::uint32_t node) noexcept {
+    lists.remove(node);
+    --listSize[listOf[node]];
+    listOf[node] = None;
+}
+
+template <typename T> inline void TwoQueuePolicy<T>::prepareMiss(std::uint32_t tag) noexcept {
+    missPending = true;
+    pendingTag = tag;
+    const auto ghost = ghosts.find(tag);
+    pendingWasRemembered = ghost != TagTable::notFound;
+    if (pendingWasRemembered) {
+        remove(ghost);
+        ghosts.release(ghost);
+    }
+}
+
+template <typename T> inline void TwoQueuePolicy<T>::logMiss(std::uint32_t tag) { prepareMiss(tag); }
+
+// precondition: usage lies in [0, size)
+template <typename T> inline void TwoQueuePolicy<T>::logUse(T usage) {
+    const auto index = static_cast<std::uint32_t>(usage);
+    assert(index < size);
+    if (listOf[index] == Am) {
+        remove(index);
+        push(Am, index);
+        return;
+    }
+    if (listOf[index] == A1In) // a correlated reference, it does not count as reuse
+        return;
+    if (!missPending)
+        prepareMiss(GhostPool::noTag);
+    push(pendingWasRemembered ? Am : A1In, index);
+    tagOfCacheline[index] = pendingTag;
+    missPending = false;
+}
+
+// Precondition: the cache is full
+template <typename T> inline T TwoQueuePolicy<T>::pop() {
+    const bool fromA1In = listSize[A1In] > 0 && (listSize[A1In] > maxA1InSize || listSize[Am] == 0);
+    const auto victim = lists.front(fromA1In ? A1In : Am);
+    assert(victim != IndexLists::none);
+    remove(victim);
+
+    const auto tag = tagOfCacheline[victim];
+    tagOfCacheline[victim] = GhostPool::noTag;
+    if (fromA1In && tag != GhostPool::noTag) {
+        if (ghosts.isFull()) {
+            const auto oldestGhost = lists.front(A1Out);
+            remove(oldestGhost);
+            ghosts.release(oldestGhost);
+        }
+        push(A1Out, ghosts.add(tag));
+    }
+    return static_cast<T>(victim);
+}
+
+template <typename T> inline constexpr std::size_t TwoQueuePolicy<T>::calcBasicGates() const noexcept {
+    // two 32 bit pointer registers (4 gates per bit) and the relinking multiplexers per entry as for LRU, the ghost
+    // entries additionally need their tag and a comparator (32 * 2 gates) each. The sizes of A1in and Am are two
+    // counters with a comparator, about 3 * 150 gates
+    return addSatUnsigned(mulSatUnsigned(static_cast<std::size_t>(2 * 32 * 4 + 4 * 32), size + maxA1OutSize),
+                          mulSatUnsigned(static_cast<std::size_t>(32 * 4 + 32 * 2), maxA1OutSize),
+                          static_cast<std::size_t>(3 * 150));
+}
@@ -8,14 +8,18 @@ RAM::RAM(sc_core::sc_module_name name, std::uint32_t memoryLatency, std::uint32_
 }
 
 void RAM::provideData() noexcept {
+    bool mayContinueBurst = false;
     while (true) {
-        wait();
+        nextCycle();
         readyBus.write(false);
 
-        if (!validRequestBus.read())
+        if (!validRequestBus.read()) {
+            mayContinueBurst = false;
             continue;
+        }
 
-        waitOutMemoryLatency();
+        waitCycles(latencyOf(addressBus.read(), mayContinueBurst && weBus.read()));
+        mayContinueBurst = weBus.read();
 
         if (weBus.read()) {
             doWrite();
@@ -26,7 +30,7 @@ void RAM::provideData() noexcept {
 
                 // Don't have to wait for last word to be read here because of the wait at the beginning of the while
                 if (i != wordsPerRead - 1) {
-                    wait();
+                    nextCycle();
                 }
             }
         }
@@ -34,31 +38,27 @@ void RAM::provideData() noexcept {
 }
 
 void RAM::readWord(std::uint32_t word) noexcept {
-    sc_dt::sc_bv<128> readData;
-
-    // 128 / 8 -> 16
-    for (int byte = 0; byte < 16; ++byte) {
-        readData.range(8 * byte + 7, 8 * byte) = readByteFromMem(addressBus.read() + word * 16 + byte);
-    }
+    BusBeat readData;
+    dataMemory.read(addressBus.read() + word * BusBeat::SIZE_IN_BYTE, readData.bytes.data(), readData.bytes.size());
     dataOutBus.write(readData);
 
     // Next word is ready and then wait for next cycle to continue reading
     readyBus.write(true);
 }
 
-std::uint8_t RAM::readByteFromMem(std::uint32_t addr) noexcept { return dataMemory[addr]; }
-
 void RAM::doWrite() noexcept {
-    dataMemory[addressBus.read()] = (dataInBus.read() & ((1 << 8) - 1));
-    dataMemory[addressBus.read() + 1] = (dataInBus.read() >> 8) & ((1 << 8) - 1);
-    dataMemory[addressBus.read() + 2] = (dataInBus.read() >> 16) & ((1 << 8) - 1);
-    dataMemory[addressBus.read() + 3] = (dataInBus.read() >> 24) & ((1 << 8) - 1);
+    dataMemory.writeWord(addressBus.read(), dataInBus.read());
 
     readyBus.write(true);
 }
 
-void RAM::waitOutMemoryLatency() noexcept {
-    for (std::size_t i = 0; i < memoryLatency; ++i) {
-        wait();
+void RAM::nextCycle() noexcept {
+    wait();
+    ++cycle;
+}
+
+void RAM::waitCycles(std::uint32_t cycles) noexcept {
+    for (std::uint32_t i = 0; i < cycles; ++i) {
+        nextCycle();
     }
 }
\ No newline at end of file
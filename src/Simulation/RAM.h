@@ -1,10 +1,16 @@
 #pragma once
 
-#include <map>
+#include "BusBeat.h"
+#include "PagedMemory.h"
+
 #include <systemc>
-#include <unordered_map>
 #include <cstdint>
+#include <memory>
 
+/**
+ * The memory behind the caches, charging a flat memoryLatency per access. Memories timing their accesses differently,
+ * like DRAM, derive from it and override latencyOf, keeping its ports and protocol.
+ */
 SC_MODULE(RAM) {
   public:
     // ====================================== External Ports  ======================================
@@ -18,7 +24,7 @@ SC_MODULE(RAM) {
     sc_core::sc_in<bool> SC_NAMED(validRequestBus);
 
     // RAM ->
-    sc_core::sc_out<sc_dt::sc_bv<128>> SC_NAMED(dataOutBus);
+    sc_core::sc_out<BusBeat> SC_NAMED(dataOutBus);
     sc_core::sc_out<bool> SC_NAMED(readyBus);
 
   private:
@@ -29,12 +35,27 @@ SC_MODULE(RAM) {
 #ifdef RAM_DEBUG
   public:
 #endif
-    std::unordered_map<std::uint32_t, std::uint8_t> dataMemory{};
+    PagedMemory dataMemory{};
 
 
   public:
     RAM(sc_core::sc_module_name name, std::uint32_t memoryLatency, std::uint32_t wordsPerRead);
 
+    // preloads the memory with image, see PagedMemory::setImage
+    void setImage(std::shared_ptr<const MemoryImage> image) noexcept { dataMemory.setImage(std::move(image)); }
+
+  protected:
+    std::uint64_t cycle = 0; // the cycles passed since the start of the simulation
+
+    /**
+     * Returns the cycles to wait before accessing addr, memoryLatency unless the access continues a burst write.
+     * @param addr The address of the access
+     * @param continuesBurst Whether the access is a write directly following another one, the next word of a burst
+     */
+    virtual std::uint32_t latencyOf(__attribute__((unused)) std::uint32_t addr, bool continuesBurst) noexcept {
+        return continuesBurst ? 0 : memoryLatency;
+    }
+
   private:
     SC_CTOR(RAM) {}
 
@@ -42,27 +63,22 @@ SC_MODULE(RAM) {
     /**
      * Sleeps until it receives a valid requests and than based on the requests either reads from the data memory
      * or writes to it.
+     * Writes may come as a burst: if the valid request is still up in the cycle after a write, the address and data
+     * busses hold the next word, which is written without waiting out the memory latency again, see latencyOf.
      */
     void provideData() noexcept;
     /**
-     * Reads byte at the given address from the data memory
-     * @param  address to read
-     * @return data to to corresponding address
-     */
-    std::uint8_t readByteFromMem(std::uint32_t addr) noexcept;
-    /**
-     * Splits up input int into 4 bytes and then writes it to data memory to the given address
+     * Writes the input int to data memory at the given address, least significant byte first
      */
     void doWrite() noexcept;
     /**
-     * Reads word into a 128 bit buffer byte by byte at the received address a with a offset of (128/8) * word
+     * Copies the 16 bytes at the received address with an offset of (128/8) * word into a bus beat
      * @param word offset * 16 to received address
      */
     void readWord(std::uint32_t word) noexcept;
 
     // ====================================== Waiting Helpers ======================================
-    /**
-     * Sleeps for memoryLatency cycles
-     */
-    void waitOutMemoryLatency() noexcept;
+    // sleeps for one cycle, keeping track of the current cycle
+    void nextCycle() noexcept;
+    void waitCycles(std::uint32_t cycles) noexcept;
 };
@@ -0,0 +1,51 @@
+#include "ReadResultSink.h"
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+namespace {
+void failUnlessOpen(const std::ofstream& file, const char* path) {
+    if (!file)
+        throw ReadResultSinkError{std::string{"Could not open read result file '"} + path + "': " +
+                                  std::strerror(errno)};
+}
+
+// appends the n low bytes of value to record, least significant first
+char* putLittleEndian(char* record, std::uint64_t value, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i)
+        *record++ = static_cast<char>((value >> (8 * i)) & 0xFF);
+    return record;
+}
+} // namespace
+
+CSVReadResultSink::CSVReadResultSink(const char* path) : file{path} {
+    failUnlessOpen(file, path);
+    file << "Index,Data,Cycle\n";
+}
+
+void CSVReadResultSink::record(std::size_t index, std::uint32_t data, std::uint64_t cycle) {
+    file << index << ',' << data << ',' << cycle << '\n';
+}
+
+BinaryReadResultSink::BinaryReadResultSink(const char* path) : file{path, std::ios::binary} {
+    failUnlessOpen(file, path);
+}
+
+void BinaryReadResultSink::record(std::size_t index, std::uint32_t data, std::uint64_t cycle) {
+    char record[RECORD_SIZE];
+    char* end = putLittleEndian(record, index, 8);
+    end = putLittleEndian(end, data, 4);
+    putLittleEndian(end, cycle, 8);
+    file.write(record, RECORD_SIZE);
+}
+
+std::unique_ptr<ReadResultSink> makeReadResultSink(const ReadResultOptions& options) {
+    if (options.callback != nullptr)
+        return std::make_unique<CallbackReadResultSink>(options.callback, options.context);
+    if (options.file == nullptr)
+        return nullptr;
+    if (options.binary)
+        return std::make_unique<BinaryReadResultSink>(options.file);
+    return std::make_unique<CSVReadResultSink>(options.file);
+}
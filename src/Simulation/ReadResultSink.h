@@ -0,0 +1,84 @@
+#pragma once
+#include "../SimulationOptions.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+// the file the read results are streamed to could not be opened
+class ReadResultSinkError : public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * Where the CPU streams the value every read returns and the cycle it completed in, in program order. With a sink set,
+ * the CPU leaves the trace it replays untouched, so it may be read-only and does not need to stay writable. The
+ * results of two runs can be compared to tell whether a change kept the values the reads return.
+ */
+class ReadResultSink {
+  public:
+    virtual ~ReadResultSink() = default;
+
+    /**
+     * @param[in] index The index of the read in the trace
+     * @param[in] data The value the read returned
+     * @param[in] cycle The cycle of the core clock the read completed in
+     */
+    virtual void record(std::size_t index, std::uint32_t data, std::uint64_t cycle) = 0;
+};
+
+/**
+ * Writes one line Index,Data,Cycle per read, after a header line.
+ */
+class CSVReadResultSink : public ReadResultSink {
+  public:
+    // @throws ReadResultSinkError if the file cannot be opened
+    explicit CSVReadResultSink(const char* path);
+
+    void record(std::size_t index, std::uint32_t data, std::uint64_t cycle) override;
+
+  private:
+    std::ofstream file;
+};
+
+/**
+ * Writes one packed record of RECORD_SIZE bytes per read: the index as 8, the data as 4 and the cycle as 8 bytes, all
+ * little endian. There is no header, record i starts at offset i * RECORD_SIZE.
+ */
+class BinaryReadResultSink : public ReadResultSink {
+  public:
+    static constexpr std::size_t RECORD_SIZE = 20;
+
+    // @throws ReadResultSinkError if the file cannot be opened
+    explicit BinaryReadResultSink(const char* path);
+
+    void record(std::size_t index, std::uint32_t data, std::uint64_t cycle) override;
+
+  private:
+    std::ofstream file;
+};
+
+/**
+ * Hands every read to a function of the caller of run_simulation_with_options, see ReadResultOptions.
+ */
+class CallbackReadResultSink : public ReadResultSink {
+  public:
+    CallbackReadResultSink(ReadResultCallback callback, void* context) noexcept
+        : callback{callback}, context{context} {}
+
+    void record(std::size_t index, std::uint32_t data, std::uint64_t cycle) override {
+        callback(context, index, data, cycle);
+    }
+
+  private:
+    const ReadResultCallback callback;
+    void* const context;
+};
+
+/**
+ * Creates the sink options ask for, nullptr if the read results are to be written back into the requests instead.
+ * @throws ReadResultSinkError if the file cannot be opened
+ */
+std::unique_ptr<ReadResultSink> makeReadResultSink(const ReadResultOptions& options);
@@ -1,63 +1,76 @@
 #pragma once
-#include <mutex>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-template <typename T> class RingQueue {
-    typedef typename std::vector<T>::iterator ItType;
-    std::vector<T> buffer;
-    ItType begin, end;
+/**
+ * A fixed size FIFO queue. If CAPACITY is given, the elements are stored inline in an array and the queue is default
+ * constructed. With the default CAPACITY of 0 the capacity is passed to the constructor instead and the elements are
+ * stored in a vector allocated once on construction.
+ *
+ * The queue is not synchronised. SystemC runs all processes on a single thread, so there is no need to.
+ */
+template <typename T, std::size_t CAPACITY = 0> class RingQueue {
+    typedef typename std::conditional<CAPACITY == 0, std::vector<T>, std::array<T, CAPACITY>>::type StorageType;
+    StorageType buffer;
+    std::size_t begin = 0;
     std::size_t currNumEl = 0;
-    mutable std::mutex mutex;
 
-  public:
-    RingQueue(std::size_t size) : buffer{std::vector<T>(size)}, begin{buffer.begin()}, end{buffer.begin()} {}
+    std::size_t advance(std::size_t index) const noexcept { return (index + 1 == buffer.size()) ? 0 : index + 1; }
 
-    std::size_t getSize() const {
-        std::lock_guard<std::mutex> guard{mutex};
-        return currNumEl;
-    }
-    std::size_t getCapacity() const {
-        std::lock_guard<std::mutex> guard{mutex};
-        return buffer.size();
-    }
-    bool isEmpty() const {
-        std::lock_guard<std::mutex> guard{mutex};
-        return currNumEl == 0;
+  public:
+    RingQueue() : buffer{} { static_assert(CAPACITY != 0, "a dynamically sized RingQueue needs its size passed"); }
+    explicit RingQueue(std::size_t size) : buffer(size) {
+        static_assert(CAPACITY == 0, "the size of this RingQueue is fixed at compile time");
     }
 
-    void push(T el) {
-        std::lock_guard<std::mutex> guard{mutex};
+    std::size_t getSize() const noexcept { return currNumEl; }
+    std::size_t getCapacity() const noexcept { return buffer.size(); }
+    bool isEmpty() const noexcept { return currNumEl == 0; }
+
+    void push(T el) noexcept {
         assert(currNumEl < buffer.size());
+        std::size_t end = begin + currNumEl;
+        if (end >= buffer.size())
+            end -= buffer.size();
+        buffer[end] = std::move(el);
         ++currNumEl;
-        *end = el;
-        ++end;
-        if (end == buffer.end())
-            end = buffer.begin();
     }
 
-    T pop() {
-        std::lock_guard<std::mutex> guard{mutex};
+    // the oldest element
+    T& front() noexcept {
         assert(currNumEl > 0);
-        T ret = *begin;
-        ++begin;
-        if (begin == buffer.end())
-            begin = buffer.begin();
+        return buffer[begin];
+    }
+
+    T pop() noexcept {
+        assert(currNumEl > 0);
+        T ret = std::move(buffer[begin]);
+        begin = advance(begin);
         --currNumEl;
         return ret;
     }
 
     template <typename PredicateType> bool any(PredicateType predicate) {
-        auto curr = begin;
-        std::size_t elChecked = 0;
-        while (elChecked < currNumEl) {
-            if (predicate(*curr)) {
+        std::size_t curr = begin;
+        for (std::size_t elChecked = 0; elChecked < currNumEl; ++elChecked) {
+            if (predicate(buffer[curr])) {
                 return true;
             }
-            ++elChecked;
-            ++curr;
-            if (curr == buffer.end())
-                curr = buffer.begin();
+            curr = advance(curr);
         }
         return false;
     }
-};
\ No newline at end of file
+
+    // visits the elements from the oldest to the youngest
+    template <typename FunctionType> void forEach(FunctionType function) {
+        std::size_t curr = begin;
+        for (std::size_t elVisited = 0; elVisited < currNumEl; ++elVisited) {
+            function(buffer[curr]);
+            curr = advance(curr);
+        }
+    }
+};
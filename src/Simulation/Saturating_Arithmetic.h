@@ -15,6 +15,13 @@ template <typename T, typename... U> constexpr inline auto addSatUnsigned(T a, U
     return addSatUnsigned(a, addSatUnsigned(nums...));
 }
 
+template <typename T> constexpr inline auto subSatUnsigned(T a, T b) noexcept {
+    T c;
+    if (!__builtin_sub_overflow(a, b, &c))
+        return c;
+    return std::numeric_limits<T>::min();
+}
+
 template <typename T> constexpr inline auto mulSatUnsigned(T a, T b) noexcept {
     T c;
     if (!__builtin_mul_overflow(a, b, &c))
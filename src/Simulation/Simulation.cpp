@@ -1,22 +1,73 @@
 #include "Simulation.h"
 #include "CPU.h"
 #include "Cache.h"
+#include "ClockDomainBridge.h"
+#include "CoherentCache.h"
 #include "Connections.h"
+#include "DRAM.h"
 #include "InstructionCache.h"
+#include "L2Cache.h"
+#include "MemoryController.h"
+#include "MemoryImage.h"
+#include "Policy/ARCPolicy.h"
+#include "Policy/BitPLRUPolicy.h"
+#include "Policy/DIPPolicy.h"
 #include "Policy/FIFOPolicy.h"
+#include "Policy/LFUPolicy.h"
+#include "Policy/LIRSPolicy.h"
 #include "Policy/LRUPolicy.h"
+#include "Policy/OPTPolicy.h"
+#include "Policy/PluginPolicy.h"
 #include "Policy/Policy.h"
+#include "Policy/RRIPPolicy.h"
 #include "Policy/RandomPolicy.h"
+#include "Policy/TreePLRUPolicy.h"
+#include "Policy/TwoQueuePolicy.h"
 #include "RAM.h"
+#include "ReadResultSink.h"
+#include "SnoopingBus.h"
+#include "SubRequest.h"
 
 #include <exception>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include <systemc>
 
 using namespace sc_core;
 
-std::unique_ptr<ReplacementPolicy<std::uint32_t>> getPolicy(CacheReplacementPolicy policy, unsigned int cacheSize) {
+constexpr std::uint32_t defaultRRPVBits = 2;
+
+/**
+ * The blocks the data cache accesses while processing the requests, in order - one per sub-request, i.e. per use of a
+ * cacheline. Only needed by the OPT policy.
+ */
+std::vector<std::uint32_t> blocksAccessedByDataCache(const Request requests[], size_t numRequests,
+                                                     unsigned int cacheLineSize) {
+    std::vector<std::uint32_t> blocks{};
+    blocks.reserve(numRequests);
+    for (size_t i = 0; i < numRequests; ++i) {
+        for (const auto& subRequest : splitRequestIntoSubRequests(requests[i], cacheLineSize)) {
+            blocks.push_back(subRequest.addr / cacheLineSize); // the tag of a fully associative cache
+        }
+    }
+    return blocks;
+}
+
+/**
+ * accessedBlocks are the blocks the cache is going to access in order, as far as they are known in advance. This is
+ * only required for OPT.
+ */
+std::unique_ptr<ReplacementPolicy<std::uint32_t>>
+getPolicy(CacheReplacementPolicy policy, unsigned int cacheSize, const SimulationOptions& options,
+          const std::vector<std::uint32_t>* accessedBlocks = nullptr) {
+    using RRIP = RRIPPolicy<std::uint32_t>;
+    const std::uint32_t rrpvBits = options.rrpvBits == 0 ? defaultRRPVBits : options.rrpvBits;
     switch (policy) {
     case POLICY_LRU:
         return std::make_unique<LRUPolicy<std::uint32_t>>(cacheSize);
@@ -24,13 +75,136 @@ std::unique_ptr<ReplacementPolicy<std::uint32_t>> getPolicy(CacheReplacementPoli
         return std::make_unique<FIFOPolicy<std::uint32_t>>(cacheSize);
     case POLICY_RANDOM:
         return std::make_unique<RandomPolicy<std::uint32_t>>(cacheSize);
+    case POLICY_PLRU:
+        return std::make_unique<TreePLRUPolicy<std::uint32_t>>(cacheSize);
+    case POLICY_BITPLRU:
+        return std::make_unique<BitPLRUPolicy<std::uint32_t>>(cacheSize);
+    case POLICY_SRRIP:
+        return std::make_unique<RRIP>(cacheSize, RRIP::Insertion::Static, rrpvBits);
+    case POLICY_BRRIP:
+        return std::make_unique<RRIP>(cacheSize, RRIP::Insertion::Bimodal, rrpvBits);
+    case POLICY_DRRIP:
+        return std::make_unique<RRIP>(cacheSize, RRIP::Insertion::Dynamic, rrpvBits);
+    case POLICY_LFU:
+        return std::make_unique<LFUPolicy<std::uint32_t>>(cacheSize);
+    case POLICY_ARC:
+        return std::make_unique<ARCPolicy<std::uint32_t>>(cacheSize);
+    case POLICY_TWO_QUEUE:
+        return std::make_unique<TwoQueuePolicy<std::uint32_t>>(cacheSize);
+    case POLICY_LIRS:
+        return std::make_unique<LIRSPolicy<std::uint32_t>>(cacheSize);
+    case POLICY_OPT:
+        if (accessedBlocks == nullptr)
+            throw std::runtime_error("OPT needs to know all accesses of the cache in advance");
+        return std::make_unique<OPTPolicy<std::uint32_t>>(cacheSize, *accessedBlocks);
+    case POLICY_DIP:
+        return std::make_unique<DIPPolicy<std::uint32_t>>(cacheSize);
+    case POLICY_PLUGIN:
+        if (options.policyPlugin == nullptr)
+            throw PolicyPluginError("No shared library given for the plugin policy");
+        return std::make_unique<PluginPolicy<std::uint32_t>>(cacheSize, options.policyPlugin);
+    default:
+        throw std::runtime_error("Encountered unknown policy type");
+    }
+}
+
+/**
+ * getPolicy for a cache bound to PolicyType at compile time, see visitPolicyType. Throws if PolicyType does not
+ * implement policy, as the cache would call the wrong class otherwise.
+ */
+template <typename PolicyType>
+std::unique_ptr<PolicyType> getPolicyOfType(CacheReplacementPolicy policy, unsigned int cacheSize,
+                                            const SimulationOptions& options,
+                                            const std::vector<std::uint32_t>* accessedBlocks = nullptr) {
+    auto generalPolicy = getPolicy(policy, cacheSize, options, accessedBlocks);
+    auto* typedPolicy = dynamic_cast<PolicyType*>(generalPolicy.get());
+    if (typedPolicy == nullptr)
+        throw std::logic_error("The policy class the cache is bound to does not implement its policy");
+    generalPolicy.release();
+    return std::unique_ptr<PolicyType>{typedPolicy};
+}
+
+template <typename PolicyType> struct PolicyTag {
+    using type = PolicyType;
+};
+
+/**
+ * Calls visitor with the PolicyTag of the class implementing policy, so the data cache can be bound to it at compile
+ * time. This saves the virtual call on every access of the cache.
+ */
+template <typename Visitor> Result visitPolicyType(CacheReplacementPolicy policy, Visitor visitor) {
+    switch (policy) {
+    case POLICY_LRU:
+        return visitor(PolicyTag<LRUPolicy<std::uint32_t>>{});
+    case POLICY_FIFO:
+        return visitor(PolicyTag<FIFOPolicy<std::uint32_t>>{});
+    case POLICY_RANDOM:
+        return visitor(PolicyTag<RandomPolicy<std::uint32_t>>{});
+    case POLICY_PLRU:
+        return visitor(PolicyTag<TreePLRUPolicy<std::uint32_t>>{});
+    case POLICY_BITPLRU:
+        return visitor(PolicyTag<BitPLRUPolicy<std::uint32_t>>{});
+    case POLICY_SRRIP:
+    case POLICY_BRRIP:
+    case POLICY_DRRIP:
+        return visitor(PolicyTag<RRIPPolicy<std::uint32_t>>{});
+    case POLICY_LFU:
+        return visitor(PolicyTag<LFUPolicy<std::uint32_t>>{});
+    case POLICY_ARC:
+        return visitor(PolicyTag<ARCPolicy<std::uint32_t>>{});
+    case POLICY_TWO_QUEUE:
+        return visitor(PolicyTag<TwoQueuePolicy<std::uint32_t>>{});
+    case POLICY_LIRS:
+        return visitor(PolicyTag<LIRSPolicy<std::uint32_t>>{});
+    case POLICY_OPT:
+        return visitor(PolicyTag<OPTPolicy<std::uint32_t>>{});
+    case POLICY_DIP:
+        return visitor(PolicyTag<DIPPolicy<std::uint32_t>>{});
+    case POLICY_PLUGIN:
+        return visitor(PolicyTag<PluginPolicy<std::uint32_t>>{});
     default:
         throw std::runtime_error("Encountered unknown policy type");
     }
 }
 
-template <typename CacheType>
-auto setUpTracefile(const char* traceFile, Connections& connections, CacheType& dataCache) {
+/**
+ * Writes the insertion the followers of a DIP policy chose in each phase to fileName as CSV, so the phases of a trace
+ * can be told apart. All other policies make no such decision, so nothing is written for them.
+ */
+template <typename PolicyType>
+void writeInsertionSeries(__attribute__((unused)) const PolicyType& policy,
+                          __attribute__((unused)) const char* fileName) {}
+
+void writeInsertionSeries(const DIPPolicy<std::uint32_t>& policy, const char* fileName) {
+    using DIP = DIPPolicy<std::uint32_t>;
+    std::ofstream file{fileName};
+    if (!file) {
+        std::cerr << "Could not open '" << fileName << "' to write the DIP insertion series.\n";
+        return;
+    }
+    file << "Phase,Uses,PSEL,Insertion,LRU-Leader-Misses,BIP-Leader-Misses\n";
+    std::size_t phaseNr = 0;
+    for (const auto& phase : policy.getSelectionHistory()) {
+        file << phaseNr++ << ',' << phase.uses << ',' << phase.psel << ','
+             << (phase.followerInsertion == DIP::Insertion::LRU ? "LRU" : "BIP") << ',' << phase.lruLeaderMisses << ','
+             << phase.bimodalLeaderMisses << '\n';
+    }
+}
+
+void traceBus(sc_trace_file* trace, const MemoryBus& bus) {
+    if (!bus.isUsed)
+        return;
+    sc_trace(trace, bus.address, bus.address.basename());
+    sc_trace(trace, bus.data, bus.data.basename());
+    sc_trace(trace, bus.we, bus.we.basename());
+    sc_trace(trace, bus.validRequest, bus.validRequest.basename());
+    sc_trace(trace, bus.beat, bus.beat.basename());
+    sc_trace(trace, bus.ready, bus.ready.basename());
+}
+
+template <typename CacheType, typename L2CacheType>
+auto setUpTracefile(const char* traceFile, Connections& connections, CacheType& dataCache, L2CacheType* l2Cache,
+                    bool hasMemoryController) {
     auto traceCloser = [](sc_core::sc_trace_file* trace) {
         if (trace != nullptr)
             sc_close_vcd_trace_file(trace);
@@ -43,12 +217,17 @@ auto setUpTracefile(const char* traceFile, Connections& connections, CacheType&
 
     trace->set_time_unit(100, SC_PS); // not 1 NS because write buffer does some things at falling edge
     sc_trace(trace.get(), connections.clk, "clock");
+    if (&connections.cacheClock() != &connections.clk)
+        sc_trace(trace.get(), connections.cacheClock(), "cache_clock");
+    if (&connections.memoryClock() != &connections.clk && &connections.memoryClock() != &connections.cacheClock())
+        sc_trace(trace.get(), connections.memoryClock(), "memory_clock");
 
     // Data Cache signals
     sc_trace(trace.get(), connections.CPU_to_dataCache_Address, "CPU_to_dataCache_Address");
     sc_trace(trace.get(), connections.CPU_to_dataCache_Data, "CPU_to_dataCache_Data");
     sc_trace(trace.get(), connections.CPU_to_dataCache_WE, "CPU_to_dataCache_WE");
     sc_trace(trace.get(), connections.CPU_to_dataCache_Valid_Request, "CPU_to_dataCache_Valid_Request");
+    sc_trace(trace.get(), connections.CPU_to_dataCache_Address_Space, "CPU_to_dataCache_Address_Space");
     sc_trace(trace.get(), connections.dataCache_to_CPU_Data, "dataCache_to_CPU_Data");
     sc_trace(trace.get(), connections.dataCache_to_CPU_Ready, "dataCache_to_CPU_Ready");
 
@@ -62,6 +241,7 @@ auto setUpTracefile(const char* traceFile, Connections& connections, CacheType&
     // Instruction Cache signals
     sc_trace(trace.get(), connections.CPU_to_instrCache_PC, "CPU_to_instrCache_PC");
     sc_trace(trace.get(), connections.CPU_to_instrCache_Valid_Request, "CPU_to_instrCache_Valid_Request");
+    sc_trace(trace.get(), connections.CPU_to_instrCache_Address_Space, "CPU_to_instrCache_Address_Space");
     sc_trace(trace.get(), connections.instrCache_to_CPU_Instruction, "instrCache_to_CPU_Instruction");
     sc_trace(trace.get(), connections.instrCache_to_CPU_Ready, "instrCache_to_CPU_Ready");
 
@@ -72,55 +252,729 @@ auto setUpTracefile(const char* traceFile, Connections& connections, CacheType&
     sc_trace(trace.get(), connections.instrRAM_to_instrCache_Data, "instrRAM_to_instrCache_Data");
     sc_trace(trace.get(), connections.instrRAM_to_instrCache_Ready, "instrRAM_to_instrCache_Ready");
 
+    if (l2Cache != nullptr) {
+        sc_trace(trace.get(), connections.L2_to_RAM_Address, "L2_to_RAM_Address");
+        sc_trace(trace.get(), connections.L2_to_RAM_Data, "L2_to_RAM_Data");
+        sc_trace(trace.get(), connections.L2_to_RAM_WE, "L2_to_RAM_WE");
+        sc_trace(trace.get(), connections.L2_to_RAM_Valid_Request, "L2_to_RAM_Valid_Request");
+        sc_trace(trace.get(), connections.RAM_to_L2_Data, "RAM_to_L2_Data");
+        sc_trace(trace.get(), connections.RAM_to_L2_Ready, "RAM_to_L2_Ready");
+        l2Cache->traceInternalSignals(trace.get());
+    }
+
+    if (hasMemoryController) {
+        sc_trace(trace.get(), connections.controller_to_RAM_Address, "controller_to_RAM_Address");
+        sc_trace(trace.get(), connections.controller_to_RAM_Data, "controller_to_RAM_Data");
+        sc_trace(trace.get(), connections.controller_to_RAM_WE, "controller_to_RAM_WE");
+        sc_trace(trace.get(), connections.controller_to_RAM_Valid_Request, "controller_to_RAM_Valid_Request");
+        sc_trace(trace.get(), connections.RAM_to_controller_Data, "RAM_to_controller_Data");
+        sc_trace(trace.get(), connections.RAM_to_controller_Ready, "RAM_to_controller_Ready");
+    }
+
+    traceBus(trace.get(), connections.dataCrossing);
+    traceBus(trace.get(), connections.instrCrossing);
+    traceBus(trace.get(), connections.memoryCrossing);
+
     // trace Write Buffer signals too
     dataCache.traceInternalSignals(trace.get());
 
     return trace;
 }
 
-constexpr std::uint8_t instructionCacheLineSize = 128;
-constexpr std::uint8_t instructionCacheNumLines = 16;
+constexpr std::uint32_t defaultInstructionCacheLineSize = 128;
+constexpr std::uint32_t defaultInstructionCacheLines = 16;
+// with a unified L2, instructions are fetched from here on so they do not alias the data addresses of the trace
+constexpr std::uint32_t instructionSegmentBase = 0xF0000000;
 
-template <MappingType mappingType>
-Result run_simulation_extended(unsigned int cycles, unsigned int cacheLines, unsigned int cacheLineSize,
-                               unsigned int cacheLatency, unsigned int memoryLatency, size_t numRequests,
-                               struct Request requests[], const char* tracefile, CacheReplacementPolicy policy) {
+std::uint32_t instructionCacheLineSizeOf(const SimulationOptions& options) noexcept {
+    return options.instructionCache.cacheLineSize == 0 ? defaultInstructionCacheLineSize
+                                                       : options.instructionCache.cacheLineSize;
+}
+
+/**
+ * Creates the instruction cache of a core replaying trace, configured by options.instructionCache. It fetches the real
+ * addresses of the instructions if the trace has them, otherwise the PC from fetchAddressBase on.
+ */
+std::unique_ptr<InstructionCache> makeInstructionCache(const char* name, const CoreTrace& trace,
+                                                       unsigned int cacheLatency, std::uint32_t fetchAddressBase,
+                                                       const SimulationOptions& options) {
+    const InstructionCacheOptions& instructionOptions = options.instructionCache;
+    const std::uint32_t cacheLines =
+        instructionOptions.cacheLines == 0 ? defaultInstructionCacheLines : instructionOptions.cacheLines;
+    auto instructionCache = std::make_unique<InstructionCache>(
+        name, cacheLines, instructionCacheLineSizeOf(options), cacheLatency, trace.requests, trace.numRequests,
+        fetchAddressBase,
+        instructionOptions.fullyAssociative ? getPolicy(instructionOptions.policy, cacheLines, options) : nullptr);
+    instructionCache->setFetchAddresses(trace.instructionAddresses);
+    return instructionCache;
+}
+
+InstructionCacheStatistics instructionCacheStatisticsOf(const InstructionCache& instructionCache) {
+    return InstructionCacheStatistics{instructionCache.getHitCount(), instructionCache.getMissCount()};
+}
+
+/**
+ * Throws a PolicyPluginError if the replacement policy of the cache chose a victim out of range, which stopped the
+ * simulation, see CachelineTable::checkVictim. Only a policy loaded from a plugin can do so.
+ */
+void checkVictimsOf(const char* cacheName, std::uint64_t invalidVictim, const SimulationOptions& options) {
+    if (invalidVictim == NO_INVALID_VICTIM)
+        return;
+    const std::string plugin = options.policyPlugin != nullptr ? options.policyPlugin : "unnamed";
+    throw PolicyPluginError{"Policy plugin '" + plugin + "' evicted cacheline " + std::to_string(invalidVictim) +
+                            " of the " + cacheName + ", which does not exist"};
+}
+
+std::uint32_t writeBufferDepthOf(const SimulationOptions& options) noexcept {
+    return options.writeBufferDepth == 0 ? WRITE_BUFFER_SIZE : options.writeBufferDepth;
+}
+
+std::uint32_t issueWidthOf(const SimulationOptions& options) noexcept {
+    return options.core.issueWidth == 0 ? 1 : options.core.issueWidth;
+}
+
+/**
+ * Creates the memory behind the caches: a RAM with the flat memoryLatency or a DRAM configured by options.dram.
+ */
+template <typename MemoryType>
+std::unique_ptr<MemoryType> makeMemory(const char* name, unsigned int memoryLatency, std::uint32_t wordsPerRead,
+                                       const SimulationOptions& options);
+
+template <>
+std::unique_ptr<RAM> makeMemory<RAM>(const char* name, unsigned int memoryLatency, std::uint32_t wordsPerRead,
+                                     __attribute__((unused)) const SimulationOptions& options) {
+    return std::make_unique<RAM>(name, memoryLatency, wordsPerRead);
+}
+
+template <>
+std::unique_ptr<DRAM> makeMemory<DRAM>(const char* name, __attribute__((unused)) unsigned int memoryLatency,
+                                       std::uint32_t wordsPerRead, const SimulationOptions& options) {
+    return std::make_unique<DRAM>(name, options.dram, wordsPerRead);
+}
+
+/**
+ * Maps the image preloading the memory, nullptr if options.memoryImage asks for none. Throws MemoryImageError.
+ */
+std::shared_ptr<const MemoryImage> loadMemoryImage(const SimulationOptions& options) {
+    if (options.memoryImage == nullptr)
+        return nullptr;
+    return std::make_shared<const MemoryImage>(options.memoryImage, options.memoryImageBase);
+}
+
+DRAMStatistics dramStatisticsOf(__attribute__((unused)) const RAM& ram) { return DRAMStatistics{}; }
+DRAMStatistics dramStatisticsOf(const DRAM& dram) { return dram.getStatistics(); }
+
+/**
+ * Creates the memory controller in front of the memory, nullptr if options.memoryController asks for none.
+ */
+std::unique_ptr<MemoryController> makeMemoryController(std::uint32_t readsPerCacheline,
+                                                       const SimulationOptions& options) {
+    if (options.memoryController.queueDepth == 0)
+        return nullptr;
+    return std::make_unique<MemoryController>("Memory_Controller", options.memoryController, readsPerCacheline,
+                                              options.dram);
+}
+
+MemoryControllerStatistics memoryControllerStatisticsOf(const MemoryController* controller) {
+    return controller == nullptr ? MemoryControllerStatistics{} : controller->getStatistics();
+}
+
+/**
+ * Creates the bridge from the domain of requesterClock to the one of memoryClock, nullptr if both are the same clock.
+ */
+std::unique_ptr<ClockDomainBridge> makeBridge(const char* name, const sc_clock& requesterClock,
+                                              const sc_clock& memoryClock, std::uint32_t readsPerCacheline,
+                                              const SimulationOptions& options) {
+    if (&requesterClock == &memoryClock)
+        return nullptr;
+    const std::uint32_t stages = options.clocks.crossingStages == 0 ? 2 : options.clocks.crossingStages;
+    return std::make_unique<ClockDomainBridge>(name, readsPerCacheline, stages);
+}
+
+/**
+ * Calls connect with the first component of the chain in front of memory, which is the bridge into the memory clock
+ * domain, the memory controller or the memory itself, whichever exists. The rest of the chain is connected here, the
+ * bridge through crossing.
+ */
+template <typename MemoryType, typename Connect>
+void connectMemoryChain(Connections& connections, MemoryBus& crossing, ClockDomainBridge* bridge,
+                        MemoryController* controller, MemoryType& memory, Connect connect) {
+    if (bridge != nullptr) {
+        connect(*bridge);
+        bridge->memoryClock(connections.memoryClock());
+        if (controller != nullptr) {
+            connectThroughBus(crossing, *bridge, *controller);
+            controller->clock(connections.memoryClock());
+        } else {
+            connectThroughBus(crossing, *bridge, memory);
+            memory.clock(connections.memoryClock());
+        }
+    } else if (controller != nullptr) {
+        connect(*controller);
+    } else {
+        connect(memory);
+    }
+
+    if (controller != nullptr)
+        connectControllerToMemory(connections, *controller, memory);
+}
+
+/**
+ * The trace the core replays in the multi-programmed mode: the requests of all processes interleaved round robin, a
+ * quantum at a time, see MultiprogramOptions.
+ */
+struct ProcessSchedule {
+    std::vector<CoreTrace> processes;
+    std::vector<Request> requests;
+    std::vector<std::uint16_t> addressSpaces; // the process of each request
+    std::vector<std::uint32_t> gaps; // the cycles computed before each request, empty if no process has gaps
+    std::vector<std::uint32_t> instructionAddresses; // of each request, empty if no process has them
+    std::size_t contextSwitches = 0;
+};
+
+ProcessSchedule scheduleProcesses(size_t numRequests, struct Request requests[], const std::uint32_t* gaps,
+                                  const std::uint32_t* instructionAddresses, const MultiprogramOptions& multiprogram) {
+    ProcessSchedule schedule;
+    schedule.processes.push_back(CoreTrace{numRequests, requests, gaps, instructionAddresses});
+    schedule.processes.insert(schedule.processes.end(), multiprogram.traces,
+                              multiprogram.traces + multiprogram.additionalProcesses);
+
+    std::size_t totalRequests = 0;
+    for (const auto& process : schedule.processes) {
+        totalRequests += process.numRequests;
+    }
+    schedule.requests.reserve(totalRequests);
+    schedule.addressSpaces.reserve(totalRequests);
+    const bool hasGaps = std::any_of(schedule.processes.begin(), schedule.processes.end(),
+                                     [](const CoreTrace& process) { return process.gaps != nullptr; });
+    const bool hasInstructionAddresses =
+        std::any_of(schedule.processes.begin(), schedule.processes.end(),
+                    [](const CoreTrace& process) { return process.instructionAddresses != nullptr; });
+
+    std::vector<std::size_t> nextRequest(schedule.processes.size(), 0);
+    while (schedule.requests.size() != totalRequests) {
+        for (std::uint16_t process = 0; process < schedule.processes.size(); ++process) {
+            const CoreTrace& trace = schedule.processes[process];
+            std::size_t& next = nextRequest[process];
+            const std::size_t end = std::min<std::size_t>(next + multiprogram.quantum, trace.numRequests);
+            if (next == end) // done, the next process is switched in right away
+                continue;
+            if (!schedule.addressSpaces.empty() && schedule.addressSpaces.back() != process)
+                ++schedule.contextSwitches;
+            for (; next < end; ++next) {
+                schedule.requests.push_back(trace.requests[next]);
+                schedule.addressSpaces.push_back(process);
+                if (hasGaps)
+                    schedule.gaps.push_back(trace.gaps == nullptr ? 0 : trace.gaps[next]);
+                if (hasInstructionAddresses) // without them, a process fetches its request index as the address
+                    schedule.instructionAddresses.push_back(trace.instructionAddresses == nullptr
+                                                                ? static_cast<std::uint32_t>(next)
+                                                                : trace.instructionAddresses[next]);
+            }
+        }
+    }
+    return schedule;
+}
+
+// reads the data the core read back into the traces of the processes
+void readBackIntoProcesses(const ProcessSchedule& schedule) {
+    std::vector<std::size_t> nextRequest(schedule.processes.size(), 0);
+    for (std::size_t i = 0; i < schedule.requests.size(); ++i) {
+        const std::uint16_t process = schedule.addressSpaces[i];
+        schedule.processes[process].requests[nextRequest[process]++] = schedule.requests[i];
+    }
+}
+
+/**
+ * Lets the processes of schedule share the CPU and the data cache, which is partitioned into ways if requested.
+ */
+template <MappingType mappingType, typename PolicyType>
+void setUpProcesses(CPU& cpu, Cache<mappingType, PolicyType>& dataCache, const ProcessSchedule& schedule,
+                    CacheReplacementPolicy policy, unsigned int cacheLines, const SimulationOptions& options) {
+    const MultiprogramOptions& multiprogram = options.multiprogram;
+    cpu.setAddressSpaces(schedule.addressSpaces);
+    cpu.setGaps(schedule.gaps.empty() ? nullptr : schedule.gaps.data());
+    dataCache.setAddressSpaces(static_cast<std::uint16_t>(schedule.processes.size()));
+    if (multiprogram.ways == 0)
+        return;
+
+    std::vector<std::unique_ptr<PolicyType>> wayPolicies;
+    for (unsigned int way = 0; way < multiprogram.ways; ++way) {
+        wayPolicies.push_back(getPolicyOfType<PolicyType>(policy, cacheLines / multiprogram.ways, options));
+    }
+    std::vector<std::uint32_t> wayMasks;
+    if (multiprogram.wayMasks != nullptr)
+        wayMasks.assign(multiprogram.wayMasks, multiprogram.wayMasks + schedule.processes.size());
+    dataCache.partitionWays(std::move(wayPolicies), std::move(wayMasks));
+}
+
+template <MappingType mappingType, typename PolicyType>
+MultiprogramStatistics multiprogramStatisticsOf(const Cache<mappingType, PolicyType>& dataCache,
+                                                const ProcessSchedule* schedule) {
+    MultiprogramStatistics statistics{};
+    if (schedule == nullptr)
+        return statistics;
+    statistics.processes = schedule->processes.size();
+    statistics.contextSwitches = schedule->contextSwitches;
+    for (std::size_t process = 0; process < schedule->processes.size(); ++process) {
+        const auto& counts = dataCache.addressSpaceStatistics.at(process);
+        statistics.process[process] = ProcessStatistics{schedule->processes[process].numRequests, counts.hits,
+                                                        counts.misses, counts.evictedByOthers,
+                                                        counts.evictionsOfOthers};
+        statistics.crossProcessEvictions += counts.evictionsOfOthers;
+    }
+    return statistics;
+}
+
+/**
+ * Simulates the CPU with its instruction and data cache, each in front of a memory of its own. If schedule is not
+ * nullptr, the requests are its interleaved trace and the processes share the data cache, see MultiprogramOptions.
+ */
+template <MappingType mappingType, typename PolicyType, typename MemoryType>
+Result run_simulation_harvard(unsigned int cycles, unsigned int cacheLines, unsigned int cacheLineSize,
+                              unsigned int cacheLatency, unsigned int memoryLatency, size_t numRequests,
+                              struct Request requests[], const char* tracefile, CacheReplacementPolicy policy,
+                              const SimulationOptions& options, const ProcessSchedule* schedule = nullptr) {
+
+    const auto accessedBlocks = (policy == POLICY_OPT) ? blocksAccessedByDataCache(requests, numRequests, cacheLineSize)
+                                                       : std::vector<std::uint32_t>{};
+
+    auto connections = std::make_unique<Connections>(options.clocks);
+    CPU cpu{"CPU", requests, numRequests, connections->clk.period(), options.core.loadStoreQueueSize,
+            issueWidthOf(options)};
+    // the interleaved trace of the processes is read back into theirs, it needs the read results written into it
+    auto readResultSink = (schedule == nullptr) ? makeReadResultSink(options.readResults) : nullptr;
+    cpu.setReadResultSink(readResultSink.get());
+    cpu.setGaps(options.core.gaps); // replaced by the gaps of the interleaved trace, see setUpProcesses
+    const std::uint32_t readsPerCacheline = cacheLineSize / RAM_READ_BUS_SIZE_IN_BYTE;
+    auto dataRam = makeMemory<MemoryType>("Data_RAM", memoryLatency, readsPerCacheline, options);
+    dataRam->setImage(loadMemoryImage(options)); // the instructions come from the trace, not from their RAM
+    const std::uint32_t instructionReadsPerCacheline = instructionCacheLineSizeOf(options) / RAM_READ_BUS_SIZE_IN_BYTE;
+    auto instructionRam =
+        makeMemory<MemoryType>("Instruction_RAM", memoryLatency, instructionReadsPerCacheline, options);
+    auto memoryController = makeMemoryController(readsPerCacheline, options);
+    auto dataBridge =
+        makeBridge("Data_Bridge", connections->clk, connections->memoryClock(), readsPerCacheline, options);
+    auto instructionBridge =
+        makeBridge("Instruction_Bridge", connections->clk, connections->memoryClock(), instructionReadsPerCacheline,
+                   options);
+
+    Cache<mappingType, PolicyType> dataCache{"Data_cache", cacheLines, cacheLineSize, cacheLatency,
+                                             (mappingType == MappingType::Direct)
+                                                 ? nullptr
+                                                 : getPolicyOfType<PolicyType>(policy, cacheLines, options,
+                                                                               &accessedBlocks),
+                                             writeBufferDepthOf(options), options.writeCombining != 0};
+
+    // the processes fetch the interleaved trace
+    const CoreTrace instructionTrace =
+        schedule == nullptr ? CoreTrace{numRequests, requests, nullptr, options.core.instructionAddresses}
+                            : CoreTrace{numRequests, requests, nullptr,
+                                        schedule->instructionAddresses.empty() ? nullptr
+                                                                               : schedule->instructionAddresses.data()};
+    auto instructionCache = makeInstructionCache("Instruction_Cache", instructionTrace, cacheLatency, 0, options);
+    dataCache.setClockPeriod(connections->clk.period());
+    if (schedule != nullptr)
+        setUpProcesses(cpu, dataCache, *schedule, policy, cacheLines, options);
+
+#ifdef STRICT_INSTRUCTION_ORDER
+    dataCache.setMemoryLatency(memoryLatency);
+    instructionCache->setMemoryLatency(memoryLatency);
+#endif
+
+    connectMemoryChain(*connections, connections->dataCrossing, dataBridge.get(), memoryController.get(), *dataRam,
+                       [&](auto& dataMemory) {
+                           connectMemoryChain(*connections, connections->instrCrossing, instructionBridge.get(),
+                                              nullptr, *instructionRam, [&](auto& instructionMemory) {
+                                                  connectComponents(*connections, cpu, dataMemory, instructionMemory,
+                                                                    dataCache, *instructionCache);
+                                              });
+                       });
+
+    auto tracer = setUpTracefile(tracefile, *connections, dataCache, static_cast<L2Cache<mappingType>*>(nullptr),
+                                 memoryController != nullptr);
+    // from_value takes pico-seconds, cycles are counted on the core clock
+    sc_start(sc_time::from_value(cycles * connections->clk.period().value()));
+    checkVictimsOf("data cache", dataCache.getInvalidVictim(), options);
+    checkVictimsOf("instruction cache", instructionCache->getInvalidVictim(), options);
+
+    if (mappingType == MappingType::Fully_Associative && options.dipSeriesFile != nullptr)
+        writeInsertionSeries(dataCache.getReplacementPolicy(), options.dipSeriesFile);
+
+    return Result{connections.get()->CPU_to_instrCache_PC >= numRequests - 1 ? cpu.getElapsedCycleCount() : SIZE_MAX,
+                  dataCache.missCount, dataCache.hitCount, dataCache.calculateGateCount(), L2Statistics{},
+                  dataCache.getWriteBufferStatistics(), dramStatisticsOf(*dataRam),
+                  memoryControllerStatisticsOf(memoryController.get()), CoherenceStatistics{},
+                  multiprogramStatisticsOf(dataCache, schedule), instructionCacheStatisticsOf(*instructionCache),
+                  LoadStoreQueueStatistics{cpu.getForwardedLoads()}};
+}
+
+template <MappingType mappingType, typename PolicyType, typename MemoryType>
+Result run_simulation_with_l2(unsigned int cycles, unsigned int cacheLines, unsigned int cacheLineSize,
+                              unsigned int cacheLatency, unsigned int memoryLatency, size_t numRequests,
+                              struct Request requests[], const char* tracefile, CacheReplacementPolicy policy,
+                              const SimulationOptions& options) {
+    const L2Options& l2Options = options.l2;
+    // the accesses of the L2 depend on the timing of both L1 caches, so only the data cache can use OPT
+    const auto accessedBlocks = (policy == POLICY_OPT) ? blocksAccessedByDataCache(requests, numRequests, cacheLineSize)
+                                                       : std::vector<std::uint32_t>{};
 
-    CPU cpu{"CPU", requests, numRequests};
-    RAM dataRam{"Data_RAM", memoryLatency, cacheLineSize / RAM_READ_BUS_SIZE_IN_BYTE};
-    RAM instructionRam{"Instruction_RAM", memoryLatency, cacheLineSize / RAM_READ_BUS_SIZE_IN_BYTE};
+    auto connections = std::make_unique<Connections>(options.clocks);
+    CPU cpu{"CPU", requests, numRequests, connections->clk.period(), options.core.loadStoreQueueSize,
+            issueWidthOf(options)};
+    auto readResultSink = makeReadResultSink(options.readResults);
+    cpu.setReadResultSink(readResultSink.get());
+    cpu.setGaps(options.core.gaps);
+    const std::uint32_t readsPerL2Cacheline = l2Options.cacheLineSize / RAM_READ_BUS_SIZE_IN_BYTE;
+    auto ram = makeMemory<MemoryType>("RAM", memoryLatency, readsPerL2Cacheline, options);
+    ram->setImage(loadMemoryImage(options));
+    auto memoryController = makeMemoryController(readsPerL2Cacheline, options);
+    auto memoryBridge = makeBridge("Memory_Bridge", connections->cacheClock(), connections->memoryClock(),
+                                   readsPerL2Cacheline, options);
+    // the L1 caches have their own bridges into the domain of the L2
+    auto dataBridge = makeBridge("Data_Bridge", connections->clk, connections->cacheClock(),
+                                 cacheLineSize / RAM_READ_BUS_SIZE_IN_BYTE, options);
+    const std::uint32_t instructionReadsPerCacheline = instructionCacheLineSizeOf(options) / RAM_READ_BUS_SIZE_IN_BYTE;
+    auto instructionBridge = makeBridge("Instruction_Bridge", connections->clk, connections->cacheClock(),
+                                        instructionReadsPerCacheline, options);
 
-    Cache<mappingType> dataCache{"Data_cache", cacheLines, cacheLineSize, cacheLatency,
-                                 (mappingType == MappingType::Direct) ? nullptr : getPolicy(policy, cacheLines)};
+    L2Cache<mappingType> l2Cache{
+        "L2_cache",
+        l2Options.cacheLines,
+        l2Options.cacheLineSize,
+        l2Options.cacheLatency,
+        instructionReadsPerCacheline,
+        cacheLineSize / RAM_READ_BUS_SIZE_IN_BYTE,
+        (mappingType == MappingType::Direct) ? nullptr : getPolicy(policy, l2Options.cacheLines, options)};
 
-    InstructionCache instructionCache{"Instruction_Cache", instructionCacheNumLines, instructionCacheLineSize,
-                                      cacheLatency, std::vector<Request>(requests, requests + numRequests)};
+    Cache<mappingType, PolicyType> dataCache{"Data_cache", cacheLines, cacheLineSize, cacheLatency,
+                                             (mappingType == MappingType::Direct)
+                                                 ? nullptr
+                                                 : getPolicyOfType<PolicyType>(policy, cacheLines, options,
+                                                                               &accessedBlocks),
+                                             writeBufferDepthOf(options), options.writeCombining != 0};
+
+    auto instructionCache =
+        makeInstructionCache("Instruction_Cache",
+                             CoreTrace{numRequests, requests, options.core.gaps, options.core.instructionAddresses},
+                             cacheLatency, instructionSegmentBase, options);
+    dataCache.setClockPeriod(connections->clk.period());
+    l2Cache.setClockPeriod(connections->cacheClock().period());
 
 #ifdef STRICT_INSTRUCTION_ORDER
     dataCache.setMemoryLatency(memoryLatency);
-    instructionCache.setMemoryLatency(memoryLatency);
+    instructionCache->setMemoryLatency(memoryLatency);
 #endif
 
-    auto connections = connectComponents(cpu, dataRam, instructionRam, dataCache, instructionCache);
+    connectMemoryChain(*connections, connections->memoryCrossing, memoryBridge.get(), memoryController.get(), *ram,
+                       [&](auto& memory) {
+                           if (dataBridge == nullptr) {
+                               connectComponents(*connections, cpu, memory, l2Cache, dataCache, *instructionCache);
+                               return;
+                           }
+                           connectComponents(*connections, cpu, *dataBridge, *instructionBridge, dataCache,
+                                             *instructionCache);
+                           connectBridgesToL2(*connections, *dataBridge, *instructionBridge, l2Cache);
+                           connectL2ToMemory(*connections, l2Cache, memory);
+                       });
+
+    auto tracer = setUpTracefile(tracefile, *connections, dataCache, &l2Cache, memoryController != nullptr);
+    // from_value takes pico-seconds, cycles are counted on the core clock
+    sc_start(sc_time::from_value(cycles * connections->clk.period().value()));
+    checkVictimsOf("data cache", dataCache.getInvalidVictim(), options);
+    checkVictimsOf("instruction cache", instructionCache->getInvalidVictim(), options);
+    checkVictimsOf("L2 cache", l2Cache.getInvalidVictim(), options);
 
-    auto tracer = setUpTracefile(tracefile, *connections, dataCache);
-    sc_start(sc_time::from_value(cycles * 1000ull)); // from_value takes pico-seconds and each of our cycles is a NS
+    if (mappingType == MappingType::Fully_Associative && options.dipSeriesFile != nullptr)
+        writeInsertionSeries(dataCache.getReplacementPolicy(), options.dipSeriesFile);
 
+    L2Statistics l2Statistics{l2Cache.instructionStatistics.accesses,
+                              l2Cache.instructionStatistics.misses,
+                              l2Cache.instructionStatistics.contentionStallCycles,
+                              l2Cache.dataStatistics.accesses,
+                              l2Cache.dataStatistics.misses,
+                              l2Cache.dataStatistics.contentionStallCycles};
     return Result{connections.get()->CPU_to_instrCache_PC >= numRequests - 1 ? cpu.getElapsedCycleCount() : SIZE_MAX,
-                  dataCache.missCount, dataCache.hitCount, dataCache.calculateGateCount()};
+                  dataCache.missCount, dataCache.hitCount, dataCache.calculateGateCount(), l2Statistics,
+                  dataCache.getWriteBufferStatistics(), dramStatisticsOf(*ram),
+                  memoryControllerStatisticsOf(memoryController.get()), CoherenceStatistics{},
+                  MultiprogramStatistics{}, instructionCacheStatisticsOf(*instructionCache),
+                  LoadStoreQueueStatistics{cpu.getForwardedLoads()}};
+}
+
+/**
+ * The trace file of a multicore system: the signals between every CPU and its caches and the ones towards the memory.
+ */
+auto setUpMulticoreTracefile(const char* traceFile, Connections& connections, bool hasMemoryController) {
+    auto traceCloser = [](sc_core::sc_trace_file* trace) {
+        if (trace != nullptr)
+            sc_close_vcd_trace_file(trace);
+    };
+    if (traceFile == nullptr)
+        return std::unique_ptr<sc_trace_file, decltype(traceCloser)>(nullptr, std::move(traceCloser));
+
+    std::unique_ptr<sc_trace_file, decltype(traceCloser)> trace{sc_create_vcd_trace_file(traceFile),
+                                                                std::move(traceCloser)};
+    trace->set_time_unit(100, SC_PS); // not 1 NS because the snooping bus does everything at falling edge
+    sc_trace(trace.get(), connections.clk, "clock");
+    if (&connections.memoryClock() != &connections.clk)
+        sc_trace(trace.get(), connections.memoryClock(), "memory_clock");
+
+    for (const auto& core : connections.cores) {
+        sc_trace(trace.get(), core->dataAddress, core->dataAddress.basename());
+        sc_trace(trace.get(), core->dataOut, core->dataOut.basename());
+        sc_trace(trace.get(), core->dataWe, core->dataWe.basename());
+        sc_trace(trace.get(), core->dataValidRequest, core->dataValidRequest.basename());
+        sc_trace(trace.get(), core->dataIn, core->dataIn.basename());
+        sc_trace(trace.get(), core->dataReady, core->dataReady.basename());
+        sc_trace(trace.get(), core->pc, core->pc.basename());
+        sc_trace(trace.get(), core->instrValidRequest, core->instrValidRequest.basename());
+        sc_trace(trace.get(), core->instruction, core->instruction.basename());
+        sc_trace(trace.get(), core->instrReady, core->instrReady.basename());
+        traceBus(trace.get(), core->instrMemory);
+        traceBus(trace.get(), core->instrCrossing);
+    }
+
+    traceBus(trace.get(), connections.sharedMemory);
+    traceBus(trace.get(), connections.dataCrossing);
+    if (hasMemoryController) {
+        sc_trace(trace.get(), connections.controller_to_RAM_Address, "controller_to_RAM_Address");
+        sc_trace(trace.get(), connections.controller_to_RAM_Data, "controller_to_RAM_Data");
+        sc_trace(trace.get(), connections.controller_to_RAM_WE, "controller_to_RAM_WE");
+        sc_trace(trace.get(), connections.controller_to_RAM_Valid_Request, "controller_to_RAM_Valid_Request");
+        sc_trace(trace.get(), connections.RAM_to_controller_Data, "RAM_to_controller_Data");
+        sc_trace(trace.get(), connections.RAM_to_controller_Ready, "RAM_to_controller_Ready");
+    }
+    return trace;
+}
+
+/**
+ * Simulates 1 + options.multicore.additionalCores cores, see MulticoreOptions. The data caches are configured like the
+ * single one, the replacement policy is instantiated per cache. Every core is done once its CPU processed its whole
+ * trace, the cycles are those of the core done last. Hits and misses are summed over all data caches. The gate count
+ * is not estimated for coherent caches and reported as 0.
+ */
+template <MappingType mappingType, typename MemoryType>
+Result run_simulation_multicore(unsigned int cycles, unsigned int cacheLines, unsigned int cacheLineSize,
+                                unsigned int cacheLatency, unsigned int memoryLatency, size_t numRequests,
+                                struct Request requests[], const char* tracefile, CacheReplacementPolicy policy,
+                                const SimulationOptions& options) {
+    std::vector<CoreTrace> traces{
+        CoreTrace{numRequests, requests, options.core.gaps, options.core.instructionAddresses}};
+    traces.insert(traces.end(), options.multicore.traces, options.multicore.traces + options.multicore.additionalCores);
+
+    auto connections = std::make_unique<Connections>(options.clocks);
+    const std::uint32_t readsPerCacheline = cacheLineSize / RAM_READ_BUS_SIZE_IN_BYTE;
+    const std::uint32_t instructionReadsPerCacheline = instructionCacheLineSizeOf(options) / RAM_READ_BUS_SIZE_IN_BYTE;
+    auto memory = makeMemory<MemoryType>("Shared_RAM", memoryLatency, readsPerCacheline, options);
+    memory->setImage(loadMemoryImage(options));
+    auto memoryController = makeMemoryController(readsPerCacheline, options);
+    auto memoryBridge =
+        makeBridge("Memory_Bridge", connections->clk, connections->memoryClock(), readsPerCacheline, options);
+    SnoopingBus bus{"Snooping_Bus", cacheLineSize};
+    bus.clock(connections->clk);
+
+    std::size_t runningCPUs = traces.size();
+    std::vector<std::unique_ptr<CPU>> cpus;
+    std::vector<std::unique_ptr<CoherentCache<mappingType>>> dataCaches;
+    std::vector<std::unique_ptr<InstructionCache>> instructionCaches;
+    std::vector<std::unique_ptr<MemoryType>> instructionRams;
+    std::vector<std::unique_ptr<ClockDomainBridge>> instructionBridges;
+    for (std::size_t core = 0; core < traces.size(); ++core) {
+        const std::string prefix = "core" + std::to_string(core);
+        const CoreTrace& trace = traces[core];
+        connections->cores.push_back(std::make_unique<CoreSignals>(prefix));
+        CoreSignals& signals = *connections->cores.back();
+
+        cpus.push_back(std::make_unique<CPU>((prefix + "_CPU").c_str(), trace.requests, trace.numRequests,
+                                             connections->clk.period(), options.core.loadStoreQueueSize,
+                                             issueWidthOf(options)));
+        cpus.back()->shareStopWith(runningCPUs);
+        cpus.back()->setGaps(trace.gaps);
+        dataCaches.push_back(std::make_unique<CoherentCache<mappingType>>(
+            (prefix + "_Data_cache").c_str(), bus, cacheLines, cacheLineSize, cacheLatency,
+            (mappingType == MappingType::Direct) ? nullptr : getPolicy(policy, cacheLines, options)));
+        dataCaches.back()->setClockPeriod(connections->clk.period());
+        instructionCaches.push_back(
+            makeInstructionCache((prefix + "_Instruction_Cache").c_str(), trace, cacheLatency, 0, options));
+        instructionRams.push_back(makeMemory<MemoryType>((prefix + "_Instruction_RAM").c_str(), memoryLatency,
+                                                         instructionReadsPerCacheline, options));
+        instructionBridges.push_back(makeBridge((prefix + "_Instruction_Bridge").c_str(), connections->clk,
+                                                connections->memoryClock(), instructionReadsPerCacheline, options));
+
+        connectCore(*connections, signals, *cpus.back(), *dataCaches.back(), *instructionCaches.back());
+        connectMemoryChain(*connections, signals.instrCrossing, instructionBridges.back().get(), nullptr,
+                           *instructionRams.back(), [&](auto& instructionMemory) {
+                               connectThroughBus(signals.instrMemory, *instructionCaches.back(), instructionMemory);
+                               instructionMemory.clock(connections->clk);
+                           });
+    }
+    connectMemoryChain(*connections, connections->dataCrossing, memoryBridge.get(), memoryController.get(), *memory,
+                       [&](auto& sharedMemory) {
+                           connectThroughBus(connections->sharedMemory, bus, sharedMemory);
+                           sharedMemory.clock(connections->clk);
+                       });
+
+    auto tracer = setUpMulticoreTracefile(tracefile, *connections, memoryController != nullptr);
+    // from_value takes pico-seconds, cycles are counted on the core clock
+    sc_start(sc_time::from_value(cycles * connections->clk.period().value()));
+
+    for (std::size_t core = 0; core < traces.size(); ++core) {
+        checkVictimsOf("data cache", dataCaches[core]->getInvalidVictim(), options);
+        checkVictimsOf("instruction cache", instructionCaches[core]->getInvalidVictim(), options);
+    }
+
+    std::size_t cyclesOfLastCore = 0;
+    Result result{};
+    for (std::size_t core = 0; core < traces.size(); ++core) {
+        const bool isDone = connections->cores[core]->pc.read() >= traces[core].numRequests - 1;
+        cyclesOfLastCore = isDone ? std::max<std::size_t>(cyclesOfLastCore, cpus[core]->getElapsedCycleCount())
+                                  : SIZE_MAX;
+        result.misses += dataCaches[core]->missCount;
+        result.hits += dataCaches[core]->hitCount;
+        result.coherence.coherenceMisses += dataCaches[core]->coherenceMissCount;
+        result.instructionCache.hits += instructionCaches[core]->getHitCount();
+        result.instructionCache.misses += instructionCaches[core]->getMissCount();
+        result.loadStoreQueue.forwardedLoads += cpus[core]->getForwardedLoads();
+    }
+    result.cycles = cyclesOfLastCore;
+    result.dram = dramStatisticsOf(*memory);
+    result.memoryController = memoryControllerStatisticsOf(memoryController.get());
+    result.coherence.cores = traces.size();
+    result.coherence.busTransactions = bus.statistics.transactions;
+    result.coherence.invalidations = bus.statistics.invalidations;
+    result.coherence.writeBacks = bus.statistics.writeBacks;
+    result.coherence.cacheToCacheTransfers = bus.statistics.cacheToCache;
+    result.coherence.busBusyCycles = bus.statistics.busyCycles;
+    result.coherence.cycles = bus.statistics.cycles;
+    return result;
+}
+
+/**
+ * Simulates the processes of options.multiprogram sharing a single core, see MultiprogramOptions. The hits, misses and
+ * cycles are those of the whole interleaved trace.
+ */
+template <MappingType mappingType, typename PolicyType, typename MemoryType>
+Result run_simulation_multiprogrammed(unsigned int cycles, unsigned int cacheLines, unsigned int cacheLineSize,
+                                      unsigned int cacheLatency, unsigned int memoryLatency, size_t numRequests,
+                                      struct Request requests[], const char* tracefile, CacheReplacementPolicy policy,
+                                      const SimulationOptions& options) {
+    ProcessSchedule schedule = scheduleProcesses(numRequests, requests, options.core.gaps,
+                                                 options.core.instructionAddresses, options.multiprogram);
+    const Result result = run_simulation_harvard<mappingType, PolicyType, MemoryType>(
+        cycles, cacheLines, cacheLineSize, cacheLatency, memoryLatency, schedule.requests.size(),
+        schedule.requests.data(), tracefile, policy, options, &schedule);
+    readBackIntoProcesses(schedule);
+    return result;
+}
+
+template <MappingType mappingType, typename PolicyType, typename MemoryType>
+Result run_simulation_with_memory(unsigned int cycles, unsigned int cacheLines, unsigned int cacheLineSize,
+                                  unsigned int cacheLatency, unsigned int memoryLatency, size_t numRequests,
+                                  struct Request requests[], const char* tracefile, CacheReplacementPolicy policy,
+                                  const SimulationOptions& options) {
+    if (options.multicore.additionalCores != 0) {
+        return run_simulation_multicore<mappingType, MemoryType>(cycles, cacheLines, cacheLineSize, cacheLatency,
+                                                                 memoryLatency, numRequests, requests, tracefile,
+                                                                 policy, options);
+    } else if (options.multiprogram.quantum != 0) {
+        return run_simulation_multiprogrammed<mappingType, PolicyType, MemoryType>(
+            cycles, cacheLines, cacheLineSize, cacheLatency, memoryLatency, numRequests, requests, tracefile, policy,
+            options);
+    } else if (options.l2.cacheLines == 0) {
+        return run_simulation_harvard<mappingType, PolicyType, MemoryType>(cycles, cacheLines, cacheLineSize,
+                                                                           cacheLatency, memoryLatency, numRequests,
+                                                                           requests, tracefile, policy, options);
+    } else {
+        return run_simulation_with_l2<mappingType, PolicyType, MemoryType>(cycles, cacheLines, cacheLineSize,
+                                                                           cacheLatency, memoryLatency, numRequests,
+                                                                           requests, tracefile, policy, options);
+    }
+}
+
+template <MappingType mappingType, typename PolicyType>
+Result run_simulation_extended(unsigned int cycles, unsigned int cacheLines, unsigned int cacheLineSize,
+                               unsigned int cacheLatency, unsigned int memoryLatency, size_t numRequests,
+                               struct Request requests[], const char* tracefile, CacheReplacementPolicy policy,
+                               const SimulationOptions& options) {
+    if (options.dram.banks != 0) {
+        return run_simulation_with_memory<mappingType, PolicyType, DRAM>(cycles, cacheLines, cacheLineSize,
+                                                                         cacheLatency, memoryLatency, numRequests,
+                                                                         requests, tracefile, policy, options);
+    } else {
+        return run_simulation_with_memory<mappingType, PolicyType, RAM>(cycles, cacheLines, cacheLineSize,
+                                                                        cacheLatency, memoryLatency, numRequests,
+                                                                        requests, tracefile, policy, options);
+    }
+}
+
+/**
+ * OPT has to know all accesses of a cache in advance, which it only does for the data cache of a single core, see
+ * blocksAccessedByDataCache. Returns why options rule OPT out, nullptr if they do not. The command line rejects these
+ * combinations itself, this guards the C API.
+ */
+const char* whyOptionsRuleOutOPT(const SimulationOptions& options) noexcept {
+    if (options.l2.cacheLines != 0)
+        return "OPT cannot be combined with an L2 cache";
+    if (options.multicore.additionalCores != 0)
+        return "OPT cannot be combined with several cores";
+    if (options.multiprogram.ways != 0)
+        return "OPT cannot be combined with a cache partitioned into ways";
+    return nullptr;
+}
+
+struct Result run_simulation_with_options(unsigned int cycles, int directMapped, unsigned int cacheLines,
+                                          unsigned int cacheLineSize, unsigned int cacheLatency,
+                                          unsigned int memoryLatency, size_t numRequests, struct Request requests[],
+                                          const char* tracefile, CacheReplacementPolicy policy,
+                                          const struct SimulationOptions* options) {
+    const SimulationOptions defaultOptions{};
+    if (options == nullptr) {
+        options = &defaultOptions;
+    }
+    if (policy == POLICY_OPT) {
+        if (const char* reason = whyOptionsRuleOutOPT(*options)) {
+            std::cerr << reason << '\n';
+            return Result{};
+        }
+    }
+    try {
+        if (directMapped == 0) {
+            return visitPolicyType(policy, [&](auto policyTag) {
+                using PolicyType = typename decltype(policyTag)::type;
+                return run_simulation_extended<MappingType::Fully_Associative, PolicyType>(
+                    cycles, cacheLines, cacheLineSize, cacheLatency, memoryLatency, numRequests, requests, tracefile,
+                    policy, *options);
+            });
+        } else {
+            // a direct mapped cache never calls its policy
+            return run_simulation_extended<MappingType::Direct, ReplacementPolicy<std::uint32_t>>(
+                cycles, cacheLines, cacheLineSize, cacheLatency, memoryLatency, numRequests, requests, tracefile,
+                policy, *options);
+        }
+    } catch (const PolicyPluginError& error) {
+        // a broken plugin is a user error like any invalid argument, the empty result tells the caller so
+        std::cerr << error.what() << '\n';
+        return Result{};
+    } catch (const MemoryImageError& error) {
+        std::cerr << error.what() << '\n';
+        return Result{};
+    } catch (const ReadResultSinkError& error) {
+        std::cerr << error.what() << '\n';
+        return Result{};
+    } catch (const std::exception& error) {
+        // nothing may leave this C function, an unexpected error still only ends this simulation
+        std::cerr << error.what() << '\n';
+        return Result{};
+    }
 }
 
 struct Result run_simulation_extended(unsigned int cycles, int directMapped, unsigned int cacheLines,
                                       unsigned int cacheLineSize, unsigned int cacheLatency, unsigned int memoryLatency,
                                       size_t numRequests, struct Request requests[], const char* tracefile,
                                       CacheReplacementPolicy policy) {
-    if (directMapped == 0) {
-        return run_simulation_extended<MappingType::Fully_Associative>(
-            cycles, cacheLines, cacheLineSize, cacheLatency, memoryLatency, numRequests, requests, tracefile, policy);
-    } else {
-        return run_simulation_extended<MappingType::Direct>(cycles, cacheLines, cacheLineSize, cacheLatency,
-                                                            memoryLatency, numRequests, requests, tracefile, policy);
-    }
+    return run_simulation_with_options(cycles, directMapped, cacheLines, cacheLineSize, cacheLatency, memoryLatency,
+                                       numRequests, requests, tracefile, policy, nullptr);
 }
 
 struct Result run_simulation(int cycles, int directMapped, unsigned cacheLines, unsigned cacheLineSize,
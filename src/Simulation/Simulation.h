@@ -3,6 +3,7 @@
 #include "Policy/Policy.h"
 #include "../Request.h"
 #include "../Result.h"
+#include "../SimulationOptions.h"
 #include "stddef.h"
 #include <stdint.h>
 
@@ -14,6 +15,17 @@ struct Result run_simulation_extended(uint32_t cycles, int directMapped, unsigne
                                       size_t numRequests, struct Request requests[], const char* tracefile,
                                       enum CacheReplacementPolicy policy);
 
+/**
+ * run_simulation_extended with the further components and traces described by options. NULL simulates the same system
+ * as run_simulation_extended. Invalid input, e.g. OPT together with an L2 cache, several cores or ways, is reported on
+ * stderr and results in an empty Result.
+ */
+struct Result run_simulation_with_options(uint32_t cycles, int directMapped, unsigned int cacheLines,
+                                          unsigned int cacheLineSize, unsigned int cacheLatency,
+                                          unsigned int memoryLatency, size_t numRequests, struct Request requests[],
+                                          const char* tracefile, enum CacheReplacementPolicy policy,
+                                          const struct SimulationOptions* options);
+
 struct Result run_simulation(int cycles, int directMapped, unsigned cacheLines, unsigned cacheLineSize,
                              unsigned cacheLatency, unsigned memoryLatency, size_t numRequests,
                              struct Request requests[], const char* tracefile);
@@ -0,0 +1,144 @@
+#include "SnoopingBus.h"
+
+#include <algorithm>
+#include <cassert>
+
+SnoopingBus::SnoopingBus(sc_core::sc_module_name name, std::uint32_t cacheLineSize)
+    : sc_module{name}, cacheLineSize{cacheLineSize} {
+    using namespace sc_core;
+    assert(cacheLineSize > 0 && cacheLineSize % BusBeat::SIZE_IN_BYTE == 0);
+
+    SC_THREAD(handleTransactions);
+    sensitive << clock.neg();
+
+    SC_METHOD(countCycles);
+    sensitive << clock.pos();
+    dont_initialize();
+}
+
+std::size_t SnoopingBus::attach(Snooper& snooper) {
+    requests.push_back(Attachment{&snooper, BusTransaction{}, false});
+    return requests.size() - 1;
+}
+
+void SnoopingBus::post(std::size_t requester, const BusTransaction& transaction) noexcept {
+    auto& attachment = requests.at(requester);
+    assert(!attachment.isPending);
+    attachment.transaction = transaction;
+    attachment.isPending = true;
+}
+
+void SnoopingBus::handleTransactions() noexcept {
+    while (true) {
+        wait();
+        const std::size_t requester = arbitrate();
+        if (requester == requests.size())
+            continue;
+
+        isBusy = true;
+        execute(requester);
+        lastServed = requester;
+        isBusy = false;
+    }
+}
+
+void SnoopingBus::countCycles() noexcept {
+    ++statistics.cycles;
+    if (isBusy)
+        ++statistics.busyCycles;
+}
+
+std::size_t SnoopingBus::arbitrate() const noexcept {
+    for (std::size_t i = 1; i <= requests.size(); ++i) {
+        const std::size_t candidate = (lastServed + i) % requests.size();
+        if (requests[candidate].isPending)
+            return candidate;
+    }
+    return requests.size();
+}
+
+void SnoopingBus::execute(std::size_t requester) noexcept {
+    auto& attachment = requests[requester];
+    BusTransaction& transaction = attachment.transaction;
+    attachment.snooper->prepare(transaction);
+    ++statistics.transactions;
+
+    if (transaction.hasWriteBack) {
+        writeLineToMemory(transaction.writeBackAddress, transaction.writeBackLine);
+        ++statistics.writeBacks;
+    }
+
+    const bool isFlushed = snoopOthers(requester, transaction);
+    if (isFlushed) {
+        ++statistics.cacheToCache;
+        if (transaction.operation == BusOperation::Read) { // every copy is clean from now on
+            writeLineToMemory(transaction.lineAddress, transaction.line);
+            ++statistics.writeBacks;
+        }
+    } else if (transaction.operation != BusOperation::Upgrade) {
+        readLineFromMemory(transaction.lineAddress, transaction.line);
+    } else {
+        wait(); // the invalidation takes a cycle on the bus as well
+    }
+
+    attachment.snooper->complete(transaction);
+    attachment.isPending = false;
+}
+
+bool SnoopingBus::snoopOthers(std::size_t requester, BusTransaction& transaction) noexcept {
+    transaction.isShared = false;
+    bool isFlushed = false;
+    for (std::size_t other = 0; other < requests.size(); ++other) {
+        if (other == requester)
+            continue;
+        bool wasModified = false;
+        const bool hadCopy =
+            requests[other].snooper->snoop(transaction.operation, transaction.lineAddress, transaction.line,
+                                           wasModified);
+        if (!hadCopy)
+            continue;
+        transaction.isShared = true;
+        isFlushed = isFlushed || wasModified; // MESI allows a single modified copy only
+        if (transaction.operation != BusOperation::Read)
+            ++statistics.invalidations;
+    }
+    return isFlushed;
+}
+
+void SnoopingBus::readLineFromMemory(std::uint32_t lineAddress, std::vector<std::uint8_t>& line) noexcept {
+    line.resize(cacheLineSize);
+    memoryAddrBus.write(lineAddress);
+    memoryWeBus.write(false);
+    memoryValidRequestBus.write(true);
+    while (!memoryReadyBus.read()) {
+        wait();
+    }
+    memoryValidRequestBus.write(false);
+
+    // don't need to wait before the first one because we can only get here if the memory tells us it is ready
+    for (std::uint32_t beat = 0; beat < cacheLineSize / BusBeat::SIZE_IN_BYTE; ++beat) {
+        const auto& bytes = memoryDataInBus.read().bytes;
+        std::copy(bytes.begin(), bytes.end(), line.begin() + beat * BusBeat::SIZE_IN_BYTE);
+        wait();
+    }
+}
+
+void SnoopingBus::writeLineToMemory(std::uint32_t lineAddress, const std::vector<std::uint8_t>& line) noexcept {
+    assert(line.size() == cacheLineSize);
+    for (std::uint32_t offset = 0; offset < cacheLineSize; offset += 4) {
+        if (offset != 0)
+            wait(); // gives the memory a cycle to take back its ready of the previous write
+        memoryAddrBus.write(lineAddress + offset);
+        memoryDataOutBus.write(static_cast<std::uint32_t>(line[offset]) |
+                               static_cast<std::uint32_t>(line[offset + 1]) << 8 |
+                               static_cast<std::uint32_t>(line[offset + 2]) << 16 |
+                               static_cast<std::uint32_t>(line[offset + 3]) << 24);
+        memoryWeBus.write(true);
+        memoryValidRequestBus.write(true);
+        while (!memoryReadyBus.read()) {
+            wait();
+        }
+        memoryValidRequestBus.write(false);
+    }
+    wait(); // the ready of the last word is still up, another request has to wait for the memory to take it back
+}
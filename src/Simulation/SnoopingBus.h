@@ -0,0 +1,148 @@
+#pragma once
+#include "BusBeat.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <systemc>
+
+// what a cache asks the others for on the bus
+enum class BusOperation {
+    Read,          // a copy of a line to read it, others may keep theirs
+    ReadExclusive, // the only copy of a line to write it, all others are invalidated
+    Upgrade,       // the only copy of a line the requester already shares, all others are invalidated
+};
+
+/**
+ * A bus transaction of one cache. The requester posts it with just the line it needs and whether it wants to write it
+ * (wantsExclusive). Once the bus is granted, the requester fills in the rest, the bus the result.
+ */
+struct BusTransaction {
+    std::uint32_t lineAddress{0};
+    bool wantsExclusive{false};
+
+    // filled in by the requester once the bus is granted, see Snooper::prepare
+    BusOperation operation{BusOperation::Read};
+    bool hasWriteBack{false}; // a modified line has to make room for the line read
+    std::uint32_t writeBackAddress{0};
+    std::vector<std::uint8_t> writeBackLine;
+
+    // filled in by the bus
+    std::vector<std::uint8_t> line; // the data read, unused for an Upgrade
+    bool isShared{false};           // another cache kept a copy
+};
+
+/**
+ * The side of a cache the snooping bus talks to. All calls happen on the bus, in no time.
+ */
+class Snooper {
+  public:
+    virtual ~Snooper() = default;
+
+    /**
+     * Called on the requester once the bus is granted to it: sets the operation needed by the current state of the line
+     * and the write back of a modified line it has to evict for it.
+     */
+    virtual void prepare(BusTransaction& transaction) = 0;
+    /**
+     * Called on all other caches for every Read, ReadExclusive or Upgrade of the line at lineAddress, updating the
+     * state of their copy.
+     * @param[out] line The data of their copy, if it was modified
+     * @param[out] wasModified Whether they had a modified copy, which they flush
+     * @returns whether they had a copy
+     */
+    virtual bool snoop(BusOperation operation, std::uint32_t lineAddress, std::vector<std::uint8_t>& line,
+                       bool& wasModified) = 0;
+    /**
+     * Called on the requester once the transaction is done: fills in the line read and its new state.
+     */
+    virtual void complete(const BusTransaction& transaction) = 0;
+};
+
+/**
+ * This module connects the private L1 data caches of several cores to the memory they share and keeps them coherent by
+ * snooping: every transaction is seen by all other caches, which update the state of their copy of the line as MESI
+ * demands. The caches attach themselves, posting their transactions through post and polling isDone.
+ *
+ * A single transaction is on the bus at a time. Of the caches waiting for it, the one following the cache served last
+ * is granted the bus next (round robin). A transaction then
+ * - writes back the modified line the requester evicts for it, if any
+ * - snoops all other caches. A modified copy is flushed: for a Read it is written back to memory, as all copies will be
+ *   clean, for a ReadExclusive it is handed to the requester only, who takes over the modification
+ * - reads the line from memory unless it was flushed or it is an Upgrade
+ * Towards the memory, which may be a RAM, a DRAM or a memory controller, the bus behaves like a write buffer: it acts
+ * on the falling edge and writes a line word by word.
+ */
+SC_MODULE(SnoopingBus) {
+  public:
+    // Global -> Bus
+    sc_core::sc_in<bool> SC_NAMED(clock);
+
+    // Bus -> Memory
+    sc_core::sc_out<std::uint32_t> SC_NAMED(memoryAddrBus);
+    sc_core::sc_out<std::uint32_t> SC_NAMED(memoryDataOutBus);
+    sc_core::sc_out<bool> SC_NAMED(memoryWeBus);
+    sc_core::sc_out<bool> SC_NAMED(memoryValidRequestBus);
+
+    // Memory -> Bus
+    sc_core::sc_in<BusBeat> SC_NAMED(memoryDataInBus);
+    sc_core::sc_in<bool> SC_NAMED(memoryReadyBus);
+
+    struct Statistics {
+        std::uint64_t transactions{0};
+        std::uint64_t invalidations{0};  // copies invalidated by a ReadExclusive or an Upgrade
+        std::uint64_t writeBacks{0};     // lines written to memory, evicted or flushed for a Read
+        std::uint64_t cacheToCache{0};   // lines flushed to the requester instead of being read from memory
+        std::uint64_t busyCycles{0};
+        std::uint64_t cycles{0};
+    } statistics;
+
+    /**
+     * @param[in] cacheLineSize The size of the lines of all caches, a multiple of the 16 byte bus beat.
+     */
+    SnoopingBus(sc_core::sc_module_name name, std::uint32_t cacheLineSize);
+
+    /**
+     * Attaches a cache to the bus.
+     * @returns the number identifying the cache towards the bus
+     */
+    std::size_t attach(Snooper & snooper);
+
+    /**
+     * Posts the transaction of the cache attached as requester, which has to wait for isDone before posting the next
+     */
+    void post(std::size_t requester, const BusTransaction& transaction) noexcept;
+    bool isDone(std::size_t requester) const noexcept { return !requests.at(requester).isPending; }
+    // the transaction of requester, completed once isDone
+    const BusTransaction& transactionOf(std::size_t requester) const noexcept {
+        return requests.at(requester).transaction;
+    }
+
+  private:
+    SC_CTOR(SnoopingBus);
+
+    struct Attachment {
+        Snooper* snooper;
+        BusTransaction transaction;
+        bool isPending;
+    };
+
+    const std::uint32_t cacheLineSize;
+    std::vector<Attachment> requests;
+    std::size_t lastServed = 0;
+    bool isBusy = false;
+
+    void handleTransactions() noexcept;
+    // counts the busy cycles, runs every cycle
+    void countCycles() noexcept;
+
+    // the attached cache waiting for the bus to be served next, requests.size() if there is none
+    std::size_t arbitrate() const noexcept;
+    void execute(std::size_t requester) noexcept;
+    // snoops all caches but the requester, collecting a flushed line in transaction.line
+    bool snoopOthers(std::size_t requester, BusTransaction & transaction) noexcept;
+
+    void readLineFromMemory(std::uint32_t lineAddress, std::vector<std::uint8_t> & line) noexcept;
+    void writeLineToMemory(std::uint32_t lineAddress, const std::vector<std::uint8_t>& line) noexcept;
+};
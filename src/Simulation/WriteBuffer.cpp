@@ -0,0 +1,328 @@
+#include "WriteBuffer.h"
+
+#include <algorithm>
+#include <utility>
+
+constexpr std::uint32_t WriteBuffer::idleFlushCycles;
+constexpr std::uint32_t WriteBuffer::maxOverhang;
+
+WriteBuffer::WriteBuffer(sc_core::sc_module_name name, std::uint32_t readsPerCacheline, std::uint32_t cacheLineSize,
+                         std::uint32_t depth, bool writeCombining)
+    : sc_module{name}, readsPerCacheline{readsPerCacheline}, cacheLineSize{cacheLineSize}, buffer{depth},
+      writeCombining{writeCombining} {
+    using namespace sc_core;
+    assert(depth > 0);
+    statistics.depth = depth;
+
+    SC_THREAD(updateState);
+    sensitive << clock.pos();
+    SC_THREAD(handleWrite);
+    sensitive << clock.neg();
+    SC_THREAD(handleRead);
+    sensitive << clock.neg();
+}
+
+void WriteBuffer::writeWordToRAM(const RAMWrite& write) noexcept {
+    memoryAddrBus.write(write.address);
+    memoryDataOutBus.write(write.data);
+    memoryWeBus.write(true);
+    memoryValidRequestBus.write(true);
+    while (!memoryReadyBus.read()) {
+        wait();
+    }
+    memoryValidRequestBus.write(false);
+}
+
+void WriteBuffer::writeBurstToRAM(const std::vector<RAMWrite>& writes) noexcept {
+    memoryWeBus.write(true);
+    memoryValidRequestBus.write(true); // kept up until the last word is done, which tells the RAM they belong together
+    for (std::size_t i = 0; i < writes.size(); ++i) {
+        memoryAddrBus.write(writes[i].address);
+        memoryDataOutBus.write(writes[i].data);
+        if (i != 0)
+            wait(); // the ready of the previous word is still up until the RAM took the next one
+        while (!memoryReadyBus.read()) {
+            wait();
+        }
+    }
+    memoryValidRequestBus.write(false);
+}
+
+std::vector<WriteBuffer::RAMWrite> WriteBuffer::splitIntoWords(const WriteBufferEntry& entry) const {
+    std::vector<RAMWrite> writes;
+    std::uint32_t runStart = 0;
+    while (runStart < entry.data.size()) {
+        if (!entry.isWritten[runStart]) {
+            ++runStart;
+            continue;
+        }
+        std::uint32_t runEnd = runStart;
+        while (runEnd < entry.data.size() && entry.isWritten[runEnd])
+            ++runEnd;
+        assert(runEnd - runStart >= 4);
+
+        for (std::uint32_t word = runStart; word < runEnd; word += 4) {
+            const std::uint32_t offset = std::min(word, runEnd - 4);
+            writes.push_back(RAMWrite{entry.lineAddress + offset,
+                                      static_cast<std::uint32_t>(entry.data[offset]) |
+                                          static_cast<std::uint32_t>(entry.data[offset + 1]) << 8 |
+                                          static_cast<std::uint32_t>(entry.data[offset + 2]) << 16 |
+                                          static_cast<std::uint32_t>(entry.data[offset + 3]) << 24});
+        }
+        runStart = runEnd;
+    }
+    return writes;
+}
+
+void WriteBuffer::writeToRAM() noexcept {
+    assert(buffer.getSize() > 0);
+    const WriteBufferEntry next = buffer.pop();
+    isDraining = true;
+    const auto writes = splitIntoWords(next);
+    const std::size_t drainStart = statistics.cycles;
+    if (writeCombining) {
+        ++statistics.bursts;
+        if (!isLineComplete(next))
+            ++statistics.partialFlushes;
+        statistics.savedRequests += writes.size() - 1;
+        writeBurstToRAM(writes);
+    } else {
+        for (std::size_t i = 0; i < writes.size(); ++i) {
+            if (i != 0)
+                wait(); // gives the RAM a cycle to take back its ready of the previous write
+            writeWordToRAM(writes[i]);
+        }
+    }
+    isDraining = false;
+    ramWriteRequests += writeCombining ? 1 : writes.size();
+    ramWriteCycles += statistics.cycles - drainStart;
+    updateAvoidedStallEstimate();
+}
+
+void WriteBuffer::passReadAlong() noexcept {
+    const std::uint32_t lineAddress = cacheAddrBus.read();
+    std::vector<std::uint8_t> bytes(cacheLineSize);
+    std::vector<bool> isBuffered(cacheLineSize, false);
+    const bool isForwarded = collectBufferedBytes(lineAddress, bytes, isBuffered);
+    const bool isMerged = !isForwarded && std::find(isBuffered.begin(), isBuffered.end(), true) != isBuffered.end();
+    if (isForwarded || isMerged) {
+        ++(isForwarded ? statistics.forwardedReads : statistics.mergedReads);
+        avoidedWriteRequests += countWriteRequestsAhead(lineAddress);
+        updateAvoidedStallEstimate();
+    }
+
+    if (!isForwarded) {
+        memoryAddrBus.write(lineAddress);
+        memoryWeBus.write(false);
+        memoryValidRequestBus.write(true);
+
+        while (!memoryReadyBus.read()) {
+            wait();
+        }
+        memoryValidRequestBus.write(false);
+    }
+
+    ready.write(true);
+    // don't need to wait before first one because we can only get here if RAM tells us it is ready
+    for (std::size_t i = 0; i < readsPerCacheline; ++i) {
+        BusBeat beat = isForwarded ? BusBeat{} : memoryDataInBus.read();
+        for (std::size_t byte = 0; byte < BusBeat::SIZE_IN_BYTE; ++byte) {
+            if (isBuffered[i * BusBeat::SIZE_IN_BYTE + byte])
+                beat.bytes[byte] = bytes[i * BusBeat::SIZE_IN_BYTE + byte];
+        }
+        cacheDataOutBus.write(beat);
+        wait();
+    }
+
+    ready.write(false);
+    wait(); // this wait is needed because otherwise on rising edge this would instantly be overwritten ig??
+}
+
+bool WriteBuffer::collectBufferedBytes(std::uint32_t lineAddress, std::vector<std::uint8_t>& bytes,
+                                       std::vector<bool>& isBuffered) noexcept {
+    // oldest to youngest, so the youngest write of a byte ends up in bytes
+    buffer.forEach([&](const WriteBufferEntry& entry) {
+        if (!affectsLine(entry, lineAddress))
+            return;
+        for (std::uint32_t offset = 0; offset < entry.data.size(); ++offset) {
+            const std::uint32_t lineOffset = entry.lineAddress + offset - lineAddress;
+            if (entry.isWritten[offset] && lineOffset < cacheLineSize) {
+                bytes[lineOffset] = entry.data[offset];
+                isBuffered[lineOffset] = true;
+            }
+        }
+    });
+    return std::all_of(isBuffered.begin(), isBuffered.end(), [](bool bit) { return bit; });
+}
+
+std::size_t WriteBuffer::countWriteRequestsAhead(std::uint32_t lineAddress) noexcept {
+    // without forwarding, the buffer was drained in order up to the youngest entry affecting the line
+    std::size_t requests = 0;
+    std::size_t requestsUpToLastAffecting = 0;
+    buffer.forEach([&](const WriteBufferEntry& entry) {
+        requests += writeCombining ? 1 : splitIntoWords(entry).size();
+        if (affectsLine(entry, lineAddress))
+            requestsUpToLastAffecting = requests;
+    });
+    return requestsUpToLastAffecting;
+}
+
+void WriteBuffer::updateAvoidedStallEstimate() noexcept {
+    if (ramWriteRequests > 0)
+        statistics.stallCyclesAvoided = avoidedWriteRequests * ramWriteCycles / ramWriteRequests;
+}
+
+std::uint32_t WriteBuffer::makeAddrAligned(std::uint32_t addr) const noexcept {
+    return (addr / cacheLineSize) * cacheLineSize;
+}
+
+bool WriteBuffer::overlaps(const WriteBufferEntry& entry, std::uint32_t addr) const noexcept {
+    for (std::uint32_t byte = 0; byte < 4; ++byte) {
+        const std::uint32_t offset = addr + byte - entry.lineAddress;
+        if (offset < entry.isWritten.size() && entry.isWritten[offset])
+            return true;
+    }
+    return false;
+}
+
+bool WriteBuffer::affectsLine(const WriteBufferEntry& entry, std::uint32_t lineAddress) const noexcept {
+    if (entry.lineAddress == lineAddress)
+        return true;
+    // the bytes of a write hanging over into the next line
+    for (std::uint32_t offset = cacheLineSize; offset < entry.isWritten.size(); ++offset) {
+        if (entry.isWritten[offset] && makeAddrAligned(entry.lineAddress + offset) == lineAddress)
+            return true;
+    }
+    return false;
+}
+
+WriteBuffer::WriteBufferEntry* WriteBuffer::findEntryToCoalesceInto(std::uint32_t addr) noexcept {
+    const std::uint32_t lineAddress = makeAddrAligned(addr);
+    WriteBufferEntry* candidate = nullptr;
+    // oldest to youngest, so a younger entry writing any of the same bytes has the final say
+    buffer.forEach([&](WriteBufferEntry& entry) {
+        if (entry.lineAddress == lineAddress)
+            candidate = &entry;
+        else if (overlaps(entry, addr))
+            candidate = nullptr;
+    });
+    return candidate;
+}
+
+void WriteBuffer::storeWrite(WriteBufferEntry& entry, std::uint32_t addr, std::uint32_t data) noexcept {
+    const std::uint32_t offset = addr - entry.lineAddress;
+    assert(offset + 4 <= entry.data.size());
+    for (std::uint32_t byte = 0; byte < 4; ++byte) {
+        entry.data[offset + byte] = static_cast<std::uint8_t>(data >> 8 * byte);
+        entry.isWritten[offset + byte] = true;
+    }
+}
+
+bool WriteBuffer::weCanAcceptWrite() const noexcept { return state == State::Idle || state == State::Write; }
+
+bool WriteBuffer::weCanAcceptRead() const noexcept {
+#ifdef STRICT_RAM_READ_AFTER_WRITES
+    return state == State::Idle && buffer.getSize() == 0;
+#else
+    return state == State::Idle;
+#endif
+}
+
+bool WriteBuffer::thereIsAWrite() noexcept { return (cacheValidRequest.read() && cacheWeBus.read()) || pending; }
+bool WriteBuffer::thereIsARead() noexcept { return cacheValidRequest.read() && !cacheWeBus.read(); }
+
+void WriteBuffer::acceptWriteRequest() noexcept {
+    const std::uint32_t addr = cacheAddrBus.read();
+    WriteBufferEntry* entry = findEntryToCoalesceInto(addr);
+    if (entry != nullptr) {
+        storeWrite(*entry, addr, cacheDataInBus.read());
+        ++statistics.coalescedWrites;
+    } else if (buffer.getSize() < buffer.getCapacity()) {
+        WriteBufferEntry newEntry{makeAddrAligned(addr), std::vector<std::uint8_t>(cacheLineSize + maxOverhang),
+                                  std::vector<bool>(cacheLineSize + maxOverhang, false)};
+        storeWrite(newEntry, addr, cacheDataInBus.read());
+        buffer.push(std::move(newEntry));
+    } else {
+        ++statistics.fullStallCycles;
+        ready.write(false);
+        state = State::Write;
+        pending = true;
+        return;
+    }
+    ++statistics.bufferedWrites;
+    cyclesSinceLastWrite = 0;
+    ready.write(true);
+    if (!writeCombining) // a combining buffer waits for shouldStartNextWrite, a drain in progress stays in Write
+        state = State::Write;
+    pending = false;
+}
+
+void WriteBuffer::acceptReadRequest() noexcept {
+    // do read immediately, buffered writes to the line are forwarded
+    state = State::Read;
+}
+
+bool WriteBuffer::isLineComplete(const WriteBufferEntry& entry) const noexcept {
+    return std::all_of(entry.isWritten.begin(), entry.isWritten.begin() + cacheLineSize, [](bool bit) { return bit; });
+}
+
+bool WriteBuffer::shouldStartNextWrite() noexcept {
+    if (state != State::Idle || buffer.getSize() == 0)
+        return false;
+    // a read only waiting here has to wait for all writes (STRICT_RAM_READ_AFTER_WRITES)
+    return !writeCombining || isLineComplete(buffer.front()) || cyclesSinceLastWrite >= idleFlushCycles ||
+           thereIsARead();
+}
+
+void WriteBuffer::recordCycle() noexcept {
+    const std::size_t occupancy = buffer.getSize() + (isDraining ? 1 : 0);
+    statistics.occupancySum += occupancy;
+    statistics.maxOccupancy = std::max(statistics.maxOccupancy, occupancy);
+    ++statistics.cycles;
+    if (cyclesSinceLastWrite < idleFlushCycles)
+        ++cyclesSinceLastWrite;
+}
+
+void WriteBuffer::updateState() noexcept {
+    while (true) {
+        wait();
+        recordCycle();
+        if (state != State::Read) // only in read is it possible we are actually ready rn
+            ready.write(false);   // this is a kind of catch-all safeguard that we aren't falsely reporting
+                                  // readiness. Should never be an issue though
+
+        if (weCanAcceptWrite() && thereIsAWrite()) {
+            acceptWriteRequest();
+            continue; // we can short - circuit here. We already know what to do next
+        }
+
+        if (weCanAcceptRead() && thereIsARead()) {
+            acceptReadRequest();
+            continue; // we can short - circuit here. We already know what to do next
+        }
+
+        if (shouldStartNextWrite()) {
+            state = State::Write;
+        }
+    }
+}
+
+void WriteBuffer::handleRead() noexcept {
+    while (true) {
+        wait();
+        if (state == State::Read) {
+            passReadAlong();
+            state = State::Idle;
+        }
+    }
+}
+
+void WriteBuffer::handleWrite() noexcept {
+    while (true) {
+        wait();
+        if (state == State::Write) {
+            writeToRAM();
+            state = State::Idle;
+        }
+    }
+}
@@ -1,8 +1,11 @@
 #pragma once
+#include "../Result.h"
+#include "BusBeat.h"
 #include "RingQueue.h"
 
 #include <cassert>
 #include <cstdint>
+#include <vector>
 
 #include <systemc>
 
@@ -13,12 +16,25 @@
  * write has already arrived in RAM or that it not having done so yet will simply be guaranteed to not interfere with
  * its future operations, this can save us a lot of cycles.
  *
- * Its default behaviour is to buffer all writes and, when a read happens, to check for whether the read would be
- * affected by buffered writes. If that is not the case, the read gets performed there and then, before the remaining
- * writes. As this is not completely sequentially consistent (imagine a peripheral that keeps track of reads happening
- * on it and therefore possibly changing what we would read on our read), there is the option of compiling this cache
- * with the definition STRICT_RAM_READ_AFTER_WRITES. This will lead to the behaviour of reads only going through if all
- * writes are done.
+ * Its default behaviour is to buffer all writes and to perform reads there and then, before the remaining writes. A
+ * read of a line with buffered writes does not wait for them either: if the buffered bytes cover the whole line, it is
+ * served from the buffer without asking the RAM at all (a forwarding hit), otherwise the buffered bytes are merged into
+ * the line read from RAM as it is passed on. As this is not completely sequentially consistent (imagine a peripheral
+ * that keeps track of reads happening on it and therefore possibly changing what we would read on our read), there is
+ * the option of compiling this cache with the definition STRICT_RAM_READ_AFTER_WRITES. This will lead to the behaviour
+ * of reads only going through if all writes are done.
+ *
+ * The buffer holds up to depth entries, each collecting the writes to one cacheline together with a mask of the bytes
+ * written. A write to a line that already has an entry is coalesced into it instead of taking a new one, unless a
+ * younger entry overlaps its bytes - merging it into the older entry would then reorder the two. When an entry is
+ * drained, every run of written bytes goes to RAM as 32 bit writes, the last one of a run overlapping its predecessor
+ * if the run is no multiple of 4 bytes long. As every write of the cache is 4 bytes long, a run is never shorter.
+ *
+ * By default an entry is drained as soon as the buffer has nothing else to do, one RAM request per word. In
+ * write-combining mode the oldest entry is only drained once all bytes of its line are written, a write needs its slot,
+ * a read has to wait for it or no write arrived for idleFlushCycles cycles - the latter ones being partial flushes.
+ * All its words then go to RAM as a single burst: the valid request stays up while the words follow each other one per
+ * cycle, so only the first one pays the memory latency (see RAM).
  *
  * Operations happen on both rising and falling edge. Since the write buffer is a very small component, having only half
  * a cycle for both kinds of operations is fine.
@@ -27,14 +43,14 @@
  * read or a write (or nothing)
  */
 
-template <std::uint8_t SIZE> SC_MODULE(WriteBuffer) {
+SC_MODULE(WriteBuffer) {
   public:
     // Global -> Buffer
     sc_core::sc_in<bool> SC_NAMED(clock);
 
     // Buffer -> Cache
     sc_core::sc_out<bool> SC_NAMED(ready);
-    sc_core::sc_out<sc_dt::sc_bv<128>> SC_NAMED(cacheDataOutBus);
+    sc_core::sc_out<BusBeat> SC_NAMED(cacheDataOutBus);
 
     // Cache -> Buffer
     sc_core::sc_in<std::uint32_t> SC_NAMED(cacheAddrBus);
@@ -49,28 +65,37 @@ template <std::uint8_t SIZE> SC_MODULE(WriteBuffer) {
     sc_core::sc_out<bool> SC_NAMED(memoryValidRequestBus);
 
     // RAM -> Buffer
-    sc_core::sc_in<sc_dt::sc_bv<128>> SC_NAMED(memoryDataInBus);
+    sc_core::sc_in<BusBeat> SC_NAMED(memoryDataInBus);
     sc_core::sc_in<bool> SC_NAMED(memoryReadyBus);
 
     const std::uint32_t readsPerCacheline;
     const std::uint32_t cacheLineSize;
 
-    WriteBuffer(sc_core::sc_module_name name, std::uint32_t readsPerCacheline, std::uint32_t cacheLineSize) noexcept
-        : sc_module{name}, readsPerCacheline{readsPerCacheline}, cacheLineSize{cacheLineSize} {
-        using namespace sc_core;
+    /**
+     * @param[in] depth The number of entries, i.e. of distinct cachelines writes can be buffered for. Has to be > 0.
+     * @param[in] writeCombining Whether entries wait for their line to fill and are drained as bursts.
+     */
+    WriteBuffer(sc_core::sc_module_name name, std::uint32_t readsPerCacheline, std::uint32_t cacheLineSize,
+                std::uint32_t depth, bool writeCombining);
 
-        SC_THREAD(updateState);
-        sensitive << clock.pos();
-        SC_THREAD(handleWrite);
-        sensitive << clock.neg();
-        SC_THREAD(handleRead);
-        sensitive << clock.neg();
-    }
+    const WriteBufferStatistics& getStatistics() const noexcept { return statistics; }
+
+    // cycles without a new write after which a write-combining buffer drains its oldest entry even if incomplete
+    static constexpr std::uint32_t idleFlushCycles = 64;
 
   private:
     SC_CTOR(WriteBuffer);
 
+    // a 32 bit write may start in the last 3 bytes of a line, its remaining bytes are kept behind those of the line
+    static constexpr std::uint32_t maxOverhang = 3;
+
     struct WriteBufferEntry {
+        std::uint32_t lineAddress;
+        std::vector<std::uint8_t> data;    // cacheLineSize + maxOverhang bytes
+        std::vector<bool> isWritten;       // per byte of data
+    };
+
+    struct RAMWrite {
         std::uint32_t address;
         std::uint32_t data;
     };
@@ -81,159 +106,58 @@ template <std::uint8_t SIZE> SC_MODULE(WriteBuffer) {
         Idle,
     };
 
-    RingQueue<WriteBufferEntry> buffer{SIZE};
+    RingQueue<WriteBufferEntry> buffer;
+    const bool writeCombining;
     State state = State::Idle;
     bool pending = false;
+    bool isDraining = false;
+    std::uint32_t cyclesSinceLastWrite = 0;
+    WriteBufferStatistics statistics{};
+    // for estimating the stall cycles saved by forwarding
+    std::size_t avoidedWriteRequests = 0;
+    std::size_t ramWriteRequests = 0;
+    std::size_t ramWriteCycles = 0;
 
     // ============= State update =============
     void updateState() noexcept;
     void acceptWriteRequest() noexcept;
     void acceptReadRequest() noexcept;
+    void recordCycle() noexcept;
 
     // ============= Reading =============
     void handleRead() noexcept;
     void passReadAlong() noexcept;
+    /**
+     * Collects the buffered bytes of the line at lineAddress, a younger entry overriding an older one.
+     * @returns whether all bytes of the line are buffered
+     */
+    bool collectBufferedBytes(std::uint32_t lineAddress, std::vector<std::uint8_t>& bytes,
+                              std::vector<bool>& isBuffered) noexcept;
+    // the RAM write requests a read of lineAddress would have had to wait for without forwarding
+    std::size_t countWriteRequestsAhead(std::uint32_t lineAddress) noexcept;
 
     // ============= Writing =============
     void handleWrite() noexcept;
     void writeToRAM() noexcept;
+    void writeWordToRAM(const RAMWrite& write) noexcept;
+    void writeBurstToRAM(const std::vector<RAMWrite>& writes) noexcept;
+    // the 32 bit writes covering all written bytes of entry, in ascending order
+    std::vector<RAMWrite> splitIntoWords(const WriteBufferEntry& entry) const;
+    /**
+     * @returns the entry the write of 4 bytes to addr can be coalesced into, nullptr if it needs an entry of its own
+     */
+    WriteBufferEntry* findEntryToCoalesceInto(std::uint32_t addr) noexcept;
+    void storeWrite(WriteBufferEntry & entry, std::uint32_t addr, std::uint32_t data) noexcept;
 
     // ============= Helpers =============
-    constexpr bool weCanAcceptWrite() noexcept;
-    constexpr bool weCanAcceptRead() noexcept;
+    bool weCanAcceptWrite() const noexcept;
+    bool weCanAcceptRead() const noexcept;
     bool shouldStartNextWrite() noexcept;
+    bool isLineComplete(const WriteBufferEntry& entry) const noexcept;
     bool thereIsAWrite() noexcept;
     bool thereIsARead() noexcept;
-    bool isReadAddrInWriteBuffer(std::uint32_t readAddr) noexcept;
-    constexpr std::uint32_t makeAddrAligned(std::uint32_t addr) noexcept;
+    bool affectsLine(const WriteBufferEntry& entry, std::uint32_t lineAddress) const noexcept;
+    void updateAvoidedStallEstimate() noexcept;
+    bool overlaps(const WriteBufferEntry& entry, std::uint32_t addr) const noexcept;
+    std::uint32_t makeAddrAligned(std::uint32_t addr) const noexcept;
 };
-
-template <std::uint8_t SIZE> void WriteBuffer<SIZE>::writeToRAM() noexcept {
-    assert(buffer.getSize() > 0);
-    WriteBufferEntry next = buffer.pop();
-    memoryAddrBus.write(next.address);
-    memoryDataOutBus.write(next.data);
-    memoryWeBus.write(true);
-    memoryValidRequestBus.write(true);
-    while (!memoryReadyBus.read()) {
-        wait();
-    }
-    memoryValidRequestBus.write(false);
-}
-
-template <std::uint8_t SIZE> void WriteBuffer<SIZE>::passReadAlong() noexcept {
-    memoryAddrBus.write(cacheAddrBus.read());
-    memoryWeBus.write(false);
-    memoryValidRequestBus.write(true);
-
-    while (!memoryReadyBus.read()) {
-        wait();
-    }
-    memoryValidRequestBus.write(false);
-
-    ready.write(true);
-    // don't need to wait before first one because we can only get here if RAM tells us it is ready
-    for (std::size_t i = 0; i < readsPerCacheline; ++i) {
-        cacheDataOutBus.write(memoryDataInBus.read());
-        wait();
-    }
-
-    ready.write(false);
-    wait(); // this wait is needed because otherwise on rising edge this would instantly be overwritten ig??
-}
-
-template <std::uint8_t SIZE> constexpr std::uint32_t WriteBuffer<SIZE>::makeAddrAligned(std::uint32_t addr) noexcept {
-    return (addr / cacheLineSize) * cacheLineSize;
-}
-
-template <std::uint8_t SIZE> bool WriteBuffer<SIZE>::isReadAddrInWriteBuffer(std::uint32_t readAddr) noexcept {
-    return buffer.any([readAddr, this](WriteBufferEntry& entry) { return makeAddrAligned(entry.address) == readAddr; });
-}
-
-template <std::uint8_t SIZE> constexpr bool WriteBuffer<SIZE>::weCanAcceptWrite() noexcept {
-    return state == State::Idle || state == State::Write;
-}
-
-template <std::uint8_t SIZE> constexpr bool WriteBuffer<SIZE>::weCanAcceptRead() noexcept {
-#ifdef STRICT_RAM_READ_AFTER_WRITES
-    return state == State::Idle && buffer.getSize() == 0;
-#else
-    return state == State::Idle;
-#endif
-}
-
-template <std::uint8_t SIZE> bool WriteBuffer<SIZE>::thereIsAWrite() noexcept {
-    return (cacheValidRequest.read() && cacheWeBus.read()) || pending;
-}
-template <std::uint8_t SIZE> bool WriteBuffer<SIZE>::thereIsARead() noexcept {
-    return cacheValidRequest.read() && !cacheWeBus.read();
-}
-
-template <std::uint8_t SIZE> void WriteBuffer<SIZE>::acceptWriteRequest() noexcept {
-    if (buffer.getSize() < SIZE) {
-        buffer.push(WriteBufferEntry{cacheAddrBus.read(), cacheDataInBus.read()});
-        ready.write(true);
-        state = State::Write;
-        pending = false;
-    } else {
-        ready.write(false);
-        state = State::Write;
-        pending = true;
-    }
-}
-
-template <std::uint8_t SIZE> void WriteBuffer<SIZE>::acceptReadRequest() noexcept {
-    // do read immediately unless the tag is in the buffer
-    if (isReadAddrInWriteBuffer(cacheAddrBus.read())) {
-        state = State::Write;
-    } else {
-        state = State::Read;
-    }
-}
-
-template <std::uint8_t SIZE> bool WriteBuffer<SIZE>::shouldStartNextWrite() noexcept {
-    return state == State::Idle && buffer.getSize() > 0;
-}
-
-template <std::uint8_t SIZE> void WriteBuffer<SIZE>::updateState() noexcept {
-    while (true) {
-        wait();
-        if (state != State::Read) // only in read is it possible we are actually ready rn
-            ready.write(false);   // this is a kind of catch-all safeguard that we aren't falsely reporting
-                                  // readiness. Should never be an issue though
-
-        if (weCanAcceptWrite() && thereIsAWrite()) {
-            acceptWriteRequest();
-            continue; // we can short - circuit here. We already know what to do next
-        }
-
-        if (weCanAcceptRead() && thereIsARead()) {
-            acceptReadRequest();
-            continue; // we can short - circuit here. We already know what to do next
-        }
-
-        if (shouldStartNextWrite()) {
-            state = State::Write;
-        }
-    }
-}
-
-template <std::uint8_t SIZE> void WriteBuffer<SIZE>::handleRead() noexcept {
-    while (true) {
-        wait();
-        if (state == State::Read) {
-            passReadAlong();
-            state = State::Idle;
-        }
-    }
-}
-
-template <std::uint8_t SIZE> void WriteBuffer<SIZE>::handleWrite() noexcept {
-    while (true) {
-        wait();
-        if (state == State::Write) {
-            writeToRAM();
-            state = State::Idle;
-        }
-    }
-}
\ No newline at end of file
@@ -0,0 +1,175 @@
+#pragma once
+#include "Request.h"
+#include "Simulation/Policy/Policy.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Options of run_simulation_with_options that go beyond the parameters required by the original interface. A
+ * zero-initialised structure (or passing NULL) results in the default system: CPU, instruction and data cache, each
+ * connected to its own RAM.
+ */
+
+/**
+ * Configuration of the unified second-level cache shared by instruction and data cache. A value of 0 for cacheLines
+ * disables the L2, in which case both L1 caches are connected to their own RAM.
+ */
+struct L2Options {
+    unsigned int cacheLines;
+    unsigned int cacheLineSize;
+    unsigned int cacheLatency;
+};
+
+/**
+ * Configuration of the DRAM timing model replacing the flat memory latency. A value of 0 for banks keeps the RAM with
+ * the flat latency. Otherwise channels and ranks of 0 are taken as 1 and a rowSize of 0 as 2048 bytes. All timings
+ * are in cycles: tRCD from activating a row to reading it, tCAS from reading to the data, tRP for precharging (closing)
+ * a row and tRAS as the minimum time a row stays open once activated.
+ */
+struct DRAMOptions {
+    unsigned int channels;
+    unsigned int ranks;
+    unsigned int banks; // per rank
+    unsigned int rowSize; // bytes of a row of a bank, a power of 2
+    unsigned int tRCD;
+    unsigned int tCAS;
+    unsigned int tRP;
+    unsigned int tRAS;
+    int closedPage; // if non-zero, every row is closed again right after its access instead of being left open
+};
+
+/**
+ * Configuration of the memory controller queueing the requests in front of the RAM of the data cache (or of the L2).
+ * A queueDepth of 0 connects the caches to the memory directly. Reads are served before writes unless
+ * writeHighWatermark writes are queued, which drains the writes until no more than writeLowWatermark are left. If
+ * writeHighWatermark is 0, the watermarks default to 3/4 and 1/4 of the queueDepth.
+ */
+struct MemoryControllerOptions {
+    unsigned int queueDepth;
+    unsigned int writeHighWatermark;
+    unsigned int writeLowWatermark;
+};
+
+/**
+ * The clock domains of the system, their periods in picoseconds. The CPU and the L1 caches run on the core clock, the
+ * L2 on the cache clock and the memory (with its controller) on the memory clock. A corePeriod of 0 selects 1000 ps,
+ * a cachePeriod or memoryPeriod of 0 the corePeriod. All latencies are counted in cycles of the domain of their
+ * component. Requests between domains of different periods pass a bridge, taking crossingStages cycles of the
+ * receiving clock each way (0 selects 2, a two-flop synchronizer).
+ */
+struct ClockOptions {
+    unsigned int corePeriod;
+    unsigned int cachePeriod;
+    unsigned int memoryPeriod;
+    unsigned int crossingStages;
+};
+
+/**
+ * Configuration of the CPU. A loadStoreQueueSize of 0 selects the in-order CPU, waiting for every request to be done
+ * before sending the next one. Otherwise the CPU fetches ahead into a load/store queue of that many entries and issues
+ * and retires up to issueWidth requests per cycle out of order (0 selects 1), still sending one request at a time to
+ * the data cache, see CPU.
+ *
+ * If gaps is not NULL, it holds one entry per request passed to run_simulation_with_options: the cycles the program
+ * computes before it, without accessing memory. The CPU lets that many cycles pass before it issues the request (out of
+ * order: before it fetches it). Each entry has to be below 2^31.
+ *
+ * If instructionAddresses is not NULL, it holds the address of the instruction of each request, which the instruction
+ * cache fetches instead of deriving the address from the position of the request in the trace.
+ */
+struct CoreOptions {
+    unsigned int loadStoreQueueSize;
+    unsigned int issueWidth;
+    const uint32_t* gaps;
+    const uint32_t* instructionAddresses;
+};
+
+/**
+ * Configuration of the instruction cache. A value of 0 for cacheLines selects 16 lines, for cacheLineSize 128 bytes.
+ * If fullyAssociative is non-zero, its lines are replaced by policy (POLICY_OPT and POLICY_PLUGIN are not supported),
+ * otherwise it is direct-mapped and policy is ignored.
+ */
+struct InstructionCacheOptions {
+    unsigned int cacheLines;
+    unsigned int cacheLineSize;
+    int fullyAssociative;
+    enum CacheReplacementPolicy policy;
+};
+
+/**
+ * Where the CPU puts the value every read returns. By default it is written back into the data field of the read's
+ * request, so the trace has to stay writable. Given a callback, it is called with the index of every read in the
+ * trace, the value and the cycle of the core clock the read completed in, in program order, and the requests are left
+ * untouched. Otherwise, given a file, the same is written to it, as CSV or, if binary is non-zero, as packed records,
+ * see ReadResultSink. Only supported with a single core.
+ */
+typedef void (*ReadResultCallback)(void* context, size_t index, uint32_t data, uint64_t cycle);
+
+struct ReadResultOptions {
+    const char* file;
+    int binary;
+    ReadResultCallback callback;
+    void* context; // passed to callback as is
+};
+
+// the trace a further core of a multicore system or a further process of the multi-programmed mode replays
+struct CoreTrace {
+    size_t numRequests;
+    struct Request* requests;
+    const uint32_t* gaps; // the cycles computed before each request, NULL for none, see CoreOptions
+    const uint32_t* instructionAddresses; // of the instruction of each request, NULL for none, see CoreOptions
+};
+
+/**
+ * Configuration of a multicore system. A value of 0 for additionalCores keeps the single core. Otherwise core 0
+ * replays the requests passed to run_simulation_with_options and core i + 1 the i-th of traces, which its requests are
+ * read back into like for core 0. Every core has a private instruction cache with a RAM of its own and a private data
+ * cache configured like the single core one, but write-back. The data caches are kept coherent with MESI by a snooping
+ * bus connecting them to the memory they share, see SnoopingBus. No L2 can be simulated in front of it.
+ */
+struct MulticoreOptions {
+    unsigned int additionalCores;
+    const struct CoreTrace* traces;
+};
+
+/**
+ * Configuration of the multi-programmed mode, in which several processes share the single core and its caches. A
+ * quantum of 0 keeps a single process. Otherwise process 0 replays the requests passed to run_simulation_with_options
+ * and process i + 1 the i-th of traces, which its requests are read back into like for process 0, at most MAX_PROCESSES
+ * (see Result.h) in total. The core switches to the next process round robin every quantum requests, skipping those
+ * already done. The data cache tags its lines with the number of their process (its address space ID), so no process
+ * ever hits on the lines of another one. No L2 can be simulated with it, as the L2 is not tagged.
+ *
+ * If ways is not 0, the data cache has to be fully associative and is partitioned like with Intel CAT: its lines are
+ * split into that many groups of cacheLines / ways standing in for the ways of a set, each replaced by a policy of its
+ * own, and process i only fills lines of the ways whose bit is set in wayMasks[i]. It still hits on its lines in all
+ * ways. If wayMasks is NULL, every process may fill every way.
+ */
+struct MultiprogramOptions {
+    unsigned int quantum;
+    unsigned int additionalProcesses;
+    const struct CoreTrace* traces;
+    unsigned int ways;
+    const unsigned int* wayMasks;
+};
+
+struct SimulationOptions {
+    struct L2Options l2;
+    unsigned int rrpvBits; // width of the re-reference prediction values of the RRIP policies, 0 selects 2 bits
+    // if not NULL and the data cache uses DIP, its insertion decision per phase is written to this CSV file
+    const char* dipSeriesFile;
+    const char* policyPlugin; // path of the shared library implementing POLICY_PLUGIN, see Policy/PolicyPlugin.h
+    unsigned int writeBufferDepth; // entries of the write buffer of the data cache, 0 selects the default of 4
+    int writeCombining; // if non-zero, the write buffer of the data cache drains whole lines as burst writes
+    struct DRAMOptions dram;
+    struct MemoryControllerOptions memoryController;
+    struct ClockOptions clocks;
+    // if not NULL, the raw binary file preloading the memory behind the caches from memoryImageBase on, see MemoryImage
+    const char* memoryImage;
+    unsigned int memoryImageBase;
+    struct CoreOptions core;
+    struct InstructionCacheOptions instructionCache;
+    struct ReadResultOptions readResults;
+    struct MulticoreOptions multicore;
+    struct MultiprogramOptions multiprogram;
+};
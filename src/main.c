@@ -12,12 +12,13 @@ int main(int argc, char** argv) {
     // Parse command line arguments
     struct Configuration config = parse_arguments(argc, argv);
 
-    // Call run_simulation by default or run_simulation_extended depending on additional flags
+    // Call run_simulation by default or run_simulation_with_options depending on additional flags
     struct Result result;
     if (config.callExtended) {
-        result = run_simulation_extended(config.cycles, config.directMapped, config.cacheLines, config.cacheLineSize,
-                                         config.cacheLatency, config.memoryLatency, config.numRequests, config.requests,
-                                         config.tracefile, config.policy);
+        result = run_simulation_with_options(config.cycles, config.directMapped, config.cacheLines,
+                                             config.cacheLineSize, config.cacheLatency, config.memoryLatency,
+                                             config.numRequests, config.requests, config.tracefile, config.policy,
+                                             &config.options);
     } else {
         result = run_simulation((int)config.cycles, config.directMapped, config.cacheLines, config.cacheLineSize,
                                 config.cacheLatency, config.memoryLatency, config.numRequests, config.requests,
@@ -25,6 +26,21 @@ int main(int argc, char** argv) {
     }
     free(config.requests);
     config.requests = NULL;
+    free((void*)config.options.core.gaps);
+    free((void*)config.options.core.instructionAddresses);
+    for (unsigned int i = 0; i < config.options.multicore.additionalCores; ++i) {
+        free(config.options.multicore.traces[i].requests);
+        free((void*)config.options.multicore.traces[i].gaps);
+        free((void*)config.options.multicore.traces[i].instructionAddresses);
+    }
+    free((void*)config.options.multicore.traces);
+    for (unsigned int i = 0; i < config.options.multiprogram.additionalProcesses; ++i) {
+        free(config.options.multiprogram.traces[i].requests);
+        free((void*)config.options.multiprogram.traces[i].gaps);
+        free((void*)config.options.multiprogram.traces[i].instructionAddresses);
+    }
+    free((void*)config.options.multiprogram.traces);
+    free((void*)config.options.multiprogram.wayMasks);
 
     // Check for invalid results
     if (result.cycles == 0 && result.misses == 0 && result.hits == 0 && result.primitiveGateCount == 0) {
@@ -46,5 +62,150 @@ int main(int argc, char** argv) {
             "\x1b[0m",
             result.cycles, result.misses, result.hits, result.primitiveGateCount);
 
+    const struct ClockOptions* clocks = &config.options.clocks;
+    if (clocks->corePeriod != 0 || clocks->cachePeriod != 0 || clocks->memoryPeriod != 0) {
+        const unsigned int corePeriod = clocks->corePeriod == 0 ? 1000 : clocks->corePeriod;
+        fprintf(stdout,
+                "\x1b[1m\t\tClock domains\x1b[0m\n"
+                "\tCore / cache / memory:\t%.1f / %.1f / %.1f MHz\n"
+                "\tElapsed time:\t%.3f us\n"
+                "\x1b[1m--------------------------------------------------\x1b[0m\n",
+                1e6 / corePeriod, 1e6 / (clocks->cachePeriod == 0 ? corePeriod : clocks->cachePeriod),
+                1e6 / (clocks->memoryPeriod == 0 ? corePeriod : clocks->memoryPeriod),
+                (double)result.cycles * corePeriod / 1e6);
+    }
+
+    const struct InstructionCacheStatistics* instructionCache = &result.instructionCache;
+    const size_t instructionFetches = instructionCache->hits + instructionCache->misses;
+    if (config.callExtended && instructionFetches > 0) {
+        fprintf(stdout,
+                "\x1b[1m\t\tInstruction cache\x1b[0m\n"
+                "\tMisses:\t\x1b[31m%zu\x1b[0m\n"
+                "\tHits:\t\x1b[32m%zu\x1b[0m\n"
+                "\tHit rate:\t%.2f%%\n"
+                "\x1b[1m--------------------------------------------------\x1b[0m\n",
+                instructionCache->misses, instructionCache->hits,
+                100.0 * (double)instructionCache->hits / (double)instructionFetches);
+    }
+
+    if (config.options.core.loadStoreQueueSize > 0) {
+        fprintf(stdout,
+                "\x1b[1m\t\tLoad/store queue\x1b[0m\n"
+                "\tForwarded loads:\t%zu\n"
+                "\x1b[1m--------------------------------------------------\x1b[0m\n",
+                result.loadStoreQueue.forwardedLoads);
+    }
+
+    if (config.options.l2.cacheLines > 0) {
+        fprintf(stdout,
+                "\x1b[1m\t\tUnified L2\x1b[0m\n"
+                "\tInstruction accesses:\t%zu\n"
+                "\tInstruction misses:\t\x1b[31m%zu\x1b[0m\n"
+                "\tInstruction contention stalls:\t%zu\n"
+                "\tData accesses:\t%zu\n"
+                "\tData misses:\t\x1b[31m%zu\x1b[0m\n"
+                "\tData contention stalls:\t%zu\n"
+                "\x1b[1m--------------------------------------------------\x1b[0m\n",
+                result.l2.instructionAccesses, result.l2.instructionMisses, result.l2.instructionContentionStalls,
+                result.l2.dataAccesses, result.l2.dataMisses, result.l2.dataContentionStalls);
+    }
+
+    if (config.callExtended && result.writeBuffer.cycles > 0) {
+        fprintf(stdout,
+                "\x1b[1m\t\tWrite buffer\x1b[0m\n"
+                "\tBuffered writes:\t%zu\n"
+                "\tCoalesced writes:\t%zu\n"
+                "\tMean occupancy:\t%.2f of %zu\n"
+                "\tMax occupancy:\t%zu\n"
+                "\tFull stalls:\t%zu\n"
+                "\tForwarded reads:\t%zu\n"
+                "\tMerged reads:\t%zu\n"
+                "\tStall cycles avoided (est.):\t%zu\n",
+                result.writeBuffer.bufferedWrites, result.writeBuffer.coalescedWrites,
+                (double)result.writeBuffer.occupancySum / (double)result.writeBuffer.cycles, result.writeBuffer.depth,
+                result.writeBuffer.maxOccupancy, result.writeBuffer.fullStallCycles, result.writeBuffer.forwardedReads,
+                result.writeBuffer.mergedReads, result.writeBuffer.stallCyclesAvoided);
+        if (config.options.writeCombining) {
+            fprintf(stdout,
+                    "\tBursts:\t%zu\n"
+                    "\tPartial flushes:\t%zu\n"
+                    "\tRAM requests saved:\t%zu\n",
+                    result.writeBuffer.bursts, result.writeBuffer.partialFlushes, result.writeBuffer.savedRequests);
+        }
+        fprintf(stdout, "\x1b[1m--------------------------------------------------\x1b[0m\n");
+    }
+
+    if (config.options.dram.banks > 0 && result.dram.accesses > 0) {
+        fprintf(stdout,
+                "\x1b[1m\t\tDRAM (%s)\x1b[0m\n"
+                "\tAccesses:\t%zu\n"
+                "\tRow hits:\t\x1b[32m%zu\x1b[0m\n"
+                "\tRow misses:\t%zu\n"
+                "\tRow conflicts:\t\x1b[31m%zu\x1b[0m\n"
+                "\tMean latency:\t%.2f cycles\n"
+                "\x1b[1m--------------------------------------------------\x1b[0m\n",
+                config.options.dram.closedPage ? "closed page" : "open page", result.dram.accesses,
+                result.dram.rowHits, result.dram.rowMisses, result.dram.rowConflicts,
+                (double)result.dram.latencyCycles / (double)result.dram.accesses);
+    }
+
+    if (config.options.memoryController.queueDepth > 0 && result.memoryController.cycles > 0) {
+        const struct MemoryControllerStatistics* mc = &result.memoryController;
+        const size_t requests = mc->reads + mc->writes;
+        fprintf(stdout,
+                "\x1b[1m\t\tMemory controller (%zu entries)\x1b[0m\n"
+                "\tReads:\t\t%zu\n"
+                "\tWrites:\t\t%zu\n"
+                "\tMean queueing:\t%.2f cycles\n"
+                "\tMax occupancy:\t%zu\n"
+                "\tFull stalls:\t%zu\n"
+                "\tReordered:\t%zu\n"
+                "\tWrite drains:\t%zu\n"
+                "\tBursts:\t\t%zu\n"
+                "\tUtilisation:\t%.2f%% (%.2f bytes/cycle)\n"
+                "\x1b[1m--------------------------------------------------\x1b[0m\n",
+                mc->queueDepth, mc->reads, mc->writes,
+                requests > 0 ? (double)mc->queueingDelay / (double)requests : 0.0, mc->maxOccupancy,
+                mc->fullStallCycles, mc->reorderedRequests, mc->writeDrains, mc->bursts,
+                100.0 * (double)mc->busyCycles / (double)mc->cycles,
+                (double)mc->bytesTransferred / (double)mc->cycles);
+    }
+
+    if (result.coherence.cores > 0 && result.coherence.cycles > 0) {
+        const struct CoherenceStatistics* coherence = &result.coherence;
+        fprintf(stdout,
+                "\x1b[1m\t\tCoherence (%zu cores, MESI)\x1b[0m\n"
+                "\tBus transactions:\t%zu\n"
+                "\tInvalidations:\t%zu\n"
+                "\tCoherence misses:\t\x1b[31m%zu\x1b[0m\n"
+                "\tWrite-backs:\t%zu\n"
+                "\tCache-to-cache:\t%zu\n"
+                "\tBus utilisation:\t%.2f%%\n"
+                "\x1b[1m--------------------------------------------------\x1b[0m\n",
+                coherence->cores, coherence->busTransactions, coherence->invalidations, coherence->coherenceMisses,
+                coherence->writeBacks, coherence->cacheToCacheTransfers,
+                100.0 * (double)coherence->busBusyCycles / (double)coherence->cycles);
+    }
+
+    if (result.multiprogram.processes > 0) {
+        const struct MultiprogramStatistics* multiprogram = &result.multiprogram;
+        fprintf(stdout,
+                "\x1b[1m\t\tProcesses (%zu, quantum %u)\x1b[0m\n"
+                "\tContext switches:\t%zu\n"
+                "\tCross-process evictions:\t\x1b[31m%zu\x1b[0m\n",
+                multiprogram->processes, config.options.multiprogram.quantum, multiprogram->contextSwitches,
+                multiprogram->crossProcessEvictions);
+        for (size_t i = 0; i < multiprogram->processes; ++i) {
+            const struct ProcessStatistics* process = &multiprogram->process[i];
+            const size_t accesses = process->hits + process->misses;
+            fprintf(stdout,
+                    "\tProcess %zu:\t%zu requests, hit rate %.2f%%, %zu lines lost to others, %zu taken from "
+                    "others\n",
+                    i, process->requests, accesses > 0 ? 100.0 * (double)process->hits / (double)accesses : 0.0,
+                    process->evictedByOthers, process->evictionsOfOthers);
+        }
+        fprintf(stdout, "\x1b[1m--------------------------------------------------\x1b[0m\n");
+    }
+
     return EXIT_SUCCESS;
 }
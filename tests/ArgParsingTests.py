@@ -81,6 +81,248 @@ class TestInvalidInput(unittest.TestCase):
         output = capture_stderr(args).decode()
         self.assertEqual(expected_output, output)
 
+    def test_multiple_pseudo_lru_policy_input(self):
+        args = ' --bitplru --fifo ' + FILE_PATH
+        expected_output = "Error: --fifo and --bitplru are both set. Please choose only one option!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_multiple_rrip_policy_input(self):
+        args = ' --drrip --srrip ' + FILE_PATH
+        expected_output = "Error: --srrip and --drrip are both set. Please choose only one option!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_multiple_history_policy_input(self):
+        args = ' --lirs --arc ' + FILE_PATH
+        expected_output = "Error: --arc and --lirs are both set. Please choose only one option!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_opt_with_l2(self):
+        args = ' --opt --l2-cachelines 64 ' + FILE_PATH
+        expected_output = "Error: --opt cannot be combined with an L2 cache!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_dip_series_without_dip(self):
+        args = ' --drrip --dip-series series.csv ' + FILE_PATH
+        expected_output = "Error: --dip-series requires a fully associative cache using --dip!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_dip_and_policy_plugin(self):
+        args = ' --policy-plugin lruPolicyPlugin.so --dip ' + FILE_PATH
+        expected_output = "Error: --dip and --policy-plugin are both set. Please choose only one option!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_rrpv_bits_too_wide(self):
+        args = ' --srrip --rrpv-bits 9 ' + FILE_PATH
+        expected_output = "Invalid input: RRPV width cannot exceed 8 bits!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_write_buffer_depth_too_large(self):
+        args = ' --write-buffer-depth 257 ' + FILE_PATH
+        expected_output = "Invalid input: Write buffer depth cannot exceed 256 entries!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_write_combining_with_l2(self):
+        args = ' --write-combining --l2-cachelines 64 ' + FILE_PATH
+        expected_output = "Error: --write-combining cannot be combined with an L2 cache!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_dram_option_without_banks(self):
+        args = ' --closed-page ' + FILE_PATH
+        expected_output = "Error: The DRAM options require a DRAM model set up with --dram-banks!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_dram_timing_incomplete(self):
+        args = ' --dram-banks 8 --dram-timing 14,14,14 ' + FILE_PATH
+        expected_output = ("Invalid input: '14,14,14' are no DRAM timings tRCD,tCAS,tRP,tRAS in range [0,2^16-1]!\n"
+                           + print_usage)
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_dram_row_size_not_power_of_two(self):
+        args = ' --dram-banks 8 --dram-row-size 48 ' + FILE_PATH
+        expected_output = "Invalid input: DRAM row size should be a power of 2 of at least 16 bytes!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_mc_watermarks_without_queue(self):
+        args = ' --mc-watermarks 3,1 ' + FILE_PATH
+        expected_output = ("Error: --mc-watermarks requires a memory controller set up with --mc-queue-depth!\n"
+                           + print_usage)
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_mc_watermarks_low_not_below_high(self):
+        args = ' --mc-queue-depth 8 --mc-watermarks 2,2 ' + FILE_PATH
+        expected_output = ("Invalid input: '2,2' are no memory controller watermarks high,low with low < high!\n"
+                           + print_usage)
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_mc_high_watermark_above_queue_depth(self):
+        args = ' --mc-queue-depth 4 --mc-watermarks 6,2 ' + FILE_PATH
+        expected_output = ("Error: The high watermark of the memory controller cannot exceed its queue depth!\n"
+                           + print_usage)
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_memory_clock_too_fast(self):
+        args = ' --memory-clock 20000 ' + FILE_PATH
+        expected_output = "Invalid input: --memory-clock must be in range [1,10000] MHz!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_cache_clock_without_l2(self):
+        args = ' --cache-clock 500 ' + FILE_PATH
+        expected_output = "Error: --cache-clock requires an L2 cache set up with --l2-cachelines!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_cdc_stages_too_many(self):
+        args = ' --cdc-stages 17 ' + FILE_PATH
+        expected_output = "Invalid input: Number of synchronizer stages cannot exceed 16!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_missing_memory_image(self):
+        args = ' --mem-image /nonexistent/memory.img ' + FILE_PATH
+        expected_output = ("Error opening memory image '/nonexistent/memory.img': No such file or directory\n"
+                           + print_usage)
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_memory_image_base_without_image(self):
+        args = ' --mem-image-base 0x1000 ' + FILE_PATH
+        expected_output = "Error: --mem-image-base requires a memory image set up with --mem-image!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_memory_image_base_too_large(self):
+        args = ' --mem-image-base 0x100000000 ' + FILE_PATH
+        expected_output = ("Invalid input: '0x100000000' for --mem-image-base is no address in range [0,2^32-1]!\n"
+                           + print_usage)
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_load_store_queue_too_large(self):
+        args = ' --lsq-size 257 ' + FILE_PATH
+        expected_output = "Invalid input: Size of the load/store queue cannot exceed 256!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_issue_width_without_load_store_queue(self):
+        args = ' --issue-width 2 ' + FILE_PATH
+        expected_output = "Error: --issue-width requires an out-of-order CPU set up with --lsq-size!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_several_cores_with_l2(self):
+        args = ' --l2-cachelines 64 ' + FILE_PATH + FILE_PATH
+        expected_output = "Error: Several cores cannot be combined with an L2 cache!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_several_cores_with_opt(self):
+        args = ' --opt ' + FILE_PATH + FILE_PATH
+        expected_output = "Error: Several cores cannot be combined with --opt!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_several_cores_with_dip_series(self):
+        args = ' --dip --dip-series series.csv ' + FILE_PATH + FILE_PATH
+        expected_output = "Error: Several cores cannot be combined with --dip-series!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_quantum_with_single_file(self):
+        args = ' --quantum 100 ' + FILE_PATH
+        expected_output = "Error: --quantum requires several files, one per process!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_ways_without_quantum(self):
+        args = ' --ways 4 ' + FILE_PATH + FILE_PATH
+        expected_output = "Error: --ways and --way-masks require several processes set up with --quantum!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_ways_with_direct_mapped_cache(self):
+        args = ' --quantum 100 --ways 4 --directmapped ' + FILE_PATH + FILE_PATH
+        expected_output = "Error: --ways requires a fully associative cache!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_way_masks_not_one_per_process(self):
+        args = ' --quantum 100 --ways 4 --way-masks 0x3 ' + FILE_PATH + FILE_PATH
+        expected_output = "Error: --way-masks requires one mask per process!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_way_mask_beyond_ways(self):
+        args = ' --quantum 100 --ways 2 --way-masks 0x1,0x4 ' + FILE_PATH + FILE_PATH
+        expected_output = "Error: The way mask 0x4 selects ways beyond the 2 set by --ways!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_binary_read_results_without_file(self):
+        args = ' --read-results-binary ' + FILE_PATH
+        expected_output = "Error: --read-results-binary requires a file set up with --read-results!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_read_results_with_several_files(self):
+        args = ' --read-results results.csv ' + FILE_PATH + FILE_PATH
+        expected_output = "Error: --read-results cannot be combined with several files!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_icache_line_size_not_multiple_of_sixteen(self):
+        args = ' --icache-line-size 24 ' + FILE_PATH
+        expected_output = "Invalid input: Instruction cacheline size should be a multiple of 16 bytes!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_icache_line_size_not_power_of_two(self):
+        args = ' --icache-line-size 48 ' + FILE_PATH
+        expected_output = "Invalid input: Instruction cacheline size should be a power of 2!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_icache_too_big(self):
+        args = ' --icache-lines 16384 --icache-line-size 128 ' + FILE_PATH
+        expected_output = ("Error: Instruction cache of 16384 128 byte long cache lines is too big. Max total size is "
+                           "2^20\n" + print_usage)
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_icache_policy_unknown(self):
+        args = ' --icache-fullassociative --icache-policy opt ' + FILE_PATH
+        expected_output = "Error: 'opt' is no replacement policy of the instruction cache!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_icache_policy_without_fullassociative(self):
+        args = ' --icache-policy fifo ' + FILE_PATH
+        expected_output = ("Error: --icache-policy requires a fully associative instruction cache set up with "
+                           "--icache-fullassociative!\n" + print_usage)
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_l2_cacheline_size_not_multiple_of_sixteen(self):
+        args = ' --l2-cachelines 64 --l2-cacheline-size 24 ' + FILE_PATH
+        expected_output = "Invalid input: L2 cacheline size should be a multiple of 16 bytes!\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
     def test_multiple_policy_input(self):
         args = ' --fifo --random ' + FILE_PATH
         expected_output = "Error: --fifo and --random are both set. Please choose only one option!\n" + print_usage
@@ -117,6 +359,12 @@ class TestInvalidInput(unittest.TestCase):
         output = capture_stderr(args).decode()
         self.assertEqual(expected_output, output)
 
+    def test_missing_argument_l2_cachelines(self):
+        args = FILE_PATH + ' --l2-cachelines '
+        expected_output = "Error: Option --l2-cachelines requires an argument.\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
     def test_missing_argument_memory_latency(self):
         args = FILE_PATH + ' --memory-latency '
         expected_output = "Error: Option --memory-latency requires an argument.\n" + print_usage
@@ -202,6 +450,10 @@ class TestOther(unittest.TestCase):
         expected_output = (print_usage + "\n"
                            + ("Positional arguments:\n"
                               "   <filename>   The name of the file to be processed (including .csv extension)\n"
+                              "   <filename> ...   The names of the files further cores process, up to 15. Each "
+                              "core has its own caches, the data caches being write-back and kept coherent by a MESI "
+                              "snooping bus in front of the shared memory. Given --quantum, processes sharing the single core "
+                              "instead\n"
                               "\n"
                               "Optional arguments:\n"
                               "   -c c / --cycles c       The number of cycles used for the simulation "
@@ -216,6 +468,113 @@ class TestOther(unittest.TestCase):
                               "   --lru                   Use LRU as cache-replacement policy (Set as default)\n"
                               "   --fifo                  Use FIFO as cache-replacement policy\n"
                               "   --random                Use random cache-replacement policy\n"
+                              "   --plru                  Use tree pseudo-LRU as cache-replacement policy\n"
+                              "   --bitplru               Use bit pseudo-LRU (one MRU bit per cache line) as "
+                              "cache-replacement policy\n"
+                              "   --srrip                 Use static re-reference interval prediction as "
+                              "cache-replacement policy\n"
+                              "   --brrip                 Use bimodal re-reference interval prediction as "
+                              "cache-replacement policy\n"
+                              "   --drrip                 Use dynamic re-reference interval prediction, choosing "
+                              "between SRRIP and BRRIP by set dueling, as cache-replacement policy\n"
+                              "   --rrpv-bits b           The width of the re-reference prediction values of the "
+                              "RRIP policies in bits, in range [1,8] (default: 2)\n"
+                              "   --lfu                   Use least frequently used with periodically halved use "
+                              "counters as cache-replacement policy\n"
+                              "   --arc                   Use adaptive replacement cache as cache-replacement "
+                              "policy\n"
+                              "   --2q                    Use 2Q (FIFO for new, LRU for reused cache lines) as "
+                              "cache-replacement policy\n"
+                              "   --lirs                  Use low inter-reference recency set as "
+                              "cache-replacement policy\n"
+                              "   --opt                   Use Belady's optimal policy, evicting the cache line used "
+                              "again farthest in the future, as cache-replacement policy. Only meant as a bound for "
+                              "the other policies\n"
+                              "   --dip                   Use dynamic insertion, choosing between LRU and bimodal "
+                              "insertion by set dueling, as cache-replacement policy\n"
+                              "   --dip-series f          The name of a CSV file the insertion DIP chooses in each "
+                              "phase of 10000 accesses is written to. If not set, no such file will be created\n"
+                              "   --policy-plugin p       The path of a shared library implementing the "
+                              "cache-replacement policy through the interface in "
+                              "src/Simulation/Policy/PolicyPlugin.h\n"
+                              "   --write-buffer-depth d  The number of entries of the write buffer of the data "
+                              "cache, each coalescing the writes to one cache line, in range [1,256] (default: 4)\n"
+                              "   --write-combining       Let the write buffer of the data cache wait for a line to "
+                              "be written completely and send it to the RAM as a single burst write, paying the "
+                              "memory latency only once\n"
+                              "   --dram-banks n          The number of banks per rank of a DRAM model replacing "
+                              "the flat memory latency, in range [1,256] (default: 0 = no DRAM model)\n"
+                              "   --dram-channels n       The number of DRAM channels, in range [1,64] (default: 1)\n"
+                              "   --dram-ranks n          The number of DRAM ranks per channel, in range [1,64] "
+                              "(default: 1)\n"
+                              "   --dram-row-size s       The size of a DRAM row in bytes, a power of 2 of at least "
+                              "16 (default: 2048)\n"
+                              "   --dram-timing t         The DRAM timings tRCD,tCAS,tRP,tRAS in cycles "
+                              "(default: 14,14,14,33)\n"
+                              "   --closed-page           Close every DRAM row right after its access instead of "
+                              "leaving it open for further accesses\n"
+                              "   --mc-queue-depth n      The number of requests a memory controller in front of "
+                              "the memory queues and reorders, in range [1,256] (default: 0 = no memory controller)\n"
+                              "   --mc-watermarks w       The number of queued writes high,low at which the memory "
+                              "controller starts and stops draining writes before reads, 0 <= low < high <= queue "
+                              "depth (default: 3/4 and 1/4 of the queue depth)\n"
+                              "   --l2-cachelines n       The number of cache lines of a unified L2 cache shared by "
+                              "instruction and data cache (default: 0 = no L2)\n"
+                              "   --l2-cacheline-size s   The size of an L2 cache line in bytes (default: 64)\n"
+                              "   --l2-latency l          The L2 cache latency in cycles (default: 10)\n"
+                              "   --core-clock f          The frequency of the CPU and the L1 caches in MHz, in range "
+                              "[1,10000] (default: 1000)\n"
+                              "   --cache-clock f         The frequency of the L2 cache in MHz, in range [1,10000] "
+                              "(default: the core clock)\n"
+                              "   --memory-clock f        The frequency of the memory and its controller in MHz, in "
+                              "range [1,10000] (default: the core clock)\n"
+                              "   --cdc-stages n          The number of synchronizer stages, i.e. cycles of the "
+                              "receiving clock, a request or its result takes to cross between clock domains, in range "
+                              "[1,16] (default: 2)\n"
+                              "   --cache-latency-ns t    The cache latency in nanoseconds, rounded up to cycles of "
+                              "the core clock. Replaces --cache-latency\n"
+                              "   --memory-latency-ns t   The memory latency in nanoseconds, rounded up to cycles of "
+                              "the memory clock. Replaces --memory-latency\n"
+                              "   --l2-latency-ns t       The L2 cache latency in nanoseconds, rounded up to cycles "
+                              "of the cache clock. Replaces --l2-latency\n"
+                              "   --mem-image f           A raw binary file (may be sparse) preloading the memory "
+                              "behind the caches, mapped instead of read so only the accessed parts are loaded. If not "
+                              "set, all memory reads as 0 until written\n"
+                              "   --mem-image-base a      The address the first byte of the memory image is loaded "
+                              "to, decimal or hexadecimal with 0x (default: 0)\n"
+                              "   --lsq-size n            The number of entries of the load/store queue of an "
+                              "out-of-order CPU, which fetches ahead, lets loads overtake older stores to independent "
+                              "addresses and serves loads from older stores to the same address, while the data "
+                              "cache still serves one request at a time, in range [1,256] (default: 0 = in-order "
+                              "CPU)\n"
+                              "   --issue-width w         The number of requests the out-of-order CPU issues and "
+                              "retires per cycle, in range [1,16] (default: 1)\n"
+                              "   --quantum q             Instead of simulating a core per file, runs the files as "
+                              "processes sharing the single core and its caches, switched round robin every q "
+                              "requests, in range [1,2^20]. The data cache tags every line with the address space ID "
+                              "of its process\n"
+                              "   --ways n                The number of equally sized groups of lines the fully "
+                              "associative data cache is partitioned into, standing in for the ways CAT masks select, "
+                              "in range [1,32]. Each is replaced by its own policy. Has to divide the number of "
+                              "cachelines\n"
+                              "   --way-masks m           One mask per process, decimal or hexadecimal with 0x, "
+                              "separated by commas. Bit i of the mask of a process lets it fill way i (default: all "
+                              "ways)\n"
+                              "   --read-results f        The name of a file the index, value and completion cycle of "
+                              "every read are written to as CSV, instead of writing the value back into the data of "
+                              "its request. Single core only. If not set, no such file will be created\n"
+                              "   --read-results-binary   Write the read results as packed little-endian records of 20 "
+                              "bytes: the index as 8, the value as 4 and the completion cycle as 8 bytes\n"
+                              "   --icache-lines n        The number of cache lines of the instruction cache (default: "
+                              "16)\n"
+                              "   --icache-line-size s    The size of an instruction cache line in bytes (default: "
+                              "128)\n"
+                              "   --icache-fullassociative Simulate a fully associative instruction cache instead of a "
+                              "direct-mapped one\n"
+                              "   --icache-policy p       The replacement policy of the fully associative instruction "
+                              "cache, one of lru, fifo, random, plru, bitplru, srrip, brrip, drrip, lfu, arc, 2q, lirs "
+                              "and dip (default: lru). The instruction cache fetches the instruction addresses of the "
+                              "optional fifth column of the file, or the index of the request if there are none\n"
                               "   --tf=<filename>         The name for a trace file (without file extension) "
                               "containing all "
                               "signals. If not set, no trace file will be created\n"
@@ -231,8 +590,21 @@ if __name__ == '__main__':
 
 print_usage = ("usage: " + CACHE_PATH + " [-c c/--cycles c] [--lcycles] [--directmapped] [--fullassociative] "
                                         "[--cacheline-size s] [--cachelines n] [--cache-latency l] [--memorylatency m] "
-                                        "[--lru] [--fifo] [--random] [--tf=<filename>] [--extended] [-h/--help] "
-                                        "<filename>\n"
+                                        "[--lru] [--fifo] [--random] [--plru] [--bitplru] [--srrip] [--brrip] [--drrip] "
+                                        "[--rrpv-bits b] [--lfu] [--arc] [--2q] [--lirs] [--opt] [--dip] "
+                                        "[--dip-series f] [--policy-plugin p] [--write-buffer-depth d] [--write-combining] "
+                                        "[--dram-banks n] [--dram-channels n] [--dram-ranks n] [--dram-row-size s] "
+                                        "[--dram-timing t] [--closed-page] [--mc-queue-depth n] [--mc-watermarks w] "
+                                        "[--l2-cachelines n] "
+                                        "[--l2-cacheline-size s] [--l2-latency l] [--core-clock f] [--cache-clock f] "
+                                        "[--memory-clock f] [--cdc-stages n] [--cache-latency-ns t] "
+                                        "[--memory-latency-ns t] [--l2-latency-ns t] [--mem-image f] "
+                                        "[--mem-image-base a] [--lsq-size n] [--issue-width w] [--quantum q] [--ways n] "
+                                        "[--way-masks m] [--read-results f] [--read-results-binary] "
+                                        "[--icache-lines n] [--icache-line-size s] [--icache-fullassociative] "
+                                        "[--icache-policy p] [--tf=<filename>] "
+                                        "[--extended] "
+                                        "[-h/--help] <filename> [<filename> ...]\n"
                                         "   -c c / --cycles c       Set the number of cycles to be simulated to c. "
                                         "Allows inputs in range [0,2^16-1]\n"
                                         "   --lcycles               Allow input of cycles of up to 2^32-1\n"
@@ -245,6 +617,76 @@ print_usage = ("usage: " + CACHE_PATH + " [-c c/--cycles c] [--lcycles] [--direc
                                         "   --lru                   Use LRU as cache-replacement policy\n"
                                         "   --fifo                  Use FIFO as cache-replacement policy\n"
                                         "   --random                Use random cache-replacement policy\n"
+                                        "   --plru                  Use tree pseudo-LRU as cache-replacement policy\n"
+                                        "   --bitplru               Use bit pseudo-LRU as cache-replacement policy\n"
+                                        "   --srrip                 Use static RRIP as cache-replacement policy\n"
+                                        "   --brrip                 Use bimodal RRIP as cache-replacement policy\n"
+                                        "   --drrip                 Use dynamic RRIP (set dueling between SRRIP and "
+                                        "BRRIP) as cache-replacement policy\n"
+                                        "   --rrpv-bits b           Set the width of the re-reference prediction "
+                                        "values of the RRIP policies to b bits\n"
+                                        "   --lfu                   Use LFU with aging as cache-replacement policy\n"
+                                        "   --arc                   Use ARC as cache-replacement policy\n"
+                                        "   --2q                    Use 2Q as cache-replacement policy\n"
+                                        "   --lirs                  Use LIRS as cache-replacement policy\n"
+                                        "   --opt                   Use Belady's optimal policy as cache-replacement "
+                                        "policy (not combinable with an L2)\n"
+                                        "   --dip                   Use DIP (set dueling between LRU and bimodal "
+                                        "insertion) as cache-replacement policy\n"
+                                        "   --dip-series f          Write the insertion DIP chooses per phase to the "
+                                        "CSV file f\n"
+                                        "   --policy-plugin p       Use the cache-replacement policy implemented by "
+                                        "the shared library p\n"
+                                        "   --write-buffer-depth d  Set the number of write buffer entries of the data "
+                                        "cache to d\n"
+                                        "   --write-combining       Drain whole lines from the write buffer as burst "
+                                        "writes (not combinable with an L2)\n"
+                                        "   --dram-banks n          Replace the flat memory latency by a DRAM model "
+                                        "with n banks per rank\n"
+                                        "   --dram-channels n       Set the number of DRAM channels to n\n"
+                                        "   --dram-ranks n          Set the number of DRAM ranks per channel to n\n"
+                                        "   --dram-row-size s       Set the size of a DRAM row to s bytes\n"
+                                        "   --dram-timing t         Set the DRAM timings to t = tRCD,tCAS,tRP,tRAS "
+                                        "cycles\n"
+                                        "   --closed-page           Close every DRAM row right after its access\n"
+                                        "   --mc-queue-depth n      Put a memory controller queueing n requests in "
+                                        "front of the memory\n"
+                                        "   --mc-watermarks w       Set the write drain watermarks of the memory "
+                                        "controller to w = high,low\n"
+                                        "   --l2-cachelines n       Add a unified L2 cache with n cachelines shared by "
+                                        "instruction and data cache\n"
+                                        "   --l2-cacheline-size s   Set the L2 cache line size to s bytes\n"
+                                        "   --l2-latency l          Set the L2 cache latency to l cycles\n"
+                                        "   --core-clock f          Run the CPU and the L1 caches at f MHz\n"
+                                        "   --cache-clock f         Run the L2 cache at f MHz\n"
+                                        "   --memory-clock f        Run the memory and its controller at f MHz\n"
+                                        "   --cdc-stages n          Let requests between clock domains pass n "
+                                        "synchronizer stages\n"
+                                        "   --cache-latency-ns t    Set the cache latency to t nanoseconds\n"
+                                        "   --memory-latency-ns t   Set the memory latency to t nanoseconds\n"
+                                        "   --l2-latency-ns t       Set the L2 cache latency to t nanoseconds\n"
+                                        "   --mem-image f           Preload the memory from the raw binary file f\n"
+                                        "   --mem-image-base a      Load the memory image to the addresses from a "
+                                        "on\n"
+                                        "   --lsq-size n            Run the CPU out of order with a load/store queue "
+                                        "of n entries\n"
+                                        "   --issue-width w         Issue and retire up to w requests per cycle out "
+                                        "of order\n"
+                                        "   --quantum q             Run the files as processes sharing the core, "
+                                        "switching every q requests\n"
+                                        "   --ways n                Partition the fully associative data cache into n "
+                                        "ways\n"
+                                        "   --way-masks m           Let the processes fill only the ways set in their "
+                                        "masks m = mask,mask,...\n"
+                                        "   --read-results f        Write the value and completion cycle of every "
+                                        "read to the file f\n"
+                                        "   --read-results-binary   Write the read results as packed binary records "
+                                        "instead of CSV\n"
+                                        "   --icache-lines n        Set the number of instruction cache lines to n\n"
+                                        "   --icache-line-size s    Set the instruction cache line size to s bytes\n"
+                                        "   --icache-fullassociative Simulate a fully associative instruction cache\n"
+                                        "   --icache-policy p       Replace the lines of the instruction cache by the "
+                                        "policy p\n"
                                         "   --extended              Call extended run_simulation-method\n"
                                         "   --tf=<filename>         File name for a trace (without file extension) "
                                         "containing all signals. If not set, no "
@@ -12,11 +12,13 @@ SC_MODULE(InstrMemoryMock) {
     sc_in<bool> clock;
     sc_in<bool> validInstrRequest;
     sc_in<std::uint32_t> pcBus;
+    sc_in<std::uint16_t> addressSpaceBus;
 
     sc_out<Request> instrBus;
     sc_out<bool> instrReadyBus;
 
     std::unordered_map<std::uint32_t, Request> instructionMemory;
+    std::vector<std::uint16_t> addressSpacesFetched;
 
     SC_CTOR(InstrMemoryMock) {
         SC_THREAD(provideInstr);
@@ -42,6 +44,7 @@ SC_MODULE(InstrMemoryMock) {
             auto requestToWrite = instructionMemory.at(pc);
             instrBus.write(requestToWrite);
             instrReadyBus.write(true);
+            addressSpacesFetched.push_back(addressSpaceBus.read());
         }
     }
 };
@@ -52,12 +55,14 @@ SC_MODULE(DataMemoryMock) {
     sc_in<bool> weBus;
     sc_in<std::uint32_t> addressBus;
     sc_in<std::uint32_t> dataInBus;
+    sc_in<std::uint16_t> addressSpaceBus;
 
     sc_out<std::uint32_t> dataOutBus;
     sc_out<bool> dataReadyBus;
 
     std::unordered_map<std::uint32_t, std::uint32_t> dataMemory;
     std::vector<Request> dataProvided;
+    std::vector<std::uint16_t> addressSpacesProvided;
 
     SC_CTOR(DataMemoryMock) {
         SC_THREAD(provideData);
@@ -82,6 +87,7 @@ SC_MODULE(DataMemoryMock) {
             dataReadyBus.write(true);
 
             dataProvided.push_back(Request{addressBus.read(), dataInBus.read(), weBus.read()});
+            addressSpacesProvided.push_back(addressSpaceBus.read());
         }
     }
 };
@@ -94,6 +100,7 @@ class CPUTests : public testing::Test {
     sc_signal<std::uint32_t> addressSignal;
     sc_signal<std::uint32_t> dataOutSignal;
     sc_signal<bool, SC_MANY_WRITERS> validDataRequestSignal;
+    sc_signal<std::uint16_t> addressSpaceSignal;
 
     // Cache -> CPU
     sc_signal<std::uint32_t> dataInSignal;
@@ -106,6 +113,7 @@ class CPUTests : public testing::Test {
     // CPU -> Instr Cache
     sc_signal<std::uint32_t> pcSignal;
     sc_signal<bool, SC_MANY_WRITERS> validInstrRequestSignal;
+    sc_signal<std::uint16_t> instrAddressSpaceSignal;
 
     sc_clock clock{"clk", sc_time(1, SC_NS)};
 
@@ -115,6 +123,7 @@ class CPUTests : public testing::Test {
         instrMock.instrBus.bind(instrSignal);
         instrMock.instrReadyBus.bind(instrReadySignal);
         instrMock.validInstrRequest.bind(validInstrRequestSignal);
+        instrMock.addressSpaceBus.bind(instrAddressSpaceSignal);
 
         dataMock.clock.bind(clock);
         dataMock.weBus.bind(weSignal);
@@ -123,6 +132,7 @@ class CPUTests : public testing::Test {
         dataMock.dataOutBus.bind(dataInSignal);
         dataMock.dataReadyBus.bind(dataReadySignal);
         dataMock.validDataRequest.bind(validDataRequestSignal);
+        dataMock.addressSpaceBus.bind(addressSpaceSignal);
         std::cout << "done binding mocks" << std::endl;
     }
 
@@ -140,7 +150,9 @@ class CPUTests : public testing::Test {
 
         cpu.pcBus.bind(pcSignal);
         cpu.validInstrRequestBus.bind(validInstrRequestSignal);
+        cpu.instrAddressSpaceBus.bind(instrAddressSpaceSignal);
         cpu.validDataRequestBus.bind(validDataRequestSignal);
+        cpu.addressSpaceBus.bind(addressSpaceSignal);
 
         std::cout << "done binding cpu" << std::endl;
     }
@@ -241,3 +253,202 @@ TEST_F(CPUTests, CPUHandlesRandomInputWithoutThrowing) {
     sc_start(5, SC_SEC);
     ASSERT_EQ(dataMock.dataProvided.size(), numRequests);
 }
+
+TEST_F(CPUTests, OutOfOrderCPUForwardsStoreToLoadOfSameAddress) {
+    Request requests[2] = {Request{8, 42, 1}, Request{8, 0, 0}};
+    instrMock.instructionMemory[0] = requests[0];
+    instrMock.instructionMemory[1] = requests[1];
+
+    CPU cpu{"cpu", requests, 2, sc_time(1, SC_NS), 4};
+    createConnectionsToCPU(cpu);
+
+    sc_start(1, SC_SEC);
+    // only the store reaches the cache, the load takes its data
+    ASSERT_EQ(dataMock.dataProvided.size(), 1);
+    ASSERT_EQ(requests[1].data, 42);
+    ASSERT_EQ(cpu.getForwardedLoads(), 1);
+}
+
+TEST_F(CPUTests, OutOfOrderCPUKeepsStoresToSameAddressInOrder) {
+    Request requests[3] = {Request{1, 5, 1}, Request{1, 7, 1}, Request{1, 0, 0}};
+    for (std::uint32_t i = 0; i < 3; ++i) {
+        instrMock.instructionMemory[i] = requests[i];
+    }
+
+    CPU cpu{"cpu", requests, 3, sc_time(1, SC_NS), 4, 2};
+    createConnectionsToCPU(cpu);
+
+    sc_start(1, SC_SEC);
+    ASSERT_EQ(dataMock.dataProvided.size(), 2);
+    ASSERT_EQ(dataMock.dataProvided.at(0).data, 5);
+    ASSERT_EQ(dataMock.dataProvided.at(1).data, 7);
+    ASSERT_EQ(dataMock.dataMemory[1], 7);
+    ASSERT_EQ(requests[2].data, 7);
+}
+
+TEST_F(CPUTests, OutOfOrderCPUReadsSameValuesAsInOrderExecution) {
+    constexpr std::uint32_t numRequests = 2000;
+    Request requests[numRequests];
+
+    // few distinct addresses, so that many requests depend on each other
+    auto randomAddresses = generateRandomVector(numRequests, 16);
+    auto randomData = generateRandomVector(numRequests, UINT32_MAX);
+    auto randomWE = generateRandomVector(numRequests, 2);
+
+    std::unordered_map<std::uint32_t, std::uint32_t> expectedMemory;
+    std::vector<std::uint32_t> expectedReads(numRequests);
+    for (std::uint32_t i = 0; i < numRequests; ++i) {
+        auto req = Request{static_cast<std::uint32_t>(randomAddresses[i]) * 4,
+                           static_cast<std::uint32_t>(randomData[i]), static_cast<int>(randomWE[i])};
+        if (req.we) {
+            expectedMemory[req.addr] = req.data;
+        } else {
+            expectedReads[i] = expectedMemory[req.addr];
+        }
+        requests[i] = req;
+        instrMock.instructionMemory[i] = req;
+    }
+
+    CPU cpu{"cpu", requests, numRequests, sc_time(1, SC_NS), 16, 4};
+    createConnectionsToCPU(cpu);
+
+    sc_start(5, SC_SEC);
+    for (std::uint32_t i = 0; i < numRequests; ++i) {
+        if (!requests[i].we) {
+            ASSERT_EQ(requests[i].data, expectedReads[i]);
+        }
+    }
+    for (const auto& addressAndData : expectedMemory) {
+        ASSERT_EQ(dataMock.dataMemory[addressAndData.first], addressAndData.second);
+    }
+}
+
+TEST_F(CPUTests, CPUSendsAddressSpaceOfEachRequest) {
+    Request requests[4] = {{0, 1, 1}, {4, 2, 1}, {0, 0, 0}, {4, 0, 0}};
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        instrMock.instructionMemory[i] = requests[i];
+    }
+
+    CPU cpu{"cpu", requests, 4};
+    cpu.setAddressSpaces({0, 1, 1, 0});
+    createConnectionsToCPU(cpu);
+
+    sc_start(1, SC_SEC);
+    ASSERT_EQ(dataMock.addressSpacesProvided, (std::vector<std::uint16_t>{0, 1, 1, 0}));
+}
+
+TEST_F(CPUTests, CPUSendsAddressSpaceOfEachInstructionFetch) {
+    Request requests[4] = {{0, 1, 1}, {4, 2, 1}, {0, 0, 0}, {4, 0, 0}};
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        instrMock.instructionMemory[i] = requests[i];
+    }
+
+    CPU cpu{"cpu", requests, 4};
+    cpu.setAddressSpaces({1, 0, 0, 1});
+    createConnectionsToCPU(cpu);
+
+    sc_start(1, SC_SEC);
+    ASSERT_EQ(instrMock.addressSpacesFetched, (std::vector<std::uint16_t>{1, 0, 0, 1}));
+}
+
+// keeps every read result the CPU streams to it
+class RecordingSink : public ReadResultSink {
+  public:
+    struct ReadResult {
+        std::size_t index;
+        std::uint32_t data;
+        std::uint64_t cycle;
+    };
+    std::vector<ReadResult> results;
+
+    void record(std::size_t index, std::uint32_t data, std::uint64_t cycle) override {
+        results.push_back(ReadResult{index, data, cycle});
+    }
+};
+
+TEST_F(CPUTests, CPUStreamsReadResultsInsteadOfWritingThemBack) {
+    Request requests[3] = {Request{1, 0, 0}, Request{2, 9, 1}, Request{2, 0, 0}};
+    for (std::uint32_t i = 0; i < 3; ++i) {
+        instrMock.instructionMemory[i] = requests[i];
+    }
+    dataMock.dataMemory[1] = 10;
+
+    RecordingSink sink;
+    CPU cpu{"cpu", requests, 3};
+    cpu.setReadResultSink(&sink);
+    createConnectionsToCPU(cpu);
+
+    sc_start(1, SC_SEC);
+    ASSERT_EQ(sink.results.size(), 2);
+    ASSERT_EQ(sink.results.at(0).index, 0);
+    ASSERT_EQ(sink.results.at(0).data, 10);
+    ASSERT_EQ(sink.results.at(1).index, 2);
+    ASSERT_EQ(sink.results.at(1).data, 9);
+    ASSERT_LT(sink.results.at(0).cycle, sink.results.at(1).cycle);
+    ASSERT_EQ(sink.results.at(1).cycle, cpu.getElapsedCycleCount());
+    // the trace is left as it was
+    ASSERT_EQ(requests[0].data, 0);
+    ASSERT_EQ(requests[2].data, 0);
+}
+
+TEST_F(CPUTests, OutOfOrderCPUStreamsReadResultsInProgramOrder) {
+    Request requests[4] = {Request{8, 42, 1}, Request{1, 0, 0}, Request{8, 0, 0}, Request{1, 0, 0}};
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        instrMock.instructionMemory[i] = requests[i];
+    }
+    dataMock.dataMemory[1] = 10;
+
+    RecordingSink sink;
+    CPU cpu{"cpu", requests, 4, sc_time(1, SC_NS), 4, 2};
+    cpu.setReadResultSink(&sink);
+    createConnectionsToCPU(cpu);
+
+    sc_start(1, SC_SEC);
+    ASSERT_EQ(sink.results.size(), 3);
+    for (std::size_t i = 0; i < 3; ++i) {
+        ASSERT_EQ(sink.results.at(i).index, i + 1);
+    }
+    ASSERT_EQ(sink.results.at(0).data, 10);
+    ASSERT_EQ(sink.results.at(1).data, 42);
+    ASSERT_EQ(sink.results.at(2).data, 10);
+    ASSERT_LE(sink.results.at(0).cycle, sink.results.at(2).cycle);
+    ASSERT_EQ(requests[2].data, 0);
+}
+
+TEST_F(CPUTests, CPUComputesForGapBeforeIssuingRequest) {
+    Request requests[3] = {Request{1, 0, 0}, Request{2, 0, 0}, Request{3, 0, 0}};
+    for (std::uint32_t i = 0; i < 3; ++i) {
+        instrMock.instructionMemory[i] = requests[i];
+    }
+    const std::uint32_t gaps[3] = {0, 100, 0};
+
+    RecordingSink sink;
+    CPU cpu{"cpu", requests, 3};
+    cpu.setReadResultSink(&sink);
+    cpu.setGaps(gaps);
+    createConnectionsToCPU(cpu);
+
+    sc_start(1, SC_SEC);
+    ASSERT_EQ(sink.results.size(), 3);
+    ASSERT_GE(sink.results.at(1).cycle - sink.results.at(0).cycle, 100);
+    ASSERT_LT(sink.results.at(2).cycle - sink.results.at(1).cycle, 100);
+}
+
+TEST_F(CPUTests, OutOfOrderCPUComputesForGapBeforeFetchingRequest) {
+    Request requests[3] = {Request{1, 0, 0}, Request{2, 0, 0}, Request{3, 0, 0}};
+    for (std::uint32_t i = 0; i < 3; ++i) {
+        instrMock.instructionMemory[i] = requests[i];
+    }
+    const std::uint32_t gaps[3] = {0, 100, 0};
+
+    RecordingSink sink;
+    CPU cpu{"cpu", requests, 3, sc_time(1, SC_NS), 4, 2};
+    cpu.setReadResultSink(&sink);
+    cpu.setGaps(gaps);
+    createConnectionsToCPU(cpu);
+
+    sc_start(1, SC_SEC);
+    ASSERT_EQ(sink.results.size(), 3);
+    ASSERT_GE(sink.results.at(1).cycle - sink.results.at(0).cycle, 100);
+    ASSERT_GE(cpu.getElapsedCycleCount(), 100);
+}
@@ -16,6 +16,7 @@ using namespace sc_core;
 
 SC_MODULE(CPUMock) {
     std::vector<Request> instructions;
+    std::vector<std::uint16_t> addressSpaces; // of the instructions, all 0 if empty
     std::vector<Request> instructionsProvided;
 
     std::uint64_t currPC = 0;
@@ -24,6 +25,7 @@ SC_MODULE(CPUMock) {
     sc_out<std::uint32_t> dataOutBus;
     sc_out<bool> weBus;
     sc_out<bool> validRequestBus;
+    sc_out<std::uint16_t> addressSpaceBus;
 
     sc_in<std::uint32_t> dataInBus;
     sc_in<bool> cacheReadyBus;
@@ -42,6 +44,7 @@ SC_MODULE(CPUMock) {
             weBus.write(requestToWrite.we);
             addrBus.write(requestToWrite.addr);
             dataOutBus.write(requestToWrite.data);
+            addressSpaceBus.write(currPC < addressSpaces.size() ? addressSpaces.at(currPC) : 0);
             validRequestBus.write(true);
 
             instructionsProvided.push_back(requestToWrite);
@@ -79,11 +82,12 @@ SC_MODULE(RAMMock) {
     sc_in<std::uint32_t> addressBus;
     sc_in<std::uint32_t> dataInBus;
 
-    sc_out<sc_dt::sc_bv<128>> dataOutBus;
+    sc_out<BusBeat> dataOutBus;
     sc_out<bool> readyBus;
 
     std::map<std::uint32_t, std::uint8_t> dataMemory{};
     std::uint32_t numRequestsPerformed;
+    bool continuesBurst = false;
 
     SC_CTOR(RAMMock) {}
     std::uint32_t latency = 20;
@@ -101,13 +105,17 @@ SC_MODULE(RAMMock) {
             wait(clock.posedge_event());
             readyBus.write(false);
 
-            if (!validDataRequest.read())
+            if (!validDataRequest.read()) {
+                continuesBurst = false;
                 continue;
+            }
 
-            // Wait out latency
-            for (std::size_t cycles = 0; cycles < latency; ++cycles) {
+            // Wait out latency, unless this is the next word of a burst write
+            const bool isNextWordOfBurst = continuesBurst && weBus.read();
+            for (std::size_t cycles = 0; cycles < latency && !isNextWordOfBurst; ++cycles) {
                 wait(clock.posedge_event());
             }
+            continuesBurst = weBus.read();
 
             if (weBus.read()) {
                 // Writing happens in one cycle -> one able to write 32 bits
@@ -118,11 +126,11 @@ SC_MODULE(RAMMock) {
                 readyBus.write(true);
             } else {
                 // Reading takes wordsPerRead cycles
-                sc_dt::sc_bv<128> readData;
+                BusBeat readData;
                 for (std::uint32_t i = 0; i < wordsPerRead; ++i) {
                     // 128 / 8 -> 16
                     for (int byte = 0; byte < 16; ++byte) {
-                        readData.range(8 * byte + 7, 8 * byte) = readByteFromMem(addressBus.read() + i * 16 + byte);
+                        readData.bytes[byte] = readByteFromMem(addressBus.read() + i * 16 + byte);
                     }
                     dataOutBus.write(readData);
 
@@ -135,15 +143,17 @@ SC_MODULE(RAMMock) {
                 }
             }
 
-            ++numRequestsPerformed;
+            if (!isNextWordOfBurst)
+                ++numRequestsPerformed; // a burst counts as a single request
         }
     }
 };
 
-template <typename T> class CacheTests : public testing::Test {
+template <typename T, bool writeCombining> class CacheTestsBase : public testing::Test {
   public:
     CPUMock cpu{"CPU"};
-    Cache<T::value> cache{"Cache", 10, 64, 10, std::make_unique<RandomPolicy<std::uint32_t>>(10)};
+    Cache<T::value> cache{"Cache", 10, 64, 10, std::make_unique<RandomPolicy<std::uint32_t>>(10), WRITE_BUFFER_SIZE,
+                          writeCombining};
     RAMMock ram{"RAM", 64 / 16};
 
     // CPU -> Cache
@@ -151,6 +161,7 @@ template <typename T> class CacheTests : public testing::Test {
     sc_signal<std::uint32_t> SC_NAMED(cpuAddressSignal);
     sc_signal<std::uint32_t> SC_NAMED(cpuDataInSignal);
     sc_signal<bool, SC_MANY_WRITERS> SC_NAMED(cpuValidDataRequestSignal);
+    sc_signal<std::uint16_t> SC_NAMED(cpuAddressSpaceSignal);
 
     // Cache -> CPU
     sc_signal<std::uint32_t> SC_NAMED(cpuDataOutSignal);
@@ -159,7 +170,7 @@ template <typename T> class CacheTests : public testing::Test {
     // Cache -> RAM
     sc_signal<bool, SC_MANY_WRITERS> SC_NAMED(ramWeSignal);
     sc_signal<std::uint32_t, SC_MANY_WRITERS> SC_NAMED(ramAdressSignal);
-    sc_signal<sc_dt::sc_bv<128>> SC_NAMED(ramDataOutSignal);
+    sc_signal<BusBeat> SC_NAMED(ramDataOutSignal);
     sc_signal<bool, SC_MANY_WRITERS> SC_NAMED(ramValidDataRequestSignal);
 
     // RAM -> Cache
@@ -177,6 +188,7 @@ template <typename T> class CacheTests : public testing::Test {
         cpu.addrBus.bind(cpuAddressSignal);
         cpu.dataOutBus.bind(cpuDataInSignal);
         cpu.validRequestBus.bind(cpuValidDataRequestSignal);
+        cpu.addressSpaceBus.bind(cpuAddressSpaceSignal);
 
         cpu.dataInBus.bind(cpuDataOutSignal);
         cpu.cacheReadyBus.bind(cpuDataReadySignal);
@@ -187,6 +199,7 @@ template <typename T> class CacheTests : public testing::Test {
         cache.cpuDataInBus.bind(cpuDataInSignal);
         cache.cpuWeBus.bind(cpuWeSignal);
         cache.cpuValidRequest.bind(cpuValidDataRequestSignal);
+        cache.cpuAddressSpaceBus.bind(cpuAddressSpaceSignal);
 
         cache.ready.bind(cpuDataReadySignal);
         cache.cpuDataOutBus.bind(cpuDataOutSignal);
@@ -210,6 +223,9 @@ template <typename T> class CacheTests : public testing::Test {
     }
 };
 
+template <typename T> class CacheTests : public CacheTestsBase<T, false> {};
+template <typename T> class WriteCombiningCacheTests : public CacheTestsBase<T, true> {};
+
 template <MappingType mappingType> struct TestMappingType {
     static constexpr MappingType value = mappingType;
 };
@@ -218,6 +234,20 @@ using MappingTypes =
     ::testing::Types<TestMappingType<MappingType::Direct>, TestMappingType<MappingType::Fully_Associative>>;
 
 TYPED_TEST_SUITE(CacheTests, MappingTypes);
+TYPED_TEST_SUITE(WriteCombiningCacheTests, MappingTypes);
+
+// way partitioning is only defined for a fully associative cache
+class PartitionedCacheTests : public CacheTestsBase<TestMappingType<MappingType::Fully_Associative>, false> {
+  public:
+    // two ways of five lines, process 0 fills way 0 only, process 1 both
+    void partition(std::vector<std::uint32_t> wayMasks) {
+        cache.setAddressSpaces(2);
+        std::vector<std::unique_ptr<ReplacementPolicy<std::uint32_t>>> wayPolicies;
+        wayPolicies.push_back(std::make_unique<LRUPolicy<std::uint32_t>>(5));
+        wayPolicies.push_back(std::make_unique<LRUPolicy<std::uint32_t>>(5));
+        cache.partitionWays(std::move(wayPolicies), std::move(wayMasks));
+    }
+};
 
 TYPED_TEST(CacheTests, CacheTransfersSingleInstructionCorrectly) {
     auto req = Request{1, 5, 0};
@@ -562,6 +592,62 @@ TYPED_TEST(CacheTests, CacheWriteBufferHandlesMoreWritesThanCapacity) {
     ASSERT_EQ(TestFixture::ram.numRequestsPerformed, 7); // 6 writes + 1 read
 }
 
+TYPED_TEST(CacheTests, CacheWriteBufferCoalescesWritesToBufferedLine) {
+    TestFixture::ram.latency = 1000;
+    TestFixture::cpu.instructions.push_back(Request{100, 1, 1});
+    TestFixture::cpu.instructions.push_back(Request{100, 2, 1}); // new entry, the first one is being drained
+    TestFixture::cpu.instructions.push_back(Request{100, 3, 1});
+    TestFixture::cpu.instructions.push_back(Request{100, 4, 1});
+    TestFixture::cpu.instructions.push_back(Request{104, 5, 1});
+
+    sc_start(10, SC_MS);
+    ASSERT_EQ(TestFixture::cpu.instructionsProvided.size(), 5);
+    ASSERT_EQ(TestFixture::ram.numRequestsPerformed, 4); // 1 read + first write + 2 words of the coalesced entry
+    ASSERT_EQ(TestFixture::ram.dataMemory[100], 4);
+    ASSERT_EQ(TestFixture::ram.dataMemory[104], 5);
+
+    const auto& statistics = TestFixture::cache.getWriteBufferStatistics();
+    ASSERT_EQ(statistics.depth, WRITE_BUFFER_SIZE);
+    ASSERT_EQ(statistics.bufferedWrites, 5);
+    ASSERT_EQ(statistics.coalescedWrites, 3);
+    ASSERT_EQ(statistics.fullStallCycles, 0);
+    ASSERT_EQ(statistics.maxOccupancy, 2);
+}
+
+TYPED_TEST(WriteCombiningCacheTests, CacheWriteBufferBurstsCompleteLine) {
+    TestFixture::ram.latency = 1000;
+    for (std::uint32_t word = 0; word < 16; ++word)
+        TestFixture::cpu.instructions.push_back(Request{128 + 4 * word, word, 1});
+
+    sc_start(10, SC_MS);
+    ASSERT_EQ(TestFixture::cpu.instructionsProvided.size(), 16);
+    ASSERT_EQ(TestFixture::ram.numRequestsPerformed, 2); // 1 read + 1 burst of 16 words
+    for (std::uint32_t word = 0; word < 16; ++word)
+        ASSERT_EQ(TestFixture::ram.dataMemory[128 + 4 * word], word);
+
+    const auto& statistics = TestFixture::cache.getWriteBufferStatistics();
+    ASSERT_EQ(statistics.coalescedWrites, 15);
+    ASSERT_EQ(statistics.bursts, 1);
+    ASSERT_EQ(statistics.partialFlushes, 0);
+    ASSERT_EQ(statistics.savedRequests, 15);
+}
+
+TYPED_TEST(WriteCombiningCacheTests, CacheWriteBufferFlushesIncompleteLineWhenIdle) {
+    TestFixture::ram.latency = 100;
+    TestFixture::cpu.instructions.push_back(Request{200, 7, 1});
+    TestFixture::cpu.instructions.push_back(Request{204, 8, 1});
+
+    sc_start(10, SC_MS);
+    ASSERT_EQ(TestFixture::ram.numRequestsPerformed, 2); // 1 read + 1 burst of 2 words
+    ASSERT_EQ(TestFixture::ram.dataMemory[200], 7);
+    ASSERT_EQ(TestFixture::ram.dataMemory[204], 8);
+
+    const auto& statistics = TestFixture::cache.getWriteBufferStatistics();
+    ASSERT_EQ(statistics.bursts, 1);
+    ASSERT_EQ(statistics.partialFlushes, 1);
+    ASSERT_EQ(statistics.savedRequests, 1);
+}
+
 TYPED_TEST(CacheTests, CacheReadsResultInSameValuesAsManuallyRecorded) {
     TestFixture::ram.latency = 1;
     int numRequests = 10000;
@@ -602,6 +688,11 @@ TEST(HelperTest, SaturatingAddWorks) {
     ASSERT_EQ(addSatUnsigned(4u, 5u), 9u);
 }
 
+TEST(HelperTest, SaturatingSubWorks) {
+    ASSERT_EQ(subSatUnsigned((uint32_t)4, (uint32_t)9499), 0u);
+    ASSERT_EQ(subSatUnsigned(9u, 5u), 4u);
+}
+
 TEST(HelperTest, SaturatingMulWorks) {
     ASSERT_EQ(mulSatUnsigned(UINT32_MAX, (uint32_t)9499), UINT32_MAX);
     ASSERT_EQ(mulSatUnsigned(4u, 5u), 20u);
@@ -610,4 +701,71 @@ TEST(HelperTest, SaturatingMulWorks) {
 TEST(HelperTest, SaturatingPowWorks) {
     ASSERT_EQ(powSatUnsigned(UINT32_MAX, (uint32_t)9499), UINT32_MAX);
     ASSERT_EQ(powSatUnsigned(2u, 8u), 1u << 8u);
-}
\ No newline at end of file
+}
+
+TYPED_TEST(CacheTests, CacheAddressSpacesDoNotHitOnEachOthersLines) {
+    TestFixture::cache.setAddressSpaces(2);
+    TestFixture::cpu.instructions = {{0x100, 0xAB, 1}, {0x100, 0, 0}, {0x100, 0, 0}, {0x100, 0, 0}};
+    TestFixture::cpu.addressSpaces = {0, 1, 1, 0};
+    sc_start(2, SC_MS);
+
+    // the processes share the memory behind the cache, only the lines are private
+    ASSERT_EQ(TestFixture::cpu.dataReceivedForAddress.at(1), std::make_pair(0x100u, 0xABu));
+    const auto& process0 = TestFixture::cache.addressSpaceStatistics.at(0);
+    const auto& process1 = TestFixture::cache.addressSpaceStatistics.at(1);
+    ASSERT_EQ(process1.misses, 1);
+    ASSERT_EQ(process1.hits, 1);
+    if (TypeParam::value == MappingType::Direct) {
+        // the line of each process maps to the same index, the other one takes it away
+        ASSERT_EQ(process0.misses, 2);
+        ASSERT_EQ(process0.evictedByOthers, 1);
+        ASSERT_EQ(process1.evictedByOthers, 1);
+        ASSERT_EQ(process1.evictionsOfOthers, 1);
+    } else {
+        ASSERT_EQ(process0.misses, 1);
+        ASSERT_EQ(process0.hits, 1);
+        ASSERT_EQ(process0.evictedByOthers, 0);
+        ASSERT_EQ(process1.evictedByOthers, 0);
+    }
+}
+
+TEST_F(PartitionedCacheTests, CacheProcessFillsOnlyWaysOfItsMask) {
+    partition({0b01, 0b11});
+    // process 1 fills way 0 first, process 0 then has to evict its lines from there as way 1 is not in its mask
+    for (std::uint32_t line = 0; line < 5; ++line) {
+        cpu.instructions.push_back({0x1000 + line * 64, 0, 0});
+        cpu.addressSpaces.push_back(1);
+    }
+    for (std::uint32_t line = 0; line < 5; ++line) {
+        cpu.instructions.push_back({0x8000 + line * 64, 0, 0});
+        cpu.addressSpaces.push_back(0);
+    }
+    sc_start(3, SC_MS);
+
+    ASSERT_EQ(cache.addressSpaceStatistics.at(0).misses, 5);
+    ASSERT_EQ(cache.addressSpaceStatistics.at(0).evictionsOfOthers, 5);
+    ASSERT_EQ(cache.addressSpaceStatistics.at(1).evictedByOthers, 5);
+}
+
+TEST_F(PartitionedCacheTests, CacheProcessKeepsLinesOutsideTheMasksOfOthers) {
+    partition({0b01, 0b10});
+    // process 1 may only fill way 1, so the lines of process 0 in way 0 survive
+    for (std::uint32_t line = 0; line < 5; ++line) {
+        cpu.instructions.push_back({0x1000 + line * 64, 0, 0});
+        cpu.addressSpaces.push_back(0);
+    }
+    for (std::uint32_t line = 0; line < 8; ++line) {
+        cpu.instructions.push_back({0x8000 + line * 64, 0, 0});
+        cpu.addressSpaces.push_back(1);
+    }
+    for (std::uint32_t line = 0; line < 5; ++line) {
+        cpu.instructions.push_back({0x1000 + line * 64, 0, 0});
+        cpu.addressSpaces.push_back(0);
+    }
+    sc_start(5, SC_MS);
+
+    ASSERT_EQ(cache.addressSpaceStatistics.at(0).hits, 5);
+    ASSERT_EQ(cache.addressSpaceStatistics.at(0).evictedByOthers, 0);
+    ASSERT_EQ(cache.addressSpaceStatistics.at(1).misses, 8);
+    ASSERT_EQ(cache.addressSpaceStatistics.at(1).evictionsOfOthers, 0);
+}
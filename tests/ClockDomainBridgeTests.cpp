@@ -0,0 +1,93 @@
+#include "../src/Simulation/ClockDomainBridge.h"
+#include "../src/Simulation/RAM.h"
+#include "Utils.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <systemc>
+#include <vector>
+using namespace sc_core;
+
+constexpr std::uint32_t beatsPerBridgedRead = 64 / 16;
+constexpr std::uint32_t bridgedRAMLatency = 10;
+
+class ClockDomainBridgeTests : public testing::Test {
+  public:
+    MemoryRequester requester{"Requester", beatsPerBridgedRead};
+    ClockDomainBridge bridge{"Bridge", beatsPerBridgedRead, 2};
+    RAM memory{"Memory", bridgedRAMLatency, beatsPerBridgedRead};
+
+    // Requester <-> Bridge
+    sc_signal<std::uint32_t> SC_NAMED(requestAddrSignal);
+    sc_signal<std::uint32_t> SC_NAMED(requestDataSignal);
+    sc_signal<bool> SC_NAMED(requestWeSignal);
+    sc_signal<bool> SC_NAMED(requestValidSignal);
+    sc_signal<BusBeat> SC_NAMED(requestBeatSignal);
+    sc_signal<bool> SC_NAMED(requestReadySignal);
+
+    // Bridge <-> Memory
+    sc_signal<std::uint32_t> SC_NAMED(memoryAddrSignal);
+    sc_signal<std::uint32_t> SC_NAMED(memoryDataSignal);
+    sc_signal<bool> SC_NAMED(memoryWeSignal);
+    sc_signal<bool> SC_NAMED(memoryValidSignal);
+    sc_signal<BusBeat> SC_NAMED(memoryBeatSignal);
+    sc_signal<bool> SC_NAMED(memoryReadySignal);
+
+    // the memory runs at a third of the frequency of the requester
+    sc_clock clock{"clk", sc_time(1, SC_NS)};
+    sc_clock memoryClock{"memory_clk", sc_time(3, SC_NS)};
+
+    void SetUp() override {
+        requester.clock.bind(clock);
+        requester.addrBus.bind(requestAddrSignal);
+        requester.dataOutBus.bind(requestDataSignal);
+        requester.weBus.bind(requestWeSignal);
+        requester.validRequestBus.bind(requestValidSignal);
+        requester.dataInBus.bind(requestBeatSignal);
+        requester.readyBus.bind(requestReadySignal);
+
+        bridge.clock.bind(clock);
+        bridge.addressBus.bind(requestAddrSignal);
+        bridge.dataInBus.bind(requestDataSignal);
+        bridge.weBus.bind(requestWeSignal);
+        bridge.validRequestBus.bind(requestValidSignal);
+        bridge.dataOutBus.bind(requestBeatSignal);
+        bridge.readyBus.bind(requestReadySignal);
+
+        bridge.memoryClock.bind(memoryClock);
+        bridge.memoryAddrBus.bind(memoryAddrSignal);
+        bridge.memoryDataOutBus.bind(memoryDataSignal);
+        bridge.memoryWeBus.bind(memoryWeSignal);
+        bridge.memoryValidRequestBus.bind(memoryValidSignal);
+        bridge.memoryDataInBus.bind(memoryBeatSignal);
+        bridge.memoryReadyBus.bind(memoryReadySignal);
+
+        memory.clock.bind(memoryClock);
+        memory.addressBus.bind(memoryAddrSignal);
+        memory.dataInBus.bind(memoryDataSignal);
+        memory.weBus.bind(memoryWeSignal);
+        memory.validRequestBus.bind(memoryValidSignal);
+        memory.dataOutBus.bind(memoryBeatSignal);
+        memory.readyBus.bind(memoryReadySignal);
+    }
+};
+
+TEST_F(ClockDomainBridgeTests, ReadSeesWriteAcrossDomains) {
+    requester.requests = {{0x104, 0x04030201, true}, {0x100, 0, false}};
+    sc_start(1, SC_MS);
+
+    ASSERT_EQ(memory.dataMemory.readWord(0x104), 0x04030201);
+    ASSERT_EQ(requester.linesRead.size(), 1);
+    ASSERT_EQ(requester.linesRead.at(0).size(), beatsPerBridgedRead * BusBeat::SIZE_IN_BYTE);
+    ASSERT_EQ(requester.linesRead.at(0).at(0), 0);
+    ASSERT_EQ(requester.linesRead.at(0).at(4), 0x01);
+    ASSERT_EQ(requester.linesRead.at(0).at(7), 0x04);
+}
+
+TEST_F(ClockDomainBridgeTests, LatencyIsCountedInCyclesOfTheMemoryClock) {
+    requester.requests = {{0x0, 0, false}};
+    sc_start(1, SC_MS);
+
+    // the memory latency alone takes 3 requester cycles per memory cycle, the crossings come on top
+    ASSERT_EQ(requester.latencies.size(), 1);
+    ASSERT_GT(requester.latencies.at(0), 3 * bridgedRAMLatency + 2);
+}
@@ -0,0 +1,207 @@
+#include "../src/Request.h"
+#include "../src/Simulation/CoherentCache.h"
+#include "../src/Simulation/Policy/LRUPolicy.h"
+#include "../src/Simulation/RAM.h"
+#include "../src/Simulation/SnoopingBus.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <systemc>
+#include <utility>
+#include <vector>
+using namespace sc_core;
+
+// the CPU of one core: waits startCycles, then sends its requests one after the other and records what the reads
+// returned
+SC_MODULE(CoreMock) {
+    std::vector<Request> requests;
+    std::vector<std::uint32_t> dataRead;
+    std::uint64_t startCycles = 0;
+
+    sc_in<bool> clock;
+
+    sc_out<std::uint32_t> addrBus;
+    sc_out<std::uint32_t> dataOutBus;
+    sc_out<bool> weBus;
+    sc_out<bool> validRequestBus;
+
+    sc_in<std::uint32_t> dataInBus;
+    sc_in<bool> cacheReadyBus;
+
+    SC_CTOR(CoreMock) {
+        SC_THREAD(dispatchRequests);
+        sensitive << clock.pos();
+    }
+
+    void dispatchRequests() {
+        for (std::uint64_t cycle = 0; cycle <= startCycles; ++cycle) {
+            wait();
+        }
+        std::size_t next = 0;
+        while (true) {
+            if (next == requests.size()) { // more requests may be added between two sc_start
+                wait();
+                continue;
+            }
+            const Request request = requests.at(next++);
+            addrBus.write(request.addr);
+            dataOutBus.write(request.data);
+            weBus.write(request.we);
+            validRequestBus.write(true);
+            wait();
+            validRequestBus.write(false);
+            while (!cacheReadyBus.read()) {
+                wait();
+            }
+            if (!request.we)
+                dataRead.push_back(dataInBus.read());
+            wait();
+        }
+    }
+};
+
+// one core of the fixture: the CPU mock, its coherent data cache and the signals between them
+template <MappingType mappingType> struct TestCore {
+    CoreMock cpu;
+    CoherentCache<mappingType> cache;
+
+    sc_signal<std::uint32_t> addrSignal;
+    sc_signal<std::uint32_t> dataToCacheSignal;
+    sc_signal<bool> weSignal;
+    sc_signal<bool> validSignal;
+    sc_signal<std::uint32_t> dataToCPUSignal;
+    sc_signal<bool> readySignal;
+
+    TestCore(const char* name, SnoopingBus& bus, std::uint32_t lines, std::uint32_t lineSize)
+        : cpu{(std::string{name} + "_CPU").c_str()},
+          cache{(std::string{name} + "_Cache").c_str(), bus, lines, lineSize, 1,
+                std::make_unique<LRUPolicy<std::uint32_t>>(lines)} {}
+
+    void connect(sc_clock& clock) {
+        cpu.clock.bind(clock);
+        cache.clock.bind(clock);
+
+        cpu.addrBus.bind(addrSignal);
+        cpu.dataOutBus.bind(dataToCacheSignal);
+        cpu.weBus.bind(weSignal);
+        cpu.validRequestBus.bind(validSignal);
+        cpu.dataInBus.bind(dataToCPUSignal);
+        cpu.cacheReadyBus.bind(readySignal);
+
+        cache.cpuAddrBus.bind(addrSignal);
+        cache.cpuDataInBus.bind(dataToCacheSignal);
+        cache.cpuWeBus.bind(weSignal);
+        cache.cpuValidRequest.bind(validSignal);
+        cache.cpuDataOutBus.bind(dataToCPUSignal);
+        cache.ready.bind(readySignal);
+    }
+};
+
+template <typename T> class CoherenceTests : public testing::Test {
+  public:
+    static constexpr std::uint32_t lines = 4;
+    static constexpr std::uint32_t lineSize = 16;
+
+    SnoopingBus bus{"Bus", lineSize};
+    TestCore<T::value> core0{"Core0", bus, lines, lineSize};
+    TestCore<T::value> core1{"Core1", bus, lines, lineSize};
+    RAM ram{"RAM", 10, lineSize / 16};
+
+    // Bus <-> RAM
+    sc_signal<std::uint32_t> SC_NAMED(ramAddrSignal);
+    sc_signal<std::uint32_t> SC_NAMED(ramDataInSignal);
+    sc_signal<bool> SC_NAMED(ramWeSignal);
+    sc_signal<bool> SC_NAMED(ramValidSignal);
+    sc_signal<BusBeat> SC_NAMED(ramDataOutSignal);
+    sc_signal<bool> SC_NAMED(ramReadySignal);
+
+    sc_clock clock{"clk", sc_time(1, SC_NS)};
+
+    void SetUp() override {
+        core0.connect(clock);
+        core1.connect(clock);
+
+        bus.clock.bind(clock);
+        bus.memoryAddrBus.bind(ramAddrSignal);
+        bus.memoryDataOutBus.bind(ramDataInSignal);
+        bus.memoryWeBus.bind(ramWeSignal);
+        bus.memoryValidRequestBus.bind(ramValidSignal);
+        bus.memoryDataInBus.bind(ramDataOutSignal);
+        bus.memoryReadyBus.bind(ramReadySignal);
+
+        ram.clock.bind(clock);
+        ram.addressBus.bind(ramAddrSignal);
+        ram.dataInBus.bind(ramDataInSignal);
+        ram.weBus.bind(ramWeSignal);
+        ram.validRequestBus.bind(ramValidSignal);
+        ram.dataOutBus.bind(ramDataOutSignal);
+        ram.readyBus.bind(ramReadySignal);
+    }
+};
+
+template <MappingType mappingType> struct CoherenceMappingType {
+    static constexpr MappingType value = mappingType;
+};
+
+using CoherenceMappingTypes = ::testing::Types<CoherenceMappingType<MappingType::Direct>,
+                                               CoherenceMappingType<MappingType::Fully_Associative>>;
+
+TYPED_TEST_SUITE(CoherenceTests, CoherenceMappingTypes);
+
+TYPED_TEST(CoherenceTests, PrivateLineIsWrittenWithoutBusTransaction) {
+    TestFixture::core0.cpu.requests = {{0x300, 0, 0}, {0x300, 0x11223344, 1}, {0x300, 0, 0}};
+    sc_start(1, SC_MS);
+
+    ASSERT_EQ(TestFixture::core0.cpu.dataRead, (std::vector<std::uint32_t>{0, 0x11223344}));
+    // the read finds no other copy and takes the line Exclusive, so the write needs nobody's permission
+    ASSERT_EQ(TestFixture::bus.statistics.transactions, 1);
+    ASSERT_EQ(TestFixture::core0.cache.missCount, 1);
+    ASSERT_EQ(TestFixture::core0.cache.hitCount, 2);
+    ASSERT_EQ(TestFixture::bus.statistics.writeBacks, 0);
+}
+
+TYPED_TEST(CoherenceTests, ReadOfLineModifiedByOtherCoreIsFlushed) {
+    TestFixture::core0.cpu.requests = {{0x100, 0xDEADBEEF, 1}};
+    TestFixture::core1.cpu.startCycles = 100;
+    TestFixture::core1.cpu.requests = {{0x100, 0, 0}};
+    sc_start(1, SC_MS);
+
+    ASSERT_EQ(TestFixture::core1.cpu.dataRead, (std::vector<std::uint32_t>{0xDEADBEEF}));
+    ASSERT_EQ(TestFixture::bus.statistics.transactions, 2);
+    ASSERT_EQ(TestFixture::bus.statistics.cacheToCache, 1);
+    // both copies are Shared afterwards, so the flushed line is written back as well
+    ASSERT_EQ(TestFixture::bus.statistics.writeBacks, 1);
+    ASSERT_EQ(TestFixture::bus.statistics.invalidations, 0);
+}
+
+TYPED_TEST(CoherenceTests, WriteInvalidatesOtherCopiesAndCausesCoherenceMiss) {
+    TestFixture::core0.cpu.requests = {{0x200, 0, 0}};
+    TestFixture::core1.cpu.startCycles = 100;
+    TestFixture::core1.cpu.requests = {{0x200, 0, 0}, {0x200, 0xCAFE, 1}};
+    sc_start(1, SC_US); // both cores share the line, core 1 upgrades its copy
+    TestFixture::core0.cpu.requests.push_back({0x200, 0, 0});
+    sc_start(1, SC_MS);
+
+    ASSERT_EQ(TestFixture::core0.cpu.dataRead.size(), 2);
+    ASSERT_EQ(TestFixture::core0.cpu.dataRead.at(1), 0xCAFE);
+    ASSERT_EQ(TestFixture::bus.statistics.invalidations, 1);
+    ASSERT_EQ(TestFixture::core0.cache.coherenceMissCount, 1);
+    ASSERT_EQ(TestFixture::core1.cache.coherenceMissCount, 0);
+    // the write to the Shared copy hits, the Upgrade only invalidates
+    ASSERT_EQ(TestFixture::core1.cache.missCount, 1);
+    ASSERT_EQ(TestFixture::core1.cache.hitCount, 1);
+}
+
+TYPED_TEST(CoherenceTests, EvictedModifiedLineIsWrittenBack) {
+    // five lines, so the first one is evicted in both a direct mapped and a fully associative cache of four lines
+    for (std::uint32_t i = 0; i < 5; ++i) {
+        TestFixture::core0.cpu.requests.push_back({i * 0x40, i + 1, 1});
+    }
+    TestFixture::core0.cpu.requests.push_back({0x0, 0, 0});
+    sc_start(1, SC_MS);
+
+    ASSERT_EQ(TestFixture::core0.cpu.dataRead, (std::vector<std::uint32_t>{1}));
+    ASSERT_GE(TestFixture::bus.statistics.writeBacks, 1);
+    ASSERT_EQ(TestFixture::core0.cache.coherenceMissCount, 0);
+}
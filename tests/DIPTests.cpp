@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "../src/Simulation/Policy/DIPPolicy.h"
+#include "../src/Simulation/Policy/LRUPolicy.h"
+#include "Utils.h"
+
+#include <cstdint>
+#include <vector>
+
+using DIP = DIPPolicy<std::uint32_t>;
+
+// a new working set that fits into the cache every few rounds, which LRU insertion keeps and bimodal insertion does not
+static std::vector<std::uint32_t> shiftingWorkingSets(std::uint32_t firstBlock, std::uint32_t workingSetSize,
+                                                      std::size_t roundsPerSet, std::size_t numSets) {
+    std::vector<std::uint32_t> blocks;
+    for (std::size_t set = 0; set < numSets; ++set) {
+        for (auto block : cyclicAccesses(workingSetSize, roundsPerSet))
+            blocks.push_back(firstBlock + static_cast<std::uint32_t>(set) * workingSetSize + block);
+    }
+    return blocks;
+}
+
+TEST(DIPPolicyTests, DIPPolicyOrdersHitsLikeLRU) {
+    DIP dipPolicy{64};
+    for (std::uint32_t i = 0; i < 64; ++i)
+        dipPolicy.logUse(i);
+    for (std::uint32_t i = 0; i < 64; ++i)
+        dipPolicy.logUse(i);
+    for (std::uint32_t i = 0; i < 64; ++i)
+        ASSERT_EQ(i, dipPolicy.pop());
+}
+
+TEST(DIPPolicyTests, DIPPolicyIgnoresBlocksWithoutTag) {
+    DIP dipPolicy{64};
+    for (std::uint32_t round = 0; round < 100; ++round) {
+        for (std::uint32_t i = 0; i < 64; ++i) {
+            if (round > 0) {
+                ASSERT_EQ(i, dipPolicy.pop());
+            }
+            dipPolicy.logUse(i); // filled without a reported miss, so the leaders never see it
+        }
+    }
+    ASSERT_EQ((1u << DIP::pselBits) / 2, dipPolicy.getSelectionHistory().back().psel);
+    ASSERT_EQ(DIP::Insertion::LRU, dipPolicy.getFollowerInsertion());
+}
+
+TEST(DIPPolicyTests, DIPPolicyKeepsPartOfThrashingWorkingSet) {
+    const auto blocks = cyclicAccesses(1536, 20);
+    DIP dipPolicy{1024};
+    LRUPolicy<std::uint32_t> lruPolicy{1024};
+    ASSERT_EQ(0, countHits(lruPolicy, 1024, blocks));
+    ASSERT_GT(countHits(dipPolicy, 1024, blocks), blocks.size() / 4);
+    ASSERT_EQ(DIP::Insertion::Bimodal, dipPolicy.getFollowerInsertion());
+}
+
+TEST(DIPPolicyTests, DIPPolicyMatchesLRUWhenRecencyPays) {
+    const auto blocks = shiftingWorkingSets(0, 768, 3, 20);
+    DIP dipPolicy{1024};
+    LRUPolicy<std::uint32_t> lruPolicy{1024};
+    const auto lruHits = countHits(lruPolicy, 1024, blocks);
+    ASSERT_GT(countHits(dipPolicy, 1024, blocks), lruHits * 9 / 10);
+    ASSERT_EQ(DIP::Insertion::LRU, dipPolicy.getFollowerInsertion());
+}
+
+TEST(DIPPolicyTests, DIPPolicyRecordsDecisionOfEveryPhase) {
+    const std::uint64_t phaseLength = 2000;
+    auto blocks = cyclicAccesses(1536, 10);                          // 15360 uses favouring bimodal insertion
+    const auto recencyPhase = shiftingWorkingSets(1536, 768, 3, 20); // 46080 uses favouring LRU insertion
+    blocks.insert(blocks.end(), recencyPhase.begin(), recencyPhase.end());
+
+    DIP dipPolicy{1024, phaseLength};
+    countHits(dipPolicy, 1024, blocks);
+    const auto history = dipPolicy.getSelectionHistory();
+
+    ASSERT_EQ((blocks.size() + phaseLength - 1) / phaseLength, history.size());
+    for (std::size_t phase = 0; phase + 1 < history.size(); ++phase)
+        ASSERT_EQ((phase + 1) * phaseLength, history[phase].uses);
+    ASSERT_EQ(blocks.size(), history.back().uses);
+    ASSERT_EQ(DIP::Insertion::Bimodal, history[6].followerInsertion);
+    ASSERT_EQ(DIP::Insertion::LRU, history.back().followerInsertion);
+    ASSERT_GT(history[6].lruLeaderMisses, history[6].bimodalLeaderMisses);
+}
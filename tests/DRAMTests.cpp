@@ -0,0 +1,86 @@
+#include "../src/Simulation/DRAM.h"
+#include "Utils.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <systemc>
+#include <vector>
+using namespace sc_core;
+
+// 2 banks of 64 byte rows: row 0 of bank 0 is [0,64), row 0 of bank 1 [64,128), row 1 of bank 0 [128,192) ...
+template <bool closedPage> class DRAMTestsBase : public testing::Test {
+  public:
+    static DRAMOptions options() { return DRAMOptions{1, 1, 2, 64, 2, 3, 4, 10, closedPage}; }
+
+    MemoryRequester requester{"Requester", 1};
+    DRAM dram{"DRAM", options(), 1};
+
+    sc_signal<std::uint32_t> SC_NAMED(addrSignal);
+    sc_signal<std::uint32_t> SC_NAMED(dataSignal);
+    sc_signal<bool> SC_NAMED(weSignal);
+    sc_signal<bool> SC_NAMED(validSignal);
+    sc_signal<BusBeat> SC_NAMED(beatSignal);
+    sc_signal<bool> SC_NAMED(readySignal);
+
+    sc_clock clock{"clk", sc_time(1, SC_NS)};
+
+    void SetUp() override {
+        requester.clock.bind(clock);
+        requester.addrBus.bind(addrSignal);
+        requester.dataOutBus.bind(dataSignal);
+        requester.weBus.bind(weSignal);
+        requester.validRequestBus.bind(validSignal);
+        requester.dataInBus.bind(beatSignal);
+        requester.readyBus.bind(readySignal);
+
+        dram.clock.bind(clock);
+        dram.addressBus.bind(addrSignal);
+        dram.dataInBus.bind(dataSignal);
+        dram.weBus.bind(weSignal);
+        dram.validRequestBus.bind(validSignal);
+        dram.dataOutBus.bind(beatSignal);
+        dram.readyBus.bind(readySignal);
+    }
+};
+
+using OpenPageDRAMTests = DRAMTestsBase<false>;
+using ClosedPageDRAMTests = DRAMTestsBase<true>;
+
+TEST_F(OpenPageDRAMTests, ReadsBackWrittenData) {
+    requester.requests = {{0x104, 0x04030201, true}, {0x100, 0, false}};
+    sc_start(1, SC_MS);
+
+    ASSERT_EQ(requester.linesRead.size(), 1);
+    ASSERT_EQ(requester.linesRead.at(0).at(4), 0x01);
+    ASSERT_EQ(requester.linesRead.at(0).at(7), 0x04);
+    ASSERT_EQ(requester.linesRead.at(0).at(0), 0);
+}
+
+TEST_F(OpenPageDRAMTests, OpenRowIsHitAndOtherRowOfSameBankConflicts) {
+    requester.requests = {{0, 0, false}, {16, 0, false}, {128, 0, false}, {64, 0, false}};
+    sc_start(1, SC_MS);
+
+    const auto& statistics = dram.getStatistics();
+    ASSERT_EQ(statistics.accesses, 4);
+    ASSERT_EQ(statistics.rowMisses, 2); // first accesses of bank 0 and 1
+    ASSERT_EQ(statistics.rowHits, 1);
+    ASSERT_EQ(statistics.rowConflicts, 1);
+
+    const auto& latencies = requester.latencies;
+    ASSERT_LT(latencies.at(1), latencies.at(0)); // tCAS < tRCD + tCAS
+    ASSERT_GE(latencies.at(2) - latencies.at(0), 4); // tRP on top of a miss
+    ASSERT_EQ(latencies.at(3), latencies.at(0)); // the other bank is unaffected
+}
+
+TEST_F(ClosedPageDRAMTests, EveryAccessActivatesItsRow) {
+    requester.requests = {{0, 0, false}, {16, 0, false}, {128, 0, false}, {64, 0, false}};
+    sc_start(1, SC_MS);
+
+    const auto& statistics = dram.getStatistics();
+    ASSERT_EQ(statistics.accesses, 4);
+    ASSERT_EQ(statistics.rowMisses, 4);
+    ASSERT_EQ(statistics.rowHits, 0);
+    ASSERT_EQ(statistics.rowConflicts, 0);
+    // twice bank 0 is still busy with the previous row when the next request arrives 2 cycles after the data: the row
+    // stays open for tRAS after its activation and is closed in another tRP
+    ASSERT_EQ(statistics.latencyCycles, 4 * (2 + 3) + 2 * (10 - 2 - 3 - 2 + 4));
+}
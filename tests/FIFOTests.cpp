@@ -17,7 +17,8 @@ TEST(FIFOPolicyTests, FIFOPolicyAddingSingleValueReturnsSameValue) {
 
 TEST(FIFOPolicyTests, FIFOPolicyAddingMultipleUniqueValuesReturnsInCorrectOrder) {
     FIFOPolicy<std::uint64_t> fifoPolicy{10000};
-    auto randomVec = makeVectorUniqueNoOrderPreserve(generateRandomVector(10000));
+    // keys are cacheline indices and therefore have to be smaller than the capacity
+    auto randomVec = makeVectorUniqueNoOrderPreserve(generateRandomVector(10000, 10000));
     std::for_each(randomVec.cbegin(), randomVec.cend(), [&fifoPolicy](std::uint64_t val) { fifoPolicy.logUse(val); });
     ASSERT_EQ(randomVec.size(), fifoPolicy.getSize());
     for (std::size_t i = 0; i < randomVec.size(); ++i) {
@@ -82,4 +83,46 @@ TEST(RingQueueTest, AddSingleValWorks) {
     ASSERT_EQ(q.getCapacity(), 4);
     q.push(4);
     ASSERT_EQ(4, q.pop());
-}
\ No newline at end of file
+}
+
+TEST(RingQueueTest, CompileTimeCapacityWrapsAroundCorrectly) {
+    RingQueue<std::uint64_t, 3> q{};
+    ASSERT_EQ(q.getCapacity(), 3);
+    for (std::uint64_t i = 0; i < 10; ++i) {
+        q.push(i);
+        q.push(i + 100);
+        ASSERT_EQ(q.getSize(), 2);
+        ASSERT_EQ(i, q.pop());
+        ASSERT_EQ(i + 100, q.pop());
+        ASSERT_TRUE(q.isEmpty());
+    }
+}
+
+TEST(RingQueueTest, AnyOnlySeesQueuedElements) {
+    RingQueue<std::uint64_t, 4> q{};
+    for (std::uint64_t i = 0; i < 4; ++i)
+        q.push(i);
+    q.pop();
+    q.pop();
+    q.push(7);
+    ASSERT_FALSE(q.any([](std::uint64_t el) { return el == 0; }));
+    ASSERT_TRUE(q.any([](std::uint64_t el) { return el == 3; }));
+    ASSERT_TRUE(q.any([](std::uint64_t el) { return el == 7; }));
+}
+
+TEST(RingQueueTest, ForEachVisitsOldestFirstAndCanModify) {
+    RingQueue<std::uint64_t> q{3};
+    q.push(1);
+    q.pop();
+    for (std::uint64_t i = 2; i < 5; ++i)
+        q.push(i);
+    std::vector<std::uint64_t> visited;
+    q.forEach([&visited](std::uint64_t& el) {
+        visited.push_back(el);
+        el *= 10;
+    });
+    ASSERT_EQ((std::vector<std::uint64_t>{2, 3, 4}), visited);
+    ASSERT_EQ(20, q.pop());
+    ASSERT_EQ(30, q.pop());
+    ASSERT_EQ(40, q.pop());
+}
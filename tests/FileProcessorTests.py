@@ -71,6 +71,19 @@ class TestExtractFileData(unittest.TestCase):
         output = capture_stderr(args).decode()
         self.assertEqual(expected_output, output)
 
+    def test_invalid_gap(self):
+        args = INVALID_FILE_PATH + '/invalid_gap.csv'
+        expected_output = "Error: Wrong file format! The gap has to be a number of cycles below 2^31.\n" + print_usage
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
+    def test_invalid_instruction_address(self):
+        args = INVALID_FILE_PATH + '/invalid_instruction_address.csv'
+        expected_output = ("Error: Wrong file format! The instruction address has to be a number below 2^32.\n" +
+                           print_usage)
+        output = capture_stderr(args).decode()
+        self.assertEqual(expected_output, output)
+
 
 class TestCheckTraceFile(unittest.TestCase):
     def test_existing_directory_tf(self):
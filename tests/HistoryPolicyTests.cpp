@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include "../src/Simulation/Policy/ARCPolicy.h"
+#include "../src/Simulation/Policy/LIRSPolicy.h"
+#include "../src/Simulation/Policy/LRUPolicy.h"
+#include "../src/Simulation/Policy/TagTable.h"
+#include "../src/Simulation/Policy/TwoQueuePolicy.h"
+#include "Utils.h"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// a hot set that fits into the cache, interrupted by scans of blocks that are never used again
+static std::vector<std::uint32_t> hotSetWithScans(std::uint32_t hotSetSize, std::uint32_t scanLength,
+                                                  std::size_t rounds) {
+    std::vector<std::uint32_t> blocks{};
+    std::uint32_t nextScanBlock = 1000000;
+    for (std::size_t round = 0; round < rounds; ++round) {
+        for (int repetition = 0; repetition < 2; ++repetition)
+            for (std::uint32_t block = 0; block < hotSetSize; ++block)
+                blocks.push_back(block);
+        for (std::uint32_t i = 0; i < scanLength; ++i)
+            blocks.push_back(nextScanBlock++);
+    }
+    return blocks;
+}
+
+template <typename PolicyType> class HistoryPolicyTests : public testing::Test {};
+using HistoryPolicies =
+    ::testing::Types<ARCPolicy<std::uint32_t>, TwoQueuePolicy<std::uint32_t>, LIRSPolicy<std::uint32_t>>;
+TYPED_TEST_SUITE(HistoryPolicyTests, HistoryPolicies);
+
+TYPED_TEST(HistoryPolicyTests, HistoryPolicyOnlyEvictsExistingCachelines) {
+    for (std::size_t size : {1, 2, 7, 100}) {
+        TypeParam policy{size};
+        auto accesses = generateRandomVector(20000, 3 * size);
+        std::vector<std::uint32_t> blocks(accesses.cbegin(), accesses.cend());
+        countHits(policy, size, blocks); // asserts inside the policies check their invariants
+        for (std::uint32_t i = 0; i < 100; ++i) {
+            policy.logMiss(5000000 + i);
+            auto victim = policy.pop();
+            ASSERT_LT(victim, size);
+            policy.logUse(victim);
+        }
+    }
+}
+
+TYPED_TEST(HistoryPolicyTests, HistoryPolicyWorksWithoutReportedMisses) {
+    TypeParam policy{64};
+    for (std::uint32_t i = 0; i < 64; ++i)
+        policy.logUse(i);
+    auto accesses = generateRandomVector(10000, 64);
+    for (auto access : accesses) {
+        policy.logUse(access);
+        auto victim = policy.pop();
+        ASSERT_LT(victim, 64);
+        policy.logUse(victim);
+    }
+}
+
+TYPED_TEST(HistoryPolicyTests, HistoryPolicyIsScanResistant) {
+    const auto blocks = hotSetWithScans(32, 64, 100);
+    TypeParam policy{64};
+    LRUPolicy<std::uint32_t> lruPolicy{64};
+    const auto hits = countHits(policy, 64, blocks);
+    const auto lruHits = countHits(lruPolicy, 64, blocks);
+    // LRU loses the hot set to every scan, the policies with history keep (most of) it
+    ASSERT_GT(hits, lruHits + 32 * 100 / 2);
+}
+
+TEST(ARCPolicyTests, ARCPolicyAdaptsToRecencyFriendlyWorkload) {
+    ARCPolicy<std::uint32_t> arcPolicy{16};
+    LRUPolicy<std::uint32_t> lruPolicy{16};
+    const auto blocks = cyclicAccesses(12, 100);
+    ASSERT_EQ(countHits(arcPolicy, 16, blocks), countHits(lruPolicy, 16, blocks));
+}
+
+TEST(LIRSPolicyTests, LIRSPolicyKeepsPartOfLoopLargerThanCache) {
+    LIRSPolicy<std::uint32_t> lirsPolicy{64};
+    LRUPolicy<std::uint32_t> lruPolicy{64};
+    const auto blocks = cyclicAccesses(80, 100);
+    ASSERT_EQ(0, countHits(lruPolicy, 64, blocks));
+    ASSERT_GT(countHits(lirsPolicy, 64, blocks), blocks.size() / 2);
+}
+
+TEST(TagTableTests, TagTableFindsWhatWasInsertedUntilErased) {
+    TagTable table{1000};
+    std::unordered_map<std::uint32_t, std::uint32_t> reference{};
+    auto tags = generateRandomVector(20000, 4000);
+    std::uint32_t value = 0;
+    for (auto tag64 : tags) {
+        auto tag = static_cast<std::uint32_t>(tag64);
+        if (reference.count(tag) != 0) {
+            ASSERT_EQ(reference[tag], table.find(tag));
+            table.erase(tag);
+            reference.erase(tag);
+        } else if (reference.size() < 1000) {
+            table.insert(tag, value);
+            reference[tag] = value++;
+        }
+        ASSERT_EQ(TagTable::notFound, table.find(tag + 4000));
+    }
+    for (auto& entry : reference)
+        ASSERT_EQ(entry.second, table.find(entry.first));
+}
@@ -1,5 +1,6 @@
 #include "../src/Simulation/CPU.h"
 #include "../src/Simulation/Connections.h"
+#include "../src/Simulation/Policy/FIFOPolicy.h"
 #include "../src/Simulation/Policy/LRUPolicy.h"
 #include "../src/Simulation/Policy/Policy.h"
 #include "../src/Simulation/Policy/RandomPolicy.h"
@@ -36,14 +37,14 @@ class IntegrationTests : public TestWithParam<std::tuple<unsigned int, unsigned
 
     Request* requests = std::get<5>(GetParam()).first;
     int requestsSize = std::get<5>(GetParam()).second;
-    std::vector<Request> requestsAsVector = std::vector<Request>(requests, requests + requestsSize);
 
     CPU cpu{"CPU", requests, requestsSize};
 
     RAM dataRam{"Data_RAM", memoryLatency, cacheLineSize / 16};
     RAM instructionRam{"Instruction_RAM", memoryLatency, cacheLineSize / 16};
 
-    InstructionCache instructionCache{"Instruction_Cache", 16, 64, cacheLatency, requestsAsVector};
+    InstructionCache instructionCache{"Instruction_Cache", 16, 64, cacheLatency, requests,
+                                      static_cast<std::size_t>(requestsSize)};
 
     std::unordered_map<std::uint32_t, std::uint8_t> memRecord;
     std::unordered_map<std::uint32_t, std::uint32_t> readRecord;
@@ -105,6 +106,85 @@ TEST_P(IntegrationTests, FullyAssociative) {
     }
 }
 
+// a loop of 4 instructions fits a single line, only the first fetch misses
+TEST(InstructionCacheTests, FetchesRealAddressesOfInstructions) {
+    constexpr std::size_t numRequests = 100;
+    Request* requests = generateRandomRequests(numRequests);
+    std::vector<std::uint32_t> instructionAddresses;
+    for (std::uint32_t i = 0; i < numRequests; ++i) {
+        instructionAddresses.push_back(0x400000 + (i % 4) * 4);
+    }
+
+    CPU cpu{"CPU", requests, numRequests};
+    RAM dataRam{"Data_RAM", 10, 4};
+    RAM instructionRam{"Instruction_RAM", 10, 4};
+    Cache<MappingType::Direct> dataCache{"Data_cache", 16, 64, 1};
+    InstructionCache instructionCache{"Instruction_Cache", 16, 64, 1, requests, numRequests};
+    instructionCache.setFetchAddresses(instructionAddresses.data());
+
+    auto connections = connectComponents(cpu, dataRam, instructionRam, dataCache, instructionCache);
+
+    sc_start(1, SC_MS);
+
+    ASSERT_EQ(cpu.pcBus, numRequests);
+    ASSERT_EQ(instructionCache.getMissCount(), 1);
+    ASSERT_EQ(instructionCache.getHitCount(), numRequests - 1);
+}
+
+// two instructions a direct-mapped cache of 16 lines maps to the same line share a fully associative one of 2 lines
+TEST(InstructionCacheTests, FullyAssociativeKeepsConflictingInstructions) {
+    constexpr std::size_t numRequests = 100;
+    Request* requests = generateRandomRequests(numRequests);
+    std::vector<std::uint32_t> instructionAddresses;
+    for (std::uint32_t i = 0; i < numRequests; ++i) {
+        instructionAddresses.push_back((i % 2) * 16 * 64);
+    }
+
+    CPU cpu{"CPU", requests, numRequests};
+    RAM dataRam{"Data_RAM", 10, 4};
+    RAM instructionRam{"Instruction_RAM", 10, 4};
+    Cache<MappingType::Direct> dataCache{"Data_cache", 16, 64, 1};
+    InstructionCache instructionCache{"Instruction_Cache", 2, 64, 1, requests, numRequests, 0,
+                                      std::make_unique<LRUPolicy<std::uint32_t>>(2)};
+    instructionCache.setFetchAddresses(instructionAddresses.data());
+
+    auto connections = connectComponents(cpu, dataRam, instructionRam, dataCache, instructionCache);
+
+    sc_start(1, SC_MS);
+
+    ASSERT_EQ(cpu.pcBus, numRequests);
+    ASSERT_EQ(instructionCache.getMissCount(), 2);
+    ASSERT_EQ(instructionCache.getHitCount(), numRequests - 2);
+}
+
+// two processes running the same code fetch the same addresses, but do not hit on the lines of each other
+TEST(InstructionCacheTests, ProcessesFetchingSameAddressDoNotShareLines) {
+    constexpr std::size_t numRequests = 100;
+    Request* requests = generateRandomRequests(numRequests);
+    std::vector<std::uint32_t> instructionAddresses(numRequests, 0x400000);
+    std::vector<std::uint16_t> addressSpaces;
+    for (std::uint16_t i = 0; i < numRequests; ++i) {
+        addressSpaces.push_back(i % 2);
+    }
+
+    CPU cpu{"CPU", requests, numRequests};
+    cpu.setAddressSpaces(addressSpaces);
+    RAM dataRam{"Data_RAM", 10, 4};
+    RAM instructionRam{"Instruction_RAM", 10, 4};
+    Cache<MappingType::Direct> dataCache{"Data_cache", 16, 64, 1};
+    InstructionCache instructionCache{"Instruction_Cache", 2, 64, 1, requests, numRequests, 0,
+                                      std::make_unique<LRUPolicy<std::uint32_t>>(2)};
+    instructionCache.setFetchAddresses(instructionAddresses.data());
+
+    auto connections = connectComponents(cpu, dataRam, instructionRam, dataCache, instructionCache);
+
+    sc_start(1, SC_MS);
+
+    ASSERT_EQ(cpu.pcBus, numRequests);
+    ASSERT_EQ(instructionCache.getMissCount(), 2);
+    ASSERT_EQ(instructionCache.getHitCount(), numRequests - 2);
+}
+
 std::string ParamNameGenerator(const testing::TestParamInfo<IntegrationTests::ParamType>& info) {
     auto memoryLatency = std::to_string(std::get<0>(info.param));
     auto cacheLatency = std::to_string(std::get<1>(info.param));
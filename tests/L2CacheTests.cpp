@@ -0,0 +1,167 @@
+#include "../src/Simulation/L2Cache.h"
+#include "../src/Simulation/Policy/LRUPolicy.h"
+#include "../src/Simulation/RAM.h"
+#include "Utils.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <systemc>
+#include <vector>
+using namespace sc_core;
+
+template <typename T> class L2CacheTests : public testing::Test {
+  public:
+    MemoryRequester instructionCache{"Instruction_Cache", 128 / 16};
+    MemoryRequester dataCache{"Data_Cache", 64 / 16};
+    L2Cache<T::value> l2{"L2", 32, 64, 5, 128 / 16, 64 / 16, std::make_unique<LRUPolicy<std::uint32_t>>(32)};
+    RAM ram{"RAM", 10, 64 / 16};
+
+    // Instruction Cache <-> L2
+    sc_signal<std::uint32_t> SC_NAMED(instrAddrSignal);
+    sc_signal<std::uint32_t> SC_NAMED(instrDataSignal);
+    sc_signal<bool> SC_NAMED(instrWeSignal);
+    sc_signal<bool> SC_NAMED(instrValidSignal);
+    sc_signal<BusBeat> SC_NAMED(instrLineSignal);
+    sc_signal<bool> SC_NAMED(instrReadySignal);
+
+    // Data Cache <-> L2
+    sc_signal<std::uint32_t> SC_NAMED(dataAddrSignal);
+    sc_signal<std::uint32_t> SC_NAMED(dataDataSignal);
+    sc_signal<bool> SC_NAMED(dataWeSignal);
+    sc_signal<bool> SC_NAMED(dataValidSignal);
+    sc_signal<BusBeat> SC_NAMED(dataLineSignal);
+    sc_signal<bool> SC_NAMED(dataReadySignal);
+
+    // L2 <-> RAM
+    sc_signal<std::uint32_t, SC_MANY_WRITERS> SC_NAMED(ramAddrSignal);
+    sc_signal<std::uint32_t> SC_NAMED(ramDataInSignal);
+    sc_signal<bool, SC_MANY_WRITERS> SC_NAMED(ramWeSignal);
+    sc_signal<bool, SC_MANY_WRITERS> SC_NAMED(ramValidSignal);
+    sc_signal<BusBeat> SC_NAMED(ramDataOutSignal);
+    sc_signal<bool> SC_NAMED(ramReadySignal);
+
+    sc_clock clock{"clk", sc_time(1, SC_NS)};
+
+    void connect(MemoryRequester& l1, sc_signal<std::uint32_t>& addr, sc_signal<std::uint32_t>& data,
+                 sc_signal<bool>& we, sc_signal<bool>& valid, sc_signal<BusBeat>& line, sc_signal<bool>& ready) {
+        l1.clock.bind(clock);
+        l1.addrBus.bind(addr);
+        l1.dataOutBus.bind(data);
+        l1.weBus.bind(we);
+        l1.validRequestBus.bind(valid);
+        l1.dataInBus.bind(line);
+        l1.readyBus.bind(ready);
+    }
+
+    void SetUp() override {
+        connect(instructionCache, instrAddrSignal, instrDataSignal, instrWeSignal, instrValidSignal, instrLineSignal,
+                instrReadySignal);
+        connect(dataCache, dataAddrSignal, dataDataSignal, dataWeSignal, dataValidSignal, dataLineSignal,
+                dataReadySignal);
+
+        l2.clock.bind(clock);
+        l2.instrAddrBus.bind(instrAddrSignal);
+        l2.instrDataInBus.bind(instrDataSignal);
+        l2.instrWeBus.bind(instrWeSignal);
+        l2.instrValidRequestBus.bind(instrValidSignal);
+        l2.instrDataOutBus.bind(instrLineSignal);
+        l2.instrReadyBus.bind(instrReadySignal);
+
+        l2.dataAddrBus.bind(dataAddrSignal);
+        l2.dataDataInBus.bind(dataDataSignal);
+        l2.dataWeBus.bind(dataWeSignal);
+        l2.dataValidRequestBus.bind(dataValidSignal);
+        l2.dataDataOutBus.bind(dataLineSignal);
+        l2.dataReadyBus.bind(dataReadySignal);
+
+        l2.memoryAddrBus.bind(ramAddrSignal);
+        l2.memoryDataOutBus.bind(ramDataInSignal);
+        l2.memoryWeBus.bind(ramWeSignal);
+        l2.memoryValidRequestBus.bind(ramValidSignal);
+        l2.memoryDataInBus.bind(ramDataOutSignal);
+        l2.memoryReadyBus.bind(ramReadySignal);
+
+        ram.clock.bind(clock);
+        ram.addressBus.bind(ramAddrSignal);
+        ram.dataInBus.bind(ramDataInSignal);
+        ram.weBus.bind(ramWeSignal);
+        ram.validRequestBus.bind(ramValidSignal);
+        ram.dataOutBus.bind(ramDataOutSignal);
+        ram.readyBus.bind(ramReadySignal);
+    }
+};
+
+template <MappingType mappingType> struct TestMappingType {
+    static constexpr MappingType value = mappingType;
+};
+
+using MappingTypes =
+    ::testing::Types<TestMappingType<MappingType::Direct>, TestMappingType<MappingType::Fully_Associative>>;
+
+TYPED_TEST_SUITE(L2CacheTests, MappingTypes);
+
+TYPED_TEST(L2CacheTests, ReadReturnsDataWrittenBefore) {
+    TestFixture::dataCache.requests = {{0x104, 0xDEADBEEF, true}, {0x100, 0, false}};
+    sc_start(1, SC_MS);
+
+    ASSERT_EQ(TestFixture::dataCache.linesRead.size(), 1);
+    auto& line = TestFixture::dataCache.linesRead.at(0);
+    ASSERT_EQ(line.size(), 64);
+    ASSERT_EQ(line.at(4), 0xEF);
+    ASSERT_EQ(line.at(5), 0xBE);
+    ASSERT_EQ(line.at(6), 0xAD);
+    ASSERT_EQ(line.at(7), 0xDE);
+    ASSERT_EQ(line.at(0), 0);
+}
+
+TYPED_TEST(L2CacheTests, WriteToPresentLineUpdatesL2Copy) {
+    TestFixture::dataCache.requests = {{0x100, 0, false}, {0x108, 0x01020304, true}, {0x100, 0, false}};
+    sc_start(1, SC_MS);
+
+    ASSERT_EQ(TestFixture::dataCache.linesRead.size(), 2);
+    ASSERT_EQ(TestFixture::dataCache.linesRead.at(1).at(8), 0x04);
+    ASSERT_EQ(TestFixture::dataCache.linesRead.at(1).at(11), 0x01);
+    ASSERT_EQ(TestFixture::l2.dataStatistics.accesses, 3);
+    ASSERT_EQ(TestFixture::l2.dataStatistics.misses, 1);
+    ASSERT_EQ(TestFixture::l2.dataStatistics.hits, 2);
+}
+
+TYPED_TEST(L2CacheTests, InstructionReadSpanningTwoL2LinesCountsAsSingleMiss) {
+    TestFixture::instructionCache.requests = {{0xF0000000, 0, false}, {0xF0000040, 0, false}};
+    sc_start(1, SC_MS);
+
+    ASSERT_EQ(TestFixture::instructionCache.linesRead.size(), 2);
+    ASSERT_EQ(TestFixture::instructionCache.linesRead.at(0).size(), 128);
+    ASSERT_EQ(TestFixture::l2.instructionStatistics.accesses, 2);
+    ASSERT_EQ(TestFixture::l2.instructionStatistics.misses, 1);
+    ASSERT_EQ(TestFixture::l2.instructionStatistics.hits, 1);
+    ASSERT_EQ(TestFixture::l2.dataStatistics.accesses, 0);
+}
+
+TYPED_TEST(L2CacheTests, SimultaneousRequestsAreBothServedAndCauseContention) {
+    TestFixture::instructionCache.requests = {{0xF0000000, 0, false}};
+    TestFixture::dataCache.requests = {{0x200, 0, false}};
+    sc_start(1, SC_MS);
+
+    ASSERT_EQ(TestFixture::instructionCache.linesRead.size(), 1);
+    ASSERT_EQ(TestFixture::dataCache.linesRead.size(), 1);
+    ASSERT_EQ(TestFixture::l2.instructionStatistics.accesses, 1);
+    ASSERT_EQ(TestFixture::l2.dataStatistics.accesses, 1);
+    // the instruction side wins the first tie, so only the data side has to wait
+    ASSERT_EQ(TestFixture::l2.instructionStatistics.contentionStallCycles, 0);
+    ASSERT_GT(TestFixture::l2.dataStatistics.contentionStallCycles, 0);
+    ASSERT_GT(TestFixture::dataCache.cycleLastRequestFinished, TestFixture::instructionCache.cycleLastRequestFinished);
+}
+
+TYPED_TEST(L2CacheTests, ArbiterAlternatesBetweenWaitingSides) {
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        TestFixture::instructionCache.requests.push_back({0xF0000000 + i * 0x1000, 0, false});
+        TestFixture::dataCache.requests.push_back({i * 0x1000, 0, false});
+    }
+    sc_start(1, SC_MS);
+
+    ASSERT_EQ(TestFixture::instructionCache.linesRead.size(), 4);
+    ASSERT_EQ(TestFixture::dataCache.linesRead.size(), 4);
+    // neither side is starved: both have to wait for the other one at some point
+    ASSERT_GT(TestFixture::l2.instructionStatistics.contentionStallCycles, 0);
+    ASSERT_GT(TestFixture::l2.dataStatistics.contentionStallCycles, 0);
+}
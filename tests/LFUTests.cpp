@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "../src/Simulation/Policy/LFUPolicy.h"
+#include "Utils.h"
+
+#include <cstdint>
+
+TEST(LFUPolicyTests, LFUPolicyEvictsLeastFrequentlyUsed) {
+    LFUPolicy<std::uint32_t> lfuPolicy{4};
+    for (std::uint32_t i = 0; i < 4; ++i)
+        lfuPolicy.logUse(i);
+    lfuPolicy.logUse(0);
+    lfuPolicy.logUse(0);
+    lfuPolicy.logUse(1);
+    lfuPolicy.logUse(3);
+    ASSERT_EQ(2, lfuPolicy.pop());
+    lfuPolicy.logUse(2);
+    ASSERT_EQ(2, lfuPolicy.pop()); // a filled cacheline starts from scratch
+}
+
+TEST(LFUPolicyTests, LFUPolicyEvictsInFillOrderOnEqualFrequency) {
+    LFUPolicy<std::uint32_t> lfuPolicy{4};
+    for (std::uint32_t i = 0; i < 4; ++i)
+        lfuPolicy.logUse(i);
+    ASSERT_EQ(0, lfuPolicy.pop());
+    ASSERT_EQ(1, lfuPolicy.pop());
+}
+
+TEST(LFUPolicyTests, LFUPolicyAgingLetsFormerlyHotCachelinesGo) {
+    constexpr std::uint32_t size = 4;
+    LFUPolicy<std::uint32_t> lfuPolicy{size};
+    for (std::uint32_t i = 0; i < size; ++i)
+        lfuPolicy.logUse(i);
+    for (int i = 0; i < 10; ++i)
+        lfuPolicy.logUse(0); // hot for a while
+    // then cacheline 1 is used a bit more than once in a while, long enough for several agings
+    for (std::size_t i = 0; i < 4 * LFUPolicy<std::uint32_t>::agingInterval * size; ++i) {
+        lfuPolicy.logUse(i % 2 == 0 ? 1 : 2 + (i / 2) % 2);
+    }
+    lfuPolicy.logUse(1);
+    ASSERT_EQ(0, lfuPolicy.pop());
+}
+
+TEST(LFUPolicyTests, LFUPolicyEvictsLowerCountBeforeAgingFirstOnEqualFrequency) {
+    constexpr std::uint32_t size = 3;
+    LFUPolicy<std::uint32_t> lfuPolicy{size};
+    for (std::uint32_t i = 0; i < size; ++i)
+        lfuPolicy.logUse(i);
+    lfuPolicy.logUse(0);
+    lfuPolicy.logUse(0); // count 3, reached before cacheline 1 reaches its count
+    lfuPolicy.logUse(1); // count 2
+    // cacheline 2 fills up the uses until the aging, which halves the counts of cachelines 0 and 1 to 1
+    for (std::size_t use = 2 * size; use < LFUPolicy<std::uint32_t>::agingInterval * size; ++use)
+        lfuPolicy.logUse(2);
+    ASSERT_EQ(1, lfuPolicy.pop());
+    lfuPolicy.logUse(1); // a filled cacheline reaches count 1 after both aged ones
+    ASSERT_EQ(0, lfuPolicy.pop());
+    ASSERT_EQ(1, lfuPolicy.pop());
+}
+
+TEST(LFUPolicyTests, LFUPolicyNeverEvictsMostRecentlyUsedAfterFill) {
+    LFUPolicy<std::uint32_t> lfuPolicy{100};
+    for (std::uint32_t i = 0; i < 100; ++i)
+        lfuPolicy.logUse(i);
+    auto accesses = generateRandomVector(10000, 100);
+    for (auto access : accesses) {
+        lfuPolicy.logUse(access);
+        auto victim = lfuPolicy.pop();
+        ASSERT_LT(victim, 100);
+        lfuPolicy.logUse(victim);
+    }
+}
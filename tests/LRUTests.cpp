@@ -17,7 +17,8 @@ TEST(LRUPolicyTests, LRUPolicyAddingSingleValueReturnsSameValue) {
 
 TEST(LRUPolicyTests, LRUPolicyAddingMultipleUniqueValuesReturnsInCorrectOrder) {
     LRUPolicy<std::uint64_t> LRUPolicy{10000};
-    auto randomVec = makeVectorUniqueNoOrderPreserve(generateRandomVector(10000));
+    // keys are cacheline indices and therefore have to be smaller than the capacity
+    auto randomVec = makeVectorUniqueNoOrderPreserve(generateRandomVector(10000, 10000));
     std::for_each(randomVec.cbegin(), randomVec.cend(), [&LRUPolicy](std::uint64_t val) { LRUPolicy.logUse(val); });
     ASSERT_EQ(randomVec.size(), LRUPolicy.getSize());
     for (std::size_t i = 0; i < randomVec.size(); ++i) {
@@ -63,3 +64,42 @@ TEST(LRUPolicyTests, LRUPolicyAddingManyNonUniqueValuesReturnsInCorrectOrder) {
         inputListIt++;
     }
 }
+
+TEST(LRUPolicyTests, LRUPolicyPoppedIndexCanBeLoggedAgain) {
+    LRUPolicy<std::uint32_t> LRUPolicy{4};
+    for (std::uint32_t i = 0; i < 4; ++i)
+        LRUPolicy.logUse(i);
+    LRUPolicy.logUse(0);
+    ASSERT_EQ(1, LRUPolicy.pop());
+    LRUPolicy.logUse(1); // the freed cacheline gets refilled
+    ASSERT_EQ(4, LRUPolicy.getSize());
+    ASSERT_EQ(2, LRUPolicy.pop());
+    ASSERT_EQ(3, LRUPolicy.pop());
+    ASSERT_EQ(0, LRUPolicy.pop());
+    ASSERT_EQ(1, LRUPolicy.pop());
+    ASSERT_EQ(0, LRUPolicy.getSize());
+}
+
+TEST(LRUPolicyTests, LRUPolicyBehavesLikeCacheUnderRandomHitsAndMisses) {
+    constexpr std::uint32_t size = 64;
+    LRUPolicy<std::uint32_t> LRUPolicy{size};
+    std::vector<std::uint32_t> recency{}; // most recently used at the back
+    for (std::uint32_t i = 0; i < size; ++i) {
+        LRUPolicy.logUse(i);
+        recency.push_back(i);
+    }
+    auto accesses = generateRandomVector(10000, size + 1);
+    for (auto access : accesses) {
+        if (access == size) { // miss: evict and refill
+            auto victim = LRUPolicy.pop();
+            ASSERT_EQ(recency.front(), victim);
+            recency.erase(recency.begin());
+            LRUPolicy.logUse(victim);
+            recency.push_back(victim);
+        } else { // hit
+            LRUPolicy.logUse(access);
+            recency.erase(std::find(recency.begin(), recency.end(), access));
+            recency.push_back(access);
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include "../src/Simulation/LoadStoreQueue.h"
+
+#include <cstddef>
+#include <vector>
+
+TEST(LoadStoreQueueTests, IsFullAtCapacity) {
+    LoadStoreQueue queue{2};
+    ASSERT_TRUE(queue.isEmpty());
+    queue.push(0, Request{0, 0, 0});
+    ASSERT_FALSE(queue.isFull());
+    queue.push(1, Request{4, 0, 0});
+    ASSERT_TRUE(queue.isFull());
+}
+
+TEST(LoadStoreQueueTests, LoadOvertakesOlderStoreToIndependentAddress) {
+    LoadStoreQueue queue{4};
+    queue.push(0, Request{0, 1, 1});
+    queue.push(1, Request{64, 0, 0});
+    ASSERT_EQ(queue.nextForCache(), 1);
+}
+
+TEST(LoadStoreQueueTests, LoadTakesDataOfYoungestOlderStoreToSameAddress) {
+    LoadStoreQueue queue{4};
+    queue.push(0, Request{8, 1, 1});
+    queue.push(1, Request{8, 2, 1});
+    queue.push(2, Request{8, 0, 0});
+    ASSERT_TRUE(queue.forward(2));
+    ASSERT_EQ(queue.at(2).request.data, 2);
+    ASSERT_TRUE(queue.at(2).isDone);
+    ASSERT_EQ(queue.getForwardedLoads(), 1);
+}
+
+TEST(LoadStoreQueueTests, LoadWaitsForPartiallyOverlappingStore) {
+    LoadStoreQueue queue{4};
+    queue.push(0, Request{8, 1, 1});
+    queue.push(1, Request{10, 0, 0});
+    ASSERT_FALSE(queue.forward(1));
+    // only the store may go, the load has to read what it writes
+    ASSERT_EQ(queue.nextForCache(), 0);
+    queue.at(0).isIssued = true;
+    ASSERT_EQ(queue.nextForCache(), queue.getSize());
+
+    queue.at(0).isDone = true;
+    ASSERT_EQ(queue.nextForCache(), 1);
+}
+
+TEST(LoadStoreQueueTests, StoreWaitsForOlderLoadOfSameAddress) {
+    LoadStoreQueue queue{4};
+    queue.push(0, Request{8, 0, 0});
+    queue.push(1, Request{8, 1, 1});
+    queue.at(0).isIssued = true;
+    ASSERT_EQ(queue.nextForCache(), queue.getSize());
+
+    queue.at(0).isDone = true;
+    ASSERT_EQ(queue.nextForCache(), 1);
+}
+
+TEST(LoadStoreQueueTests, RetiresDoneRequestsInOrderUpToMaxCount) {
+    LoadStoreQueue queue{4};
+    for (std::size_t i = 0; i < 4; ++i) {
+        queue.push(i, Request{static_cast<std::uint32_t>(4 * i), 0, 0});
+    }
+    queue.at(0).isDone = true;
+    queue.at(1).isDone = true;
+    queue.at(3).isDone = true;
+
+    std::vector<std::size_t> retired;
+    auto collect = [&retired](const LoadStoreQueue::Entry& entry) { retired.push_back(entry.index); };
+    ASSERT_EQ(queue.retire(1, collect), 1);
+    // the third request is not done yet, the fourth has to wait for it
+    ASSERT_EQ(queue.retire(4, collect), 1);
+    ASSERT_EQ(retired, (std::vector<std::size_t>{0, 1}));
+    ASSERT_EQ(queue.getSize(), 2);
+}
@@ -0,0 +1,158 @@
+#include "../src/Simulation/DRAM.h"
+#include "../src/Simulation/MemoryController.h"
+#include "../src/Simulation/RAM.h"
+#include "Utils.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <systemc>
+#include <vector>
+using namespace sc_core;
+
+constexpr std::uint32_t beatsPerRead = 64 / 16;
+
+template <typename MemoryType> class MemoryControllerTestsBase : public testing::Test {
+  public:
+    MemoryRequester requester{"Requester", beatsPerRead};
+    MemoryController controller;
+    MemoryType memory;
+
+    // Requester <-> Controller
+    sc_signal<std::uint32_t> SC_NAMED(requestAddrSignal);
+    sc_signal<std::uint32_t> SC_NAMED(requestDataSignal);
+    sc_signal<bool> SC_NAMED(requestWeSignal);
+    sc_signal<bool> SC_NAMED(requestValidSignal);
+    sc_signal<BusBeat> SC_NAMED(requestBeatSignal);
+    sc_signal<bool> SC_NAMED(requestReadySignal);
+
+    // Controller <-> Memory
+    sc_signal<std::uint32_t> SC_NAMED(memoryAddrSignal);
+    sc_signal<std::uint32_t> SC_NAMED(memoryDataSignal);
+    sc_signal<bool> SC_NAMED(memoryWeSignal);
+    sc_signal<bool> SC_NAMED(memoryValidSignal);
+    sc_signal<BusBeat> SC_NAMED(memoryBeatSignal);
+    sc_signal<bool> SC_NAMED(memoryReadySignal);
+
+    sc_clock clock{"clk", sc_time(1, SC_NS)};
+
+    template <typename... MemoryArgs>
+    MemoryControllerTestsBase(const MemoryControllerOptions& options, const DRAMOptions& dram,
+                              MemoryArgs... memoryArgs)
+        : controller{"Controller", options, beatsPerRead, dram}, memory{"Memory", memoryArgs...} {}
+
+    void SetUp() override {
+        requester.clock.bind(clock);
+        requester.addrBus.bind(requestAddrSignal);
+        requester.dataOutBus.bind(requestDataSignal);
+        requester.weBus.bind(requestWeSignal);
+        requester.validRequestBus.bind(requestValidSignal);
+        requester.dataInBus.bind(requestBeatSignal);
+        requester.readyBus.bind(requestReadySignal);
+
+        controller.clock.bind(clock);
+        controller.addressBus.bind(requestAddrSignal);
+        controller.dataInBus.bind(requestDataSignal);
+        controller.weBus.bind(requestWeSignal);
+        controller.validRequestBus.bind(requestValidSignal);
+        controller.dataOutBus.bind(requestBeatSignal);
+        controller.readyBus.bind(requestReadySignal);
+
+        controller.memoryAddrBus.bind(memoryAddrSignal);
+        controller.memoryDataOutBus.bind(memoryDataSignal);
+        controller.memoryWeBus.bind(memoryWeSignal);
+        controller.memoryValidRequestBus.bind(memoryValidSignal);
+        controller.memoryDataInBus.bind(memoryBeatSignal);
+        controller.memoryReadyBus.bind(memoryReadySignal);
+
+        memory.clock.bind(clock);
+        memory.addressBus.bind(memoryAddrSignal);
+        memory.dataInBus.bind(memoryDataSignal);
+        memory.weBus.bind(memoryWeSignal);
+        memory.validRequestBus.bind(memoryValidSignal);
+        memory.dataOutBus.bind(memoryBeatSignal);
+        memory.readyBus.bind(memoryReadySignal);
+    }
+};
+
+class RAMControllerTests : public MemoryControllerTestsBase<RAM> {
+  public:
+    RAMControllerTests()
+        : MemoryControllerTestsBase{MemoryControllerOptions{8, 0, 0}, DRAMOptions{}, 20u, beatsPerRead} {}
+};
+
+class FullRAMControllerTests : public MemoryControllerTestsBase<RAM> {
+  public:
+    FullRAMControllerTests()
+        : MemoryControllerTestsBase{MemoryControllerOptions{1, 0, 0}, DRAMOptions{}, 20u, beatsPerRead} {}
+};
+
+// 2 banks of 256 byte rows: row 0 of bank 0 is [0,256), row 0 of bank 1 [256,512), row 1 of bank 0 [512,768) ...
+class DRAMControllerTests : public MemoryControllerTestsBase<DRAM> {
+  public:
+    static DRAMOptions dramOptions() { return DRAMOptions{1, 1, 2, 256, 2, 3, 4, 10, 0}; }
+
+    DRAMControllerTests()
+        : MemoryControllerTestsBase{MemoryControllerOptions{8, 0, 0}, dramOptions(), dramOptions(), beatsPerRead} {}
+};
+
+TEST_F(RAMControllerTests, WritesArePostedAndReadAfterThemSeesTheirData) {
+    requester.requests = {{0x104, 0x04030201, true}, {0x108, 0x08070605, true}, {0x100, 0, false}};
+    sc_start(1, SC_MS);
+
+    // the writes only had to get into the queue, not into the RAM
+    ASSERT_EQ(requester.latencies.at(0), 1);
+    ASSERT_EQ(requester.latencies.at(1), 1);
+    ASSERT_GT(requester.latencies.at(2), 20);
+
+    ASSERT_EQ(requester.linesRead.size(), 1);
+    ASSERT_EQ(requester.linesRead.at(0).at(0), 0);
+    ASSERT_EQ(requester.linesRead.at(0).at(4), 0x01);
+    ASSERT_EQ(requester.linesRead.at(0).at(11), 0x08);
+
+    const auto& statistics = controller.getStatistics();
+    ASSERT_EQ(statistics.writes, 2);
+    ASSERT_EQ(statistics.reads, 1);
+    ASSERT_EQ(statistics.bursts, 1); // the second write followed the first one
+    ASSERT_EQ(statistics.reorderedRequests, 0);
+    ASSERT_EQ(statistics.bytesTransferred, 2 * 4 + 64);
+}
+
+TEST_F(RAMControllerTests, ReadBypassesQueuedWritesToOtherLines) {
+    requester.requests = {{0x1000, 1, true}, {0x2000, 2, true}, {0x3000, 3, true}, {0x0, 0, false}};
+    sc_start(1, SC_MS);
+
+    const auto& statistics = controller.getStatistics();
+    ASSERT_EQ(statistics.writes, 3);
+    ASSERT_EQ(statistics.reads, 1);
+    ASSERT_EQ(statistics.reorderedRequests, 1); // the read went before the writes to 0x2000 and 0x3000
+    ASSERT_EQ(statistics.writeDrains, 0);       // 3 writes stay below the high watermark of 6
+    // it only had to wait for the write already sent, not for all three
+    ASSERT_LT(requester.latencies.at(3), 2 * 21 + 4);
+    ASSERT_EQ(memory.dataMemory.readWord(0x3000), 3);
+}
+
+TEST_F(FullRAMControllerTests, RequestsWaitForAFreeQueueSlot) {
+    requester.requests = {{0x1000, 1, true}, {0x2000, 2, true}, {0x3000, 3, true}};
+    sc_start(1, SC_MS);
+
+    const auto& statistics = controller.getStatistics();
+    ASSERT_EQ(statistics.maxOccupancy, 1);
+    ASSERT_GT(statistics.fullStallCycles, 0);
+    ASSERT_EQ(requester.latencies.at(0), 1);
+    ASSERT_GT(requester.latencies.at(2), 1);
+}
+
+TEST_F(DRAMControllerTests, WriteHittingOpenRowGoesFirst) {
+    // while the write to row 0 of bank 0 is done, one to row 1 and another one to row 0 of bank 0 arrive
+    requester.requests = {{0x0, 1, true}, {0x200, 2, true}, {0x40, 3, true}};
+    sc_start(1, SC_MS);
+
+    const auto& controllerStatistics = controller.getStatistics();
+    ASSERT_EQ(controllerStatistics.reorderedRequests, 1);
+
+    // in arrival order both the write to 0x200 and the one to 0x40 would have been row conflicts
+    const auto& dramStatistics = memory.getStatistics();
+    ASSERT_EQ(dramStatistics.accesses, 3);
+    ASSERT_EQ(dramStatistics.rowMisses, 1);
+    ASSERT_EQ(dramStatistics.rowHits, 1);
+    ASSERT_EQ(dramStatistics.rowConflicts, 1);
+}
@@ -13,7 +13,7 @@ protected:
     sc_signal<std::uint32_t> addressSignal;
     sc_signal<bool> validRequestSignal;
 
-    sc_signal<sc_dt::sc_bv<128>> dataOutSignal;
+    sc_signal<BusBeat> dataOutSignal;
     sc_signal<bool> readySignal;
 
     sc_clock clock{"clk", sc_time(1, SC_NS)};
@@ -49,10 +49,10 @@ TEST_F(MemoryTests, MemoryWriteAndReadSameAddress) {
 
     sc_start(1, SC_MS);
 
-    ASSERT_EQ(dataOutSignal.read().range(7, 0), sc_dt::sc_bv<8>(valueInBytes[0]));
-    ASSERT_EQ(dataOutSignal.read().range(15, 8), sc_dt::sc_bv<8>(valueInBytes[1]));
-    ASSERT_EQ(dataOutSignal.read().range(23, 16), sc_dt::sc_bv<8>(valueInBytes[2]));
-    ASSERT_EQ(dataOutSignal.read().range(31, 24), sc_dt::sc_bv<8>(valueInBytes[3]));
+    ASSERT_EQ(dataOutSignal.read().bytes[0], valueInBytes[0]);
+    ASSERT_EQ(dataOutSignal.read().bytes[1], valueInBytes[1]);
+    ASSERT_EQ(dataOutSignal.read().bytes[2], valueInBytes[2]);
+    ASSERT_EQ(dataOutSignal.read().bytes[3], valueInBytes[3]);
 }
 
 TEST_F(MemoryTests, MemoryOverwriteAddressWithZeroAndRead) {
@@ -78,10 +78,10 @@ TEST_F(MemoryTests, MemoryOverwriteAddressWithZeroAndRead) {
 
     sc_start(1, SC_MS);
 
-    ASSERT_EQ(dataOutSignal.read().range(7, 0), sc_dt::sc_bv<8>(static_cast<uint8_t>(value)));
-    ASSERT_EQ(dataOutSignal.read().range(15, 8), sc_dt::sc_bv<8>(0));
-    ASSERT_EQ(dataOutSignal.read().range(23, 16), sc_dt::sc_bv<8>(0));
-    ASSERT_EQ(dataOutSignal.read().range(31, 24), sc_dt::sc_bv<8>(0));
+    ASSERT_EQ(dataOutSignal.read().bytes[0], static_cast<uint8_t>(value));
+    ASSERT_EQ(dataOutSignal.read().bytes[1], 0);
+    ASSERT_EQ(dataOutSignal.read().bytes[2], 0);
+    ASSERT_EQ(dataOutSignal.read().bytes[3], 0);
 }
 
 TEST_F(MemoryTests, ReadBlankAddress) {
@@ -91,5 +91,5 @@ TEST_F(MemoryTests, ReadBlankAddress) {
 
     sc_start(1, SC_MS);
 
-    ASSERT_EQ(dataOutSignal.read(), sc_dt::sc_bv<128>(0));
+    ASSERT_EQ(dataOutSignal.read(), BusBeat{});
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include "../src/Simulation/Policy/ARCPolicy.h"
+#include "../src/Simulation/Policy/LRUPolicy.h"
+#include "../src/Simulation/Policy/OPTPolicy.h"
+#include "../src/Simulation/Policy/RRIPPolicy.h"
+#include "Utils.h"
+
+#include <cstdint>
+#include <vector>
+
+TEST(OPTPolicyTests, OPTPolicyEvictsCachelineUsedFarthestInTheFuture) {
+    const std::vector<std::uint32_t> blocks{0, 1, 2, 0, 1, 3, 0, 1, 2};
+    OPTPolicy<std::uint32_t> optPolicy{3, blocks};
+    // blocks 0 - 2 fill cachelines 0 - 2, 0 and 1 hit. For block 3, block 2 is used again last
+    ASSERT_EQ(2, countHits(optPolicy, 3, std::vector<std::uint32_t>(blocks.begin(), blocks.begin() + 5)));
+    ASSERT_EQ(2, optPolicy.pop());
+}
+
+TEST(OPTPolicyTests, OPTPolicyPrefersBlocksNeverUsedAgain) {
+    const std::vector<std::uint32_t> blocks{0, 1, 2, 3, 0};
+    OPTPolicy<std::uint32_t> optPolicy{2, blocks};
+    ASSERT_EQ(1, countHits(optPolicy, 2, blocks));
+}
+
+TEST(OPTPolicyTests, OPTPolicyIsNeverWorseThanOtherPolicies) {
+    auto accesses = generateRandomVector(20000, 300);
+    std::vector<std::uint32_t> blocks(accesses.cbegin(), accesses.cend());
+    for (std::size_t size : {1, 16, 100}) {
+        OPTPolicy<std::uint32_t> optPolicy{size, blocks};
+        LRUPolicy<std::uint32_t> lruPolicy{size};
+        ARCPolicy<std::uint32_t> arcPolicy{size};
+        RRIPPolicy<std::uint32_t> rripPolicy{size, RRIPPolicy<std::uint32_t>::Insertion::Dynamic};
+        const auto optHits = countHits(optPolicy, size, blocks);
+        ASSERT_GE(optHits, countHits(lruPolicy, size, blocks));
+        ASSERT_GE(optHits, countHits(arcPolicy, size, blocks));
+        ASSERT_GE(optHits, countHits(rripPolicy, size, blocks));
+    }
+}
+
+TEST(OPTPolicyTests, OPTPolicyKeepsMostOfLoopLargerThanCache) {
+    const auto blocks = cyclicAccesses(80, 100);
+    OPTPolicy<std::uint32_t> optPolicy{64, blocks};
+    // per round of 80 accesses, only about 80 - 64 accesses can miss
+    ASSERT_GE(countHits(optPolicy, 64, blocks), 99 * (64 - 16));
+}
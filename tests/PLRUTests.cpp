@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include "../src/Simulation/Policy/BitPLRUPolicy.h"
+#include "../src/Simulation/Policy/TreePLRUPolicy.h"
+#include "Utils.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+
+TEST(TreePLRUPolicyTests, TreePLRUPolicyEvictsInRoundRobinWhenNothingIsReused) {
+    TreePLRUPolicy<std::uint32_t> plruPolicy{8};
+    for (std::uint32_t i = 0; i < 8; ++i)
+        plruPolicy.logUse(i);
+    // after filling in order, the tree always points to the half that was filled first
+    ASSERT_EQ(0, plruPolicy.pop());
+    ASSERT_EQ(4, plruPolicy.pop());
+    ASSERT_EQ(2, plruPolicy.pop());
+    ASSERT_EQ(6, plruPolicy.pop());
+}
+
+TEST(TreePLRUPolicyTests, TreePLRUPolicyNeverEvictsMostRecentlyUsed) {
+    TreePLRUPolicy<std::uint32_t> plruPolicy{64};
+    for (std::uint32_t i = 0; i < 64; ++i)
+        plruPolicy.logUse(i);
+    auto accesses = generateRandomVector(10000, 64);
+    for (auto access : accesses) {
+        plruPolicy.logUse(access);
+        ASSERT_NE(access, plruPolicy.pop());
+    }
+}
+
+TEST(TreePLRUPolicyTests, TreePLRUPolicyOnlyEvictsExistingCachelinesIfSizeIsNoPowerOfTwo) {
+    TreePLRUPolicy<std::uint32_t> plruPolicy{5};
+    std::unordered_set<std::uint32_t> evicted{};
+    for (int i = 0; i < 100; ++i) {
+        auto victim = plruPolicy.pop();
+        ASSERT_LT(victim, 5);
+        evicted.insert(victim);
+    }
+    ASSERT_EQ(evicted.size(), 5); // every cacheline gets its turn
+}
+
+TEST(BitPLRUPolicyTests, BitPLRUPolicyEvictsLowestUnusedCacheline) {
+    BitPLRUPolicy<std::uint32_t> plruPolicy{4};
+    plruPolicy.logUse(0);
+    plruPolicy.logUse(2);
+    ASSERT_EQ(1, plruPolicy.pop());
+    ASSERT_EQ(3, plruPolicy.pop()); // setting the last bit clears all others
+    ASSERT_EQ(0, plruPolicy.pop());
+}
+
+TEST(BitPLRUPolicyTests, BitPLRUPolicyNeverEvictsMostRecentlyUsed) {
+    BitPLRUPolicy<std::uint32_t> plruPolicy{100};
+    auto accesses = generateRandomVector(10000, 100);
+    for (auto access : accesses) {
+        plruPolicy.logUse(access);
+        ASSERT_NE(access, plruPolicy.pop());
+    }
+}
+
+TEST(BitPLRUPolicyTests, BitPLRUPolicyOnlyEvictsExistingCachelinesAcrossWords) {
+    BitPLRUPolicy<std::uint32_t> plruPolicy{130};
+    std::unordered_set<std::uint32_t> evicted{};
+    for (int i = 0; i < 1000; ++i) {
+        auto victim = plruPolicy.pop();
+        ASSERT_LT(victim, 130);
+        evicted.insert(victim);
+    }
+    ASSERT_EQ(evicted.size(), 130);
+}
+
+TEST(BitPLRUPolicyTests, BitPLRUPolicyWithSingleCachelineAlwaysEvictsIt) {
+    BitPLRUPolicy<std::uint32_t> plruPolicy{1};
+    plruPolicy.logUse(0);
+    ASSERT_EQ(0, plruPolicy.pop());
+    ASSERT_EQ(0, plruPolicy.pop());
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include "../src/Simulation/PagedMemory.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+TEST(PagedMemoryTests, UnwrittenMemoryReadsZeroWithoutAllocating) {
+    PagedMemory memory;
+    ASSERT_EQ(memory.readByte(0x12345678), 0);
+    ASSERT_EQ(memory.readWord(0xFFFFFFF0), 0);
+    std::vector<std::uint8_t> line(64, 0xFF);
+    memory.read(0x1000, line.data(), line.size());
+    ASSERT_EQ(line, std::vector<std::uint8_t>(64, 0));
+    ASSERT_EQ(memory.getAllocatedPages(), 0);
+}
+
+TEST(PagedMemoryTests, WordsAreStoredLittleEndian) {
+    PagedMemory memory;
+    memory.writeWord(100, 0x04030201);
+    ASSERT_EQ(memory.readByte(100), 0x01);
+    ASSERT_EQ(memory.readByte(103), 0x04);
+    ASSERT_EQ(memory.readWord(100), 0x04030201);
+    ASSERT_EQ(memory.readWord(102), 0x0403);
+    ASSERT_EQ(memory.getAllocatedPages(), 1);
+}
+
+TEST(PagedMemoryTests, BlockSpanningPagesIsSplitAcrossThem) {
+    PagedMemory memory;
+    std::vector<std::uint8_t> data(PagedMemory::PAGE_SIZE + 32);
+    for (std::size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<std::uint8_t>(i * 7);
+
+    memory.write(PagedMemory::PAGE_SIZE - 16, data.data(), data.size());
+    ASSERT_EQ(memory.getAllocatedPages(), 3);
+
+    std::vector<std::uint8_t> readBack(data.size());
+    memory.read(PagedMemory::PAGE_SIZE - 16, readBack.data(), readBack.size());
+    ASSERT_EQ(readBack, data);
+    ASSERT_EQ(memory.readByte(PagedMemory::PAGE_SIZE - 17), 0);
+}
+
+TEST(PagedMemoryTests, AddressesWrapAroundAtEndOfAddressSpace) {
+    PagedMemory memory;
+    memory.writeWord(0xFFFFFFFE, 0xAABBCCDD);
+    ASSERT_EQ(memory.readByte(0xFFFFFFFF), 0xCC);
+    ASSERT_EQ(memory.readByte(0), 0xBB);
+    ASSERT_EQ(memory.readWord(0xFFFFFFFE), 0xAABBCCDD);
+    ASSERT_EQ(memory.getAllocatedPages(), 2);
+}
+
+TEST(PagedMemoryTests, SubscriptGivesWritableByte) {
+    PagedMemory memory;
+    memory[0x13C] = 0xAB;
+    ASSERT_EQ(memory.readByte(0x13C), 0xAB);
+    ASSERT_EQ(memory[0x13C], 0xAB);
+    ASSERT_EQ(memory.readWord(0x13C), 0xAB);
+}
+
+// writes bytes to a fresh temporary file, removed again once the test is over
+class ImageFile {
+  public:
+    std::string path;
+
+    explicit ImageFile(const std::vector<std::uint8_t>& bytes) {
+        char name[] = "/tmp/PagedMemoryTestsImageXXXXXX";
+        const int fd = mkstemp(name);
+        path = name;
+        if (fd >= 0) {
+            const ssize_t written = write(fd, bytes.data(), bytes.size());
+            (void)written;
+            close(fd);
+        }
+    }
+    ~ImageFile() { std::remove(path.c_str()); }
+};
+
+TEST(PagedMemoryTests, ImageIsReadWithoutAllocating) {
+    std::vector<std::uint8_t> bytes(2 * PagedMemory::PAGE_SIZE);
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+        bytes[i] = static_cast<std::uint8_t>(i * 3);
+    ImageFile file{bytes};
+
+    PagedMemory memory;
+    memory.setImage(std::make_shared<const MemoryImage>(file.path.c_str(), 0x10000));
+    ASSERT_EQ(memory.readByte(0x10001), 3);
+    ASSERT_EQ(memory.readByte(0xFFFF), 0); // below the image
+    ASSERT_EQ(memory.readWord(0x10000 + bytes.size() - 2), 0x0000FDFA); // spanning its end
+
+    std::vector<std::uint8_t> readBack(bytes.size());
+    memory.read(0x10000, readBack.data(), readBack.size());
+    ASSERT_EQ(readBack, bytes);
+    ASSERT_EQ(memory.getAllocatedPages(), 0);
+}
+
+TEST(PagedMemoryTests, WriteCopiesPageFromImage) {
+    std::vector<std::uint8_t> bytes(PagedMemory::PAGE_SIZE, 0x11);
+    ImageFile file{bytes};
+
+    PagedMemory memory;
+    memory.setImage(std::make_shared<const MemoryImage>(file.path.c_str(), 0));
+    memory.writeWord(8, 0xAABBCCDD);
+    ASSERT_EQ(memory.getAllocatedPages(), 1);
+    ASSERT_EQ(memory.readWord(8), 0xAABBCCDD);
+    ASSERT_EQ(memory.readWord(4), 0x11111111); // the rest of the page still holds the image
+}
+
+TEST(PagedMemoryTests, MissingImageThrows) {
+    ASSERT_THROW(MemoryImage("/nonexistent/memory.img", 0), MemoryImageError);
+}
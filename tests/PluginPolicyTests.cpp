@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+
+#include "../src/Simulation/Policy/LRUPolicy.h"
+#include "../src/Simulation/Policy/PluginPolicy.h"
+#include "Utils.h"
+
+#include <cstdint>
+#include <vector>
+
+// LRU_POLICY_PLUGIN is the path of the example plugin in tools/PolicyPlugin, built alongside the tests
+using Plugin = PluginPolicy<std::uint32_t>;
+
+TEST(PluginPolicyTests, PluginPolicyChoosesLikeBuiltInLRU) {
+    auto accesses = generateRandomVector(20000, 300);
+    const std::vector<std::uint32_t> blocks(accesses.cbegin(), accesses.cend());
+    for (std::size_t size : {1, 16, 100}) {
+        Plugin pluginPolicy{size, LRU_POLICY_PLUGIN};
+        LRUPolicy<std::uint32_t> lruPolicy{size};
+        ASSERT_EQ(countHits(lruPolicy, size, blocks), countHits(pluginPolicy, size, blocks));
+        for (std::size_t i = 0; i < size; ++i)
+            ASSERT_EQ(lruPolicy.pop(), pluginPolicy.pop());
+    }
+}
+
+TEST(PluginPolicyTests, PluginPolicyReportsGatesOfPlugin) {
+    Plugin pluginPolicy{256, LRU_POLICY_PLUGIN};
+    ASSERT_EQ(LRUPolicy<std::uint32_t>{256}.calcBasicGates(), pluginPolicy.calcBasicGates());
+}
+
+TEST(PluginPolicyTests, PluginPolicyInstancesAreIndependent) {
+    Plugin first{2, LRU_POLICY_PLUGIN};
+    Plugin second{2, LRU_POLICY_PLUGIN};
+    first.logUse(0);
+    first.logUse(1);
+    second.logUse(1);
+    second.logUse(0);
+    ASSERT_EQ(0, first.pop());
+    ASSERT_EQ(1, second.pop());
+}
+
+TEST(PluginPolicyTests, PluginPolicyRejectsMissingLibrary) {
+    ASSERT_THROW((Plugin{16, "./doesNotExist.so"}), PolicyPluginError);
+}
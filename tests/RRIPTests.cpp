@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include "../src/Simulation/Policy/RRIPPolicy.h"
+#include "Utils.h"
+
+#include <cstdint>
+
+using RRIP = RRIPPolicy<std::uint32_t>;
+
+TEST(RRIPPolicyTests, SRRIPPolicyEvictsInFillOrderWhenNothingIsReused) {
+    RRIP rripPolicy{4, RRIP::Insertion::Static};
+    for (std::uint32_t i = 0; i < 4; ++i)
+        rripPolicy.logUse(i);
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        auto victim = rripPolicy.pop();
+        ASSERT_EQ(i, victim);
+        rripPolicy.logUse(victim);
+    }
+}
+
+TEST(RRIPPolicyTests, SRRIPPolicyKeepsReusedCachelinesDuringScan) {
+    RRIP rripPolicy{4, RRIP::Insertion::Static};
+    for (std::uint32_t i = 0; i < 4; ++i)
+        rripPolicy.logUse(i);
+    rripPolicy.logUse(0);
+    rripPolicy.logUse(1);
+    // the scan replaces the cachelines that were never reused until the reused ones have aged
+    for (int i = 0; i < 4; ++i) {
+        auto victim = rripPolicy.pop();
+        ASSERT_TRUE(victim == 2 || victim == 3);
+        rripPolicy.logUse(victim);
+    }
+}
+
+TEST(RRIPPolicyTests, BRRIPPolicyKeepsPartOfThrashingWorkingSet) {
+    // a cyclic working set larger than the cache makes every insertion with the same prediction miss
+    const auto blocks = cyclicAccesses(12, 200);
+    RRIP srripPolicy{8, RRIP::Insertion::Static};
+    RRIP brripPolicy{8, RRIP::Insertion::Bimodal};
+    ASSERT_EQ(0, countHits(srripPolicy, 8, blocks));
+    ASSERT_GT(countHits(brripPolicy, 8, blocks), blocks.size() / 4);
+}
+
+TEST(RRIPPolicyTests, DRRIPPolicyFollowsTheBetterInsertion) {
+    const auto blocks = cyclicAccesses(96, 200);
+    RRIP srripPolicy{64, RRIP::Insertion::Static};
+    RRIP brripPolicy{64, RRIP::Insertion::Bimodal};
+    RRIP drripPolicy{64, RRIP::Insertion::Dynamic};
+    const auto srripHits = countHits(srripPolicy, 64, blocks);
+    const auto brripHits = countHits(brripPolicy, 64, blocks);
+    const auto drripHits = countHits(drripPolicy, 64, blocks);
+    ASSERT_LT(srripHits, brripHits);
+    ASSERT_GT(drripHits, srripHits + (brripHits - srripHits) / 2);
+}
+
+TEST(RRIPPolicyTests, RRIPPoliciesNeverEvictMostRecentlyUsed) {
+    for (auto insertion : {RRIP::Insertion::Static, RRIP::Insertion::Bimodal, RRIP::Insertion::Dynamic}) {
+        for (std::uint32_t rrpvBits : {1u, 2u, 3u}) {
+            RRIP rripPolicy{100, insertion, rrpvBits};
+            for (std::uint32_t i = 0; i < 100; ++i)
+                rripPolicy.logUse(i);
+            auto accesses = generateRandomVector(10000, 100);
+            for (auto access : accesses) {
+                rripPolicy.logUse(access);
+                auto victim = rripPolicy.pop();
+                ASSERT_NE(access, victim);
+                ASSERT_LT(victim, 100);
+                rripPolicy.logUse(victim);
+            }
+        }
+    }
+}
+
+TEST(RRIPPolicyTests, RRIPPolicyWithSingleCachelineAlwaysEvictsIt) {
+    RRIP rripPolicy{1, RRIP::Insertion::Dynamic};
+    rripPolicy.logUse(0);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(0, rripPolicy.pop());
+        rripPolicy.logUse(0);
+    }
+}
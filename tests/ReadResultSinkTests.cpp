@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include "../src/Simulation/ReadResultSink.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+// a fresh temporary file for the sink to write to, removed again once the test is over
+class ResultFile {
+  public:
+    std::string path;
+
+    ResultFile() {
+        char name[] = "/tmp/ReadResultSinkTestsXXXXXX";
+        const int fd = mkstemp(name);
+        path = name;
+        if (fd >= 0)
+            close(fd);
+    }
+    ~ResultFile() { std::remove(path.c_str()); }
+
+    std::string contents() const {
+        std::ifstream file{path, std::ios::binary};
+        return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    }
+};
+
+TEST(ReadResultSinkTests, CSVSinkWritesOneLinePerRead) {
+    ResultFile file;
+    {
+        CSVReadResultSink sink{file.path.c_str()};
+        sink.record(0, 10, 104);
+        sink.record(3, 4294967295u, 213);
+    }
+    ASSERT_EQ(file.contents(), "Index,Data,Cycle\n0,10,104\n3,4294967295,213\n");
+}
+
+TEST(ReadResultSinkTests, BinarySinkWritesPackedLittleEndianRecords) {
+    ResultFile file;
+    {
+        BinaryReadResultSink sink{file.path.c_str()};
+        sink.record(0x0102, 0xAABBCCDD, 0x0100000003);
+        sink.record(7, 1, 2);
+    }
+    const std::string bytes = file.contents();
+    ASSERT_EQ(bytes.size(), 2 * BinaryReadResultSink::RECORD_SIZE);
+    const std::vector<std::uint8_t> first(bytes.begin(), bytes.begin() + BinaryReadResultSink::RECORD_SIZE);
+    ASSERT_EQ(first, (std::vector<std::uint8_t>{0x02, 0x01, 0, 0, 0, 0, 0, 0, 0xDD, 0xCC, 0xBB, 0xAA, 0x03, 0, 0, 0,
+                                                0x01, 0, 0, 0}));
+    ASSERT_EQ(static_cast<std::uint8_t>(bytes[BinaryReadResultSink::RECORD_SIZE]), 7);
+}
+
+TEST(ReadResultSinkTests, OptionsSelectSink) {
+    ReadResultOptions options{};
+    ASSERT_EQ(makeReadResultSink(options), nullptr);
+
+    std::vector<std::uint64_t> recorded;
+    options.callback = [](void* context, size_t index, uint32_t data, uint64_t cycle) {
+        auto& results = *static_cast<std::vector<std::uint64_t>*>(context);
+        results.insert(results.end(), {index, data, cycle});
+    };
+    options.context = &recorded;
+    makeReadResultSink(options)->record(5, 6, 7);
+    ASSERT_EQ(recorded, (std::vector<std::uint64_t>{5, 6, 7}));
+}
+
+TEST(ReadResultSinkTests, UnopenableFileThrows) {
+    ASSERT_THROW(CSVReadResultSink{"/nonexistent/directory/results.csv"}, ReadResultSinkError);
+}
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <ctime>
 #include <random>
+#include <unordered_map>
 #include <unordered_set>
 
 std::vector<std::uint64_t> generateRandomVector(std::uint64_t len) {
@@ -38,4 +39,76 @@ Request* generateRandomRequests(std::uint64_t len, std::uint64_t addressMax, std
     }
 
     return requests;
-}
\ No newline at end of file
+}
+
+std::size_t countHits(ReplacementPolicy<std::uint32_t>& policy, std::size_t numCacheLines,
+                      const std::vector<std::uint32_t>& blocks) {
+    std::unordered_map<std::uint32_t, std::uint32_t> lineOfBlock{};
+    std::vector<std::uint32_t> blockInLine{};
+    std::size_t hits = 0;
+    for (auto block : blocks) {
+        auto found = lineOfBlock.find(block);
+        if (found != lineOfBlock.end()) {
+            ++hits;
+            policy.logUse(found->second);
+            continue;
+        }
+        // same order of calls as the fully associative cache
+        policy.logMiss(block);
+        auto line = static_cast<std::uint32_t>(blockInLine.size());
+        if (blockInLine.size() < numCacheLines) {
+            blockInLine.push_back(block);
+        } else {
+            line = policy.pop();
+            lineOfBlock.erase(blockInLine[line]);
+            blockInLine[line] = block;
+        }
+        lineOfBlock[block] = line;
+        policy.logUse(line);
+    }
+    return hits;
+}
+
+std::vector<std::uint32_t> cyclicAccesses(std::uint32_t workingSetSize, std::size_t rounds) {
+    std::vector<std::uint32_t> blocks{};
+    for (std::size_t round = 0; round < rounds; ++round)
+        for (std::uint32_t block = 0; block < workingSetSize; ++block)
+            blocks.push_back(block);
+    return blocks;
+}
+
+MemoryRequester::MemoryRequester(sc_core::sc_module_name name, std::uint32_t beatsPerRead)
+    : sc_module{name}, beatsPerRead{beatsPerRead} {
+    SC_THREAD(dispatchRequests);
+    sensitive << clock.neg();
+}
+
+void MemoryRequester::dispatchRequests() {
+    wait();
+    for (auto& request : requests) {
+        addrBus.write(request.addr);
+        dataOutBus.write(request.data);
+        weBus.write(request.we);
+        validRequestBus.write(true);
+        std::uint32_t latency = 0;
+        do {
+            wait();
+            ++latency;
+        } while (!readyBus.read());
+        validRequestBus.write(false);
+        latencies.push_back(latency);
+
+        if (!request.we) {
+            std::vector<std::uint8_t> line;
+            for (std::uint32_t beat = 0; beat < beatsPerRead; ++beat) {
+                const auto& bytes = dataInBus.read().bytes;
+                line.insert(line.end(), bytes.begin(), bytes.end());
+                if (beat != beatsPerRead - 1)
+                    wait();
+            }
+            linesRead.push_back(line);
+        }
+        cycleLastRequestFinished = sc_core::sc_time_stamp().value() / 1000;
+        wait();
+    }
+}
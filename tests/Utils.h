@@ -1,11 +1,54 @@
 #pragma once
 
 #include "../src/Request.h"
+#include "../src/Simulation/BusBeat.h"
+#include "../src/Simulation/Policy/ReplacementPolicy.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
+#include <systemc>
+
 std::vector<std::uint64_t> generateRandomVector(std::uint64_t len);
 std::vector<std::uint64_t> generateRandomVector(std::uint64_t len, std::uint64_t max);
 std::vector<std::uint64_t> makeVectorUniqueNoOrderPreserve(std::vector<std::uint64_t> input);
 Request* generateRandomRequests(std::uint64_t len, std::uint64_t addressMax = UINT32_MAX, std::uint64_t dataMax = UINT32_MAX, std::uint64_t weMax = 2);
+
+// replays accesses to the given blocks on a fully associative cache using the policy, returns the number of hits
+std::size_t countHits(ReplacementPolicy<std::uint32_t>& policy, std::size_t numCacheLines,
+                      const std::vector<std::uint32_t>& blocks);
+// every block of [0, workingSetSize) once per round, in order
+std::vector<std::uint32_t> cyclicAccesses(std::uint32_t workingSetSize, std::size_t rounds);
+
+// speaks the protocol of a write buffer towards the memory side (RAM, DRAM, memory controller, clock domain bridge or
+// L2): issues its requests one after the other on falling edge, holds valid until ready and takes all beatsPerRead
+// beats of a read. Records how many of its cycles each request took until ready, the bytes of every line read and the
+// cycle (of a 1 ns clock) its last request finished in
+SC_MODULE(MemoryRequester) {
+    struct MemoryRequest {
+        std::uint32_t addr;
+        std::uint32_t data;
+        bool we;
+    };
+    std::vector<MemoryRequest> requests;
+    std::vector<std::uint32_t> latencies;
+    std::vector<std::vector<std::uint8_t>> linesRead;
+    std::uint32_t beatsPerRead;
+    std::uint64_t cycleLastRequestFinished = 0;
+
+    sc_core::sc_in<bool> clock;
+
+    sc_core::sc_out<std::uint32_t> addrBus;
+    sc_core::sc_out<std::uint32_t> dataOutBus;
+    sc_core::sc_out<bool> weBus;
+    sc_core::sc_out<bool> validRequestBus;
+
+    sc_core::sc_in<BusBeat> dataInBus;
+    sc_core::sc_in<bool> readyBus;
+
+    SC_CTOR(MemoryRequester);
+    MemoryRequester(sc_core::sc_module_name name, std::uint32_t beatsPerRead);
+
+    void dispatchRequests();
+};
@@ -0,0 +1,116 @@
+#include "../src/Simulation/RAM.h"
+#include "../src/Simulation/WriteBuffer.h"
+#include "Utils.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <systemc>
+#include <vector>
+using namespace sc_core;
+
+class WriteBufferTests : public testing::Test {
+  public:
+    MemoryRequester cache{"Cache", 64 / 16};
+    WriteBuffer writeBuffer{"WriteBuffer", 64 / 16, 64, 4, false};
+    RAM ram{"RAM", 100, 64 / 16};
+
+    // Cache <-> Buffer
+    sc_signal<std::uint32_t> SC_NAMED(cacheAddrSignal);
+    sc_signal<std::uint32_t> SC_NAMED(cacheDataSignal);
+    sc_signal<bool> SC_NAMED(cacheWeSignal);
+    sc_signal<bool> SC_NAMED(cacheValidSignal);
+    sc_signal<BusBeat> SC_NAMED(cacheLineSignal);
+    sc_signal<bool> SC_NAMED(cacheReadySignal);
+
+    // Buffer <-> RAM
+    sc_signal<std::uint32_t> SC_NAMED(ramAddrSignal);
+    sc_signal<std::uint32_t> SC_NAMED(ramDataInSignal);
+    sc_signal<bool> SC_NAMED(ramWeSignal);
+    sc_signal<bool> SC_NAMED(ramValidSignal);
+    sc_signal<BusBeat> SC_NAMED(ramDataOutSignal);
+    sc_signal<bool> SC_NAMED(ramReadySignal);
+
+    sc_clock clock{"clk", sc_time(1, SC_NS)};
+
+    void SetUp() override {
+        cache.clock.bind(clock);
+        cache.addrBus.bind(cacheAddrSignal);
+        cache.dataOutBus.bind(cacheDataSignal);
+        cache.weBus.bind(cacheWeSignal);
+        cache.validRequestBus.bind(cacheValidSignal);
+        cache.dataInBus.bind(cacheLineSignal);
+        cache.readyBus.bind(cacheReadySignal);
+
+        writeBuffer.clock.bind(clock);
+        writeBuffer.cacheAddrBus.bind(cacheAddrSignal);
+        writeBuffer.cacheDataInBus.bind(cacheDataSignal);
+        writeBuffer.cacheWeBus.bind(cacheWeSignal);
+        writeBuffer.cacheValidRequest.bind(cacheValidSignal);
+        writeBuffer.cacheDataOutBus.bind(cacheLineSignal);
+        writeBuffer.ready.bind(cacheReadySignal);
+
+        writeBuffer.memoryAddrBus.bind(ramAddrSignal);
+        writeBuffer.memoryDataOutBus.bind(ramDataInSignal);
+        writeBuffer.memoryWeBus.bind(ramWeSignal);
+        writeBuffer.memoryValidRequestBus.bind(ramValidSignal);
+        writeBuffer.memoryDataInBus.bind(ramDataOutSignal);
+        writeBuffer.memoryReadyBus.bind(ramReadySignal);
+
+        ram.clock.bind(clock);
+        ram.addressBus.bind(ramAddrSignal);
+        ram.dataInBus.bind(ramDataInSignal);
+        ram.weBus.bind(ramWeSignal);
+        ram.validRequestBus.bind(ramValidSignal);
+        ram.dataOutBus.bind(ramDataOutSignal);
+        ram.readyBus.bind(ramReadySignal);
+    }
+};
+
+TEST_F(WriteBufferTests, ReadOfCompletelyBufferedLineIsForwarded) {
+    cache.requests.push_back({0x100, 0xFFFFFFFF, true}); // drained right away, the next writes get their own entry
+    for (std::uint32_t word = 0; word < 16; ++word)
+        cache.requests.push_back({0x100 + 4 * word, 0x01010101 * word, true});
+    cache.requests.push_back({0x100, 0, false});
+    sc_start(1, SC_MS);
+
+    ASSERT_EQ(cache.linesRead.size(), 1);
+    for (std::uint32_t byte = 0; byte < 64; ++byte)
+        ASSERT_EQ(cache.linesRead.at(0).at(byte), byte / 4);
+    // served once the first write is done (~100 cycles), without waiting for a RAM read of another 100
+    ASSERT_LT(cache.cycleLastRequestFinished, 200);
+
+    const auto& statistics = writeBuffer.getStatistics();
+    ASSERT_EQ(statistics.forwardedReads, 1);
+    ASSERT_EQ(statistics.mergedReads, 0);
+    ASSERT_GE(statistics.stallCyclesAvoided, 16 * 100);
+}
+
+TEST_F(WriteBufferTests, ReadOfPartlyBufferedLineMergesBufferedBytesIntoRAMData) {
+    ram.dataMemory[0x13C] = 0xAB;
+    cache.requests = {{0x100, 0x04030201, true}, {0x108, 0xDEADBEEF, true}, {0x100, 0, false}};
+    sc_start(1, SC_MS);
+
+    ASSERT_EQ(cache.linesRead.size(), 1);
+    auto& line = cache.linesRead.at(0);
+    ASSERT_EQ(line.at(0), 0x01); // drained before the read
+    ASSERT_EQ(line.at(3), 0x04);
+    ASSERT_EQ(line.at(8), 0xEF); // still buffered during the read
+    ASSERT_EQ(line.at(11), 0xDE);
+    ASSERT_EQ(line.at(0x3C), 0xAB); // only in RAM
+
+    const auto& statistics = writeBuffer.getStatistics();
+    ASSERT_EQ(statistics.forwardedReads, 0);
+    ASSERT_EQ(statistics.mergedReads, 1);
+    ASSERT_GT(statistics.stallCyclesAvoided, 0);
+    ASSERT_EQ(ram.dataMemory[0x108], 0xEF); // the merged write still reaches the RAM afterwards
+}
+
+TEST_F(WriteBufferTests, ReadOfUnrelatedLineIsNeitherForwardedNorMerged) {
+    cache.requests = {{0x100, 1, true}, {0x200, 0, false}};
+    sc_start(1, SC_MS);
+
+    ASSERT_EQ(cache.linesRead.size(), 1);
+    const auto& statistics = writeBuffer.getStatistics();
+    ASSERT_EQ(statistics.forwardedReads, 0);
+    ASSERT_EQ(statistics.mergedReads, 0);
+    ASSERT_EQ(statistics.stallCyclesAvoided, 0);
+}
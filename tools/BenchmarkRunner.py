@@ -72,11 +72,19 @@ def runBenchmarkForCacheSize(*,  cacheLineNum: int, memLatency: int, cacheLatenc
 
 def runBenchmarkForPolicy(*, cacheLineNum: int, memLatency: int, cacheLatency: int, cacheLineSize: int):
     bs = []
-    for policyI in {"lru", "fifo", "random"}:
+    for policyI in {"lru", "fifo", "random", "plru", "bitplru", "srrip", "brrip", "drrip", "lfu", "arc", "2q", "lirs", "dip", "opt"}:
         r = runBenchmark(f"BenchmarkInputGenerator/Benchmarks/merge_sort_100.csv", cacheLineNum=cacheLineNum, memLatency=memLatency, cacheLatency=cacheLatency, cacheSize=cacheLineSize, policy=policyI, direct_mapped=False) 
         bs.append(BenchmarkResult(100, "merge", policy=policyI, direct_mapped=False, cacheLatency=cacheLatency, memLatency=memLatency, result=r, cacheLineNum=cacheLineNum, cacheLineSize=cacheLineSize))             
     return bs
 
+def hitRate(b: BenchmarkResult) -> float:
+    return 100*b.result.hits / (b.result.hits+b.result.misses)
+
+# how many percentage points of hit rate the policy loses against OPT on the same input and cache
+def regretVersusOpt(b: BenchmarkResult, benches: List[BenchmarkResult]) -> float:
+    opt = [o for o in benches if o.policy == "opt" and o.alg == b.alg and o.inputSize == b.inputSize and o.cacheLineNum == b.cacheLineNum and o.cacheLineSize == b.cacheLineSize][0]
+    return hitRate(opt) - hitRate(b)
+
 def runBenchmarkForPolicyAndCacheLineNum(*, memLatency: int, cacheLatency: int, cacheLineSize: int):
     bs = []
     for cachelineNum in {10, 100, 1000}:
@@ -143,7 +151,7 @@ printAsCSV(["Cacheline-Size", "Hit-%", "Cycles/M.A."], [[b.cacheLineSize for b i
 
 
 benches: list[BenchmarkResult] = runBenchmarkForPolicy(cacheLineNum=8, cacheLineSize=16, memLatency=100, cacheLatency=5)
-printAsCSV(["Replacement-Policy", "Hit-%", "Cycles/M.A."], [[b.policy for b in benches], [100*b.result.hits / (b.result.hits+b.result.misses) for b in benches], [b.result.cyclesNeeded  / ((b.result.hits+b.result.misses)) for b in benches]], "../BenchmarkResults/policyBenchmarks.csv")
+printAsCSV(["Replacement-Policy", "Hit-%", "Regret-%", "Cycles/M.A."], [[b.policy for b in benches], [hitRate(b) for b in benches], [regretVersusOpt(b, benches) for b in benches], [b.result.cyclesNeeded  / ((b.result.hits+b.result.misses)) for b in benches]], "../BenchmarkResults/policyBenchmarks.csv")
 #print("done with replacement policy")
     
     
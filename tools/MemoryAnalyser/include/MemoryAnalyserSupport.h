@@ -3,17 +3,58 @@
 #include <fstream>
 #include <stdint.h>
 #include <string>
+#include <time.h>
 
 const std::string filename = "memory_analysis.csv";
 
+/**
+ * Reads the cycle counter into counter: the time stamp counter on x86, nanoseconds of the monotonic clock elsewhere.
+ * A macro instead of a function, as the pass instruments the memory accesses of every function but the log functions.
+ */
+#if defined(__x86_64__) || defined(__i386__)
+#define READ_CYCLE_COUNTER(counter) counter = __builtin_ia32_rdtsc()
+#else
+#define READ_CYCLE_COUNTER(counter)                                                                                    \
+    do {                                                                                                               \
+        struct timespec time;                                                                                          \
+        clock_gettime(CLOCK_MONOTONIC, &time);                                                                         \
+        counter = (uint64_t)time.tv_sec * 1000000000u + (uint64_t)time.tv_nsec;                                        \
+    } while (0)
+#endif
+
+/**
+ * The cycles that passed since the previous access was logged, the gap column of the trace: 0 for the first access,
+ * capped at 2^31-1, the most the simulator takes. They include the access itself, but not the time logging takes, as
+ * lastLogged is only taken once the line is written.
+ */
+#define CYCLES_SINCE_LAST_ACCESS(now)                                                                                  \
+    (lastLogged == 0 ? 0 : (now - lastLogged > INT32_MAX ? INT32_MAX : now - lastLogged))
+
+// the cycle counter once the previous access was logged, 0 before the first one
+static uint64_t lastLogged = 0;
+
+/**
+ * The instruction column of the trace: the return address of the log function, which is the instruction after the call
+ * the pass inserted next to the access. Only its low 32 bits, the addresses the simulator takes, which keeps the
+ * distances within the code of the program. A macro so it is taken in the frame of the log function.
+ */
+#define INSTRUCTION_ADDRESS ((uint32_t)(uintptr_t)__builtin_return_address(0))
+
 extern "C" void logRead(void* address) {
+    uint64_t now;
+    READ_CYCLE_COUNTER(now);
     std::ofstream ofs(filename, std::ios_base::app);
-    ofs << "R," << address <<","<< "\n";
+    ofs << "R," << address << ",," << CYCLES_SINCE_LAST_ACCESS(now) << "," << INSTRUCTION_ADDRESS << "\n";
     ofs.close();
+    READ_CYCLE_COUNTER(lastLogged);
 }
 
 extern "C" void logWrite(void* address, uint64_t value) {
+    uint64_t now;
+    READ_CYCLE_COUNTER(now);
     std::ofstream ofs(filename, std::ios_base::app);
-    ofs << "W," << address << "," << value << "\n";
+    ofs << "W," << address << "," << value << "," << CYCLES_SINCE_LAST_ACCESS(now) << "," << INSTRUCTION_ADDRESS
+        << "\n";
     ofs.close();
-}
\ No newline at end of file
+    READ_CYCLE_COUNTER(lastLogged);
+}
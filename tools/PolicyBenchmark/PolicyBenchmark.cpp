@@ -0,0 +1,119 @@
+#include "../../src/Simulation/Policy/ARCPolicy.h"
+#include "../../src/Simulation/Policy/BitPLRUPolicy.h"
+#include "../../src/Simulation/Policy/DIPPolicy.h"
+#include "../../src/Simulation/Policy/FIFOPolicy.h"
+#include "../../src/Simulation/Policy/LFUPolicy.h"
+#include "../../src/Simulation/Policy/LIRSPolicy.h"
+#include "../../src/Simulation/Policy/LRUPolicy.h"
+#include "../../src/Simulation/Policy/PluginPolicy.h"
+#include "../../src/Simulation/Policy/RRIPPolicy.h"
+#include "../../src/Simulation/Policy/TreePLRUPolicy.h"
+#include "../../src/Simulation/Policy/TwoQueuePolicy.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * Microbenchmark for the replacement policies of the fully associative cache. It replays the calls the cache makes:
+ * every access is a logUse of the cacheline index it hit, every miss in a full cache first pops the victim and then
+ * logs the use of the freed index. One in missInterval accesses is a miss, which is reported with the tag of a block
+ * drawn from four times as many blocks as there are cachelines, so the policies with a history see it again at times.
+ *
+ * Every policy runs twice: once called through the ReplacementPolicy interface and once bound at compile time, as the
+ * data cache of the simulation is. The ratio of both is the per-access speedup of the latter.
+ *
+ * LRU-plugin is the example plugin of tools/PolicyPlugin loaded through --policy-plugin's PluginPolicy. It makes the
+ * same choices as the built-in LRU, so comparing both shows the overhead of calling a policy across the plugin ABI.
+ */
+
+constexpr std::size_t accessesPerRun = 10000000;
+constexpr std::size_t missInterval = 8;
+constexpr std::uint32_t missFlag = 1u << 31; // a miss carries the tag of the missing block in the remaining bits
+constexpr const char* lruPluginPath = "../PolicyPlugin/lruPolicyPlugin.so";
+
+static std::vector<std::uint32_t> generateAccessPattern(std::size_t numCacheLines) {
+    std::mt19937 generator{42}; // fixed seed so every policy sees the same accesses
+    std::uniform_int_distribution<std::uint32_t> lineDistr(0, numCacheLines - 1);
+    std::uniform_int_distribution<std::uint32_t> blockDistr(0, 4 * numCacheLines - 1);
+    std::vector<std::uint32_t> pattern(accessesPerRun);
+    for (std::size_t i = 0; i < accessesPerRun; ++i) {
+        pattern[i] = (i % missInterval == 0) ? (missFlag | blockDistr(generator)) : lineDistr(generator);
+    }
+    return pattern;
+}
+
+/**
+ * Replays the pattern on policy and returns the time per access in ns. PolicyRef is either the ReplacementPolicy
+ * interface, so every call is virtual like in a cache choosing its policy at runtime, or the final policy class itself,
+ * so the calls can be inlined like in a cache bound to the policy at compile time.
+ */
+template <typename PolicyRef>
+static double replay(PolicyRef& policy, const std::vector<std::uint32_t>& pattern, std::size_t numCacheLines,
+                     std::uint64_t& checksum) {
+    for (std::uint32_t line = 0; line < numCacheLines; ++line) {
+        policy.logUse(line); // the cache fills up empty lines in order before it ever pops
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto line : pattern) {
+        if ((line & missFlag) != 0) {
+            policy.logMiss(line & ~missFlag);
+            const auto victim = policy.pop();
+            checksum += victim;
+            policy.logUse(victim);
+        } else {
+            policy.logUse(line);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() /
+           static_cast<double>(accessesPerRun);
+}
+
+// not inlined, so the compiler cannot see the dynamic type of the policy behind the interface
+template <typename PolicyType, typename... Args>
+__attribute__((noinline)) static std::unique_ptr<ReplacementPolicy<std::uint32_t>> makeVirtual(Args... policyArgs) {
+    return std::make_unique<PolicyType>(policyArgs...);
+}
+
+template <typename PolicyType, typename... Args>
+static void benchmark(const char* name, std::size_t numCacheLines, Args... policyArgs) {
+    const auto pattern = generateAccessPattern(numCacheLines);
+
+    std::uint64_t virtualChecksum = 0; // keeps the compiler from dropping the pops
+    auto virtualPolicy = makeVirtual<PolicyType>(numCacheLines, policyArgs...);
+    const double virtualNs = replay(*virtualPolicy, pattern, numCacheLines, virtualChecksum);
+
+    std::uint64_t boundChecksum = 0;
+    PolicyType boundPolicy{numCacheLines, policyArgs...};
+    const double boundNs = replay(boundPolicy, pattern, numCacheLines, boundChecksum);
+
+    // both runs have to make the same choices
+    std::printf("%-10s %8zu lines: %7.2f ns/access virtual, %7.2f ns/access bound, speedup %5.2fx (checksum %llu%s)\n",
+                name, numCacheLines, virtualNs, boundNs, virtualNs / boundNs,
+                static_cast<unsigned long long>(boundChecksum), virtualChecksum == boundChecksum ? "" : ", differs");
+}
+
+int main() {
+    for (std::size_t numCacheLines : {16, 256, 4096, 65536, 100000}) {
+        benchmark<LRUPolicy<std::uint32_t>>("LRU", numCacheLines);
+        benchmark<PluginPolicy<std::uint32_t>>("LRU-plugin", numCacheLines, lruPluginPath);
+        benchmark<FIFOPolicy<std::uint32_t>>("FIFO", numCacheLines);
+        benchmark<TreePLRUPolicy<std::uint32_t>>("PLRU", numCacheLines);
+        benchmark<BitPLRUPolicy<std::uint32_t>>("BitPLRU", numCacheLines);
+        using RRIP = RRIPPolicy<std::uint32_t>;
+        benchmark<RRIP>("SRRIP", numCacheLines, RRIP::Insertion::Static);
+        benchmark<RRIP>("BRRIP", numCacheLines, RRIP::Insertion::Bimodal);
+        benchmark<RRIP>("DRRIP", numCacheLines, RRIP::Insertion::Dynamic);
+        benchmark<LFUPolicy<std::uint32_t>>("LFU", numCacheLines);
+        benchmark<ARCPolicy<std::uint32_t>>("ARC", numCacheLines);
+        benchmark<TwoQueuePolicy<std::uint32_t>>("2Q", numCacheLines);
+        benchmark<LIRSPolicy<std::uint32_t>>("LIRS", numCacheLines);
+        benchmark<DIPPolicy<std::uint32_t>>("DIP", numCacheLines);
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "../../src/Simulation/Policy/PolicyPlugin.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * Example replacement-policy plugin implementing LRU in plain C, with the same doubly linked list over cacheline
+ * indices as the built-in LRUPolicy. Index numCacheLines is the sentinel closing the list into a ring, the most
+ * recently used cacheline follows it and the least recently used one precedes it. A cacheline not in the list points
+ * to itself.
+ */
+struct LRUState {
+    uint32_t sentinel;
+    uint32_t* prev;
+    uint32_t* next;
+};
+
+static void* create(size_t numCacheLines) {
+    if (numCacheLines == 0 || numCacheLines >= UINT32_MAX)
+        return NULL;
+    struct LRUState* lru = malloc(sizeof(struct LRUState));
+    if (lru == NULL)
+        return NULL;
+    lru->sentinel = (uint32_t)numCacheLines;
+    lru->prev = malloc((numCacheLines + 1) * sizeof(uint32_t));
+    lru->next = malloc((numCacheLines + 1) * sizeof(uint32_t));
+    if (lru->prev == NULL || lru->next == NULL) {
+        free(lru->prev);
+        free(lru->next);
+        free(lru);
+        return NULL;
+    }
+    for (uint32_t index = 0; index <= lru->sentinel; ++index) {
+        lru->prev[index] = index;
+        lru->next[index] = index;
+    }
+    return lru;
+}
+
+static void destroy(void* state) {
+    struct LRUState* lru = state;
+    free(lru->prev);
+    free(lru->next);
+    free(lru);
+}
+
+static void unlink_cacheline(struct LRUState* lru, uint32_t index) {
+    lru->next[lru->prev[index]] = lru->next[index];
+    lru->prev[lru->next[index]] = lru->prev[index];
+}
+
+static void log_use(void* state, uint32_t cacheline) {
+    struct LRUState* lru = state;
+    if (lru->next[cacheline] != cacheline)
+        unlink_cacheline(lru, cacheline);
+    lru->next[cacheline] = lru->next[lru->sentinel];
+    lru->prev[cacheline] = lru->sentinel;
+    lru->prev[lru->next[lru->sentinel]] = cacheline;
+    lru->next[lru->sentinel] = cacheline;
+}
+
+static uint32_t pop(void* state) {
+    struct LRUState* lru = state;
+    const uint32_t leastRecentlyUsed = lru->prev[lru->sentinel];
+    unlink_cacheline(lru, leastRecentlyUsed);
+    lru->prev[leastRecentlyUsed] = leastRecentlyUsed;
+    lru->next[leastRecentlyUsed] = leastRecentlyUsed;
+    return leastRecentlyUsed;
+}
+
+static size_t calc_basic_gates(const void* state) {
+    // the same estimate as the built-in LRU: a 32 bit register per cacheline plus the hash table of the main cache
+    const struct LRUState* lru = state;
+    return (size_t)lru->sentinel * 32 + 2753000;
+}
+
+static const struct PolicyPlugin plugin = {POLICY_PLUGIN_ABI_VERSION, "LRU (plugin)", create, destroy, log_use, pop,
+                                           NULL, calc_basic_gates};
+
+const struct PolicyPlugin* cache_policy_plugin(void) { return &plugin; }